@@ -101,6 +101,12 @@ void Engine::PerformGets(core::GetContext &ctx)
     m_Engine->PerformGets(ctx);
 }
 
+std::shared_future<void> Engine::PerformGetsAsync(core::GetContext &ctx)
+{
+    helper::CheckForNullptr(m_Engine, "in call to Engine::PerformGetsAsync");
+    return m_Engine->PerformGetsAsync(ctx);
+}
+
 void Engine::LockWriterDefinitions()
 {
     helper::CheckForNullptr(m_Engine, "in call to Engine::LockWriterDefinitions");
@@ -15,6 +15,8 @@
 #include "adios2/common/ADIOSMacros.h"
 #include "adios2/common/ADIOSTypes.h"
 
+#include <future>
+
 namespace adios2
 {
 
@@ -458,6 +460,14 @@ public:
 
     void PerformGets(core::GetContext &ctx);
 
+    /**
+     * Non-blocking PerformGets(ctx): the reads run in the background while
+     * other contexts are filled or processed. Keep ctx and the Get
+     * destinations alive until the returned future is ready; its get()
+     * rethrows any read error.
+     */
+    std::shared_future<void> PerformGetsAsync(core::GetContext &ctx);
+
     /**
      * Ends current step, by default calls PerformsPut/Get internally
      * For most engines, this is an MPI collective function.
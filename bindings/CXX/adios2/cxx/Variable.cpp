@@ -247,6 +247,13 @@ namespace adios2
     }                                                                                              \
                                                                                                    \
     template <>                                                                                    \
+    std::vector<uint64_t> Variable<T>::Histogram(const size_t step) const                          \
+    {                                                                                              \
+        helper::CheckForNullptr(m_Variable, "in call to Variable<T>::Histogram");                  \
+        return m_Variable->Histogram(step);                                                        \
+    }                                                                                              \
+                                                                                                   \
+    template <>                                                                                    \
     adios2::Accuracy Variable<T>::GetAccuracy()                                                    \
     {                                                                                              \
         helper::CheckForNullptr(m_Variable, "in call to Variable<T>::GetAccuracy");                \
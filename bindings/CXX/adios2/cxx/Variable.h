@@ -383,6 +383,19 @@ public:
      */
     T Max(const size_t step = adios2::DefaultSizeT) const;
 
+    /**
+     * Read mode only: return the histogram of the variable's values at a
+     * step, stored by BP5 with StatsLevel=2, in StatsHistogramBins
+     * equal-width bins between Min(step) and Max(step). Steps as in MinMax.
+     * The counts are rebinned from the histograms of the blocks, whose bins
+     * do not line up with these, and are approximate: each block bin is split
+     * between the bins it overlaps as if its values were spread evenly.
+     * @param step input step
+     * @return bin counts, empty if the file has no histograms or a block of
+     * the step has none (written from device memory)
+     */
+    std::vector<uint64_t> Histogram(const size_t step = adios2::DefaultSizeT) const;
+
     /**
      * Get the provided accuracy for the last read operation.
      * Most operations provide data as it was written, meaning that
@@ -409,6 +422,9 @@ public:
         size_t BlockID = 0;
         /** block corresponding step */
         size_t Step = 0;
+        /** histogram of the block's values over [Min, Max] (BP5 StatsLevel 2),
+         *  empty if none was stored, as for blocks in device memory */
+        std::vector<uint64_t> Histogram;
         /** reference to internal block data (used by inline Engine).
          *  For deferred variables, valid pointer is not returned until
          *  EndStep/PerformGets has been called. */
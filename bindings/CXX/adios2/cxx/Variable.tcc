@@ -197,6 +197,11 @@ Variable<T>::ToBlocksInfoMin(const MinVarInfo *coreVarInfo) const
         {
             blockInfo.Min = *(T *)&coreBlockInfo.MinMax.MinUnion;
             blockInfo.Max = *(T *)&coreBlockInfo.MinMax.MaxUnion;
+            if (coreBlockInfo.Histogram)
+            {
+                blockInfo.Histogram.assign(coreBlockInfo.Histogram,
+                                           coreBlockInfo.Histogram + coreBlockInfo.HistogramBins);
+            }
         }
         blockInfo.BlockID = coreBlockInfo.BlockID;
         blocksInfo.push_back(blockInfo);
@@ -198,6 +198,18 @@ struct MinBlockInfo
     const size_t *Count;
     MinMaxStruct MinMax;
     void *BufferP = NULL;
+    /** Sub-block statistics (BP5 StatsBlockSize): the divisions of Count
+     *  [Dims] as in helper::BlockDivisionInfo::Div, and SubBlockCount min/max
+     *  pairs of the variable's type, in helper::GetSubBlock() order.
+     *  SubBlockCount is 0 if the block was not divided. */
+    const size_t *SubBlockDiv = nullptr;
+    size_t SubBlockCount = 0;
+    const void *SubMinMax = nullptr;
+    /** Histogram of the block's values (BP5 StatsLevel 2): HistogramBins
+     *  equal-width bins between MinMax.MinUnion and MinMax.MaxUnion.
+     *  HistogramBins is 0 if none was stored. */
+    const uint64_t *Histogram = nullptr;
+    size_t HistogramBins = 0;
 };
 
 struct MinVarInfo
@@ -246,6 +258,10 @@ constexpr uint64_t DefaultBufferChunkSize = 128 * 1024 * 1024;
  *  4Mb */
 constexpr size_t DefaultMinDeferredSize = 4 * 1024 * 1024;
 
+/** default upper limit for one coalesced read of several read requests
+ *  4Mb */
+constexpr size_t DefaultMaxCoalescedReadSize = 4 * 1024 * 1024;
+
 /** default size for writing/reading files using POSIX/fstream/stdio write
  *  2Gb - 100Kb (tolerance)*/
 constexpr size_t DefaultMaxFileBatchSize = 2147483648 - 102400;
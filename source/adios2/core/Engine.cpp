@@ -86,6 +86,11 @@ void Engine::PerformDataWrite() { return; }
 // Feature probe: null => engine doesn't support the ctx-form pipeline.
 std::unique_ptr<GetContext> Engine::NewGetContext() { return nullptr; }
 void Engine::PerformGets(GetContext &) { ThrowUp("PerformGets(GetContext&)"); }
+std::shared_future<void> Engine::PerformGetsAsync(GetContext &)
+{
+    ThrowUp("PerformGetsAsync");
+    return {};
+}
 void Engine::DoGetContextDeferred(GetContext &, VariableBase &, void *, const Selection &)
 {
     ThrowUp("DoGetContextDeferred");
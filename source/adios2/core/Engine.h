@@ -10,6 +10,7 @@
 /// \cond EXCLUDE_FROM_DOXYGEN
 #include <float.h>
 #include <functional> //std::function
+#include <future>     //std::shared_future
 #include <limits.h>
 #include <limits> //std::numeric_limits
 #include <memory> //std::shared_ptr
@@ -397,6 +398,13 @@ public:
 
     virtual void PerformGets(GetContext &ctx);
 
+    /**
+     * Starts PerformGets(ctx) in the background and returns right away.
+     * ctx and the Get destinations must stay alive and untouched until the
+     * returned future is ready; get() on it rethrows read errors.
+     */
+    virtual std::shared_future<void> PerformGetsAsync(GetContext &ctx);
+
     /**
      * Reader application indicates that no more data will be read from the
      * current stream before advancing.
@@ -537,6 +545,14 @@ public:
         return false;
     }
 
+    /** Histogram of the values of Step from stored statistics, over the
+     *  bins of the range in Range; false if the engine has none */
+    virtual bool VariableHistogram(const VariableBase &, const size_t Step, MinMaxStruct &Range,
+                                   std::vector<uint64_t> &Counts)
+    {
+        return false;
+    }
+
     virtual std::string VariableExprStr(const VariableBase &) { return ""; }
 
     /** Per-file id, for engines that carry one (currently BP5); 0 means none. */
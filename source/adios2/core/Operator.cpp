@@ -79,6 +79,8 @@ Dims Operator::ConvertDims(const Dims &dimensions, const DataType type, const si
 
 size_t Operator::GetHeaderSize() const { return 0; }
 
+bool Operator::IsThreadSafe() const { return false; }
+
 size_t Operator::GetEstimatedSize(const size_t ElemCount, const size_t ElemSize, const size_t ndims,
                                   const size_t *dims) const
 {
@@ -98,5 +100,73 @@ size_t Operator::InverseOperate(const char *bufferIn, const size_t sizeIn, char
     return 0;
 }
 
+size_t Operator::InverseOperateSubset(const char *bufferIn, const size_t sizeIn,
+                                      const Dims &blockCount, const Dims &start, const Dims &count,
+                                      char *dataOut)
+{
+    return 0;
+}
+
+size_t Operator::ForEachSubsetRun(const Dims &blockCount, const Dims &start, const Dims &count,
+                                  const size_t elementSize,
+                                  const std::function<void(size_t, size_t, size_t)> &copyRun) const
+{
+    const size_t ndims = blockCount.size();
+    if (ndims == 0 || start.size() != ndims || count.size() != ndims)
+    {
+        return 0;
+    }
+    for (const auto c : count)
+    {
+        if (c == 0)
+        {
+            return 0;
+        }
+    }
+
+    std::vector<size_t> stride(ndims, 1);
+    for (size_t d = ndims - 1; d > 0; --d)
+    {
+        stride[d - 1] = stride[d] * blockCount[d];
+    }
+    // fold the fastest dimensions the box covers entirely into one run
+    size_t inner = ndims - 1;
+    while (inner > 0 && start[inner] == 0 && count[inner] == blockCount[inner])
+    {
+        --inner;
+    }
+    const size_t runBytes = count[inner] * stride[inner] * elementSize;
+
+    std::vector<size_t> pos(inner, 0);
+    size_t boxOffset = 0;
+    size_t runs = 0;
+    while (true)
+    {
+        size_t blockOffset = start[inner] * stride[inner];
+        for (size_t d = 0; d < inner; ++d)
+        {
+            blockOffset += (start[d] + pos[d]) * stride[d];
+        }
+        copyRun(blockOffset * elementSize, boxOffset, runBytes);
+        boxOffset += runBytes;
+        ++runs;
+
+        size_t d = inner;
+        for (; d > 0; --d)
+        {
+            if (++pos[d - 1] < count[d - 1])
+            {
+                break;
+            }
+            pos[d - 1] = 0;
+        }
+        if (d == 0)
+        {
+            break;
+        }
+    }
+    return runs;
+}
+
 } // end namespace core
 } // end namespace adios2
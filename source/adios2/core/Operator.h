@@ -90,8 +90,31 @@ public:
      */
     virtual size_t InverseOperate(const char *bufferIn, const size_t sizeIn, char *dataOut);
 
+    /**
+     * @param bufferIn
+     * @param sizeIn
+     * @param blockCount dimensions of the whole block in bufferIn
+     * @param start first element of the box, relative to the block
+     * @param count dimensions of the box
+     * @param dataOut receives only the box, densely packed in row-major order
+     * @return size of the decompressed box, or 0 if the operator cannot
+     * decompress a part of this buffer cheaper than all of it, in which case
+     * the caller falls back to InverseOperate.
+     */
+    virtual size_t InverseOperateSubset(const char *bufferIn, const size_t sizeIn,
+                                        const Dims &blockCount, const Dims &start,
+                                        const Dims &count, char *dataOut);
+
     virtual bool IsDataTypeValid(const DataType type) const = 0;
 
+    /**
+     * @return true if distinct instances of this operator may run
+     * InverseOperate concurrently from different threads, i.e. the
+     * underlying library keeps no process-global state. Readers use this to
+     * decompress blocks in parallel with one instance per thread.
+     */
+    virtual bool IsThreadSafe() const;
+
 protected:
     /** Parameters associated with a particular Operator */
     Params m_Parameters;
@@ -113,6 +136,16 @@ protected:
     Dims ConvertDims(const Dims &dimensions, const DataType type, const size_t targetDims = 0,
                      const bool enforceDims = false, const size_t defaultDimSize = 1) const;
 
+    /**
+     * Walks the box (start, count) of a row-major block with dimensions
+     * blockCount in runs of contiguous bytes, calling
+     * copyRun(offsetInBlock, offsetInBox, bytes) for each of them.
+     * @return number of runs
+     */
+    size_t ForEachSubsetRun(const Dims &blockCount, const Dims &start, const Dims &count,
+                            const size_t elementSize,
+                            const std::function<void(size_t, size_t, size_t)> &copyRun) const;
+
     template <typename T>
     void MakeCommonHeader(char *bufferOut, T &bufferOutOffset, const uint8_t bufferVersion)
     {
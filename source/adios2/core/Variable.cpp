@@ -97,6 +97,12 @@ namespace core
     }                                                                                              \
                                                                                                    \
     template <>                                                                                    \
+    std::vector<uint64_t> Variable<T>::Histogram(const size_t step) const                          \
+    {                                                                                              \
+        return DoHistogram(step);                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    template <>                                                                                    \
     std::vector<std::vector<typename Variable<T>::BPInfo>> Variable<T>::AllStepsBlocksInfo() const \
     {                                                                                              \
         return DoAllStepsBlocksInfo();                                                             \
@@ -128,6 +128,14 @@ public:
 
     T Max(const size_t step = adios2::DefaultSizeT) const;
 
+    /**
+     * Histogram from statistics stored in the file (BP5 StatsLevel 2), in
+     * equal-width bins between MinMax(step), rebinned from the block
+     * histograms and so approximate. Empty if the file has none, or
+     * if a block of the step has none (written from device memory).
+     */
+    std::vector<uint64_t> Histogram(const size_t step = adios2::DefaultSizeT) const;
+
     std::vector<std::vector<typename Variable<T>::BPInfo>> AllStepsBlocksInfo() const;
 
 private:
@@ -139,6 +147,8 @@ private:
 
     std::pair<T, T> DoMinMax(const size_t step) const;
 
+    std::vector<uint64_t> DoHistogram(const size_t step) const;
+
     std::vector<std::vector<typename Variable<T>::BPInfo>> DoAllStepsBlocksInfo() const;
 
     size_t WriterIndex;
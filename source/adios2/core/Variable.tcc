@@ -296,6 +296,20 @@ size_t Variable<T>::SelectionSize(const Selection &selection) const
     return 0;
 }
 
+template <class T>
+std::vector<uint64_t> Variable<T>::DoHistogram(const size_t step) const
+{
+    CheckRandomAccess(step, "Histogram");
+
+    std::vector<uint64_t> counts;
+    MinMaxStruct range;
+    if (m_Engine != nullptr && !m_Engine->VariableHistogram(*this, step, range, counts))
+    {
+        counts.clear();
+    }
+    return counts;
+}
+
 template <class T>
 std::pair<T, T> Variable<T>::DoMinMax(const size_t step) const
 {
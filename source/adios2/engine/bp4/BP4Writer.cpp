@@ -230,6 +230,9 @@ void BP4Writer::InitTransports()
             /* start up BB thread */
             m_FileDrainer.SetVerbose(m_BP4Serializer.m_Parameters.BurstBufferVerbose,
                                      m_BP4Serializer.m_RankMPI);
+            m_FileDrainer.SetThreads(m_BP4Serializer.m_Parameters.BurstBufferDrainThreads);
+            m_FileDrainer.SetMaxBandwidth(m_BP4Serializer.m_Parameters.BurstBufferMaxBandwidth);
+            m_FileDrainer.SetLowPriority(m_BP4Serializer.m_Parameters.BurstBufferLowPriority);
             m_FileDrainer.Start();
         }
     }
@@ -838,6 +841,22 @@ size_t BP4Writer::DebugGetDataBufferSize() const
     return m_BP4Serializer.DebugGetDataBufferSize();
 }
 
+void BP4Writer::EnterComputationBlock() noexcept
+{
+    if (m_DrainBB)
+    {
+        m_FileDrainer.EnterComputationBlock();
+    }
+}
+
+void BP4Writer::ExitComputationBlock() noexcept
+{
+    if (m_DrainBB)
+    {
+        m_FileDrainer.ExitComputationBlock();
+    }
+}
+
 void BP4Writer::NotifyEngineAttribute(std::string name, DataType type) noexcept
 {
     m_BP4Serializer.m_SerializedAttributes.erase(name);
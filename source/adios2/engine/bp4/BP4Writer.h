@@ -10,7 +10,7 @@
 #include "adios2/common/ADIOSConfig.h"
 #include "adios2/core/Engine.h"
 #include "adios2/helper/adiosComm.h"
-#include "adios2/toolkit/burstbuffer/FileDrainerSingleThread.h"
+#include "adios2/toolkit/burstbuffer/FileDrainerMultiThread.h"
 #include "adios2/toolkit/format/bp/bp4/BP4Serializer.h"
 #include "adios2/toolkit/transportman/TransportMan.h"
 
@@ -43,6 +43,10 @@ public:
 
     size_t DebugGetDataBufferSize() const final;
 
+    /** Only the burst buffer draining uses computation blocks */
+    void EnterComputationBlock() noexcept final;
+    void ExitComputationBlock() noexcept final;
+
 protected:
     void DestructorClose(bool Verbose) noexcept;
 
@@ -67,7 +71,7 @@ private:
     /** true if burst buffer is drained to disk  */
     bool m_DrainBB = true;
     /** File drainer thread if burst buffer is used */
-    burstbuffer::FileDrainerSingleThread m_FileDrainer;
+    burstbuffer::FileDrainerMultiThread m_FileDrainer;
     /** m_Name modified with burst buffer path if BB is used,
      * == m_Name otherwise.
      * m_Name is a constant of Engine and is the user provided target path
@@ -256,6 +256,40 @@ void BP5Engine::ParseParams(IO &io, struct BP5Params &Params)
         }
     };
 
+    auto lf_SetBufferAllocatorParameter = [&](const std::string key, int &parameter, int def) {
+        const std::string lkey = helper::LowerCase(std::string(key));
+        auto itKey = params_lowercase.find(lkey);
+        parameter = def;
+        if (itKey != params_lowercase.end())
+        {
+            const std::string value = helper::LowerCase(itKey->second);
+            if (value == "malloc")
+            {
+                parameter = (int)format::BufferAllocator::Malloc;
+            }
+            else if (value == "hugepage")
+            {
+                parameter = (int)format::BufferAllocator::HugePage;
+            }
+            else if (value == "numa_local")
+            {
+                parameter = (int)format::BufferAllocator::NumaLocal;
+            }
+            else if (value == "interleave")
+            {
+                parameter = (int)format::BufferAllocator::Interleave;
+            }
+            else
+            {
+                helper::Throw<std::invalid_argument>(
+                    "Engine", "BP5Engine", "ParseParams",
+                    "Unknown BP5 BufferAllocator parameter \"" + value +
+                        "\" (must be \"malloc\", \"hugepage\", \"numa_local\" or "
+                        "\"interleave\")");
+            }
+        }
+    };
+
     auto lf_SetAggregationTypeParameter = [&](const std::string key, int &parameter, int def) {
         const std::string lkey = helper::LowerCase(std::string(key));
         auto itKey = params_lowercase.find(lkey);
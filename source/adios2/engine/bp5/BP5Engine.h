@@ -10,8 +10,9 @@
 #include "adios2/common/ADIOSConfig.h"
 #include "adios2/core/Engine.h"
 #include "adios2/helper/adiosComm.h"
-#include "adios2/toolkit/burstbuffer/FileDrainerSingleThread.h"
+#include "adios2/toolkit/burstbuffer/FileDrainerMultiThread.h"
 #include "adios2/toolkit/format/bp5/BP5Serializer.h"
+#include "adios2/toolkit/format/buffer/BufferAllocator.h"
 #include "adios2/toolkit/transportman/TransportMan.h"
 #include <cstdint>
 
@@ -63,7 +64,9 @@ public:
         char columnMajor;     // y or n
         uint8_t flattenSteps; // writer requests all steps flattened to one on read
         char fileUUID[4];     // random per-file id; 0 = none (legacy/neutralized output)
-        char unused2[18];     // init to zero
+        uint8_t dedupBlocks;  // data blocks may refer to the data of earlier steps
+        char dedupMaxAge[4];  // how many steps back they may refer; 0 = any
+        char unused2[13];     // init to zero
     };
     static constexpr size_t m_IndexHeaderSize = sizeof(BP5IndexTableHeader);
     static constexpr size_t m_EndianFlagPosition = offsetof(BP5IndexTableHeader, isLittleEndian);
@@ -77,8 +80,12 @@ public:
     static constexpr size_t m_VersionTagLength = sizeof(BP5IndexTableHeader().VersionTag);
     static constexpr size_t m_FileUUIDPosition = offsetof(BP5IndexTableHeader, fileUUID);
     static constexpr size_t m_FileUUIDLength = sizeof(BP5IndexTableHeader().fileUUID);
+    static constexpr size_t m_DedupBlocksFlagPosition = offsetof(BP5IndexTableHeader, dedupBlocks);
+    static constexpr size_t m_DedupMaxAgePosition = offsetof(BP5IndexTableHeader, dedupMaxAge);
     static_assert(m_FileUUIDLength == sizeof(uint32_t),
                   "fileUUID is read and written as a uint32_t");
+    static_assert(sizeof(BP5IndexTableHeader().dedupMaxAge) == sizeof(uint32_t),
+                  "dedupMaxAge is read and written as a uint32_t");
     static constexpr size_t m_HeaderTailPadding = sizeof(BP5IndexTableHeader().unused2);
 
     static constexpr uint8_t m_BP5MinorVersion = 2;
@@ -144,6 +151,9 @@ public:
     MACRO(StreamReader, Bool, bool, false)                                                         \
     MACRO(BurstBufferDrain, Bool, bool, true)                                                      \
     MACRO(BurstBufferPath, String, std::string, "")                                                \
+    MACRO(BurstBufferDrainThreads, UInt, unsigned int, 4)                                          \
+    MACRO(BurstBufferMaxBandwidth, SizeBytes, size_t, 0)                                           \
+    MACRO(BurstBufferLowPriority, Bool, bool, false)                                               \
     MACRO(NodeLocal, Bool, bool, false)                                                            \
     MACRO(verbose, Int, int, 0)                                                                    \
     MACRO(NumAggregators, UInt, unsigned int, 0)                                                   \
@@ -155,20 +165,32 @@ public:
     MACRO(DirectIOAlignBuffer, UInt, unsigned int, 0)                                              \
     MACRO(AggregationType, AggregationType, int, (int)AggregationType::TwoLevelShm)                \
     MACRO(EnableWriterRerouting, Bool, bool, false)                                                \
+    MACRO(AdaptiveAggregators, Bool, bool, false)                                                  \
     MACRO(ReroutingThresholdFactor, Float, float, 0.3f)                                            \
     MACRO(AsyncOpen, Bool, bool, true)                                                             \
     MACRO(AsyncWrite, AsyncWrite, int, (int)AsyncWrite::Sync)                                      \
+    MACRO(AsyncWriteSteps, UInt, unsigned int, 1)                                                  \
+    MACRO(AsyncWriteMaxMemory, SizeBytes, size_t, 0)                                               \
     MACRO(GrowthFactor, Float, float, DefaultBufferGrowthFactor)                                   \
     MACRO(InitialBufferSize, SizeBytes, size_t, DefaultInitialBufferSize)                          \
     MACRO(MinDeferredSize, SizeBytes, size_t, DefaultMinDeferredSize)                              \
+    MACRO(DirectWriteMinSize, SizeBytes, size_t, 0)                                                \
     MACRO(BufferChunkSize, SizeBytes, size_t, DefaultBufferChunkSize)                              \
     MACRO(MaxShmSize, SizeBytes, size_t, DefaultMaxShmSize)                                        \
     MACRO(BufferVType, BufferVType, int, (int)BufferVType::ChunkVType)                             \
+    MACRO(BufferAllocator, BufferAllocator, int, (int)format::BufferAllocator::Malloc)             \
     MACRO(AppendAfterSteps, Int, int, INT_MAX)                                                     \
     MACRO(SelectSteps, String, std::string, "")                                                    \
     MACRO(ReaderShortCircuitReads, Bool, bool, false)                                              \
     MACRO(StatsLevel, UInt, unsigned int, 1)                                                       \
+    MACRO(StatsThreads, UInt, unsigned int, 1)                                                     \
+    MACRO(StatsBlockSize, UInt, unsigned int, 0)                                                   \
+    MACRO(StatsHistogramBins, UInt, unsigned int, 32)                                              \
     MACRO(Threads, UInt, unsigned int, 0)                                                          \
+    MACRO(AsyncCompressionThreads, UInt, unsigned int, 0)                                          \
+    MACRO(DeduplicateBlocks, Bool, bool, false)                                                    \
+    MACRO(DeduplicateMaxAge, UInt, unsigned int, 100)                                              \
+    MACRO(DeduplicateVerify, Bool, bool, true)                                                     \
     MACRO(MetadataThreads, UInt, unsigned int, 8)                                                  \
     MACRO(UseOneTimeAttributes, Bool, bool, true)                                                  \
     MACRO(UseSelectiveMetadataAggregation, Bool, bool, true)                                       \
@@ -180,6 +202,13 @@ public:
     MACRO(UUID, String, std::string, "")                                                           \
     MACRO(TarInfo, String, std::string, "")                                                        \
     MACRO(MaxOpenFilesAtOnce, UInt, unsigned int, UINT_MAX)                                        \
+    MACRO(ReadSieveGapBytes, SizeBytes, size_t, 0)                                                 \
+    MACRO(MaxCoalescedReadSize, SizeBytes, size_t, DefaultMaxCoalescedReadSize)                    \
+    MACRO(ReadAheadSteps, UInt, unsigned int, 0)                                                   \
+    MACRO(ReadAheadBufferSize, SizeBytes, size_t, 256 * 1024 * 1024)                               \
+    MACRO(DecompressedBlockCacheSize, SizeBytes, size_t, 0)                                        \
+    MACRO(LazyMetadataInstall, Bool, bool, false)                                                  \
+    MACRO(ShareMetadataOnNode, Bool, bool, false)                                                  \
     MACRO(DataFileTransport, String, std::string, "")                                              \
     MACRO(S3Endpoint, String, std::string, "")                                                     \
     MACRO(S3Bucket, String, std::string, "")                                                       \
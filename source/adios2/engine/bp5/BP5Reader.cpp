@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <errno.h>
 #include <fstream>
 #include <iostream>
@@ -63,6 +65,9 @@ BP5Reader::BP5Reader(IO &io, const std::string &name, const Mode mode, helper::C
 
 BP5Reader::~BP5Reader()
 {
+    WaitForAsyncGets();
+    m_ReadPool.reset();
+    ReleaseReadAhead(MaxSizeT);
     if (m_BP5Deserializer)
         delete m_BP5Deserializer;
     if (m_IsOpen)
@@ -75,7 +80,15 @@ BP5Reader::~BP5Reader()
 void BP5Reader::DestructorClose(bool Verbose) noexcept
 {
     // Nothing special needs to be done to "close" a BP5 reader during shutdown
-    // if it hasn't already been Closed
+    // if it hasn't already been Closed, except for freeing the shared metadata
+    // window (skipped by Win_free if MPI has been finalized already)
+    try
+    {
+        FreeSharedMetadata();
+    }
+    catch (...)
+    {
+    }
     m_IsOpen = false;
 }
 
@@ -84,7 +97,8 @@ constexpr size_t HEADERLENGTH = 8; // this must be the same across all engines
 
 void BP5Reader::GetMetadata(char **md, size_t *size)
 {
-    uint64_t sizes[3] = {m_Metadata.Size(), m_MetaMetadata.m_Buffer.size(),
+    uint64_t sizes[3] = {m_SharedMetadata ? m_SharedMetadataSize : m_Metadata.Size(),
+                         m_MetaMetadata.m_Buffer.size(),
                          m_MetadataIndex.m_Buffer.size()};
 
     /* BP5 modifies the metadata block in memory during processing
@@ -175,6 +189,7 @@ void BP5Reader::ProcessMetadataFromMemory(const char *md)
                                                         (m_OpenMode == Mode::ReadRandomAccess),
                                                         false, m_Minifooter.IsLittleEndian);
         m_BP5Deserializer->m_Engine = this;
+        m_BP5Deserializer->SetDecompressedBlockCacheSize(m_Parameters.DecompressedBlockCacheSize);
     }
 
     if (m_StepsCount > stepsBefore)
@@ -183,16 +198,196 @@ void BP5Reader::ProcessMetadataFromMemory(const char *md)
 
         if (m_OpenMode == Mode::ReadRandomAccess)
         {
-            for (size_t Step = 0; Step < m_MetadataIndexTable.size(); Step++)
+            const size_t NSteps = m_MetadataIndexTable.size();
+            if (LazyMetadataInstall())
+            {
+                IndexMetadataForSteps(0, NSteps);
+            }
+            else
             {
-                m_BP5Deserializer->SetupForStep(Step,
-                                                m_WriterMap[m_WriterMapIndex[Step]].WriterCount);
-                InstallMetadataForTimestep(Step);
+                InstallMetadataForSteps(0, NSteps);
             }
         }
     }
 }
 
+bool BP5Reader::ShareMetadataOnNode() const
+{
+    // streaming replaces the metadata every step, only share it when it is
+    // read once for the whole file
+    return m_Parameters.ShareMetadataOnNode && (m_OpenMode == Mode::ReadRandomAccess) &&
+           !m_FlattenSteps;
+}
+
+bool BP5Reader::ShareMetadata(const size_t Size)
+{
+    FreeSharedMetadata();
+    m_MetadataNodeComm = m_Comm.GroupByShm("creating per-node comm for shared metadata");
+    if (m_MetadataNodeComm.Size() < 2)
+    {
+        return false;
+    }
+    const bool nodeLeader = (m_MetadataNodeComm.Rank() == 0);
+    // rank 0 is the first rank of its node, so it leads its node and is rank 0
+    // among the node leaders
+    helper::Comm leaderComm = m_Comm.Split(nodeLeader ? 0 : 1, m_Comm.Rank(),
+                                           "creating node leader comm for shared metadata");
+    char *ptr = nullptr;
+    if (nodeLeader)
+    {
+        m_MetadataWin = m_MetadataNodeComm.Win_allocate_shared(Size, 1, &ptr);
+        if (m_Comm.Rank() == 0)
+        {
+            // the shared copy replaces the one read from the file
+            std::memcpy(ptr, m_Metadata.Data(), Size);
+            m_Metadata.Delete();
+        }
+        leaderComm.Bcast(ptr, Size, 0, "broadcasting metadata to node leaders");
+    }
+    else
+    {
+        m_MetadataWin = m_MetadataNodeComm.Win_allocate_shared(0, 1, &ptr);
+        size_t shmsize;
+        int disp_unit;
+        m_MetadataNodeComm.Win_shared_query(m_MetadataWin, 0, &shmsize, &disp_unit, &ptr);
+    }
+    m_MetadataNodeComm.Barrier("waiting for shared metadata");
+    m_SharedMetadata = ptr;
+    m_SharedMetadataSize = Size;
+    // decoding in place would write into the shared copy
+    m_BP5Deserializer->SetMetadataIsShared(true);
+    return true;
+}
+
+void BP5Reader::FreeSharedMetadata()
+{
+    if (m_SharedMetadata)
+    {
+        m_MetadataNodeComm.Win_free(m_MetadataWin, "freeing shared metadata");
+        m_SharedMetadata = nullptr;
+        m_SharedMetadataSize = 0;
+    }
+}
+
+bool BP5Reader::LazyMetadataInstall() const
+{
+    return m_Parameters.LazyMetadataInstall && (m_OpenMode == Mode::ReadRandomAccess) &&
+           !m_FlattenSteps;
+}
+
+void BP5Reader::InstallMetadataForSteps(const size_t FirstStep, const size_t EndStep)
+{
+    for (size_t Step = FirstStep; Step < EndStep; Step++)
+    {
+        m_BP5Deserializer->SetupForStep(Step, m_WriterMap[m_WriterMapIndex[Step]].WriterCount);
+        if (m_Parameters.MetadataThreads > 1)
+        {
+            ParallelInstallMetadataForTimestep(Step);
+        }
+        else
+        {
+            InstallMetadataForTimestep(Step);
+        }
+    }
+}
+
+void BP5Reader::IndexMetadataForSteps(const size_t FirstStep, const size_t EndStep)
+{
+    m_BP5Deserializer->IndexSteps(EndStep);
+    m_InstalledSteps.resize(EndStep, false);
+    for (size_t Step = FirstStep; Step < EndStep; Step++)
+    {
+        const uint64_t WriterCount = m_WriterMap[m_WriterMapIndex[Step]].WriterCount;
+        m_BP5Deserializer->SetupForStep(Step, WriterCount);
+        size_t Position = m_MetadataIndexTable[Step][0] + sizeof(uint64_t); // skip total data size
+        size_t MDPosition = Position + 2 * sizeof(uint64_t) * WriterCount;
+        bool InstallNow = false;
+        for (size_t WriterRank = 0; WriterRank < WriterCount; WriterRank++)
+        {
+            size_t ThisMDSize =
+                helper::ReadValue<uint64_t>(MetadataData(), Position, m_Minifooter.IsLittleEndian);
+            char *ThisMD = MetadataData() + MDPosition;
+            if (m_BP5Deserializer->IndexMetaData(ThisMD, ThisMDSize, WriterRank, Step))
+            {
+                InstallNow = true;
+            }
+            MDPosition += ThisMDSize;
+        }
+        // attributes are few and apply to the whole file, install them all
+        for (size_t WriterRank = 0; WriterRank < WriterCount; WriterRank++)
+        {
+            size_t ThisADSize =
+                helper::ReadValue<uint64_t>(MetadataData(), Position, m_Minifooter.IsLittleEndian);
+            char *ThisAD = MetadataData() + MDPosition;
+            if (ThisADSize > 0)
+                m_BP5Deserializer->InstallAttributeData(ThisAD, ThisADSize);
+            MDPosition += ThisADSize;
+        }
+        if (InstallNow)
+        {
+            InstallIndexedStep(Step);
+        }
+    }
+}
+
+void BP5Reader::InstallIndexedStep(const size_t Step) const
+{
+    const uint64_t WriterCount = m_WriterMap.at(m_WriterMapIndex[Step]).WriterCount;
+    size_t Position = m_MetadataIndexTable.at(Step)[0] + sizeof(uint64_t); // skip total data size
+    size_t MDPosition = Position + 2 * sizeof(uint64_t) * WriterCount;
+    for (size_t WriterRank = 0; WriterRank < WriterCount; WriterRank++)
+    {
+        size_t ThisMDSize =
+            helper::ReadValue<uint64_t>(MetadataData(), Position, m_Minifooter.IsLittleEndian);
+        m_BP5Deserializer->InstallIndexedMetaData(MetadataData() + MDPosition, ThisMDSize,
+                                                  WriterRank, Step);
+        MDPosition += ThisMDSize;
+    }
+    m_InstalledSteps[Step] = true;
+}
+
+void BP5Reader::InstallMetadataForStep(const size_t Step) const
+{
+    if (!LazyMetadataInstall())
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lockGuard(m_LazyMetadataMutex);
+    const size_t NSteps = m_InstalledSteps.size();
+    const size_t FirstStep = (Step == DefaultSizeT) ? 0 : Step;
+    const size_t EndStep = (Step == DefaultSizeT) ? NSteps : std::min(Step + 1, NSteps);
+    for (size_t s = FirstStep; s < EndStep; s++)
+    {
+        if (!m_InstalledSteps[s])
+        {
+            InstallIndexedStep(s);
+        }
+    }
+}
+
+void BP5Reader::InstallMetadataForVariable(const VariableBase &variable, const size_t RelStepStart,
+                                           const size_t RelStepCount) const
+{
+    if (!LazyMetadataInstall())
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lockGuard(m_LazyMetadataMutex);
+    for (size_t RelStep = RelStepStart; RelStep < RelStepStart + RelStepCount; RelStep++)
+    {
+        const size_t Step = m_BP5Deserializer->AbsoluteStep(variable, RelStep);
+        if (Step == MaxSizeT)
+        {
+            // beyond the steps of the variable, QueueGet reports it
+            break;
+        }
+        if (!m_InstalledSteps[Step])
+        {
+            InstallIndexedStep(Step);
+        }
+    }
+}
+
 void BP5Reader::InstallMetadataForTimestep(size_t Step)
 {
     size_t pgstart = m_MetadataIndexTable[Step][0];
@@ -203,8 +398,8 @@ void BP5Reader::InstallMetadataForTimestep(size_t Step)
     {
         // variable metadata for timestep
         size_t ThisMDSize =
-            helper::ReadValue<uint64_t>(m_Metadata.Data(), Position, m_Minifooter.IsLittleEndian);
-        char *ThisMD = m_Metadata.Data() + MDPosition;
+            helper::ReadValue<uint64_t>(MetadataData(), Position, m_Minifooter.IsLittleEndian);
+        char *ThisMD = MetadataData() + MDPosition;
         if ((m_OpenMode == Mode::ReadRandomAccess) || (m_FlattenSteps))
         {
             m_BP5Deserializer->InstallMetaData(ThisMD, ThisMDSize, WriterRank, Step);
@@ -219,8 +414,8 @@ void BP5Reader::InstallMetadataForTimestep(size_t Step)
     {
         // attribute metadata for timestep
         size_t ThisADSize =
-            helper::ReadValue<uint64_t>(m_Metadata.Data(), Position, m_Minifooter.IsLittleEndian);
-        char *ThisAD = m_Metadata.Data() + MDPosition;
+            helper::ReadValue<uint64_t>(MetadataData(), Position, m_Minifooter.IsLittleEndian);
+        char *ThisAD = MetadataData() + MDPosition;
         if (ThisADSize > 0)
             m_BP5Deserializer->InstallAttributeData(ThisAD, ThisADSize);
         MDPosition += ThisADSize;
@@ -259,7 +454,7 @@ void BP5Reader::ParallelInstallMetadataForTimestep(size_t Step)
                 break;
             }
             size_t ThisMDSize = MDsize_vec[rank];
-            char *ThisMD = m_Metadata.Data() + MDpos_vec[rank];
+            char *ThisMD = MetadataData() + MDpos_vec[rank];
             FFSTypeHandle FFSFormat = FFSFormat_vec[rank];
             void *PreppedBuffer =
                 m_BP5Deserializer->MetadataBufferPrep(ThisMD, ThisMDSize, rank, FFSFormat);
@@ -280,10 +475,10 @@ void BP5Reader::ParallelInstallMetadataForTimestep(size_t Step)
     {
         // variable metadata for timestep
         size_t ThisMDSize =
-            helper::ReadValue<uint64_t>(m_Metadata.Data(), Position, m_Minifooter.IsLittleEndian);
+            helper::ReadValue<uint64_t>(MetadataData(), Position, m_Minifooter.IsLittleEndian);
         MDsize_vec[WriterRank] = ThisMDSize;
         MDpos_vec[WriterRank] = MDPosition;
-        char *ThisMD = m_Metadata.Data() + MDPosition;
+        char *ThisMD = MetadataData() + MDPosition;
         FFSFormat_vec[WriterRank] = m_BP5Deserializer->BufferMetaMetaPrep(ThisMD);
         MDPosition += ThisMDSize;
     }
@@ -323,8 +518,8 @@ void BP5Reader::ParallelInstallMetadataForTimestep(size_t Step)
     {
         // attribute metadata for timestep
         size_t ThisADSize =
-            helper::ReadValue<uint64_t>(m_Metadata.Data(), Position, m_Minifooter.IsLittleEndian);
-        char *ThisAD = m_Metadata.Data() + MDPosition;
+            helper::ReadValue<uint64_t>(MetadataData(), Position, m_Minifooter.IsLittleEndian);
+        char *ThisAD = MetadataData() + MDPosition;
         if (ThisADSize > 0)
             m_BP5Deserializer->InstallAttributeData(ThisAD, ThisADSize);
         MDPosition += ThisADSize;
@@ -400,6 +595,10 @@ StepStatus BP5Reader::BeginStep(StepMode mode, const float timeoutSeconds)
         }
         m_IO.ResetVariablesStepSelection(false, "in call to BP5 Reader BeginStep");
 
+        ReleaseReadAhead(m_CurrentStep);
+        ScheduleReadAhead();
+        ReleaseDedupSteps(m_MetadataIndexTable[m_CurrentStep][5]);
+
         // caches attributes for each step
         // if a variable name is a prefix
         // e.g. var  prefix = {var/v1, var/v2, var/v3}
@@ -426,6 +625,16 @@ void BP5Reader::EndStep()
     m_BetweenStepPairs = false;
     PERFSTUBS_SCOPED_TIMER("BP5Reader::EndStep");
     PerformGets();
+    if (ReadAheadEnabled())
+    {
+        // this step's reads are the pattern for the steps ahead
+        if (!m_ReadAheadStepRanges.empty())
+        {
+            m_ReadAheadPattern = std::move(m_ReadAheadStepRanges);
+            m_ReadAheadStepRanges.clear();
+        }
+        ScheduleReadAhead();
+    }
     for (auto &item : MinBlocksInfoMap)
     {
         delete item.second;
@@ -463,8 +672,8 @@ std::string BP5Reader::UpdateWithTarInfo(const std::string &path, Params &params
     return retval;
 }
 
-double BP5Reader::ReadData(PoolableFile *DataFile, const size_t WriterRank, const size_t Timestep,
-                           const uint64_t StartOffset, const size_t Length, char *Destination)
+uint64_t BP5Reader::DataFileOffset(const size_t WriterRank, const size_t Timestep,
+                                   const uint64_t StartOffset)
 {
     /*
      * Warning: this function is called by multiple threads
@@ -475,15 +684,14 @@ double BP5Reader::ReadData(PoolableFile *DataFile, const size_t WriterRank, cons
     /* Each block is in exactly one flush. The StartOffset was calculated
        as if all the flushes were in a single contiguous block in file.
     */
-    TP startRead = NOW();
-    auto lf_ReadAt = [&](const uint64_t base, const uint64_t offset) {
+    auto lf_FileOffset = [&](const uint64_t base, const uint64_t offset) -> uint64_t {
         const uint64_t maxOffset = static_cast<uint64_t>(std::numeric_limits<size_t>::max());
         if (offset > maxOffset || base > maxOffset - offset)
         {
-            helper::Throw<std::overflow_error>("Engine", "BP5Reader", "ReadData",
+            helper::Throw<std::overflow_error>("Engine", "BP5Reader", "DataFileOffset",
                                                "file offset exceeds size_t on this platform");
         }
-        DataFile->Read(Destination, Length, static_cast<size_t>(base + offset));
+        return base + offset;
     };
     size_t InfoStartPos = DataPosPos + (WriterRank * (2 * FlushCount + 1) * sizeof(uint64_t));
     uint64_t SumDataSize = 0; // count in contiguous space
@@ -497,20 +705,112 @@ double BP5Reader::ReadData(PoolableFile *DataFile, const size_t WriterRank, cons
         if (StartOffset < SumDataSize + ThisDataSize)
         {
             // discount offsets of skipped flushes
-            uint64_t Offset = StartOffset - SumDataSize;
-            lf_ReadAt(ThisDataPos, Offset);
-            TP endRead = NOW();
-            double timeRead = DURATION(startRead, endRead);
-            return timeRead;
+            return lf_FileOffset(ThisDataPos, StartOffset - SumDataSize);
         }
         SumDataSize += ThisDataSize;
     }
 
     uint64_t ThisDataPos = helper::ReadValue<uint64_t>(m_MetadataIndex.m_Buffer, InfoStartPos,
                                                        m_Minifooter.IsLittleEndian);
-    uint64_t Offset = StartOffset - SumDataSize;
-    lf_ReadAt(ThisDataPos, Offset);
+    return lf_FileOffset(ThisDataPos, StartOffset - SumDataSize);
+}
 
+void BP5Reader::DataLocation(const size_t WriterRank, const size_t Timestep,
+                             const uint64_t StartOffset, size_t &SubfileNum, uint64_t &FileOffset)
+{
+    if (!format::BP5Base::IsDedupLocation(StartOffset))
+    {
+        SubfileNum = static_cast<size_t>(
+            m_WriterMap.at(m_WriterMapIndex[Timestep]).RankToSubfile[WriterRank]);
+        FileOffset = DataFileOffset(WriterRank, Timestep, StartOffset);
+        return;
+    }
+
+    uint64_t Offset = StartOffset;
+    size_t Step = 0;
+    // written straight to the subfile inside Put (DirectWriteMinSize), in
+    // this step or, with DeduplicateBlocks, in an earlier one
+    const bool InSubfile = format::BP5Base::IsFileLocation(StartOffset);
+    if (InSubfile)
+    {
+        format::BP5Base::ResolveFileLocation(Offset, Step);
+        if (!m_DedupBlocks)
+        {
+            SubfileNum = static_cast<size_t>(
+                m_WriterMap.at(m_WriterMapIndex[Timestep]).RankToSubfile[WriterRank]);
+            FileOffset = Offset;
+            return;
+        }
+    }
+    else
+    {
+        format::BP5Base::ResolveDataBlockLocation(Offset, Step);
+    }
+    auto it = m_DedupSteps.find(Step);
+    if (it == m_DedupSteps.end())
+    {
+        helper::Throw<std::runtime_error>("Engine", "BP5Reader", "DataLocation",
+                                          "a block refers to the data of step " +
+                                              std::to_string(Step) +
+                                              " whose location is not known");
+    }
+    const DedupStepInfo &Info = it->second;
+    // the subfile this writer wrote to in that step, aggregation may change
+    SubfileNum =
+        static_cast<size_t>(m_WriterMap.at(Info.WriterMapKey).RankToSubfile[WriterRank]);
+    if (InSubfile)
+    {
+        FileOffset = Offset;
+        return;
+    }
+    // same layout as the index record, see DataFileOffset()
+    const uint64_t *Pos = Info.DataPositions.data() + WriterRank * (2 * Info.FlushCount + 1);
+    uint64_t SumDataSize = 0;
+    for (uint64_t flush = 0; flush < Info.FlushCount; flush++)
+    {
+        const uint64_t ThisDataPos = Pos[2 * flush];
+        const uint64_t ThisDataSize = Pos[2 * flush + 1];
+        if (Offset < SumDataSize + ThisDataSize)
+        {
+            FileOffset = ThisDataPos + (Offset - SumDataSize);
+            return;
+        }
+        SumDataSize += ThisDataSize;
+    }
+    FileOffset = Pos[2 * Info.FlushCount] + (Offset - SumDataSize);
+}
+
+void BP5Reader::ReleaseDedupSteps(const size_t Step)
+{
+    if (!m_DedupBlocks || !m_DedupMaxAge || (Step <= m_DedupMaxAge))
+    {
+        return;
+    }
+    // the writer refers to copies at most m_DedupMaxAge steps old
+    const size_t Oldest = Step - m_DedupMaxAge;
+    for (auto it = m_DedupSteps.begin(); it != m_DedupSteps.end();)
+    {
+        if (it->first < Oldest)
+        {
+            it = m_DedupSteps.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+double BP5Reader::ReadData(PoolableFile *DataFile, const uint64_t FileOffset, const size_t Length,
+                           char *Destination)
+{
+    TP startRead = NOW();
+    if (FileOffset > static_cast<uint64_t>(std::numeric_limits<size_t>::max()))
+    {
+        helper::Throw<std::overflow_error>("Engine", "BP5Reader", "ReadData",
+                                           "file offset exceeds size_t on this platform");
+    }
+    DataFile->Read(Destination, Length, static_cast<size_t>(FileOffset));
     TP endRead = NOW();
     double timeRead = DURATION(startRead, endRead);
     return timeRead;
@@ -612,6 +912,7 @@ void BP5Reader::DoGetContextDeferred(core::GetContext &abstract_ctx, VariableBas
                                      void *data, const Selection &selection)
 {
     auto &ctx = static_cast<format::BP5Deserializer::BP5GetContext &>(abstract_ctx);
+    InstallMetadataForVariable(variable, selection.GetStepStart(), selection.GetStepCount());
     m_BP5Deserializer->QueueGet(ctx, variable, data, selection);
 }
 
@@ -627,6 +928,81 @@ void BP5Reader::PerformGets(core::GetContext &abstract_ctx)
     PerformLocalGets(ctx);
 }
 
+std::shared_future<void> BP5Reader::PerformGetsAsync(core::GetContext &abstract_ctx)
+{
+    if (m_dataIsRemote)
+    {
+        helper::Throw<std::logic_error>("Engine", "BP5Reader", "PerformGetsAsync",
+                                        "Context-bearing PerformGets is supported only for "
+                                        "local (non-remote) BP5 reads");
+    }
+    auto *ctx = &static_cast<format::BP5Deserializer::BP5GetContext &>(abstract_ctx);
+    std::shared_future<void> done = ReadPool().Submit([this, ctx]() { PerformLocalGets(*ctx); });
+
+    std::lock_guard<std::mutex> lockGuard(m_AsyncGetsMutex);
+    // forget the ones that are done so the list does not grow with every call
+    m_AsyncGets.erase(std::remove_if(m_AsyncGets.begin(), m_AsyncGets.end(),
+                                     [](const std::shared_future<void> &f) {
+                                         return f.wait_for(std::chrono::seconds(0)) ==
+                                                std::future_status::ready;
+                                     }),
+                      m_AsyncGets.end());
+    m_AsyncGets.push_back(done);
+    return done;
+}
+
+helper::ThreadPool &BP5Reader::ReadPool()
+{
+    std::lock_guard<std::mutex> lockGuard(m_ReadPoolMutex);
+    if (!m_ReadPool)
+    {
+        // the thread calling PerformGets is the remaining reader
+        m_ReadPool.reset(new helper::ThreadPool(m_Threads > 1 ? m_Threads - 1 : 1));
+    }
+    return *m_ReadPool;
+}
+
+BP5Reader::ReadScratch BP5Reader::AcquireReadScratch(const size_t size)
+{
+    ReadScratch scratch;
+    {
+        std::lock_guard<std::mutex> lockGuard(m_ReadScratchMutex);
+        if (!m_ReadScratch.empty())
+        {
+            scratch = std::move(m_ReadScratch.back());
+            m_ReadScratch.pop_back();
+        }
+    }
+    if (scratch.Size < size)
+    {
+        // Uninitialized on purpose: every byte handed to NdCopy is
+        // overwritten by the read that precedes it.
+        scratch.Data.reset(new char[size]);
+        scratch.Size = size;
+    }
+    return scratch;
+}
+
+void BP5Reader::ReleaseReadScratch(ReadScratch scratch)
+{
+    std::lock_guard<std::mutex> lockGuard(m_ReadScratchMutex);
+    m_ReadScratch.push_back(std::move(scratch));
+}
+
+void BP5Reader::WaitForAsyncGets()
+{
+    std::vector<std::shared_future<void>> inFlight;
+    {
+        std::lock_guard<std::mutex> lockGuard(m_AsyncGetsMutex);
+        inFlight.swap(m_AsyncGets);
+    }
+    for (auto &f : inFlight)
+    {
+        // errors are reported to whoever holds the future
+        f.wait();
+    }
+}
+
 void BP5Reader::PerformRemoteGetsWithKVCache()
 {
     auto GetRequests = m_BP5Deserializer->DefaultGetContext().PendingGetRequests;
@@ -909,15 +1285,345 @@ void BP5Reader::PerformRemoteGets()
     }
 }
 
-void BP5Reader::PerformLocalGets(format::BP5Deserializer::BP5GetContext &ctx)
+std::vector<BP5Reader::CoalescedRead>
+BP5Reader::CoalesceReadRequests(const std::vector<format::BP5Deserializer::ReadRequest> &Reqs,
+                                const std::vector<size_t> &ReqIndices, size_t *maxReadSize)
+{
+    std::vector<CoalescedRead> Reads;
+    Reads.reserve(ReqIndices.size());
+    for (const size_t i : ReqIndices)
+    {
+        const auto &Req = Reqs[i];
+        CoalescedRead R;
+        DataLocation(Req.WriterRank, Req.Timestep, Req.StartOffset, R.SubfileNum, R.FileOffset);
+        R.Length = Req.ReadLength;
+        R.Members.push_back(i);
+        R.MemberOffsets.push_back(0);
+        Reads.push_back(std::move(R));
+    }
+
+    const uint64_t gap = m_Parameters.ReadSieveGapBytes;
+    const uint64_t maxSize = m_Parameters.MaxCoalescedReadSize;
+    if (maxSize == 0 || Reads.size() < 2)
+    {
+        return Reads;
+    }
+
+    std::sort(Reads.begin(), Reads.end(), [](const CoalescedRead &a, const CoalescedRead &b) {
+        return (a.SubfileNum < b.SubfileNum) ||
+               (a.SubfileNum == b.SubfileNum && a.FileOffset < b.FileOffset);
+    });
+
+    std::vector<CoalescedRead> Merged;
+    for (auto &R : Reads)
+    {
+        if (!Merged.empty())
+        {
+            auto &Cur = Merged.back();
+            const uint64_t curEnd = Cur.FileOffset + Cur.Length;
+            const uint64_t newEnd = std::max(curEnd, R.FileOffset + R.Length);
+            if (R.SubfileNum == Cur.SubfileNum && R.FileOffset <= curEnd + gap &&
+                newEnd - Cur.FileOffset <= maxSize)
+            {
+                Cur.Members.push_back(R.Members[0]);
+                Cur.MemberOffsets.push_back(static_cast<size_t>(R.FileOffset - Cur.FileOffset));
+                Cur.Length = static_cast<size_t>(newEnd - Cur.FileOffset);
+                continue;
+            }
+        }
+        Merged.push_back(std::move(R));
+    }
+
+    for (const auto &R : Merged)
+    {
+        if (R.Members.size() > 1 && R.Length > *maxReadSize)
+        {
+            *maxReadSize = R.Length;
+        }
+    }
+    return Merged;
+}
+
+bool BP5Reader::ReadAheadEnabled() const
+{
+    // the byte ranges of one step predict the next only if every step lays
+    // out its blocks the same way, which deduplicated steps do not
+    return (m_Parameters.ReadAheadSteps > 0) && (m_OpenMode == Mode::Read) && !m_FlattenSteps &&
+           !m_dataIsRemote && !m_DedupBlocks;
+}
+
+void BP5Reader::ScheduleReadAhead()
 {
-    auto lf_CompareReqSubfile =
-        [&](const adios2::format::BP5Deserializer::ReadRequest &r1,
-            const adios2::format::BP5Deserializer::ReadRequest &r2) -> bool {
-        return (m_WriterMap[m_WriterMapIndex[r1.Timestep]].RankToSubfile[r1.WriterRank] <
-                m_WriterMap[m_WriterMapIndex[r2.Timestep]].RankToSubfile[r2.WriterRank]);
+    if (!ReadAheadEnabled() || m_ReadAheadPattern.empty())
+    {
+        return;
+    }
+    size_t patternBytes = 0;
+    for (const auto &r : m_ReadAheadPattern)
+    {
+        patternBytes += r.Length;
+    }
+
+    struct Job
+    {
+        size_t SubfileNum;
+        uint64_t FileOffset;
+        size_t Length;
+        size_t DataOffset;
     };
 
+    for (size_t Step = m_CurrentStep + 1; Step <= m_CurrentStep + m_Parameters.ReadAheadSteps;
+         ++Step)
+    {
+        if (m_ReadAhead.count(Step))
+        {
+            continue;
+        }
+        // only steps whose index is in memory can be located in the data files
+        if (m_MetadataIndexTable.find(Step) == m_MetadataIndexTable.end() ||
+            Step >= m_WriterMapIndex.size())
+        {
+            break;
+        }
+        if (m_ReadAheadBytes + patternBytes > m_Parameters.ReadAheadBufferSize)
+        {
+            break;
+        }
+        const auto &WriterMap = m_WriterMap[m_WriterMapIndex[Step]];
+
+        // Offsets are computed here because the index buffer and table are
+        // replaced by UpdateBuffer on this thread while the reads are running.
+        ReadAheadStep &RA = m_ReadAhead[Step];
+        auto jobs = std::make_shared<std::vector<Job>>();
+        size_t pos = 0;
+        for (const auto &r : m_ReadAheadPattern)
+        {
+            // a block written inside Put is elsewhere in the file every step
+            if ((r.WriterRank >= WriterMap.WriterCount) ||
+                format::BP5Base::IsFileLocation(r.StartOffset))
+            {
+                continue;
+            }
+            if (!RA.Index.emplace(std::make_pair(r.WriterRank, r.StartOffset),
+                                  std::make_pair(pos, r.Length))
+                     .second)
+            {
+                continue;
+            }
+            size_t SubfileNum;
+            uint64_t FileOffset;
+            DataLocation(r.WriterRank, Step, r.StartOffset, SubfileNum, FileOffset);
+            jobs->push_back({SubfileNum, FileOffset, r.Length, pos});
+            pos += r.Length;
+        }
+        RA.Size = pos;
+        RA.Data.reset(new char[pos]);
+        m_ReadAheadBytes += pos;
+
+        char *Data = RA.Data.get();
+        std::atomic<ReadAheadStep::State> *Status = &RA.Status;
+        auto lf_ReadAhead = [this, jobs, Data, Status]() {
+            auto expected = ReadAheadStep::State::Queued;
+            if (!Status->compare_exchange_strong(expected, ReadAheadStep::State::Running))
+            {
+                // the step has been read without waiting for us
+                return;
+            }
+            try
+            {
+                std::unique_ptr<PoolableFile> DataFile = nullptr;
+                size_t LastSubfileNum = -1;
+                for (const auto &job : *jobs)
+                {
+                    if (job.SubfileNum != LastSubfileNum)
+                    {
+                        const std::string subFileName = GetBPSubStreamName(
+                            m_Name, job.SubfileNum, m_Minifooter.HasSubFiles, true);
+                        DataFile = m_DataFiles->Acquire(subFileName);
+                        LastSubfileNum = job.SubfileNum;
+                    }
+                    ReadData(DataFile.get(), job.FileOffset, job.Length, Data + job.DataOffset);
+                }
+            }
+            catch (...)
+            {
+                // speculation failed, the requests will be read normally
+                Status->store(ReadAheadStep::State::Failed);
+                return;
+            }
+            Status->store(ReadAheadStep::State::Ready);
+        };
+        RA.Done = ReadPool().Submit(lf_ReadAhead);
+    }
+}
+
+void BP5Reader::ReleaseReadAhead(const size_t Step)
+{
+    auto it = m_ReadAhead.begin();
+    while (it != m_ReadAhead.end() && it->first < Step)
+    {
+        if (it->second.Done.valid())
+        {
+            it->second.Done.wait();
+        }
+        m_ReadAheadBytes -= it->second.Size;
+        it = m_ReadAhead.erase(it);
+    }
+}
+
+bool BP5Reader::ReadFromReadAhead(format::BP5Deserializer::BP5GetContext &ctx,
+                                  format::BP5Deserializer::ReadRequest &Req)
+{
+    auto itStep = m_ReadAhead.find(Req.Timestep);
+    if (itStep == m_ReadAhead.end())
+    {
+        return false;
+    }
+    auto &RA = itStep->second;
+    auto it = RA.Index.find(std::make_pair(Req.WriterRank, Req.StartOffset));
+    if (it == RA.Index.end() || it->second.second < Req.ReadLength)
+    {
+        return false;
+    }
+    auto expected = ReadAheadStep::State::Queued;
+    if (RA.Status.compare_exchange_strong(expected, ReadAheadStep::State::Cancelled))
+    {
+        return false;
+    }
+    if (expected == ReadAheadStep::State::Running)
+    {
+        RA.Done.wait();
+    }
+    if (RA.Status.load() != ReadAheadStep::State::Ready)
+    {
+        return false;
+    }
+    char *src = RA.Data.get() + it->second.first;
+    if (Req.DirectToAppMemory)
+    {
+        std::memcpy(Req.DestinationAddr, src, Req.ReadLength);
+    }
+    else
+    {
+        Req.DestinationAddr = src;
+    }
+    m_BP5Deserializer->FinalizeGet(ctx, Req, false);
+    {
+        std::lock_guard<std::mutex> profLock(m_ProfilerMutex);
+        m_JSONProfiler.AddCount("readaheadbytes", Req.ReadLength);
+    }
+    return true;
+}
+
+BP5Reader::SubfileReadScheduler::SubfileReadScheduler(const std::vector<CoalescedRead> &Reads,
+                                                      const size_t nThreads)
+{
+    m_Order.resize(Reads.size());
+    for (size_t i = 0; i < m_Order.size(); ++i)
+    {
+        m_Order[i] = i;
+    }
+    std::sort(m_Order.begin(), m_Order.end(), [&Reads](const size_t a, const size_t b) {
+        return (Reads[a].SubfileNum < Reads[b].SubfileNum) ||
+               (Reads[a].SubfileNum == Reads[b].SubfileNum &&
+                Reads[a].FileOffset < Reads[b].FileOffset);
+    });
+
+    size_t totalBytes = 0;
+    for (const auto &R : Reads)
+    {
+        totalBytes += R.Length;
+    }
+    // a subfile holding much of the data is cut into consecutive pieces so
+    // that it can still be read by several threads
+    const size_t pieceLimit = std::max<size_t>(totalBytes / (2 * nThreads), 1);
+
+    std::vector<Batch> batches;
+    for (size_t i = 0; i < m_Order.size(); ++i)
+    {
+        const CoalescedRead &R = Reads[m_Order[i]];
+        if (batches.empty() || Reads[m_Order[i - 1]].SubfileNum != R.SubfileNum ||
+            batches.back().Bytes >= pieceLimit)
+        {
+            batches.push_back({i, i, 0});
+        }
+        batches.back().End = i + 1;
+        batches.back().Bytes += R.Length;
+    }
+
+    // biggest first, each to the thread with the least work so far
+    std::stable_sort(batches.begin(), batches.end(),
+                     [](const Batch &a, const Batch &b) { return a.Bytes > b.Bytes; });
+    for (size_t t = 0; t < nThreads; ++t)
+    {
+        m_Workers.push_back(std::unique_ptr<Worker>(new Worker));
+    }
+    for (const auto &b : batches)
+    {
+        Worker *least = m_Workers[0].get();
+        for (const auto &w : m_Workers)
+        {
+            if (w->QueuedBytes < least->QueuedBytes)
+            {
+                least = w.get();
+            }
+        }
+        least->Queue.push_back(b);
+        least->QueuedBytes += b.Bytes;
+    }
+}
+
+size_t BP5Reader::SubfileReadScheduler::Next(const size_t tid)
+{
+    Worker &self = *m_Workers[tid];
+    if (self.Current.Begin < self.Current.End)
+    {
+        return m_Order[self.Current.Begin++];
+    }
+    {
+        std::lock_guard<std::mutex> lockGuard(self.Mutex);
+        if (!self.Queue.empty())
+        {
+            self.Current = self.Queue.front();
+            self.Queue.pop_front();
+            self.QueuedBytes -= self.Current.Bytes;
+            return m_Order[self.Current.Begin++];
+        }
+    }
+
+    // out of work: take the last batch of the thread with the most left
+    while (true)
+    {
+        Worker *victim = nullptr;
+        size_t most = 0;
+        for (const auto &w : m_Workers)
+        {
+            std::lock_guard<std::mutex> lockGuard(w->Mutex);
+            if (w->QueuedBytes > most || (!victim && !w->Queue.empty()))
+            {
+                victim = w.get();
+                most = w->QueuedBytes;
+            }
+        }
+        if (!victim)
+        {
+            return MaxSizeT;
+        }
+        std::lock_guard<std::mutex> lockGuard(victim->Mutex);
+        if (victim->Queue.empty())
+        {
+            // someone else was faster, look again
+            continue;
+        }
+        self.Current = victim->Queue.back();
+        victim->Queue.pop_back();
+        victim->QueuedBytes -= self.Current.Bytes;
+        return m_Order[self.Current.Begin++];
+    }
+}
+
+void BP5Reader::PerformLocalGets(format::BP5Deserializer::BP5GetContext &ctx)
+{
     std::call_once(m_InitialWriterActiveCheckFlag, [this]() {
         CheckWriterActive();
         if (!m_WriterIsActive)
@@ -943,27 +1649,45 @@ void BP5Reader::PerformLocalGets(format::BP5Deserializer::BP5GetContext &ctx)
 
     // TP startGenerate = NOW();
     auto ReadRequests = m_BP5Deserializer->GenerateReadRequests(ctx, false, &maxReadSize);
-    size_t nRequest = ReadRequests.size();
     // TP endGenerate = NOW();
     // double generateTime = DURATION(startGenerate, endGenerate);
 
-    size_t nextRequest = 0;
-    std::mutex mutexReadRequests;
-
-    auto lf_GetNextRequest = [&]() -> size_t {
-        std::lock_guard<std::mutex> lockGuard(mutexReadRequests);
-        size_t reqidx = MaxSizeT;
-        if (nextRequest < nRequest)
+    std::vector<size_t> ReqIndices;
+    ReqIndices.reserve(ReadRequests.size());
+    const bool readAhead = ReadAheadEnabled() && (&ctx == &m_BP5Deserializer->DefaultGetContext());
+    for (size_t i = 0; i < ReadRequests.size(); ++i)
+    {
+        auto &Req = ReadRequests[i];
+        if (readAhead)
         {
-            reqidx = nextRequest;
-            ++nextRequest;
+            if (Req.Timestep == m_CurrentStep)
+            {
+                m_ReadAheadStepRanges.push_back({Req.WriterRank, Req.StartOffset, Req.ReadLength});
+            }
+            if (ReadFromReadAhead(ctx, Req))
+            {
+                continue;
+            }
         }
-        if (reqidx <= nRequest)
+        ReqIndices.push_back(i);
+    }
+
+    // Merge requests to nearby byte ranges of the same subfile into single
+    // reads; a singleton group is read exactly as the request was generated.
+    auto Reads = CoalesceReadRequests(ReadRequests, ReqIndices, &maxReadSize);
+    size_t nRead = Reads.size();
+    const size_t nThreads = (m_Threads > 1 && nRead > 1) ? std::min<size_t>(m_Threads, nRead) : 1;
+    SubfileReadScheduler scheduler(Reads, nThreads);
+
+    auto lf_GetNextRead = [&](const size_t tid) -> size_t {
+        const size_t readidx = scheduler.Next(tid);
+        if (readidx < nRead)
         {
             std::lock_guard<std::mutex> profLock(m_ProfilerMutex);
-            m_JSONProfiler.AddBytes("dataread", ReadRequests[reqidx].ReadLength);
+            m_JSONProfiler.AddBytes("dataread", Reads[readidx].Length);
+            m_JSONProfiler.AddCount("datareads");
         }
-        return reqidx;
+        return readidx;
     };
 
     auto lf_Reader = [&](const int FileManagerID,
@@ -972,133 +1696,160 @@ void BP5Reader::PerformLocalGets(format::BP5Deserializer::BP5GetContext &ctx)
         double readTotal = 0.0;
         double subfileTotal = 0.0;
         size_t nReads = 0;
-        // Uninitialized on purpose: vector<char>(n) value-initializes, so each
-        // thread memset maxReadSize once per step even though every byte handed
-        // to NdCopy is overwritten by the read that precedes it.
-        std::unique_ptr<char[]> buf(new char[maxReadSize]);
+        ReadScratch buf = AcquireReadScratch(maxReadSize);
 
         std::unique_ptr<PoolableFile> DataFile = nullptr;
         size_t LastSubfileNum = -1;
+
+        // reads straight into application memory on the current subfile go
+        // to the transport together, so it can keep them all in flight
+        constexpr size_t maxBatch = 32;
+        std::vector<Transport::ReadOp> batch;
+        std::vector<size_t> batchMembers;
+        auto lf_FlushBatch = [&]() {
+            if (batch.empty())
+            {
+                return;
+            }
+            TP startRead = NOW();
+            DataFile->ReadV(batch.data(), batch.size());
+            TP startCopy = NOW();
+            for (const size_t r : batchMembers)
+            {
+                m_BP5Deserializer->FinalizeGet(ctx, ReadRequests[r], false);
+            }
+            TP endCopy = NOW();
+            readTotal += DURATION(startRead, startCopy);
+            copyTotal += DURATION(startCopy, endCopy);
+            nReads += batch.size();
+            batch.clear();
+            batchMembers.clear();
+        };
+
         while (true)
         {
             double timeSubfile = 0.0;
-            const auto reqidx = lf_GetNextRequest();
-            if (reqidx > nRequest)
+            const auto readidx = lf_GetNextRead(static_cast<size_t>(FileManagerID));
+            if (readidx >= nRead)
             {
                 break;
             }
-            auto &Req = ReadRequests[reqidx];
-            if (!Req.DestinationAddr)
-            {
-                Req.DestinationAddr = buf.get();
-            }
-            size_t SubfileNum = static_cast<size_t>(
-                m_WriterMap[m_WriterMapIndex[Req.Timestep]].RankToSubfile[Req.WriterRank]);
+            auto &Read = Reads[readidx];
 
             // if we're on the same subfile, DataFile is already valid
             // (We're Acquiring the datafile here rather than in ReadData to increase reuse in case
             // multiple consecutive requests target the same subfile
-            if (SubfileNum != LastSubfileNum)
+            if (Read.SubfileNum != LastSubfileNum)
             {
+                lf_FlushBatch();
                 TP startSubfile = NOW();
                 const std::string subFileName =
-                    GetBPSubStreamName(m_Name, SubfileNum, m_Minifooter.HasSubFiles, true);
+                    GetBPSubStreamName(m_Name, Read.SubfileNum, m_Minifooter.HasSubFiles, true);
                 DataFile = m_DataFiles->Acquire(subFileName);
+                LastSubfileNum = Read.SubfileNum;
 
                 TP endSubfile = NOW();
                 timeSubfile += DURATION(startSubfile, endSubfile);
             }
-            double timeRead = ReadData(DataFile.get(), Req.WriterRank, Req.Timestep,
-                                       Req.StartOffset, Req.ReadLength, Req.DestinationAddr);
 
-            TP startCopy = NOW();
-            m_BP5Deserializer->FinalizeGet(ctx, Req, false);
+            if (Read.Members.size() == 1 && ReadRequests[Read.Members[0]].DestinationAddr)
+            {
+                auto &Req = ReadRequests[Read.Members[0]];
+                if (Read.FileOffset > static_cast<uint64_t>(MaxSizeT))
+                {
+                    helper::Throw<std::overflow_error>(
+                        "Engine", "BP5Reader", "PerformLocalGets",
+                        "file offset exceeds size_t on this platform");
+                }
+                batch.push_back({Req.DestinationAddr, Req.ReadLength,
+                                 static_cast<size_t>(Read.FileOffset)});
+                batchMembers.push_back(Read.Members[0]);
+                subfileTotal += timeSubfile;
+                if (batch.size() == maxBatch)
+                {
+                    lf_FlushBatch();
+                }
+                continue;
+            }
+
+            double timeRead = 0.0;
+            TP startCopy;
+            // a mapped subfile is used in place instead of being read into scratch
+            char *mapped = const_cast<char *>(
+                DataFile->DataPointer(static_cast<size_t>(Read.FileOffset), Read.Length));
+            if (mapped)
+            {
+                std::lock_guard<std::mutex> profLock(m_ProfilerMutex);
+                m_JSONProfiler.AddCount("mappedreads");
+            }
+            if (Read.Members.size() == 1)
+            {
+                auto &Req = ReadRequests[Read.Members[0]];
+                if (mapped)
+                {
+                    Req.DestinationAddr = mapped;
+                }
+                else
+                {
+                    Req.DestinationAddr = buf.Data.get();
+                    timeRead = ReadData(DataFile.get(), Read.FileOffset, Req.ReadLength,
+                                        Req.DestinationAddr);
+                }
+                startCopy = NOW();
+                m_BP5Deserializer->FinalizeGet(ctx, Req, false);
+            }
+            else
+            {
+                // one read for the whole extent, then scatter into the original destinations
+                char *extent = mapped;
+                if (!extent)
+                {
+                    extent = buf.Data.get();
+                    timeRead = ReadData(DataFile.get(), Read.FileOffset, Read.Length, extent);
+                }
+                startCopy = NOW();
+                for (size_t m = 0; m < Read.Members.size(); ++m)
+                {
+                    auto &Req = ReadRequests[Read.Members[m]];
+                    char *src = extent + Read.MemberOffsets[m];
+                    if (Req.DirectToAppMemory)
+                    {
+                        std::memcpy(Req.DestinationAddr, src, Req.ReadLength);
+                    }
+                    else
+                    {
+                        Req.DestinationAddr = src;
+                    }
+                    m_BP5Deserializer->FinalizeGet(ctx, Req, false);
+                }
+            }
+            // the mapping it points into may be replaced once it is given back
+            DataFile->ReleaseDataPointer(mapped);
             TP endCopy = NOW();
             subfileTotal += timeSubfile;
             readTotal += timeRead;
             copyTotal += DURATION(startCopy, endCopy);
             ++nReads;
         }
+        lf_FlushBatch();
+        ReleaseReadScratch(std::move(buf));
         return std::make_tuple(subfileTotal, readTotal, copyTotal, nReads);
     };
 
     // TP startRead = NOW();
-    // double sortTime = 0.0;
-    if (m_Threads > 1 && nRequest > 1)
+    if (nThreads > 1)
     {
-        // TP startSort = NOW();
-        std::sort(ReadRequests.begin(), ReadRequests.end(), lf_CompareReqSubfile);
-        // TP endSort = NOW();
-        // sortTime = DURATION(startSort, endSort);
-        size_t nThreads = (m_Threads < nRequest ? m_Threads : nRequest);
-
         size_t maxOpenFiles = helper::SetWithinLimit(
             (size_t)m_Parameters.MaxOpenFilesAtOnce / nThreads, (size_t)1, MaxSizeT);
 
-        std::vector<std::future<std::tuple<double, double, double, size_t>>> futures(nThreads - 1);
-
-        // launch Threads-1 threads to process subsets of requests,
-        // then main thread process the last subset
-        for (size_t tid = 0; tid < nThreads - 1; ++tid)
-        {
-            futures[tid] = std::async(std::launch::async, lf_Reader, (int)(tid + 1), maxOpenFiles);
-        }
-        // main thread runs last subset of reads
-        /*auto tMain = */ lf_Reader(0, maxOpenFiles);
-        /*{
-            double tSubfile = std::get<0>(tMain);
-            double tRead = std::get<1>(tMain);
-            double tCopy = std::get<2>(tMain);
-            size_t nReads = std::get<3>(tMain);
-            std::cout << " -> PerformGets() thread MAIN total = "
-                      << tSubfile + tRead + tCopy << "s, subfile = " << tSubfile
-                      << "s, read = " << tRead << "s, copy = " << tCopy
-                      << ", nReads = " << nReads << std::endl;
-        }*/
-
-        // wait for all async threads
-        for (auto &f : futures)
-        {
-            f.get();
-        }
+        // this thread and nThreads-1 pool workers pull reads until none are left
+        ReadPool().Run(nThreads, [&](const size_t tid) {
+            lf_Reader(static_cast<int>(tid), maxOpenFiles);
+        });
     }
     else
     {
-        // Uninitialized: see the threaded path above.
-        std::unique_ptr<char[]> buf(new char[maxReadSize]);
-        std::unique_ptr<PoolableFile> DataFile = nullptr;
-        size_t LastSubfileNum = -1;
-        for (auto &Req : ReadRequests)
-        {
-            if (!Req.DestinationAddr)
-            {
-                Req.DestinationAddr = buf.get();
-            }
-            {
-                std::lock_guard<std::mutex> profLock(m_ProfilerMutex);
-                m_JSONProfiler.AddBytes("dataread", Req.ReadLength);
-            }
-            size_t SubfileNum = static_cast<size_t>(
-                m_WriterMap[m_WriterMapIndex[Req.Timestep]].RankToSubfile[Req.WriterRank]);
-
-            // if we're on the same subfile, DataFile is already valid
-            // (We're Acquiring the datafile here rather than in ReadData to increase reuse in case
-            // multiple consecutive requests target the same subfile
-            if (SubfileNum != LastSubfileNum)
-            {
-                TP startSubfile = NOW();
-                const std::string subFileName =
-                    GetBPSubStreamName(m_Name, SubfileNum, m_Minifooter.HasSubFiles, true);
-                DataFile = m_DataFiles->Acquire(subFileName);
-
-                TP endSubfile = NOW();
-                double timeSubfile = DURATION(startSubfile, endSubfile);
-                (void)timeSubfile;
-            }
-            ReadData(DataFile.get(), Req.WriterRank, Req.Timestep, Req.StartOffset, Req.ReadLength,
-                     Req.DestinationAddr);
-            m_BP5Deserializer->FinalizeGet(ctx, Req, false);
-        }
+        lf_Reader(0, m_Parameters.MaxOpenFilesAtOnce);
     }
     m_BP5Deserializer->FinalizeDerivedGets(ctx, ReadRequests);
     ctx.Clear();
@@ -1110,8 +1861,7 @@ void BP5Reader::PerformLocalGets(format::BP5Deserializer::BP5GetContext &ctx)
     double t1 = DURATION(start, end);
     double t2 = DURATION(startRead, end);
     std::cout << " -> PerformGets() total = " << t1 << "s, Read loop = " << t2
-              << "s, sort = " << sortTime << "s, generate = " << generateTime
-              << ", nRequests = " << nRequest << std::endl;*/
+              << "s, generate = " << generateTime << ", nRequests = " << nRead << std::endl;*/
 }
 
 // PRIVATE
@@ -1418,25 +2168,39 @@ void BP5Reader::OpenFiles(TimePoint &timeoutInstant, const Seconds &pollSeconds,
 
 MinVarInfo *BP5Reader::MinBlocksInfo(const VariableBase &Var, const size_t Step) const
 {
+    InstallMetadataForVariable(Var, (Step == adios2::EngineCurrentStep) ? Var.m_StepsStart : Step,
+                               1);
     return m_BP5Deserializer->MinBlocksInfo(Var, Step);
 }
 
 MinVarInfo *BP5Reader::MinBlocksInfo(const VariableBase &Var, const size_t Step,
                                      const size_t WriterID, const size_t BlockID) const
 {
+    InstallMetadataForVariable(Var, (Step == adios2::EngineCurrentStep) ? Var.m_StepsStart : Step,
+                               1);
     return m_BP5Deserializer->MinBlocksInfo(Var, Step, WriterID, BlockID);
 }
 
 bool BP5Reader::VarShape(const VariableBase &Var, const size_t Step, Dims &Shape) const
 {
+    InstallMetadataForVariable(Var, (Step == adios2::EngineCurrentStep) ? Var.m_StepsStart : Step,
+                               1);
     return m_BP5Deserializer->VarShape(Var, Step, Shape);
 }
 
 bool BP5Reader::VariableMinMax(const VariableBase &Var, const size_t Step, MinMaxStruct &MinMax)
 {
+    InstallMetadataForStep(Step);
     return m_BP5Deserializer->VariableMinMax(Var, Step, MinMax);
 }
 
+bool BP5Reader::VariableHistogram(const VariableBase &Var, const size_t Step, MinMaxStruct &Range,
+                                  std::vector<uint64_t> &Counts)
+{
+    InstallMetadataForStep(Step);
+    return m_BP5Deserializer->VariableHistogram(Var, Step, Range, Counts);
+}
+
 std::string BP5Reader::VariableExprStr(const VariableBase &Var)
 {
 #ifdef ADIOS2_HAVE_DERIVED_VARIABLE
@@ -1709,6 +2473,8 @@ void BP5Reader::UpdateBuffer(const TimePoint &timeoutInstant, const Seconds &pol
                 m_WriterIsRowMajor, m_ReaderIsRowMajor, (m_OpenMode != Mode::Read),
                 (m_FlattenSteps), m_Minifooter.IsLittleEndian);
             m_BP5Deserializer->m_Engine = this;
+            m_BP5Deserializer->SetDecompressedBlockCacheSize(
+                m_Parameters.DecompressedBlockCacheSize);
         }
     }
     if (m_StepsCount > stepsBefore)
@@ -1802,27 +2568,26 @@ void BP5Reader::UpdateBuffer(const TimePoint &timeoutInstant, const Seconds &pol
 
         size_t inputSize = m_Comm.BroadcastValue(m_Metadata.Size(), 0);
 
-        if (m_Comm.Rank() != 0)
+        if (!ShareMetadataOnNode() || !ShareMetadata(inputSize))
         {
-            m_Metadata.Resize(inputSize, "metadata broadcast");
-        }
+            if (m_Comm.Rank() != 0)
+            {
+                m_Metadata.Resize(inputSize, "metadata broadcast");
+            }
 
-        m_Comm.Bcast(m_Metadata.Data(), inputSize, 0);
+            m_Comm.Bcast(m_Metadata.Data(), inputSize, 0);
+        }
 
         if ((m_OpenMode == Mode::ReadRandomAccess) || m_FlattenSteps)
         {
-            for (size_t Step = 0; Step < m_MetadataIndexTable.size(); Step++)
+            const size_t NSteps = m_MetadataIndexTable.size();
+            if (LazyMetadataInstall())
             {
-                m_BP5Deserializer->SetupForStep(Step,
-                                                m_WriterMap[m_WriterMapIndex[Step]].WriterCount);
-                if (m_Parameters.MetadataThreads > 1)
-                {
-                    ParallelInstallMetadataForTimestep(Step);
-                }
-                else
-                {
-                    InstallMetadataForTimestep(Step);
-                }
+                IndexMetadataForSteps(0, NSteps);
+            }
+            else
+            {
+                InstallMetadataForSteps(0, NSteps);
             }
         }
     }
@@ -1927,6 +2692,12 @@ size_t BP5Reader::ParseMetadataIndex(format::BufferSTL &bufferSTL, const size_t
         position = m_FileUUIDPosition;
         m_FileUUID = helper::ReadValue<uint32_t>(buffer, position, m_Minifooter.IsLittleEndian);
 
+        position = m_DedupBlocksFlagPosition;
+        m_DedupBlocks =
+            (helper::ReadValue<uint8_t>(buffer, position, m_Minifooter.IsLittleEndian) != 0);
+        // byte 47-50: zero in files of writers that did not bound it
+        m_DedupMaxAge = helper::ReadValue<uint32_t>(buffer, position, m_Minifooter.IsLittleEndian);
+
         // move position to first row
         position = m_IndexHeaderSize;
     }
@@ -2021,6 +2792,7 @@ size_t BP5Reader::ParseMetadataIndex(format::BufferSTL &bufferSTL, const size_t
                 ptrs.push_back(position);
                 // absolute pos in file before read
                 ptrs.push_back(MetadataPos);
+                ptrs.push_back(m_AbsStepsInFile);
                 m_MetadataIndexTable[m_StepsCount] = ptrs;
 #ifdef DUMPDATALOCINFO
                 for (uint64_t i = 0; i < m_WriterCount; i++)
@@ -2055,6 +2827,21 @@ size_t BP5Reader::ParseMetadataIndex(format::BufferSTL &bufferSTL, const size_t
                 minfo_size = 0;
             }
 
+            if (m_DedupBlocks)
+            {
+                // later steps may refer to this one after the index buffer is replaced
+                DedupStepInfo &Info = m_DedupSteps[m_AbsStepsInFile];
+                Info.WriterMapKey = m_LastMapStep;
+                Info.FlushCount = FlushCount;
+                Info.DataPositions.resize(m_LastWriterCount * ((2 * FlushCount) + 1));
+                size_t DataPosPos = position;
+                for (auto &v : Info.DataPositions)
+                {
+                    v = helper::ReadValue<uint64_t>(buffer, DataPosPos,
+                                                    m_Minifooter.IsLittleEndian);
+                }
+            }
+
             // skip over the writer -> data file offset records
             position += sizeof(uint64_t) * m_LastWriterCount * ((2 * FlushCount) + 1);
             ++m_AbsStepsInFile;
@@ -2227,6 +3014,7 @@ void BP5Reader::DoGetStructDeferred(VariableStruct &variable, void *data)
 void BP5Reader::DoClose(const int transportIndex)
 {
     PERFSTUBS_SCOPED_TIMER("BP5Reader::Close");
+    WaitForAsyncGets();
     if (m_OpenMode == Mode::ReadRandomAccess)
     {
         PerformGets();
@@ -2236,6 +3024,8 @@ void BP5Reader::DoClose(const int transportIndex)
         EndStep();
     }
     FlushProfiler();
+    ReleaseReadAhead(MaxSizeT);
+    m_ReadScratch.clear();
 
     // Release PoolableFile objects BEFORE their owning FilePools.
     // PoolableFile destructor calls Release() on its pool, which locks
@@ -2244,6 +3034,9 @@ void BP5Reader::DoClose(const int transportIndex)
     m_MDIndexFile.reset();
     m_MetaMetadataFile.reset();
 
+    // Close is collective, so the node's ranks free the window together
+    FreeSharedMetadata();
+
     // Now safe to release the file pools and their transports.
     // This ensures transports using external resources (like AWS SDK)
     // are cleaned up while those resources are still available.
@@ -2287,6 +3080,17 @@ void BP5Reader::FlushProfiler()
         lf_AddMe(Trans);
     }
 
+    if (m_BP5Deserializer)
+    {
+        for (const auto &count : m_BP5Deserializer->ProfileCounts())
+        {
+            if (count.second)
+            {
+                m_JSONProfiler.AddCount(count.first, count.second);
+            }
+        }
+    }
+
     const std::string LineJSON(
         m_JSONProfiler.GetRankProfilingJSON(transportTypes, transportNames, transportProfilers) +
         ",\n");
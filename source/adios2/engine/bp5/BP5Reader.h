@@ -15,15 +15,20 @@
 #include "adios2/helper/adiosComm.h"
 #include "adios2/helper/adiosRangeFilter.h"
 #include "adios2/helper/adiosString.h"
+#include "adios2/helper/adiosThreadPool.h"
 #include "adios2/toolkit/filepool/FilePool.h"
 #include "adios2/toolkit/format/bp5/BP5Deserializer.h"
 #include "adios2/toolkit/format/buffer/heap/BufferMalloc.h"
 #include "adios2/toolkit/kvcache/KVCacheCommon.h"
 #include "adios2/toolkit/remote/Remote.h"
 
+#include <atomic>
 #include <chrono>
+#include <deque>
+#include <future>
 #include <map>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace adios2
@@ -63,6 +68,7 @@ public:
     // Context-bearing thread-safe Get pipeline; local data path only.
     std::unique_ptr<core::GetContext> NewGetContext() final;
     void PerformGets(core::GetContext &ctx) final;
+    std::shared_future<void> PerformGetsAsync(core::GetContext &ctx) final;
     void DoGetContextDeferred(core::GetContext &ctx, VariableBase &variable, void *data,
                               const Selection &selection) final;
 
@@ -71,6 +77,8 @@ public:
                               const size_t BlockID) const;
     bool VarShape(const VariableBase &Var, const size_t Step, Dims &Shape) const;
     bool VariableMinMax(const VariableBase &, const size_t Step, MinMaxStruct &MinMax);
+    bool VariableHistogram(const VariableBase &, const size_t Step, MinMaxStruct &Range,
+                           std::vector<uint64_t> &Counts);
     std::string VariableExprStr(const VariableBase &Var);
     void SetFlattenMode(bool flatten) { m_FlattenSteps = flatten; };
 
@@ -104,6 +112,29 @@ private:
     // Cached at first transport open; gates NewGetContext.
     bool m_HasReentrantReadTransport = false;
 
+    // PerformGetsAsync calls that may still be running; Close waits for them
+    std::vector<std::shared_future<void>> m_AsyncGets;
+    std::mutex m_AsyncGetsMutex;
+    void WaitForAsyncGets();
+
+    // Workers for multi-threaded and asynchronous PerformGets, started on
+    // first use and kept until the engine goes away
+    std::unique_ptr<helper::ThreadPool> m_ReadPool;
+    std::mutex m_ReadPoolMutex;
+    helper::ThreadPool &ReadPool();
+
+    // Read buffers of the PerformGets threads, kept across calls and grown to
+    // the largest read seen so far
+    struct ReadScratch
+    {
+        std::unique_ptr<char[]> Data;
+        size_t Size = 0;
+    };
+    std::vector<ReadScratch> m_ReadScratch;
+    std::mutex m_ReadScratchMutex;
+    ReadScratch AcquireReadScratch(const size_t size);
+    void ReleaseReadScratch(ReadScratch scratch);
+
     /* How many bytes of metadata index have we already read in? */
     size_t m_MDIndexFileAlreadyReadSize = 0;
 
@@ -266,15 +297,165 @@ private:
 
     uint32_t m_FileUUID = 0; // per-file id from the index header; 0 means none
 
+    bool m_DedupBlocks = false; // blocks may refer to earlier steps (DeduplicateBlocks)
+    uint32_t m_DedupMaxAge = 0; // at most this many steps back, 0 = any (DeduplicateMaxAge)
+    // data positions of every step of such a file, kept after the index buffer moves on
+    struct DedupStepInfo
+    {
+        uint64_t WriterMapKey;
+        uint64_t FlushCount;
+        std::vector<uint64_t> DataPositions; // as in the index, for all writers
+    };
+    std::unordered_map<size_t, DedupStepInfo> m_DedupSteps; // by absolute step in file
+    /** Streaming: forget the steps no block of Step or later can refer to */
+    void ReleaseDedupSteps(const size_t Step);
+
     format::BufferSTL m_MetadataIndex;
     format::BufferSTL m_MetaMetadata;
     format::BufferMalloc m_Metadata;
 
+    /* ShareMetadataOnNode: the raw metadata lives once per node in a shared
+     * memory window allocated by the first rank of the node; the other ranks
+     * of the node map it and never modify it. */
+    helper::Comm m_MetadataNodeComm;
+    helper::Comm::Win m_MetadataWin;
+    char *m_SharedMetadata = nullptr;
+    size_t m_SharedMetadataSize = 0;
+    bool ShareMetadataOnNode() const;
+    /** Distribute the Size bytes of metadata read by rank 0, return false if
+     * there is no other rank on this node to share with */
+    bool ShareMetadata(const size_t Size);
+    void FreeSharedMetadata();
+    char *MetadataData() { return m_SharedMetadata ? m_SharedMetadata : m_Metadata.Data(); }
+    const char *MetadataData() const
+    {
+        return m_SharedMetadata ? m_SharedMetadata : m_Metadata.Data();
+    }
+
     void InstallMetaMetaData(format::BufferSTL MetaMetadata);
     void InstallMetadataForTimestep(size_t Step);
     void ParallelInstallMetadataForTimestep(size_t Step);
-    double ReadData(PoolableFile *DataFile, const size_t WriterRank, const size_t Timestep,
-                    const uint64_t StartOffset, const size_t Length, char *Destination);
+
+    /* ReadRandomAccess with LazyMetadataInstall: Open only indexes which
+     * variables every step holds, and the blocks of a step are installed on
+     * first use. Installs happen in the thread that asks for the step, before
+     * its reads are queued, and are serialized by m_LazyMetadataMutex.
+     */
+    mutable std::vector<bool> m_InstalledSteps;
+    mutable std::mutex m_LazyMetadataMutex;
+    bool LazyMetadataInstall() const;
+    /** Install steps [FirstStep, EndStep) into the deserializer */
+    void InstallMetadataForSteps(const size_t FirstStep, const size_t EndStep);
+    /** Index steps [FirstStep, EndStep) and install those that define variables */
+    void IndexMetadataForSteps(const size_t FirstStep, const size_t EndStep);
+    /** Install the blocks of an indexed step, with m_LazyMetadataMutex held */
+    void InstallIndexedStep(const size_t Step) const;
+    /** Install absolute step Step, or every step for DefaultSizeT */
+    void InstallMetadataForStep(const size_t Step) const;
+    /** Install the steps of relative steps [RelStepStart, RelStepStart +
+     * RelStepCount) of the variable */
+    void InstallMetadataForVariable(const VariableBase &variable, const size_t RelStepStart,
+                                    const size_t RelStepCount) const;
+    /** Translate a writer's contiguous data offset for a step into the offset in its subfile */
+    uint64_t DataFileOffset(const size_t WriterRank, const size_t Timestep,
+                            const uint64_t StartOffset);
+    /** Subfile and offset in it of a data block, following a reference to an
+     * earlier step or into the subfile (BP5Base::IsDedupLocation) */
+    void DataLocation(const size_t WriterRank, const size_t Timestep, const uint64_t StartOffset,
+                      size_t &SubfileNum, uint64_t &FileOffset);
+    double ReadData(PoolableFile *DataFile, const uint64_t FileOffset, const size_t Length,
+                    char *Destination);
+
+    /** One read from a subfile serving one or more ReadRequests */
+    struct CoalescedRead
+    {
+        size_t SubfileNum;
+        uint64_t FileOffset;
+        size_t Length;
+        std::vector<size_t> Members;       // indices into the ReadRequest vector
+        std::vector<size_t> MemberOffsets; // offset of each member within the read
+    };
+
+    /** Merge requests to the same subfile that are adjacent or no more than
+     * ReadSieveGapBytes apart into reads of at most MaxCoalescedReadSize bytes.
+     * Raises maxReadSize to fit the largest merged read.
+     */
+    std::vector<CoalescedRead>
+    CoalesceReadRequests(const std::vector<format::BP5Deserializer::ReadRequest> &Reqs,
+                         const std::vector<size_t> &ReqIndices, size_t *maxReadSize);
+
+    /** Deals the reads of one PerformGets out to the reader threads: reads
+     * are grouped into per-subfile batches in offset order, so a thread
+     * streams through a subfile, and batches go to the threads by size. A
+     * thread that runs out takes a batch from the one with the most left.
+     */
+    class SubfileReadScheduler
+    {
+    public:
+        SubfileReadScheduler(const std::vector<CoalescedRead> &Reads, const size_t nThreads);
+        /** @return index of the next read for thread tid, MaxSizeT if done */
+        size_t Next(const size_t tid);
+
+    private:
+        struct Batch
+        {
+            size_t Begin; // range in m_Order
+            size_t End;
+            size_t Bytes;
+        };
+        struct Worker
+        {
+            std::mutex Mutex;
+            std::deque<Batch> Queue; // protected by Mutex
+            size_t QueuedBytes = 0;  // protected by Mutex
+            Batch Current = {0, 0, 0};
+        };
+        std::vector<size_t> m_Order; // reads by subfile, then offset
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+    };
+
+    /* Streaming read-ahead (ReadAheadSteps > 0): the reads of a step are
+     * recorded and speculatively repeated for the following steps as tasks of
+     * the read pool. A request of a later step whose writer rank and offset
+     * match a prefetched range is served from memory.
+     */
+    struct ReadAheadRange
+    {
+        size_t WriterRank;
+        uint64_t StartOffset;
+        size_t Length;
+    };
+    struct ReadAheadStep
+    {
+        // (WriterRank, StartOffset) -> (offset in Data, Length)
+        std::map<std::pair<size_t, uint64_t>, std::pair<size_t, size_t>> Index;
+        std::unique_ptr<char[]> Data;
+        size_t Size = 0;
+        /* Queued until a pool thread starts the reads. A request finding the
+         * task still queued cancels it and reads normally, rather than wait
+         * behind other tasks of the pool. */
+        enum class State
+        {
+            Queued,
+            Running,
+            Ready,
+            Failed,
+            Cancelled
+        };
+        std::atomic<State> Status{State::Queued};
+        std::shared_future<void> Done;
+    };
+    std::vector<ReadAheadRange> m_ReadAheadPattern;    // reads of the last completed step
+    std::vector<ReadAheadRange> m_ReadAheadStepRanges; // reads of the current step so far
+    std::map<size_t, ReadAheadStep> m_ReadAhead;       // step -> prefetched data
+    size_t m_ReadAheadBytes = 0;
+    bool ReadAheadEnabled() const;
+    void ScheduleReadAhead();
+    /** Wait for and drop the prefetched data of all steps before Step */
+    void ReleaseReadAhead(const size_t Step);
+    /** Serve a request from prefetched data, return false if not prefetched */
+    bool ReadFromReadAhead(format::BP5Deserializer::BP5GetContext &ctx,
+                           format::BP5Deserializer::ReadRequest &Req);
 
     struct WriterMapStruct
     {
@@ -22,6 +22,7 @@ namespace engine
 inline void BP5Reader::GetSyncCommon(VariableBase &variable, void *data)
 {
     auto sel = InferSelection(variable);
+    InstallMetadataForVariable(variable, sel.GetStepStart(), sel.GetStepCount());
     bool need_sync = m_BP5Deserializer->QueueGet(variable, data, sel, m_dataIsRemote);
     if (need_sync)
         PerformGets();
@@ -30,11 +31,13 @@ inline void BP5Reader::GetSyncCommon(VariableBase &variable, void *data)
 void BP5Reader::GetDeferredCommon(VariableBase &variable, void *data)
 {
     auto sel = InferSelection(variable);
+    InstallMetadataForVariable(variable, sel.GetStepStart(), sel.GetStepCount());
     (void)m_BP5Deserializer->QueueGet(variable, data, sel, m_dataIsRemote);
 }
 
 inline void BP5Reader::GetSyncCommon(VariableBase &variable, void *data, const Selection &selection)
 {
+    InstallMetadataForVariable(variable, selection.GetStepStart(), selection.GetStepCount());
     bool need_sync = m_BP5Deserializer->QueueGet(variable, data, selection, m_dataIsRemote);
     if (need_sync)
         PerformGets();
@@ -42,6 +45,7 @@ inline void BP5Reader::GetSyncCommon(VariableBase &variable, void *data, const S
 
 void BP5Reader::GetDeferredCommon(VariableBase &variable, void *data, const Selection &selection)
 {
+    InstallMetadataForVariable(variable, selection.GetStepStart(), selection.GetStepCount());
     (void)m_BP5Deserializer->QueueGet(variable, data, selection, m_dataIsRemote);
 }
 
@@ -179,28 +179,20 @@ StepStatus BP5Writer::BeginStep(StepMode mode, const float timeoutSeconds)
 
     if (m_Parameters.AsyncWrite)
     {
-        m_AsyncWriteLock.lock();
-        m_flagRush = true;
-        m_AsyncWriteLock.unlock();
         TimePoint wait_start = Now();
-        if (m_WriteFuture.valid())
+        if (!m_AsyncSteps.empty())
         {
             profiling::ProfilerGuard g(m_Profiler, "BS_WaitOnAsync");
 
-            m_WriteFuture.get();
-            m_Comm.Barrier();
-            AsyncWriteDataCleanup();
+            // the step beginning now counts against AsyncWriteSteps
+            WaitOnAsyncWrites(m_Parameters.AsyncWriteSteps - 1, m_Parameters.AsyncWriteMaxMemory);
             Seconds wait = Now() - wait_start;
-            if (m_Comm.Rank() == 0)
+            if (m_Comm.Rank() == 0 && m_Parameters.verbose > 0)
             {
-                WriteMetadataFileIndex(m_LatestMetaDataPos, m_LatestMetaDataSize);
-                if (m_Parameters.verbose > 0)
-                {
-                    std::cout << "BeginStep, wait on async write was = " << wait.count()
-                              << " time since EndStep was = " << m_LastTimeBetweenSteps.count()
-                              << " expect next one to be = " << m_ExpectedTimeBetweenSteps.count()
-                              << std::endl;
-                }
+                std::cout << "BeginStep, wait on async write was = " << wait.count()
+                          << " time since EndStep was = " << m_LastTimeBetweenSteps.count()
+                          << " expect next one to be = " << m_ExpectedTimeBetweenSteps.count()
+                          << ", steps still in flight = " << m_AsyncSteps.size() << std::endl;
             }
         }
     }
@@ -209,15 +201,19 @@ StepStatus BP5Writer::BeginStep(StepMode mode, const float timeoutSeconds)
     {
         m_BP5Serializer.InitStep(new MallocV(
             "BP5Writer", false, m_BP5Serializer.m_BufferAlign, m_BP5Serializer.m_BufferBlockSize,
-            m_Parameters.InitialBufferSize, m_Parameters.GrowthFactor));
+            m_Parameters.InitialBufferSize, m_Parameters.GrowthFactor,
+            (format::BufferAllocator)m_Parameters.BufferAllocator));
     }
     else
     {
-        m_BP5Serializer.InitStep(new ChunkV("BP5Writer", false, m_BP5Serializer.m_BufferAlign,
-                                            m_BP5Serializer.m_BufferBlockSize,
-                                            m_Parameters.BufferChunkSize));
+        m_BP5Serializer.InitStep(new ChunkV(
+            "BP5Writer", false, m_BP5Serializer.m_BufferAlign, m_BP5Serializer.m_BufferBlockSize,
+            m_Parameters.BufferChunkSize, (format::BufferAllocator)m_Parameters.BufferAllocator));
     }
+    m_BP5Serializer.m_WriterStep = m_WriterStep;
     m_ThisTimestepDataSize = 0;
+    m_StepDataWriteTime = Seconds(0.0);
+    m_StepDataWriteBytes = 0;
 
     ts = Now() - m_EngineStart;
     // std::cout << "BEGIN STEP ended at: " << ts.count() << std::endl;
@@ -363,7 +359,7 @@ uint64_t BP5Writer::WriteMetadata(const std::vector<char> &ContigMetaData,
     return MetaDataSize;
 }
 
-void BP5Writer::AsyncWriteDataCleanup()
+void BP5Writer::AsyncWriteDataCleanup(AsyncWriteInfo *info)
 {
     if (m_Parameters.AsyncWrite)
     {
@@ -372,10 +368,10 @@ void BP5Writer::AsyncWriteDataCleanup()
         case (int)AggregationType::EveryoneWrites:
         case (int)AggregationType::EveryoneWritesSerial:
         case (int)AggregationType::DataSizeBased:
-            AsyncWriteDataCleanup_EveryoneWrites();
+            AsyncWriteDataCleanup_EveryoneWrites(info);
             break;
         case (int)AggregationType::TwoLevelShm:
-            AsyncWriteDataCleanup_TwoLevelShm();
+            AsyncWriteDataCleanup_TwoLevelShm(info);
             break;
         default:
             break;
@@ -383,6 +379,89 @@ void BP5Writer::AsyncWriteDataCleanup()
     }
 }
 
+void BP5Writer::WaitOnAsyncWrites(const size_t keepSteps, const uint64_t keepBytes)
+{
+    // the steps to retire, oldest first, so that the rest fit in the limits;
+    // the bytes in flight differ between ranks, so this count does too
+    size_t nRetire = 0;
+    uint64_t inFlightBytes = 0;
+    for (const auto &s : m_AsyncSteps)
+    {
+        inFlightBytes += s.Size;
+    }
+    while (nRetire < m_AsyncSteps.size() &&
+           (m_AsyncSteps.size() - nRetire > keepSteps ||
+            (keepBytes > 0 && inFlightBytes > keepBytes)))
+    {
+        inFlightBytes -= m_AsyncSteps[nRetire].Size;
+        ++nRetire;
+    }
+
+    // Also publish the steps whose data is written by now
+    auto lf_Done = [](const AsyncWriteStep &s) {
+        for (const auto &w : s.Writes)
+        {
+            if (w.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    while (nRetire < m_AsyncSteps.size() && lf_Done(m_AsyncSteps[nRetire]))
+    {
+        ++nRetire;
+    }
+    // Every rank takes part and all act on the largest count, so they run
+    // the same collectives below
+    const uint64_t myRetire = nRetire;
+    uint64_t n = 0;
+    m_Comm.Allreduce(&myRetire, &n, 1, helper::Comm::Op::Max);
+    nRetire = static_cast<size_t>(n);
+    if (nRetire == 0)
+    {
+        return;
+    }
+
+    m_AsyncWriteLock.lock();
+    m_flagRush = true;
+    m_AsyncWriteLock.unlock();
+    for (size_t k = 0; k < nRetire; ++k)
+    {
+        AsyncWriteStep &s = m_AsyncSteps[k];
+        for (size_t i = 0; i < s.Writes.size(); ++i)
+        {
+            if (s.Infos[i])
+            {
+                s.Writes[i].get();
+            }
+        }
+    }
+
+    // the index may only point to data that all ranks have written
+    m_Comm.Barrier();
+    for (size_t k = 0; k < nRetire; ++k)
+    {
+        AsyncWriteStep &s = m_AsyncSteps.front();
+        for (auto info : s.Infos)
+        {
+            if (info)
+            {
+                AsyncWriteDataCleanup(info);
+            }
+        }
+        if (m_Comm.Rank() == 0)
+        {
+            m_MetadataIndexFile->Write(s.IndexRecord.data(), s.IndexRecord.size());
+        }
+        m_AsyncSteps.pop_front();
+    }
+    if (m_Comm.Rank() == 0)
+    {
+        m_MetadataIndexFile->Flush();
+    }
+}
+
 void BP5Writer::WriteData(format::BufferV *Data)
 {
     std::string wd_str = "WriteData";
@@ -395,19 +474,37 @@ void BP5Writer::WriteData(format::BufferV *Data)
 
     if (m_Parameters.AsyncWrite)
     {
-        // If a previous async write is still in flight (e.g. from a prior
-        // PerformDataWrite within the same step), wait for it before starting
-        // a new one.  This prevents concurrent access to the transport layer.
-        // The inter-step asynchrony (EndStep -> BeginStep) is unaffected
-        // because BeginStep already waits before any new writes occur.
-        if (m_WriteFuture.valid())
+        if (m_AsyncSteps.empty() || m_AsyncSteps.back().Closed)
         {
-            m_AsyncWriteLock.lock();
-            m_flagRush = true;
-            m_AsyncWriteLock.unlock();
-            m_WriteFuture.get();
-            AsyncWriteDataCleanup();
+            m_AsyncSteps.emplace_back();
         }
+        AsyncWriteStep &step = m_AsyncSteps.back();
+
+        // The EveryoneWrites threads wait for the previous data write
+        // themselves, which keeps them from using the transport concurrently.
+        // TwoLevelShm creates the shared memory segments anew for each write,
+        // so a write still in flight (e.g. from a prior PerformDataWrite within
+        // the same step) must finish first.
+        if (m_Parameters.AggregationType == (int)AggregationType::TwoLevelShm)
+        {
+            for (auto &s : m_AsyncSteps)
+            {
+                for (size_t i = 0; i < s.Writes.size(); ++i)
+                {
+                    if (s.Infos[i])
+                    {
+                        m_AsyncWriteLock.lock();
+                        m_flagRush = true;
+                        m_AsyncWriteLock.unlock();
+                        s.Writes[i].get();
+                        AsyncWriteDataCleanup(s.Infos[i]);
+                        s.Infos[i] = nullptr;
+                    }
+                }
+            }
+        }
+        // Data is deleted by the async thread
+        const uint64_t dataSize = Data->Size();
 
         switch (m_Parameters.AggregationType)
         {
@@ -427,6 +524,9 @@ void BP5Writer::WriteData(format::BufferV *Data)
                                                      std::to_string(m_Parameters.AggregationType) +
                                                      "is not supported in BP5");
         }
+        step.Writes.push_back(m_WriteFuture);
+        step.Infos.push_back(m_AsyncWriteInfo);
+        step.Size += dataSize;
     }
     else
     {
@@ -438,7 +538,7 @@ void BP5Writer::WriteData(format::BufferV *Data)
         case (int)AggregationType::EveryoneWritesSerial:
             WriteData_EveryoneWrites(Data, true);
             break;
-        case (int)AggregationType::DataSizeBased:
+        case (int)AggregationType::DataSizeBased: {
             // First initialize aggregator and transports if we haven't done it yet this step
             if (!m_AggregatorInitializedThisStep)
             {
@@ -450,6 +550,10 @@ void BP5Writer::WriteData(format::BufferV *Data)
                 m_AggregatorInitializedThisStep = true;
             }
 
+            // the subfiles are opened above, only the writing itself is timed
+            const TimePoint writeStart = Now();
+            m_StepDataWriteBytes += Data->Size();
+
             // For rerouting to be useful, there must be multiple writers sending
             // data to multiple subfiles.
             if (m_Parameters.EnableWriterRerouting && m_Comm.Size() > 1 &&
@@ -473,7 +577,9 @@ void BP5Writer::WriteData(format::BufferV *Data)
             {
                 WriteData_EveryoneWrites(Data, true);
             }
+            m_StepDataWriteTime += Now() - writeStart;
             break;
+        }
         case (int)AggregationType::TwoLevelShm:
             WriteData_TwoLevelShm(Data);
             break;
@@ -595,6 +701,14 @@ void BP5Writer::WriteMetadataFileIndex(uint64_t MetaDataPos, uint64_t MetaDataSi
                   << MetaDataSize << ")" << std::endl;
     }
 
+    std::vector<char> buf = MakeMetadataIndexRecord(MetaDataPos, MetaDataSize);
+    m_MetadataIndexFile->Write(buf.data(), buf.size());
+    m_MetadataIndexFile->Flush();
+}
+
+std::vector<char> BP5Writer::MakeMetadataIndexRecord(uint64_t MetaDataPos, uint64_t MetaDataSize)
+{
+
     // bufsize: Step record
     size_t bufsize =
         1 + (4 + ((FlushPosSizeInfo.size() * 2) + 1) * m_Comm.Size()) * sizeof(uint64_t);
@@ -665,7 +779,6 @@ void BP5Writer::WriteMetadataFileIndex(uint64_t MetaDataPos, uint64_t MetaDataSi
         helper::CopyToBuffer(buf, pos, &m_WriterDataPos[writer], 1);
     }
 
-    m_MetadataIndexFile->Write((char *)buf.data(), buf.size());
 #ifdef DUMPDATALOCINFO
     std::cout << "WriterMapRecordType is: " << (buf.data() + StepRecordStartPos)[0] << std::endl;
     size_t *BufPtr = (size_t *)(buf.data() + StepRecordStartPos + 1);
@@ -688,10 +801,10 @@ void BP5Writer::WriteMetadataFileIndex(uint64_t MetaDataPos, uint64_t MetaDataSi
     }
     std::cout << "}" << std::endl;
 #endif
-    m_MetadataIndexFile->Flush();
 
     /* reset for next timestep */
     FlushPosSizeInfo.clear();
+    return buf;
 }
 
 void BP5Writer::NotifyEngineAttribute(std::string name, DataType type) noexcept
@@ -1161,6 +1274,13 @@ void BP5Writer::EndStep()
 
     m_Profiler.Stop("ES_WriteData");
 
+    if (m_Parameters.AdaptiveAggregators &&
+        m_Parameters.AggregationType == (int)AggregationType::DataSizeBased &&
+        !m_Parameters.AsyncWrite && !(m_AggregatorTuner && m_AggregatorTuner->Converged()))
+    {
+        TuneAggregators();
+    }
+
     if (m_Parameters.verbose > 4)
     {
         std::cout << "Rank " << m_Comm.Rank() << " deciding whether new writer map is needed"
@@ -1212,6 +1332,13 @@ void BP5Writer::EndStep()
 
     if (m_Parameters.AsyncWrite)
     {
+        /* The index record is written once the step's data is on disk */
+        m_AsyncSteps.back().Closed = true;
+        if (m_Comm.Rank() == 0)
+        {
+            m_AsyncSteps.back().IndexRecord =
+                MakeMetadataIndexRecord(m_LatestMetaDataPos, m_LatestMetaDataSize);
+        }
         /* Start counting computation blocks between EndStep and next BeginStep
          * each time */
         {
@@ -1282,6 +1409,40 @@ void BP5Writer::EndStep()
      std::cout << "END STEP ended at: " << ts2.count() << std::endl;*/
 }
 
+void BP5Writer::TuneAggregators()
+{
+    std::string ta_str = "ES_TuneAgg";
+    m_Profiler.AddTimerWatch(ta_str);
+    profiling::ProfilerGuard g(m_Profiler, ta_str);
+
+    // the step's data is written when the slowest rank is done
+    const double myTime = m_StepDataWriteTime.count();
+    double writeTime = 0.0;
+    uint64_t writeBytes = 0;
+    m_Comm.Allreduce(&myTime, &writeTime, 1, helper::Comm::Op::Max);
+    m_Comm.Allreduce(&m_StepDataWriteBytes, &writeBytes, 1, helper::Comm::Op::Sum);
+    if (writeTime <= 0.0 || writeBytes == 0)
+    {
+        return;
+    }
+
+    if (!m_AggregatorTuner)
+    {
+        m_AggregatorTuner.reset(new helper::PartitionCountTuner(
+            m_Aggregator->m_SubStreams, static_cast<size_t>(m_Comm.Size())));
+    }
+    const size_t tried = m_AggregatorTuner->Count();
+    const double throughput = static_cast<double>(writeBytes) / writeTime;
+    m_Parameters.NumSubFiles = static_cast<unsigned int>(m_AggregatorTuner->Update(throughput));
+    if (m_Comm.Rank() == 0 && m_Parameters.verbose > 0)
+    {
+        std::cout << "AdaptiveAggregators: " << tried << " subfiles wrote "
+                  << throughput / (1024.0 * 1024.0) << " MB/s, next step uses "
+                  << m_Parameters.NumSubFiles
+                  << (m_AggregatorTuner->Converged() ? " (converged)" : "") << std::endl;
+    }
+}
+
 // PRIVATE
 void BP5Writer::Init()
 {
@@ -1376,7 +1537,35 @@ void BP5Writer::InitParameters()
         }
     }
 
+    if (m_Parameters.AsyncWriteSteps == 0)
+    {
+        m_Parameters.AsyncWriteSteps = 1;
+    }
+    if (m_Parameters.AggregationType == (int)AggregationType::TwoLevelShm ||
+        m_Parameters.AggregationType == (int)AggregationType::DataSizeBased)
+    {
+        // the shared memory segments and the subfile choice of one step are
+        // reused by the next one, its data write cannot start earlier
+        m_Parameters.AsyncWriteSteps = 1;
+    }
+
     m_BP5Serializer.m_StatsLevel = m_Parameters.StatsLevel;
+    m_BP5Serializer.SetStatsThreads(m_Parameters.StatsThreads);
+    m_BP5Serializer.m_StatsBlockSize = m_Parameters.StatsBlockSize;
+    m_BP5Serializer.m_HistogramBins = m_Parameters.StatsHistogramBins;
+    m_BP5Serializer.m_DeduplicateBlocks = m_Parameters.DeduplicateBlocks;
+    m_BP5Serializer.m_DedupMaxAge = m_Parameters.DeduplicateMaxAge;
+    m_BP5Serializer.m_DedupVerify = m_Parameters.DeduplicateVerify;
+    if (m_Parameters.DirectWriteMinSize > 0)
+    {
+        m_BP5Serializer.m_DirectWriteMinSize = m_Parameters.DirectWriteMinSize;
+        m_BP5Serializer.m_DirectWrite = [this](const void *Data, size_t Length,
+                                               uint64_t &Location) {
+            return DirectWriteBlock(Data, Length, Location);
+        };
+    }
+    m_BP5Serializer.m_RowMajor = (m_IO.m_ArrayOrder != ArrayOrdering::ColumnMajor);
+    m_BP5Serializer.SetCompressionThreads(m_Parameters.AsyncCompressionThreads);
 }
 
 uint64_t BP5Writer::CountStepsInMetadataIndex(format::BufferSTL &bufferSTL)
@@ -1663,10 +1852,10 @@ void BP5Writer::InitAggregator(const uint64_t DataSize)
         {
             m_CommAggregators.Free("freeing aggregators comm for data-size based aggregation");
         }
-        else
+        // AdaptiveAggregators may add subfiles, which start empty
+        if (m_SubstreamDataPos.size() < static_cast<size_t>(myPart.m_subStreams))
         {
-            // Stuff we only want to do on the first timestep
-            m_SubstreamDataPos.resize(myPart.m_subStreams);
+            m_SubstreamDataPos.resize(myPart.m_subStreams, 0);
         }
 
         // This comm is for aggregator ranks only, it is used to exchange information about
@@ -1924,6 +2113,9 @@ void BP5Writer::InitTransports()
             //            m_FileDrainer.SetVerbose(
             //				     m_Parameters.BurstBufferVerbose,
             //				     m_Comm.Rank());
+            m_FileDrainer.SetThreads(m_Parameters.BurstBufferDrainThreads);
+            m_FileDrainer.SetMaxBandwidth(m_Parameters.BurstBufferMaxBandwidth);
+            m_FileDrainer.SetLowPriority(m_Parameters.BurstBufferLowPriority);
             m_FileDrainer.Start();
         }
     }
@@ -2171,6 +2363,14 @@ void BP5Writer::MakeHeader(std::vector<char> &buffer, size_t &position, const st
     }
     helper::CopyToBuffer(buffer, position, &fileUUID);
 
+    // byte 46: data blocks may refer to earlier steps (DeduplicateBlocks)
+    const uint8_t dedupBlocks = m_Parameters.DeduplicateBlocks ? 1 : 0;
+    helper::CopyToBuffer(buffer, position, &dedupBlocks);
+
+    // byte 47-50: how many steps back they may refer (DeduplicateMaxAge)
+    const uint32_t dedupMaxAge = m_Parameters.DeduplicateMaxAge;
+    helper::CopyToBuffer(buffer, position, &dedupMaxAge);
+
     // remainder  unused
     position = m_IndexHeaderSize;
     // absolutePosition = position;
@@ -2193,6 +2393,23 @@ void BP5Writer::UpdateActiveFlag(const bool active)
     }
 }
 
+void BP5Writer::UpdateDedupBlocksFlag()
+{
+    const char dedupChar = '\1';
+    m_MetadataIndexFile->Write(&dedupChar, 1, m_DedupBlocksFlagPosition);
+    m_MetadataIndexFile->Flush();
+    m_MetadataIndexFile->SeekToEnd();
+    if (m_DrainBB)
+    {
+        for (size_t i = 0; i < m_DrainMetadataIndexFileNames.size(); ++i)
+        {
+            m_FileDrainer.AddOperationWriteAt(m_DrainMetadataIndexFileNames[i],
+                                              m_DedupBlocksFlagPosition, 1, &dedupChar);
+            m_FileDrainer.AddOperationSeekEnd(m_DrainMetadataIndexFileNames[i]);
+        }
+    }
+}
+
 void BP5Writer::InitBPBuffer()
 {
     AggTransportData &aggData = m_AggregatorSpecifics.at(GetCacheKey(m_Aggregator));
@@ -2261,6 +2478,12 @@ void BP5Writer::InitBPBuffer()
             // Set the flag in the header of metadata index table to 1 again
             // to indicate a new run begins
             UpdateActiveFlag(true);
+            // appended steps may refer to their own earlier steps only, but
+            // readers must know to keep the data positions of all steps
+            if (m_Parameters.DeduplicateBlocks)
+            {
+                UpdateDedupBlocksFlag();
+            }
 
             // Truncate existing index file
             if (m_AppendMetadataIndexPos < MaxSizeT)
@@ -2304,6 +2527,10 @@ void BP5Writer::InitBPBuffer()
 
 void BP5Writer::EnterComputationBlock() noexcept
 {
+    if (m_DrainBB)
+    {
+        m_FileDrainer.EnterComputationBlock();
+    }
     if (m_Parameters.AsyncWrite && !m_BetweenStepPairs)
     {
         m_ComputationBlockStart = Now();
@@ -2317,6 +2544,10 @@ void BP5Writer::EnterComputationBlock() noexcept
 
 void BP5Writer::ExitComputationBlock() noexcept
 {
+    if (m_DrainBB)
+    {
+        m_FileDrainer.ExitComputationBlock();
+    }
     if (m_Parameters.AsyncWrite && m_InComputationBlock)
     {
         double t = Seconds(Now() - m_ComputationBlockStart).count();
@@ -2342,14 +2573,16 @@ void BP5Writer::FlushData(const bool isFinal)
         DataBuf = m_BP5Serializer.ReinitStepData(
             new MallocV("BP5Writer", false, m_BP5Serializer.m_BufferAlign,
                         m_BP5Serializer.m_BufferBlockSize, m_Parameters.InitialBufferSize,
-                        m_Parameters.GrowthFactor),
+                        m_Parameters.GrowthFactor,
+                        (format::BufferAllocator)m_Parameters.BufferAllocator),
             m_Parameters.AsyncWrite || m_Parameters.DirectIO);
     }
     else
     {
         DataBuf = m_BP5Serializer.ReinitStepData(
             new ChunkV("BP5Writer", false, m_BP5Serializer.m_BufferAlign,
-                       m_BP5Serializer.m_BufferBlockSize, m_Parameters.BufferChunkSize),
+                       m_BP5Serializer.m_BufferBlockSize, m_Parameters.BufferChunkSize,
+                       (format::BufferAllocator)m_Parameters.BufferAllocator),
             m_Parameters.AsyncWrite || m_Parameters.DirectIO);
     }
 
@@ -2380,6 +2613,57 @@ void BP5Writer::FlushData(const bool isFinal)
     }
 }
 
+bool BP5Writer::DirectWriteBlock(const void *Data, const size_t Length, uint64_t &Location)
+{
+    // Where the step's data goes is only known at EndStep when others share
+    // the subfile, and the asynchronous and burst buffer paths own the file
+    // until then, so those blocks are copied into the buffer as usual.
+    if (m_Parameters.AsyncWrite || m_WriteToBB)
+    {
+        return false;
+    }
+    bool soleWriter = false;
+    switch (m_Parameters.AggregationType)
+    {
+    case (int)AggregationType::EveryoneWrites:
+    case (int)AggregationType::EveryoneWritesSerial: {
+        const auto *a = dynamic_cast<aggregator::MPIChain *>(m_Aggregator);
+        soleWriter = a && (a->m_Comm.Size() == 1);
+        break;
+    }
+    case (int)AggregationType::TwoLevelShm: {
+        const auto *a = dynamic_cast<aggregator::MPIShmChain *>(m_Aggregator);
+        soleWriter = a && (a->m_Comm.Size() == 1) && (a->m_AggregatorChainComm.Size() == 1);
+        break;
+    }
+    default:
+        break;
+    }
+    if (!soleWriter)
+    {
+        return false;
+    }
+    if (m_Parameters.DirectIO &&
+        ((reinterpret_cast<uintptr_t>(Data) % m_Parameters.DirectIOAlignBuffer) ||
+         (Length % m_Parameters.DirectIOAlignOffset)))
+    {
+        return false;
+    }
+
+    // StripeSize is a multiple of DirectIOAlignOffset with DirectIO
+    const uint64_t Pos =
+        m_DataPos + helper::PaddingToAlignOffset(m_DataPos, m_Parameters.StripeSize);
+    if (!format::BP5Base::EncodeFileLocation(static_cast<size_t>(m_WriterStep), Pos, Location))
+    {
+        return false;
+    }
+    profiling::ProfilerGuard g(m_Profiler, "DirectWrite");
+    AggTransportData &aggData = m_AggregatorSpecifics.at(GetCacheKey(m_Aggregator));
+    aggData.m_DataSubstream->Write(static_cast<const char *>(Data), Length, Pos);
+    m_DataPos = Pos + Length;
+    return true;
+}
+
 void BP5Writer::Flush(const int transportIndex) {}
 
 void BP5Writer::PerformDataWrite()
@@ -2432,13 +2716,19 @@ void BP5Writer::DoClose(const int transportIndex)
 
         TimePoint wait_start = Now();
         Seconds wait(0.0);
-        if (m_WriteFuture.valid())
+        if (!m_AsyncSteps.empty())
         {
             profiling::ProfilerGuard g(m_Profiler, "DC_WaitOnAsync1");
             m_AsyncWriteLock.lock();
             m_flagRush = true;
             m_AsyncWriteLock.unlock();
-            m_WriteFuture.get();
+            for (auto &s : m_AsyncSteps)
+            {
+                for (auto &w : s.Writes)
+                {
+                    w.wait();
+                }
+            }
             wait += Now() - wait_start;
         }
 
@@ -2470,8 +2760,7 @@ void BP5Writer::DoClose(const int transportIndex)
             // wait until all process' writing thread completes
             profiling::ProfilerGuard g(m_Profiler, "DC_WaitOnAsync2");
             wait_start = Now();
-            m_Comm.Barrier();
-            AsyncWriteDataCleanup();
+            WaitOnAsyncWrites(0, 0);
             wait += Now() - wait_start;
             if (m_Comm.Rank() == 0 && m_Parameters.verbose > 0)
             {
@@ -2482,10 +2771,6 @@ void BP5Writer::DoClose(const int transportIndex)
 
         if (m_Comm.Rank() == 0)
         {
-            if (m_Parameters.AsyncWrite)
-            {
-                WriteMetadataFileIndex(m_LatestMetaDataPos, m_LatestMetaDataSize);
-            }
             // close metadata index file
             UpdateActiveFlag(false);
             m_MetadataIndexFile->Close();
@@ -2539,6 +2824,14 @@ void BP5Writer::FlushProfiler()
         transportProfilers.push_back(&m_MetadataFile->m_Profiler);
     }
 
+    for (const auto &count : m_BP5Serializer.ProfileCounts())
+    {
+        if (count.second)
+        {
+            m_Profiler.AddCount(count.first, count.second);
+        }
+    }
+
     // m_Profiler.WriteOut(transportTypes, transportProfilers);
 
     const std::string lineJSON(
@@ -16,13 +16,18 @@
 #include "adios2/helper/adiosPartitioner.h" // RankPartition
 #include "adios2/toolkit/aggregator/mpi/MPIChain.h"
 #include "adios2/toolkit/aggregator/mpi/MPIShmChain.h"
-#include "adios2/toolkit/burstbuffer/FileDrainerSingleThread.h"
+#include "adios2/toolkit/burstbuffer/FileDrainerMultiThread.h"
 #include "adios2/toolkit/format/bp5/BP5Serializer.h"
 #include "adios2/toolkit/format/buffer/BufferV.h"
 #include "adios2/toolkit/shm/Spinlock.h"
 #include "adios2/toolkit/shm/TokenChain.h"
 #include "adios2/toolkit/transport/Transport.h"
 
+#include <deque>
+#include <future>
+#include <memory>
+#include <vector>
+
 namespace adios2
 {
 namespace core
@@ -76,6 +81,14 @@ private:
     void OpenSubfile(const bool useComm = true, const bool forceAppend = false);
     helper::Partitioning m_Partitioning;
 
+    /* AdaptiveAggregators: searches the subfile count of DataSizeBased
+     * aggregation, fed with the time and bytes of each step's data write */
+    std::unique_ptr<helper::PartitionCountTuner> m_AggregatorTuner;
+    Seconds m_StepDataWriteTime = Seconds(0.0);
+    uint64_t m_StepDataWriteBytes = 0;
+    /** Collective, sets NumSubFiles for the next step */
+    void TuneAggregators();
+
     /** Single object controlling BP buffering */
     format::BP5Serializer m_BP5Serializer;
 
@@ -93,7 +106,7 @@ private:
     /** true if burst buffer is drained to disk  */
     bool m_DrainBB = true;
     /** File drainer thread if burst buffer is used */
-    burstbuffer::FileDrainerSingleThread m_FileDrainer;
+    burstbuffer::FileDrainerMultiThread m_FileDrainer;
     /** m_Name modified with burst buffer path if BB is used,
      * == m_Name otherwise.
      * m_Name is a constant of Engine and is the user provided target path
@@ -172,6 +185,10 @@ private:
 
     void FlushData(const bool isFinal = false);
 
+    /** Writes a block of a Sync put straight to this rank's subfile, if this
+     * rank alone writes there, see BP5Serializer::m_DirectWrite */
+    bool DirectWriteBlock(const void *Data, const size_t Length, uint64_t &Location);
+
     void DoClose(const int transportIndex = -1) final;
 
     /** Write a profiling.json file from m_BP1Writer and m_TransportsManager
@@ -182,6 +199,10 @@ private:
 
     void WriteMetadataFileIndex(uint64_t MetaDataPos, uint64_t MetaDataSize);
 
+    /** Builds the step record of the metadata index file that
+     * WriteMetadataFileIndex writes */
+    std::vector<char> MakeMetadataIndexRecord(uint64_t MetaDataPos, uint64_t MetaDataSize);
+
     uint64_t WriteMetadata(const std::vector<core::iovec> &MetaDataBlocks,
                            const std::vector<core::iovec> &AttributeBlocks);
     uint64_t WriteMetadata(const std::vector<char> &ContigMetaData,
@@ -202,6 +223,9 @@ private:
 
     void UpdateActiveFlag(const bool active);
 
+    /** Mark an appended file as having blocks that refer to earlier steps */
+    void UpdateDedupBlocksFlag();
+
     void WriteCollectiveMetadataFile(const bool isFinal = false);
 
     void MarshalAttributes();
@@ -321,8 +345,8 @@ private:
     bool m_FinishedWriting;
     bool m_MultiBlockWrite;
 
-    /* Async write's future */
-    std::future<int> m_WriteFuture;
+    /* Async write's future, of the last data write launched */
+    std::shared_future<int> m_WriteFuture;
     // variables to delay writing to index file
     uint64_t m_LatestMetaDataPos;
     uint64_t m_LatestMetaDataSize;
@@ -373,6 +397,7 @@ private:
         std::vector<ComputationBlockInfo> *currentComputationBlocks; // extended by main thread
         size_t *currentComputationBlockID;                           // increased by main thread
         shm::Spinlock *lock; // race condition over currentComp* variables
+        std::shared_future<int> previous; // data write to finish before this one starts
     };
 
     AsyncWriteInfo *m_AsyncWriteInfo;
@@ -387,6 +412,23 @@ private:
     */
     shm::Spinlock m_AsyncWriteLock;
 
+    /* an output step whose async data writes may still be in flight */
+    struct AsyncWriteStep
+    {
+        std::vector<std::shared_future<int>> Writes;
+        std::vector<AsyncWriteInfo *> Infos; // nullptr once cleaned up
+        uint64_t Size = 0;                   // bytes held by the step's buffers
+        bool Closed = false;                 // EndStep has written its metadata
+        std::vector<char> IndexRecord;       // rank 0 only, written when data is on disk
+    };
+    /* oldest first, at most AsyncWriteSteps steps including the current one */
+    std::deque<AsyncWriteStep> m_AsyncSteps;
+
+    /** Waits for the oldest in-flight steps until at most keepSteps steps and
+     * keepBytes bytes (0: no limit) are left, and writes their index records.
+     * Collective: all ranks retire the same steps */
+    void WaitOnAsyncWrites(const size_t keepSteps, const uint64_t keepBytes);
+
     /* Static functions that will run in another thread */
     static int AsyncWriteThread_EveryoneWrites(AsyncWriteInfo *info);
     static int AsyncWriteThread_TwoLevelShm(AsyncWriteInfo *info);
@@ -406,9 +448,9 @@ private:
     };
     static ComputationStatus IsInComputationBlock(AsyncWriteInfo *info, size_t &compBlockIdx);
 
-    void AsyncWriteDataCleanup();
-    void AsyncWriteDataCleanup_EveryoneWrites();
-    void AsyncWriteDataCleanup_TwoLevelShm();
+    void AsyncWriteDataCleanup(AsyncWriteInfo *info);
+    void AsyncWriteDataCleanup_EveryoneWrites(AsyncWriteInfo *info);
+    void AsyncWriteDataCleanup_TwoLevelShm(AsyncWriteInfo *info);
 };
 
 } // end namespace engine
@@ -188,6 +188,12 @@ void BP5Writer::AsyncWriteOwnData(AsyncWriteInfo *info, std::vector<core::iovec>
 
 int BP5Writer::AsyncWriteThread_EveryoneWrites(AsyncWriteInfo *info)
 {
+    // the previous step may still be writing to the same subfile
+    if (info->previous.valid())
+    {
+        info->previous.wait();
+    }
+
     if (info->tokenChain)
     {
         if (info->rank_chain > 0)
@@ -281,6 +287,7 @@ void BP5Writer::WriteData_EveryoneWrites_Async(format::BufferV *Data, bool Seria
     m_AsyncWriteInfo->deadline = m_ExpectedTimeBetweenSteps.count();
     m_AsyncWriteInfo->flagRush = &m_flagRush;
     m_AsyncWriteInfo->lock = &m_AsyncWriteLock;
+    m_AsyncWriteInfo->previous = m_WriteFuture;
 
     if (m_ComputationBlocksLength > 0.0 && m_Parameters.AsyncWrite == (int)AsyncWrite::Guided)
     {
@@ -335,14 +342,13 @@ void BP5Writer::WriteData_EveryoneWrites_Async(format::BufferV *Data, bool Seria
     }
 }
 
-void BP5Writer::AsyncWriteDataCleanup_EveryoneWrites()
+void BP5Writer::AsyncWriteDataCleanup_EveryoneWrites(AsyncWriteInfo *info)
 {
-    if (m_AsyncWriteInfo->tokenChain)
+    if (info->tokenChain)
     {
-        delete m_AsyncWriteInfo->tokenChain;
+        delete info->tokenChain;
     }
-    delete m_AsyncWriteInfo;
-    m_AsyncWriteInfo = nullptr;
+    delete info;
 }
 
 } // end namespace engine
@@ -325,17 +325,15 @@ void BP5Writer::WriteData_TwoLevelShm_Async(format::BufferV *Data)
     */
 }
 
-void BP5Writer::AsyncWriteDataCleanup_TwoLevelShm()
+void BP5Writer::AsyncWriteDataCleanup_TwoLevelShm(AsyncWriteInfo *info)
 {
-    aggregator::MPIShmChain *a =
-        dynamic_cast<aggregator::MPIShmChain *>(m_AsyncWriteInfo->aggregator);
+    aggregator::MPIShmChain *a = dynamic_cast<aggregator::MPIShmChain *>(info->aggregator);
     if (a->m_Comm.Size() > 1)
     {
         a->DestroyShm();
     }
-    delete m_AsyncWriteInfo->tokenChain;
-    delete m_AsyncWriteInfo;
-    m_AsyncWriteInfo = nullptr;
+    delete info->tokenChain;
+    delete info;
 }
 
 } // end namespace engine
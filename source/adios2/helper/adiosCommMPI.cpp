@@ -562,6 +562,13 @@ int CommImplMPI::Win_shared_query(Comm::Win &win, int rank, size_t *size, int *d
 int CommImplMPI::Win_free(Comm::Win &win, const std::string &hint) const
 {
     CommWinImplMPI *w = dynamic_cast<CommWinImplMPI *>(CommWinImpl::Get(win));
+    // a window left to a destructor running after MPI_Finalize is gone already
+    int flag;
+    MPI_Finalized(&flag);
+    if (flag)
+    {
+        return MPI_SUCCESS;
+    }
     int ret = MPI_Win_free(&w->m_Win);
     CheckMPIReturn(ret, "in call to Win_free " + hint + "\n");
     return ret;
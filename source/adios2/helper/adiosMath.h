@@ -53,6 +53,41 @@ template <class T>
 void GetMinMax(const T *values, const size_t size, T &min, T &max,
                const MemorySpace memSpace) noexcept;
 
+/**
+ * Copies values into dest and gets their min and max in the same pass, so
+ * that values are streamed from memory once instead of once for the copy and
+ * once for the statistics. Host memory only.
+ * @param values input array
+ * @param size of values array, must be > 0
+ * @param dest receives a copy of values, must not overlap it
+ * @param min of values
+ * @param max of values
+ */
+template <class T>
+void CopyAndGetMinMax(const T *values, const size_t size, T *dest, T &min, T &max) noexcept;
+
+/**
+ * Bin of value in a histogram of bins equal-width bins over [min, max].
+ * Values outside the range go to the first or last bin, and everything goes
+ * to the first bin if min == max.
+ */
+template <class T>
+size_t HistogramBin(const T value, const T min, const T max, const size_t bins) noexcept;
+
+/**
+ * Adds the values to a histogram of bins equal-width bins over [min, max],
+ * binned as in HistogramBin(). Host memory only.
+ * @param values input array
+ * @param size of values array
+ * @param min lower end of the first bin, usually the minimum of values
+ * @param max upper end of the last bin, usually the maximum of values
+ * @param bins number of bins, > 0
+ * @param counts bins counters, incremented and not reset
+ */
+template <class T>
+void GetHistogram(const T *values, const size_t size, const T min, const T max,
+                  const size_t bins, uint64_t *counts) noexcept;
+
 #ifdef ADIOS2_HAVE_GPU_SUPPORT
 template <class T>
 void GetGPUMinMax(const T *values, const size_t size, T &min, T &max) noexcept;
@@ -12,6 +12,7 @@
 
 #include <algorithm> // std::minmax_element, std::min_element, std::max_element
                      // std::transform
+#include <cmath>     // std::isfinite
 #include <limits>    //std::numeri_limits
 #include <thread>
 
@@ -457,6 +458,134 @@ inline void GetMinMax(const float *values, const size_t size, float &min, float
     GetMinMaxScalar(values, i, size, min, max);
 }
 
+// Generic fused copy: copy an L1-sized piece, then reduce it while it is still
+// in cache with the GetMinMax above (SIMD where it is specialized).
+template <class T>
+inline void CopyAndGetMinMax(const T *values, const size_t size, T *dest, T &min,
+                             T &max) noexcept
+{
+    constexpr size_t pieceElems = (16 * 1024 + sizeof(T) - 1) / sizeof(T);
+    min = values[0];
+    max = values[0];
+    for (size_t i = 0; i < size; i += pieceElems)
+    {
+        const size_t n = (std::min)(pieceElems, size - i);
+        std::copy(values + i, values + i + n, dest + i);
+        T pmin, pmax;
+        GetMinMax(dest + i, n, pmin, pmax, MemorySpace::Host);
+        if (pmin < min)
+            min = pmin;
+        if (pmax > max)
+            max = pmax;
+    }
+}
+
+// float and double, the common simulation types, load each vector once and
+// use it for the store and both reductions.
+template <>
+inline void CopyAndGetMinMax(const double *values, const size_t size, double *dest, double &min,
+                             double &max) noexcept
+{
+    size_t i = 0;
+#ifdef __aarch64__
+    float64x2_t vmin = vdupq_n_f64(values[0]);
+    float64x2_t vmax = vmin, vmin2 = vmin, vmax2 = vmin;
+    const size_t end4 = size - (size % 4);
+    for (; i < end4; i += 4)
+    {
+        float64x2_t a = vld1q_f64(values + i);
+        float64x2_t b = vld1q_f64(values + i + 2);
+        vst1q_f64(dest + i, a);
+        vst1q_f64(dest + i + 2, b);
+        vmin = vminq_f64(vmin, a);
+        vmax = vmaxq_f64(vmax, a);
+        vmin2 = vminq_f64(vmin2, b);
+        vmax2 = vmaxq_f64(vmax2, b);
+    }
+    min = vminvq_f64(vminq_f64(vmin, vmin2));
+    max = vmaxvq_f64(vmaxq_f64(vmax, vmax2));
+#elif defined(__x86_64__) || defined(_M_X64)
+    __m128d vmin = _mm_set1_pd(values[0]);
+    __m128d vmax = vmin, vmin2 = vmin, vmax2 = vmin;
+    const size_t end4 = size - (size % 4);
+    for (; i < end4; i += 4)
+    {
+        __m128d a = _mm_loadu_pd(values + i);
+        __m128d b = _mm_loadu_pd(values + i + 2);
+        _mm_storeu_pd(dest + i, a);
+        _mm_storeu_pd(dest + i + 2, b);
+        vmin = _mm_min_pd(vmin, a);
+        vmax = _mm_max_pd(vmax, a);
+        vmin2 = _mm_min_pd(vmin2, b);
+        vmax2 = _mm_max_pd(vmax2, b);
+    }
+    vmin = _mm_min_pd(vmin, vmin2);
+    vmax = _mm_max_pd(vmax, vmax2);
+    double tmin[2], tmax[2];
+    _mm_storeu_pd(tmin, vmin);
+    _mm_storeu_pd(tmax, vmax);
+    min = (std::min)(tmin[0], tmin[1]);
+    max = (std::max)(tmax[0], tmax[1]);
+#else
+    min = values[0];
+    max = values[0];
+#endif
+    std::copy(values + i, values + size, dest + i);
+    GetMinMaxScalar(values, i, size, min, max);
+}
+
+template <>
+inline void CopyAndGetMinMax(const float *values, const size_t size, float *dest, float &min,
+                             float &max) noexcept
+{
+    size_t i = 0;
+#ifdef __aarch64__
+    float32x4_t vmin = vdupq_n_f32(values[0]);
+    float32x4_t vmax = vmin, vmin2 = vmin, vmax2 = vmin;
+    const size_t end8 = size - (size % 8);
+    for (; i < end8; i += 8)
+    {
+        float32x4_t a = vld1q_f32(values + i);
+        float32x4_t b = vld1q_f32(values + i + 4);
+        vst1q_f32(dest + i, a);
+        vst1q_f32(dest + i + 4, b);
+        vmin = vminq_f32(vmin, a);
+        vmax = vmaxq_f32(vmax, a);
+        vmin2 = vminq_f32(vmin2, b);
+        vmax2 = vmaxq_f32(vmax2, b);
+    }
+    min = vminvq_f32(vminq_f32(vmin, vmin2));
+    max = vmaxvq_f32(vmaxq_f32(vmax, vmax2));
+#elif defined(__x86_64__) || defined(_M_X64)
+    __m128 vmin = _mm_set1_ps(values[0]);
+    __m128 vmax = vmin, vmin2 = vmin, vmax2 = vmin;
+    const size_t end8 = size - (size % 8);
+    for (; i < end8; i += 8)
+    {
+        __m128 a = _mm_loadu_ps(values + i);
+        __m128 b = _mm_loadu_ps(values + i + 4);
+        _mm_storeu_ps(dest + i, a);
+        _mm_storeu_ps(dest + i + 4, b);
+        vmin = _mm_min_ps(vmin, a);
+        vmax = _mm_max_ps(vmax, a);
+        vmin2 = _mm_min_ps(vmin2, b);
+        vmax2 = _mm_max_ps(vmax2, b);
+    }
+    vmin = _mm_min_ps(vmin, vmin2);
+    vmax = _mm_max_ps(vmax, vmax2);
+    float tmin[4], tmax[4];
+    _mm_storeu_ps(tmin, vmin);
+    _mm_storeu_ps(tmax, vmax);
+    min = (std::min)({tmin[0], tmin[1], tmin[2], tmin[3]});
+    max = (std::max)({tmax[0], tmax[1], tmax[2], tmax[3]});
+#else
+    min = values[0];
+    max = values[0];
+#endif
+    std::copy(values + i, values + size, dest + i);
+    GetMinMaxScalar(values, i, size, min, max);
+}
+
 template <>
 inline void GetMinMax(const std::complex<float> *values, const size_t size,
                       std::complex<float> &min, std::complex<float> &max,
@@ -881,6 +1010,51 @@ Dims PayloadDims(const Dims &dimensions, const bool isRowMajor) noexcept
     return payloadDims;
 }
 
+template <class T>
+inline size_t HistogramBin(const T value, const T min, const T max, const size_t bins) noexcept
+{
+    if (!(max > min))
+    {
+        return 0;
+    }
+    // on halves if max - min overflows
+    const double f =
+        std::isfinite(static_cast<double>(max) - static_cast<double>(min)) ? 1.0 : 0.5;
+    const double lo = f * static_cast<double>(min);
+    const double scale = static_cast<double>(bins) / (f * static_cast<double>(max) - lo);
+    const double x = (f * static_cast<double>(value) - lo) * scale;
+    // clamp before the cast, x is inf or NaN for a denormal max - min or
+    // for non-finite values; !(x > 0) catches NaN
+    if (!(x > 0))
+    {
+        return 0;
+    }
+    return (x < static_cast<double>(bins)) ? static_cast<size_t>(x) : bins - 1;
+}
+
+template <class T>
+inline void GetHistogram(const T *values, const size_t size, const T min, const T max,
+                         const size_t bins, uint64_t *counts) noexcept
+{
+    if (!(max > min))
+    {
+        counts[0] += size;
+        return;
+    }
+    // same arithmetic as HistogramBin, with the division taken out of the loop
+    const double f =
+        std::isfinite(static_cast<double>(max) - static_cast<double>(min)) ? 1.0 : 0.5;
+    const double lo = f * static_cast<double>(min);
+    const double scale = static_cast<double>(bins) / (f * static_cast<double>(max) - lo);
+    const double top = static_cast<double>(bins);
+    for (size_t i = 0; i < size; ++i)
+    {
+        const double x = (f * static_cast<double>(values[i]) - lo) * scale;
+        const size_t bin = !(x > 0) ? 0 : (x < top) ? static_cast<size_t>(x) : bins - 1;
+        ++counts[bin];
+    }
+}
+
 template <class T, class BinaryOperation>
 std::vector<T> VectorsOp(BinaryOperation op, const std::vector<T> &vector1,
                          const std::vector<T> &vector2) noexcept
@@ -7,6 +7,7 @@
 #include "adiosMemory.h"
 
 #include <algorithm>
+#include <cstring>
 #include <stddef.h> // max_align_t
 
 #include "adios2/helper/adiosType.h"
@@ -665,5 +666,91 @@ uint64_t PaddingToAlignOffset(uint64_t offset, uint64_t alignment_size)
     }
     return padSize;
 }
+
+namespace
+{
+constexpr uint64_t HashPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t HashPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t HashPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t HashPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t HashPrime5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t HashRotl(const uint64_t x, const int r) noexcept
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t HashRead64(const unsigned char *p) noexcept
+{
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t HashRound(uint64_t acc, const uint64_t input) noexcept
+{
+    acc += input * HashPrime2;
+    return HashRotl(acc, 31) * HashPrime1;
+}
+
+inline uint64_t HashMerge(uint64_t acc, const uint64_t lane) noexcept
+{
+    acc ^= HashRound(0, lane);
+    return acc * HashPrime1 + HashPrime4;
+}
+}
+
+uint64_t HashBytes(const void *data, const size_t size) noexcept
+{
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    const unsigned char *const end = p + size;
+    uint64_t h;
+    if (size >= 32)
+    {
+        // four independent lanes keep the multipliers busy
+        uint64_t v1 = HashPrime1 + HashPrime2;
+        uint64_t v2 = HashPrime2;
+        uint64_t v3 = 0;
+        uint64_t v4 = 0 - HashPrime1;
+        const unsigned char *const limit = end - 32;
+        do
+        {
+            v1 = HashRound(v1, HashRead64(p));
+            v2 = HashRound(v2, HashRead64(p + 8));
+            v3 = HashRound(v3, HashRead64(p + 16));
+            v4 = HashRound(v4, HashRead64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = HashRotl(v1, 1) + HashRotl(v2, 7) + HashRotl(v3, 12) + HashRotl(v4, 18);
+        h = HashMerge(h, v1);
+        h = HashMerge(h, v2);
+        h = HashMerge(h, v3);
+        h = HashMerge(h, v4);
+    }
+    else
+    {
+        h = HashPrime5;
+    }
+    h += static_cast<uint64_t>(size);
+
+    for (; p + 8 <= end; p += 8)
+    {
+        h ^= HashRound(0, HashRead64(p));
+        h = HashRotl(h, 27) * HashPrime1 + HashPrime4;
+    }
+    for (; p < end; ++p)
+    {
+        h ^= (*p) * HashPrime5;
+        h = HashRotl(h, 11) * HashPrime1;
+    }
+
+    h ^= h >> 33;
+    h *= HashPrime2;
+    h ^= h >> 29;
+    h *= HashPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
 } // end namespace helper
 } // end namespace adios2
@@ -244,6 +244,15 @@ size_t PayloadSize(const T *data, const Dims &count) noexcept;
  * the size alignment_size */
 uint64_t PaddingToAlignOffset(uint64_t offset, uint64_t alignment_size);
 
+/**
+ * Fast non-cryptographic 64-bit hash of a host memory area, in the manner of
+ * xxHash64, to tell whether a block changed. Not for security use.
+ * @param data start of the area
+ * @param size in bytes
+ * @return hash value
+ */
+uint64_t HashBytes(const void *data, const size_t size) noexcept;
+
 } // end namespace helper
 } // end namespace adios2
 
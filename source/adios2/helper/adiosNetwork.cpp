@@ -8,6 +8,7 @@
 #include "adios2/helper/adiosComm.h"
 #include "adios2/toolkit/transport/file/FileFStream.h"
 
+#include <cerrno>
 #include <string.h> // memcpy
 
 #ifdef _WIN32
@@ -66,6 +67,7 @@ struct WSAInit
 #include <net/if.h>    //AvailableIpAddresses() struct if_nameindex
 #include <netdb.h>
 #include <netinet/in.h> //AvailableIpAddresses() struct sockaddr_in
+#include <netinet/tcp.h> // TCP_NODELAY
 #include <nlohmann_json.hpp>
 #include <sys/ioctl.h> //AvailableIpAddresses() ioctl
 #include <sys/socket.h>
@@ -475,6 +477,49 @@ void NetworkSocket::RequestResponse(const std::string &request, char *response,
     response[result] = '\0';
 }
 
+int NetworkSocket::Send(const char *buffer, int size)
+{
+#ifdef MSG_NOSIGNAL
+    // a peer that closed the connection is an error here, not a signal
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+    while (true)
+    {
+        const auto n = send(m_Data->m_Socket, buffer, size, flags);
+#ifndef _WIN32
+        if (n == -1 && errno == EINTR)
+        {
+            continue;
+        }
+#endif
+        return static_cast<int>(n);
+    }
+}
+
+int NetworkSocket::Recv(char *buffer, int size)
+{
+    while (true)
+    {
+        const auto n = recv(m_Data->m_Socket, buffer, size, 0);
+#ifndef _WIN32
+        if (n == -1 && errno == EINTR)
+        {
+            continue;
+        }
+#endif
+        return static_cast<int>(n);
+    }
+}
+
+void NetworkSocket::SetNoDelay()
+{
+    int flag = 1;
+    setsockopt(m_Data->m_Socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char *>(&flag),
+               sizeof(flag));
+}
+
 void NetworkSocket::Close()
 {
     if (m_Data->m_Socket != -1)
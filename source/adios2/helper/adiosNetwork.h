@@ -71,6 +71,11 @@ public:
 
     void Connect(const std::string &hostname, uint16_t port, std::string protocol = "tcp");
     void RequestResponse(const std::string &request, char *response, size_t maxResponseSize);
+    /** Like send()/recv(): bytes moved, 0 at end of stream, -1 on error */
+    int Send(const char *buffer, int size);
+    int Recv(char *buffer, int size);
+    /** Send small requests right away instead of waiting to fill a packet */
+    void SetNoDelay();
     void Close();
     int GetSocket();
 
@@ -158,5 +158,52 @@ Partitioning PartitionRanks(const std::vector<uint64_t> &rankValues, uint64_t nu
     return partitioner(rankValues, numberOfPartitions);
 }
 
+PartitionCountTuner::PartitionCountTuner(const size_t initialCount, const size_t maxCount,
+                                         const double minGain)
+: m_Count(std::max<size_t>(1, std::min(initialCount, maxCount))), m_InitialCount(m_Count),
+  m_MaxCount(std::max<size_t>(1, maxCount)), m_MinGain(minGain)
+{
+}
+
+size_t PartitionCountTuner::Update(const double throughput)
+{
+    if (m_Converged)
+    {
+        return m_Count;
+    }
+
+    if (!m_Best || throughput > m_BestThroughput * (1.0 + m_MinGain))
+    {
+        m_Best = m_Count;
+        m_BestThroughput = throughput;
+    }
+    else if (m_Growing)
+    {
+        m_Growing = false;
+    }
+    else
+    {
+        m_Count = m_Best;
+        m_Converged = true;
+        return m_Count;
+    }
+
+    if (m_Growing && m_Best * 2 <= m_MaxCount)
+    {
+        m_Count = m_Best * 2;
+        return m_Count;
+    }
+    m_Growing = false;
+    // fewer partitions are only worth a try if more did not help at all
+    if (m_Best <= m_InitialCount && m_Best > 1)
+    {
+        m_Count = m_Best / 2;
+        return m_Count;
+    }
+    m_Count = m_Best;
+    m_Converged = true;
+    return m_Count;
+}
+
 } // end namespace helper
 } // end namespace adios2
@@ -65,6 +65,45 @@ Partitioning
 PartitionRanks(const std::vector<uint64_t> &rankValues, uint64_t numberOfPartitions = -1,
                PartitioningStrategy strategy = PartitioningStrategy::GreedyNumberPartitioning);
 
+/**
+ * Searches for the number of partitions that gives the best measured
+ * throughput, one measurement per count. Starting from an initial count it
+ * doubles the count while throughput improves, otherwise it halves it while
+ * that improves, and then keeps the best count seen.
+ */
+class PartitionCountTuner
+{
+public:
+    /**
+     * @param initialCount count the first measurement is taken with
+     * @param maxCount largest count to try
+     * @param minGain relative improvement needed to count as better
+     */
+    PartitionCountTuner(const size_t initialCount, const size_t maxCount,
+                        const double minGain = 0.05);
+
+    /**
+     * Records the throughput measured with Count() partitions
+     * @return the count to use next
+     */
+    size_t Update(const double throughput);
+
+    size_t Count() const noexcept { return m_Count; }
+
+    /** true once the search is over and Count() stays the same */
+    bool Converged() const noexcept { return m_Converged; }
+
+private:
+    size_t m_Count;
+    const size_t m_InitialCount;
+    const size_t m_MaxCount;
+    const double m_MinGain;
+    size_t m_Best = 0;
+    double m_BestThroughput = 0.0;
+    bool m_Growing = true;
+    bool m_Converged = false;
+};
+
 } // end namespace helper
 } // end namespace adios2
 
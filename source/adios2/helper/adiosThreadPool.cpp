@@ -0,0 +1,205 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "adiosThreadPool.h"
+
+#include <exception>
+
+namespace adios2
+{
+namespace helper
+{
+
+namespace
+{
+// the pool and queue of the worker running on this thread, if any
+thread_local const void *t_Pool = nullptr;
+thread_local size_t t_WorkerID = 0;
+
+/** What the calls of one Run share. Queued tasks hold it and may outlive the
+ *  Run, but they only touch Fn for an index they claimed, and Run waits for
+ *  all claimed indices. */
+struct RunBatch
+{
+    const std::function<void(size_t)> *Fn = nullptr;
+    size_t N = 0;
+    std::atomic<size_t> Next{1};
+    std::mutex DoneMutex;
+    std::condition_variable DoneCV;
+    size_t Remaining = 0; // protected by DoneMutex
+    std::exception_ptr Error;
+};
+
+void CallIndex(RunBatch &batch, const size_t i)
+{
+    std::exception_ptr e;
+    try
+    {
+        (*batch.Fn)(i);
+    }
+    catch (...)
+    {
+        e = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(batch.DoneMutex);
+    if (e && !batch.Error)
+    {
+        batch.Error = e;
+    }
+    if (--batch.Remaining == 0)
+    {
+        batch.DoneCV.notify_all();
+    }
+}
+
+/** Claims and calls indices of the batch until none is left */
+void CallIndices(RunBatch &batch)
+{
+    for (size_t i = batch.Next++; i < batch.N; i = batch.Next++)
+    {
+        CallIndex(batch, i);
+    }
+}
+}
+
+ThreadPool::ThreadPool(const size_t nThreads)
+{
+    const size_t n = nThreads ? nThreads : 1;
+    for (size_t i = 0; i < n; ++i)
+    {
+        m_Queues.push_back(std::unique_ptr<Queue>(new Queue));
+    }
+    m_Workers.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        m_Workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_Stop = true;
+    }
+    m_Wake.notify_all();
+    for (auto &w : m_Workers)
+    {
+        w.join();
+    }
+}
+
+std::shared_future<void> ThreadPool::Submit(std::function<void()> task)
+{
+    auto job = std::make_shared<std::packaged_task<void()>>(std::move(task));
+    std::shared_future<void> done = job->get_future().share();
+    Push([job]() { (*job)(); });
+    return done;
+}
+
+void ThreadPool::Run(const size_t n, const std::function<void(size_t)> &fn)
+{
+    if (n == 0)
+    {
+        return;
+    }
+    auto batch = std::make_shared<RunBatch>();
+    batch->Fn = &fn;
+    batch->N = n;
+    batch->Remaining = n;
+    for (size_t i = 1; i < n; ++i)
+    {
+        Push([batch]() { CallIndices(*batch); });
+    }
+    CallIndex(*batch, 0);
+
+    // take the indices no worker has started yet, but nothing else that is
+    // queued, then wait for the ones in progress
+    CallIndices(*batch);
+    {
+        std::unique_lock<std::mutex> lock(batch->DoneMutex);
+        batch->DoneCV.wait(lock, [&]() { return batch->Remaining == 0; });
+    }
+
+    if (batch->Error)
+    {
+        std::rethrow_exception(batch->Error);
+    }
+}
+
+void ThreadPool::Push(std::function<void()> task)
+{
+    // a worker keeps what it spawns, others spread round-robin
+    const size_t q = (t_Pool == this) ? t_WorkerID : (m_NextQueue++ % m_Queues.size());
+    {
+        // counted before it is visible, so a Pop never takes m_Queued below 0
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        ++m_Queued;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_Queues[q]->Mutex);
+        m_Queues[q]->Tasks.push_back(std::move(task));
+    }
+    m_Wake.notify_one();
+}
+
+bool ThreadPool::Pop(const size_t home, std::function<void()> &task)
+{
+    const size_t nQueues = m_Queues.size();
+    for (size_t k = 0; k < nQueues; ++k)
+    {
+        Queue &q = *m_Queues[(home + k) % nQueues];
+        std::lock_guard<std::mutex> lock(q.Mutex);
+        if (q.Tasks.empty())
+        {
+            continue;
+        }
+        if (k == 0)
+        {
+            // own queue: newest first, its data is most likely still cached
+            task = std::move(q.Tasks.back());
+            q.Tasks.pop_back();
+        }
+        else
+        {
+            // steal the oldest
+            task = std::move(q.Tasks.front());
+            q.Tasks.pop_front();
+        }
+        std::lock_guard<std::mutex> wakeLock(m_WakeMutex);
+        --m_Queued;
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::WorkerLoop(const size_t id)
+{
+    t_Pool = this;
+    t_WorkerID = id;
+    std::function<void()> task;
+    while (true)
+    {
+        if (Pop(id, task))
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_WakeMutex);
+        if (m_Queued == 0)
+        {
+            if (m_Stop)
+            {
+                break;
+            }
+            m_Wake.wait(lock, [this]() { return m_Stop || m_Queued > 0; });
+        }
+    }
+}
+
+} // end namespace helper
+} // end namespace adios2
@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ADIOS2_HELPER_THREADPOOL_H_
+#define ADIOS2_HELPER_THREADPOOL_H_
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+/// \endcond
+
+namespace adios2
+{
+namespace helper
+{
+
+/**
+ * Long-lived worker threads for an engine's background work. Every worker
+ * has its own task queue and idle workers steal from the others. A thread in
+ * Run() calls the indices of its own batch that no worker has taken yet, and
+ * never unrelated queued tasks, so tasks may themselves call Run() without
+ * deadlocking the pool.
+ */
+class ThreadPool
+{
+public:
+    /** @param nThreads number of worker threads, at least one is started */
+    explicit ThreadPool(const size_t nThreads);
+
+    /** Finishes the queued tasks and joins the workers */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t Size() const noexcept { return m_Workers.size(); }
+
+    /**
+     * Queues task and returns right away.
+     * @return future that becomes ready when the task has run and rethrows
+     * what it threw
+     */
+    std::shared_future<void> Submit(std::function<void()> task);
+
+    /**
+     * Calls fn(0) .. fn(n-1), fn(0) on the calling thread and the rest on
+     * the pool or, when no worker gets to them first, on the calling thread
+     * too. Returns when all have finished. The first exception thrown by any
+     * of them is rethrown.
+     */
+    void Run(const size_t n, const std::function<void(size_t)> &fn);
+
+private:
+    struct Queue
+    {
+        std::mutex Mutex;
+        std::deque<std::function<void()>> Tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_Queues;
+    std::vector<std::thread> m_Workers;
+    std::atomic<size_t> m_NextQueue{0};
+
+    std::mutex m_WakeMutex;
+    std::condition_variable m_Wake;
+    size_t m_Queued = 0; // protected by m_WakeMutex
+    bool m_Stop = false;
+
+    void Push(std::function<void()> task);
+    /** Takes a task from queue 'home' first, then from the others */
+    bool Pop(const size_t home, std::function<void()> &task);
+    void WorkerLoop(const size_t id);
+};
+
+} // end namespace helper
+} // end namespace adios2
+
+#endif /* ADIOS2_HELPER_THREADPOOL_H_ */
@@ -262,6 +262,27 @@ size_t Decompress(const char *bufferIn, const size_t sizeIn, char *dataOut, Memo
     return sizeOut;
 }
 
+size_t DecompressSubset(const char *bufferIn, const size_t sizeIn, const Dims &blockCount,
+                        const Dims &start, const Dims &count, char *dataOut,
+                        std::shared_ptr<Operator> op, Engine *engine, VariableBase *var)
+{
+    Operator::OperatorType compressorType;
+    std::memcpy(&compressorType, bufferIn, 1);
+    if (op == nullptr || op->m_TypeEnum != compressorType)
+    {
+        std::string opTypeString = OperatorTypeToString(compressorType);
+        op = MakeOperator(opTypeString, {});
+    }
+
+    if (engine && var)
+    {
+        Params operatorParams = CreateOperatorParams(engine, var);
+        op->AddExtraParameters(operatorParams);
+    }
+
+    return op->InverseOperateSubset(bufferIn, sizeIn, blockCount, start, count, dataOut);
+}
+
 Params CreateOperatorParams(const Engine *engine, const VariableBase *variable)
 {
     Params p = {{"EngineName", engine->m_Name}, {"VariableName", variable->m_Name}};
@@ -23,6 +23,16 @@ size_t Decompress(const char *bufferIn, const size_t sizeIn, char *dataOut, Memo
                   std::shared_ptr<Operator> op = nullptr, Engine *engine = nullptr,
                   VariableBase *var = nullptr);
 
+/**
+ * Decompress only the box (start, count) of the block in bufferIn, see
+ * Operator::InverseOperateSubset. Returns 0 if the operator does not support
+ * it for this buffer; the caller must then use Decompress.
+ */
+size_t DecompressSubset(const char *bufferIn, const size_t sizeIn, const Dims &blockCount,
+                        const Dims &start, const Dims &count, char *dataOut,
+                        std::shared_ptr<Operator> op = nullptr, Engine *engine = nullptr,
+                        VariableBase *var = nullptr);
+
 Params CreateOperatorParams(const Engine *engine, const VariableBase *variable);
 
 } // end namespace core
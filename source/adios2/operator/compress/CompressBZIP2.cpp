@@ -127,6 +127,8 @@ size_t CompressBZIP2::InverseOperate(const char *bufferIn, const size_t sizeIn,
 
 bool CompressBZIP2::IsDataTypeValid(const DataType type) const { return true; }
 
+bool CompressBZIP2::IsThreadSafe() const { return true; }
+
 size_t CompressBZIP2::DecompressV1(const char *bufferIn, const size_t sizeIn, char *dataOut)
 {
     // Do NOT remove even if the buffer version is updated. Data might be still
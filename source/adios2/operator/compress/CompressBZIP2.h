@@ -48,6 +48,8 @@ public:
 
     bool IsDataTypeValid(const DataType type) const final;
 
+    bool IsThreadSafe() const final;
+
 private:
     /**
      * check status from BZip compression and decompression functions
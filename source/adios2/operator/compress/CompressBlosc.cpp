@@ -16,6 +16,8 @@ extern "C" {
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 namespace adios2
 {
@@ -235,6 +237,180 @@ size_t CompressBlosc::InverseOperate(const char *bufferIn, const size_t sizeIn,
     return 0;
 }
 
+size_t CompressBlosc::InverseOperateSubset(const char *bufferIn, const size_t sizeIn,
+                                           const Dims &blockCount, const Dims &start,
+                                           const Dims &count, char *dataOut)
+{
+    // common header, V1 metadata (size, blosc version) and the data header
+    if (sizeIn < 4 + sizeof(size_t) + 3 + sizeof(DataHeader))
+    {
+        return 0;
+    }
+    size_t bufferInOffset = 1; // skip operator type
+    const uint8_t bufferVersion = GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    bufferInOffset += 2; // skip two reserved bytes
+    if (bufferVersion != 1)
+    {
+        return 0;
+    }
+
+    // blosc2 V1 metadata
+    const size_t sizeOut = GetParameter<size_t, size_t>(bufferIn, bufferInOffset);
+    bufferInOffset += 3; // skip blosc version
+    const DataHeader *dataPtr = reinterpret_cast<const DataHeader *>(bufferIn + bufferInOffset);
+    if (!dataPtr->IsChunked())
+    {
+        return 0;
+    }
+    bufferInOffset += sizeof(DataHeader);
+
+    const size_t elements = helper::GetTotalSize(blockCount);
+    if (elements == 0 || sizeOut % elements)
+    {
+        return 0;
+    }
+    const size_t elementSize = sizeOut / elements;
+    const size_t boxSize = helper::GetTotalSize(count, elementSize);
+    const char *inputDataBuff = bufferIn + bufferInOffset;
+    const size_t inputDataSize = sizeIn - bufferInOffset;
+
+    if (dataPtr->GetNumChunks() == 0)
+    {
+        // stored uncompressed
+        if (inputDataSize != sizeOut)
+        {
+            return 0;
+        }
+        ForEachSubsetRun(blockCount, start, count, elementSize,
+                         [&](size_t offsetInBlock, size_t offsetInBox, size_t bytes) {
+                             std::memcpy(dataOut + offsetInBox, inputDataBuff + offsetInBlock,
+                                         bytes);
+                         });
+        return boxSize;
+    }
+
+    /* locate the chunks, see DecompressChunkedFormat for the blosc2 header */
+    struct Chunk
+    {
+        const char *Data;
+        size_t Start; // offset of the chunk's data in the decompressed block
+        bloscSize_t CompressedSize;
+        bloscSize_t Size;
+        bloscSize_t BlockSize;
+        int TypeSize;
+    };
+    std::vector<Chunk> chunks;
+    chunks.reserve(dataPtr->GetNumChunks());
+    size_t maxBlockSize = 0;
+    size_t decompressedSize = 0;
+    for (size_t inputOffset = 0; inputOffset < inputDataSize;)
+    {
+        if (inputDataSize - inputOffset < BLOSC_MIN_HEADER_LENGTH)
+        {
+            return 0;
+        }
+        Chunk c;
+        c.Data = inputDataBuff + inputOffset;
+        c.Start = decompressedSize;
+        std::memcpy(&c.Size, c.Data + 4, sizeof(bloscSize_t));
+        std::memcpy(&c.BlockSize, c.Data + 8, sizeof(bloscSize_t));
+        std::memcpy(&c.CompressedSize, c.Data + 12, sizeof(bloscSize_t));
+        c.TypeSize = static_cast<uint8_t>(c.Data[3]);
+        if (c.CompressedSize <= 0 || c.Size <= 0 || c.TypeSize == 0 ||
+            static_cast<size_t>(c.CompressedSize) > inputDataSize - inputOffset)
+        {
+            return 0;
+        }
+        maxBlockSize = std::max<size_t>(maxBlockSize, static_cast<size_t>(c.BlockSize));
+        chunks.push_back(c);
+        inputOffset += static_cast<size_t>(c.CompressedSize);
+        decompressedSize += static_cast<size_t>(c.Size);
+    }
+    if (chunks.size() != dataPtr->GetNumChunks() || decompressedSize != sizeOut)
+    {
+        return 0;
+    }
+
+    // every run decompresses at least one blosc block: give up if that adds
+    // up to a good part of decompressing everything
+    size_t runs = 1;
+    for (size_t d = 0; d + 1 < count.size(); ++d)
+    {
+        runs *= count[d];
+    }
+    if (2 * (runs * maxBlockSize + boxSize) > sizeOut)
+    {
+        return 0;
+    }
+
+    // a private context needs neither blosc2_init nor blosc2_destroy, which
+    // would race with other threads using the global one
+    blosc2_dparams dparams = BLOSC2_DPARAMS_DEFAULTS;
+    dparams.nthreads = 1;
+    std::unique_ptr<blosc2_context, void (*)(blosc2_context *)> dctx(
+        blosc2_create_dctx(dparams), blosc2_free_ctx);
+    if (!dctx)
+    {
+        return 0;
+    }
+
+    std::vector<char> scratch;
+    auto copyFromChunks = [&](size_t offsetInBlock, size_t offsetInBox, size_t bytes) {
+        while (bytes > 0)
+        {
+            // last chunk starting at or before offsetInBlock
+            const auto it = std::upper_bound(
+                chunks.begin(), chunks.end(), offsetInBlock,
+                [](size_t offset, const Chunk &chunk) { return offset < chunk.Start; });
+            const Chunk &c = *(it - 1);
+            const size_t begin = offsetInBlock - c.Start;
+            const size_t len = std::min(bytes, static_cast<size_t>(c.Size) - begin);
+            const size_t ts = static_cast<size_t>(c.TypeSize);
+            const size_t firstItem = begin / ts;
+            const size_t endItem = (begin + len + ts - 1) / ts;
+            char *out = dataOut + offsetInBox;
+            int result = 0;
+            if (endItem * ts > static_cast<size_t>(c.Size))
+            {
+                // trailing bytes not forming a whole item: decompress the chunk
+                scratch.resize(static_cast<size_t>(c.Size));
+                result = blosc2_decompress_ctx(dctx.get(), c.Data, c.CompressedSize,
+                                               scratch.data(), c.Size);
+                std::memcpy(out, scratch.data() + begin, len);
+            }
+            else if (begin % ts == 0 && len % ts == 0)
+            {
+                result = blosc2_getitem_ctx(dctx.get(), c.Data, c.CompressedSize,
+                                            static_cast<int>(firstItem), static_cast<int>(len / ts),
+                                            out, static_cast<int32_t>(len));
+            }
+            else
+            {
+                // run starts or ends within an item of a chunk boundary
+                const size_t itemBytes = (endItem - firstItem) * ts;
+                scratch.resize(itemBytes);
+                result = blosc2_getitem_ctx(dctx.get(), c.Data, c.CompressedSize,
+                                            static_cast<int>(firstItem),
+                                            static_cast<int>(endItem - firstItem), scratch.data(),
+                                            static_cast<int32_t>(itemBytes));
+                std::memcpy(out, scratch.data() + (begin - firstItem * ts), len);
+            }
+            if (result < 0)
+            {
+                helper::Throw<std::runtime_error>("Operator", "CompressBlosc",
+                                                  "InverseOperateSubset",
+                                                  "blosc getitem failed with error " +
+                                                      std::to_string(result));
+            }
+            offsetInBlock += len;
+            offsetInBox += len;
+            bytes -= len;
+        }
+    };
+    ForEachSubsetRun(blockCount, start, count, elementSize, copyFromChunks);
+    return boxSize;
+}
+
 bool CompressBlosc::IsDataTypeValid(const DataType type) const { return true; }
 
 size_t CompressBlosc::DecompressV1(const char *bufferIn, const size_t sizeIn, char *dataOut)
@@ -59,6 +59,14 @@ public:
      */
     size_t InverseOperate(const char *bufferIn, const size_t sizeIn, char *dataOut) final;
 
+    /**
+     * Decompresses only the blosc blocks of the chunks covering the box, for
+     * buffers in the chunked format. Returns 0 (decompress everything) for
+     * the old format or when the box touches most of the data anyway.
+     */
+    size_t InverseOperateSubset(const char *bufferIn, const size_t sizeIn, const Dims &blockCount,
+                                const Dims &start, const Dims &count, char *dataOut) final;
+
     bool IsDataTypeValid(const DataType type) const final;
 
     size_t GetHeaderSize() const;
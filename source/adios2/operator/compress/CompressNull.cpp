@@ -41,8 +41,31 @@ size_t CompressNull::InverseOperate(const char *bufferIn, const size_t sizeIn, c
     return totalBytes;
 }
 
+size_t CompressNull::InverseOperateSubset(const char *bufferIn, const size_t sizeIn,
+                                          const Dims &blockCount, const Dims &start,
+                                          const Dims &count, char *dataOut)
+{
+    size_t bufferInOffset = 4; // skip common header
+
+    const size_t totalBytes = GetParameter<size_t>(bufferIn, bufferInOffset);
+    const size_t elements = helper::GetTotalSize(blockCount);
+    if (elements == 0 || totalBytes % elements)
+    {
+        return 0;
+    }
+    const char *data = bufferIn + bufferInOffset;
+    const size_t elementSize = totalBytes / elements;
+    ForEachSubsetRun(blockCount, start, count, elementSize,
+                     [&](size_t offsetInBlock, size_t offsetInBox, size_t bytes) {
+                         std::memcpy(dataOut + offsetInBox, data + offsetInBlock, bytes);
+                     });
+    return helper::GetTotalSize(count, elementSize);
+}
+
 bool CompressNull::IsDataTypeValid(const DataType type) const { return true; }
 
+bool CompressNull::IsThreadSafe() const { return true; }
+
 } // end namespace compress
 } // end namespace core
 } // end namespace adios2
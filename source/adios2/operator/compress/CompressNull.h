@@ -29,7 +29,12 @@ public:
 
     size_t InverseOperate(const char *bufferIn, const size_t sizeIn, char *dataOut) final;
 
+    size_t InverseOperateSubset(const char *bufferIn, const size_t sizeIn, const Dims &blockCount,
+                                const Dims &start, const Dims &count, char *dataOut) final;
+
     bool IsDataTypeValid(const DataType type) const final;
+
+    bool IsThreadSafe() const final;
 };
 
 } // end namespace compress
@@ -210,6 +210,8 @@ size_t CompressPNG::InverseOperate(const char *bufferIn, const size_t sizeIn, ch
 
 bool CompressPNG::IsDataTypeValid(const DataType type) const { return true; }
 
+bool CompressPNG::IsThreadSafe() const { return true; }
+
 size_t CompressPNG::DecompressV1(const char *bufferIn, const size_t sizeIn, char *dataOut)
 {
     // Do NOT remove even if the buffer version is updated. Data might be still
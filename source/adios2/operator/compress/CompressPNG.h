@@ -51,6 +51,8 @@ public:
 
     bool IsDataTypeValid(const DataType type) const final;
 
+    bool IsThreadSafe() const final;
+
 private:
     /**
      * Decompress function for V1 buffer. Do NOT remove even if the buffer
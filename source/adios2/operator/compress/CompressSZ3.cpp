@@ -233,6 +233,8 @@ bool CompressSZ3::IsDataTypeValid(const DataType type) const
     return false;
 }
 
+bool CompressSZ3::IsThreadSafe() const { return true; }
+
 size_t CompressSZ3::DecompressV1(const char *bufferIn, const size_t sizeIn, char *dataOut)
 {
     // Decompression format for SZ3 using buffer version 1 (versioning for future-proofing)
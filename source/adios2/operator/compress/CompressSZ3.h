@@ -48,6 +48,8 @@ public:
 
     bool IsDataTypeValid(const DataType type) const final;
 
+    bool IsThreadSafe() const final;
+
 private:
     /**
      * Decompress function for V1 buffer (BP3/BP4/BP5 compatible).
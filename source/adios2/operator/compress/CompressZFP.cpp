@@ -6,7 +6,10 @@
 
 #include "CompressZFP.h"
 #include "adios2/helper/adiosFunctions.h"
+#include <algorithm>
+#include <cstring>
 #include <sstream>
+#include <unordered_map>
 #include <zfp.h>
 
 /* CMake will make sure zfp >= 0.5.3
@@ -52,6 +55,13 @@ zfp_type GetZfpType(DataType type);
 
 zfp_stream *GetZFPStream(const Dims &dimensions, DataType type, const Params &parameters);
 
+/**
+ * Decodes the zfp block at the current position of the stream into block,
+ * 4^ndims values with x varying fastest
+ * @return false if zfp has no block decoder for type and ndims
+ */
+bool DecodeZFPBlock(zfp_stream *stream, zfp_type type, size_t ndims, void *block);
+
 CompressZFP::CompressZFP(const Params &parameters)
 : Operator("zfp", COMPRESS_ZFP, "compress", parameters)
 {
@@ -137,6 +147,132 @@ size_t CompressZFP::InverseOperate(const char *bufferIn, const size_t sizeIn, ch
     return 0;
 }
 
+size_t CompressZFP::InverseOperateSubset(const char *bufferIn, const size_t sizeIn,
+                                         const Dims &blockCount, const Dims &start,
+                                         const Dims &count, char *dataOut)
+{
+    size_t bufferInOffset = 1; // skip operator type
+    const uint8_t bufferVersion = GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    bufferInOffset += 2; // skip two reserved bytes
+    if (bufferVersion != 1)
+    {
+        return 0;
+    }
+
+    // zfp V1 metadata, see DecompressV1
+    const size_t ndims = GetParameter<size_t, size_t>(bufferIn, bufferInOffset);
+    if (ndims != blockCount.size())
+    {
+        return 0;
+    }
+    for (size_t i = 0; i < ndims; ++i)
+    {
+        if (GetParameter<size_t, size_t>(bufferIn, bufferInOffset) != blockCount[i])
+        {
+            return 0;
+        }
+    }
+    const DataType type = GetParameter<DataType>(bufferIn, bufferInOffset);
+    bufferInOffset += 3; // skip zfp version
+    const Params parameters = GetParameters(bufferIn, bufferInOffset);
+    if (parameters.count("rate") == 0 || bufferInOffset > sizeIn)
+    {
+        return 0;
+    }
+
+#ifdef ADIOS2_HAVE_ZFP_4D
+    const Dims convertedDims = ConvertDims(blockCount, type, 4);
+#else
+    const Dims convertedDims = ConvertDims(blockCount, type, 3);
+#endif
+    if (convertedDims.empty())
+    {
+        return 0;
+    }
+
+    // zfp sees the block as convertedDims with convertedDims[0] varying
+    // fastest and stores its 4^d blocks in that order
+    const size_t nd = convertedDims.size();
+    size_t valuesPerBlock = 1;
+    size_t nBlocks = 1;
+    Dims blocksPerDim(nd);
+    for (size_t d = 0; d < nd; ++d)
+    {
+        valuesPerBlock *= 4;
+        blocksPerDim[d] = (convertedDims[d] + 3) / 4;
+        nBlocks *= blocksPerDim[d];
+    }
+
+    zfp_stream *stream = GetZFPStream(convertedDims, type, parameters);
+    const size_t blockBits = static_cast<size_t>(stream->maxbits);
+    const size_t streamSize = sizeIn - bufferInOffset;
+    if (stream->minbits != stream->maxbits || nBlocks * blockBits > 8 * streamSize)
+    {
+        zfp_stream_close(stream);
+        return 0;
+    }
+    bitstream *bitstream = stream_open(const_cast<char *>(bufferIn + bufferInOffset), streamSize);
+    zfp_stream_set_bit_stream(stream, bitstream);
+
+    const zfp_type zfpType = GetZfpType(type);
+    const size_t valueSize = zfp_type_size(zfpType);
+    const size_t elementSize = helper::GetDataTypeSize(type);
+
+    // each zfp block touched by the box is decoded once
+    std::unordered_map<size_t, std::vector<char>> decoded;
+    auto copyFromBlocks = [&](size_t offsetInBlock, size_t offsetInBox, size_t bytes) {
+        size_t value = offsetInBlock / valueSize;
+        size_t remaining = bytes / valueSize;
+        char *out = dataOut + offsetInBox;
+        while (remaining > 0)
+        {
+            size_t blockIndex = 0;
+            size_t posInBlock = 0;
+            size_t stride = 1;
+            size_t blockStride = 1;
+            size_t rest = value;
+            for (size_t d = 0; d < nd; ++d)
+            {
+                const size_t coord = rest % convertedDims[d];
+                rest /= convertedDims[d];
+                blockIndex += (coord / 4) * blockStride;
+                posInBlock += (coord % 4) * stride;
+                blockStride *= blocksPerDim[d];
+                stride *= 4;
+            }
+            // values up to the end of this zfp block along x
+            const size_t x = value % convertedDims[0];
+            const size_t span = std::min({remaining, 4 - x % 4, convertedDims[0] - x});
+
+            auto it = decoded.find(blockIndex);
+            if (it == decoded.end())
+            {
+                std::vector<char> block(valuesPerBlock * valueSize);
+                stream_rseek(bitstream, blockIndex * blockBits);
+                if (!DecodeZFPBlock(stream, zfpType, nd, block.data()))
+                {
+                    helper::Throw<std::runtime_error>("Operator", "CompressZFP",
+                                                      "InverseOperateSubset",
+                                                      "zfp has no block decoder for " +
+                                                          std::to_string(nd) + "D data in " +
+                                                          ToString(type));
+                }
+                it = decoded.emplace(blockIndex, std::move(block)).first;
+            }
+            std::memcpy(out, it->second.data() + posInBlock * valueSize, span * valueSize);
+            out += span * valueSize;
+            value += span;
+            remaining -= span;
+        }
+    };
+
+    ForEachSubsetRun(blockCount, start, count, elementSize, copyFromBlocks);
+
+    zfp_stream_close(stream);
+    stream_close(bitstream);
+    return helper::GetTotalSize(count, elementSize);
+}
+
 bool CompressZFP::IsDataTypeValid(const DataType type) const
 {
     if (type == DataType::Float || type == DataType::Double || type == DataType::FloatComplex ||
@@ -147,6 +283,8 @@ bool CompressZFP::IsDataTypeValid(const DataType type) const
     return false;
 }
 
+bool CompressZFP::IsThreadSafe() const { return true; }
+
 // PRIVATE
 
 size_t CompressZFP::DecompressV1(const char *bufferIn, const size_t sizeIn, char *dataOut)
@@ -244,6 +382,93 @@ zfp_type GetZfpType(DataType type)
 
 // Free static functions
 
+bool DecodeZFPBlock(zfp_stream *stream, zfp_type type, size_t ndims, void *block)
+{
+    // the decoders return the bits read, a different type across zfp versions
+    switch (type)
+    {
+    case zfp_type_float:
+        switch (ndims)
+        {
+        case 1:
+            zfp_decode_block_float_1(stream, static_cast<float *>(block));
+            return true;
+        case 2:
+            zfp_decode_block_float_2(stream, static_cast<float *>(block));
+            return true;
+        case 3:
+            zfp_decode_block_float_3(stream, static_cast<float *>(block));
+            return true;
+#ifdef ADIOS2_HAVE_ZFP_4D
+        case 4:
+            zfp_decode_block_float_4(stream, static_cast<float *>(block));
+            return true;
+#endif
+        }
+        break;
+    case zfp_type_double:
+        switch (ndims)
+        {
+        case 1:
+            zfp_decode_block_double_1(stream, static_cast<double *>(block));
+            return true;
+        case 2:
+            zfp_decode_block_double_2(stream, static_cast<double *>(block));
+            return true;
+        case 3:
+            zfp_decode_block_double_3(stream, static_cast<double *>(block));
+            return true;
+#ifdef ADIOS2_HAVE_ZFP_4D
+        case 4:
+            zfp_decode_block_double_4(stream, static_cast<double *>(block));
+            return true;
+#endif
+        }
+        break;
+    case zfp_type_int32:
+        switch (ndims)
+        {
+        case 1:
+            zfp_decode_block_int32_1(stream, static_cast<int32 *>(block));
+            return true;
+        case 2:
+            zfp_decode_block_int32_2(stream, static_cast<int32 *>(block));
+            return true;
+        case 3:
+            zfp_decode_block_int32_3(stream, static_cast<int32 *>(block));
+            return true;
+#ifdef ADIOS2_HAVE_ZFP_4D
+        case 4:
+            zfp_decode_block_int32_4(stream, static_cast<int32 *>(block));
+            return true;
+#endif
+        }
+        break;
+    case zfp_type_int64:
+        switch (ndims)
+        {
+        case 1:
+            zfp_decode_block_int64_1(stream, static_cast<int64 *>(block));
+            return true;
+        case 2:
+            zfp_decode_block_int64_2(stream, static_cast<int64 *>(block));
+            return true;
+        case 3:
+            zfp_decode_block_int64_3(stream, static_cast<int64 *>(block));
+            return true;
+#ifdef ADIOS2_HAVE_ZFP_4D
+        case 4:
+            zfp_decode_block_int64_4(stream, static_cast<int64 *>(block));
+            return true;
+#endif
+        }
+        break;
+    default:
+        break;
+    }
+    return false;
+}
+
 zfp_field *GetZFPField(const char *data, const Dims &dimensions, DataType type)
 {
     zfp_type zfpType = GetZfpType(type);
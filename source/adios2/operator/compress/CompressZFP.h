@@ -46,8 +46,18 @@ public:
      */
     size_t InverseOperate(const char *bufferIn, const size_t sizeIn, char *dataOut) final;
 
+    /**
+     * Decodes only the zfp blocks covering the box, for buffers compressed in
+     * fixed-rate mode where every zfp block takes the same number of bits.
+     * Returns 0 (decompress everything) for the other modes.
+     */
+    size_t InverseOperateSubset(const char *bufferIn, const size_t sizeIn, const Dims &blockCount,
+                                const Dims &start, const Dims &count, char *dataOut) final;
+
     bool IsDataTypeValid(const DataType type) const final;
 
+    bool IsThreadSafe() const final;
+
 private:
     /**
      * Decompress function for V1 buffer. Do NOT remove even if the buffer
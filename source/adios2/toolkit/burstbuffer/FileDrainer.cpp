@@ -29,8 +29,9 @@ FileDrainOperation::FileDrainOperation(DrainOperation op, const std::string &fro
 {
     if (data)
     {
-        dataToWrite.resize(countBytes);
-        std::memcpy(dataToWrite.data(), data, countBytes);
+        auto copy = std::make_shared<std::vector<char>>(countBytes);
+        std::memcpy(copy->data(), data, countBytes);
+        dataToWrite = std::move(copy);
     };
 }
 
@@ -269,5 +270,76 @@ void FileDrainer::SetVerbose(int verboseLevel, int rank)
     m_Rank = rank;
 }
 
+void FileDrainer::SetMaxBandwidth(size_t bytesPerSecond)
+{
+    std::lock_guard<std::mutex> lock(m_PaceMutex);
+    m_MaxBandwidth = bytesPerSecond;
+}
+
+void FileDrainer::SetLowPriority(bool lowPriority)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_PaceMutex);
+        m_LowPriority = lowPriority;
+    }
+    m_PaceCV.notify_all();
+}
+
+void FileDrainer::EnterComputationBlock()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_PaceMutex);
+        m_InComputationBlock = true;
+        m_SawComputationBlock = true;
+    }
+    m_PaceCV.notify_all();
+}
+
+void FileDrainer::ExitComputationBlock()
+{
+    std::lock_guard<std::mutex> lock(m_PaceMutex);
+    m_InComputationBlock = false;
+}
+
+void FileDrainer::StopYielding()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_PaceMutex);
+        m_StopYielding = true;
+    }
+    m_PaceCV.notify_all();
+}
+
+double FileDrainer::Pace(size_t count)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto tStart = Clock::now();
+    std::unique_lock<std::mutex> lock(m_PaceMutex);
+    if (m_LowPriority)
+    {
+        // an application that never marks computation blocks is never waited for
+        m_PaceCV.wait(lock, [this]() {
+            return !m_LowPriority || m_InComputationBlock || !m_SawComputationBlock ||
+                   m_StopYielding;
+        });
+    }
+    if (m_MaxBandwidth)
+    {
+        // reserve the next slice of the budget, shared by all streams; an idle
+        // drain doesn't save up budget for a burst later
+        const auto now = Clock::now();
+        if (m_NextSlot < now)
+        {
+            m_NextSlot = now;
+        }
+        const auto start = m_NextSlot;
+        m_NextSlot += std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(count) / m_MaxBandwidth));
+        lock.unlock();
+        std::this_thread::sleep_until(start);
+    }
+    return std::chrono::duration<double>(Clock::now() - tStart).count();
+}
+
 } // end namespace burstbuffer
 } // end namespace adios2
@@ -7,6 +7,8 @@
 #ifndef ADIOS2_TOOLKIT_BURSTBUFFER_FILEDRAINER_H_
 #define ADIOS2_TOOLKIT_BURSTBUFFER_FILEDRAINER_H_
 
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
 #include <locale>
@@ -16,6 +18,7 @@
 #include <queue>
 #include <streambuf>
 #include <string>
+#include <vector>
 
 #include "adios2/common/ADIOSTypes.h"
 
@@ -47,7 +50,8 @@ struct FileDrainOperation
     size_t countBytes;
     size_t fromOffset;
     size_t toOffset;
-    std::vector<char> dataToWrite; // memory to write with Write operation
+    /** memory to write with Write operation, copied once and shared from then on */
+    std::shared_ptr<const std::vector<char>> dataToWrite;
 
     FileDrainOperation(DrainOperation op, const std::string &fromFileName,
                        const std::string &toFileName, size_t countBytes, size_t fromOffset,
@@ -96,6 +100,19 @@ public:
      * processes */
     void SetVerbose(int verboseLevel, int rank);
 
+    /** Cap the draining at this many bytes per second over all of its
+     *  streams, 0 means no cap */
+    void SetMaxBandwidth(size_t bytesPerSecond);
+
+    /** In low-priority mode, once the application marks computation blocks,
+     *  data is only moved inside them (and after Finish()), so the draining
+     *  stays off the network while the application communicates */
+    void SetLowPriority(bool lowPriority);
+
+    /** The application starts/ends a phase without I/O or communication */
+    void EnterComputationBlock();
+    void ExitComputationBlock();
+
 protected:
     std::queue<FileDrainOperation> operations;
     std::mutex operationsMutex;
@@ -105,6 +122,14 @@ protected:
     int m_Verbose = 0;
     static const int errorState = -1;
 
+    /** Call before moving count bytes. Blocks while a low-priority drain
+     *  must yield or while the drain is ahead of its bandwidth cap.
+     *  Returns the seconds it waited */
+    double Pace(size_t count);
+
+    /** The application waits for the drain to complete, don't yield anymore */
+    void StopYielding();
+
     /** instead for Open, use this function */
     InputFile GetFileForRead(const std::string &path);
     OutputFile GetFileForWrite(const std::string &path, bool append = false);
@@ -131,6 +156,16 @@ protected:
     void Delete(OutputFile &f, const std::string &path);
 
 private:
+    std::mutex m_PaceMutex;
+    std::condition_variable m_PaceCV;
+    size_t m_MaxBandwidth = 0;
+    bool m_LowPriority = false;
+    bool m_InComputationBlock = false;
+    bool m_SawComputationBlock = false;
+    bool m_StopYielding = false;
+    /** when the bandwidth budget allows the next transfer to start */
+    std::chrono::steady_clock::time_point m_NextSlot;
+
     InputFileMap m_InputFileMap;
     OutputFileMap m_OutputFileMap;
     void Open(InputFile &f, const std::string &path);
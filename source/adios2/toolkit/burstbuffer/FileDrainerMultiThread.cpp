@@ -0,0 +1,617 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "FileDrainerMultiThread.h"
+#include "adios2/helper/adiosLog.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint> // uintptr_t
+#include <cstdio>  // std::remove
+#include <cstring> // strerror
+#include <iostream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "../../core/CoreTypes.h"
+
+#if defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define NO_SANITIZE_THREAD __attribute__((no_sanitize("thread")))
+#endif
+#endif
+
+namespace adios2
+{
+namespace burstbuffer
+{
+
+namespace
+{
+constexpr size_t ioAlignment = 4096;
+const std::chrono::milliseconds readRetrySleep(10);
+
+std::string ErrnoMessage(const int localErrno)
+{
+    return ": errno = " + std::to_string(localErrno) + ": " + strerror(localErrno);
+}
+}
+
+FileDrainerMultiThread::FileDrainerMultiThread(const size_t nThreads)
+: FileDrainer(), m_NThreads(nThreads ? nThreads : 1)
+{
+}
+
+FileDrainerMultiThread::~FileDrainerMultiThread() { Join(); }
+
+void FileDrainerMultiThread::SetBufferSize(size_t bufferSizeBytes)
+{
+    // chunks start at aligned offsets when the copy does
+    m_BufferSize = std::max(ioAlignment, bufferSizeBytes / ioAlignment * ioAlignment);
+}
+
+void FileDrainerMultiThread::SetThreads(size_t nThreads) { m_NThreads = nThreads ? nThreads : 1; }
+
+void FileDrainerMultiThread::Start()
+{
+    for (size_t i = 0; i < m_NThreads; ++i)
+    {
+        m_Workers.emplace_back(&FileDrainerMultiThread::WorkerThread, this);
+    }
+    m_Dispatcher = std::thread(&FileDrainerMultiThread::DrainThread, this);
+}
+
+void FileDrainerMultiThread::Finish()
+{
+    finishMutex.lock();
+    finish = true;
+    finishMutex.unlock();
+    StopYielding();
+}
+
+void FileDrainerMultiThread::Join()
+{
+    if (m_Dispatcher.joinable())
+    {
+        const auto tTotalStart = core::Now();
+        core::Seconds timeTotal(0.0);
+
+        Finish();
+        m_Dispatcher.join();
+
+        const auto tTotalEnd = core::Now();
+        timeTotal = tTotalEnd - tTotalStart;
+        if (m_Verbose)
+        {
+#ifndef NO_SANITIZE_THREAD
+            std::cout << "Drain " << m_Rank << ": Waited for threads to join = "
+                      << timeTotal.count() << " seconds" << std::endl;
+#endif
+        }
+    }
+}
+
+FileDrainerMultiThread::InputState &FileDrainerMultiThread::Input(const std::string &path)
+{
+    auto it = m_Inputs.find(path);
+    if (it == m_Inputs.end())
+    {
+        it = m_Inputs.emplace(path, InputState()).first;
+        it->second.fd = open(path.c_str(), O_RDONLY);
+        if (it->second.fd < 0)
+        {
+            helper::Log("BurstBuffer", "FileDrainerMultiThread", "Input",
+                        "FileDrainer couldn't open " + path + ErrnoMessage(errno),
+                        helper::FATALERROR);
+        }
+    }
+    return it->second;
+}
+
+FileDrainerMultiThread::OutputState &FileDrainerMultiThread::Output(const std::string &path,
+                                                                    const bool append)
+{
+    auto it = m_Outputs.find(path);
+    if (it == m_Outputs.end())
+    {
+        it = m_Outputs.emplace(path, OutputState()).first;
+        OutputState &out = it->second;
+        const int flags = O_WRONLY | O_CREAT | (append ? 0 : O_TRUNC);
+        out.fd = open(path.c_str(), flags, 0666);
+        if (out.fd < 0)
+        {
+            helper::Log("BurstBuffer", "FileDrainerMultiThread", "Output",
+                        "FileDrainer couldn't open " + path + ErrnoMessage(errno),
+                        helper::FATALERROR);
+        }
+        else if (append)
+        {
+            const off_t end = lseek(out.fd, 0, SEEK_END);
+            out.pos = out.size = (end > 0) ? static_cast<size_t>(end) : 0;
+        }
+    }
+    return it->second;
+}
+
+void FileDrainerMultiThread::CloseFiles()
+{
+    for (auto &f : m_Outputs)
+    {
+        if (f.second.fd >= 0)
+        {
+            close(f.second.fd);
+        }
+    }
+    m_Outputs.clear();
+    for (auto &f : m_Inputs)
+    {
+        if (f.second.fd >= 0)
+        {
+            close(f.second.fd);
+        }
+    }
+    m_Inputs.clear();
+}
+
+void FileDrainerMultiThread::Dispatch(Task &&task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_TaskMutex);
+        m_Tasks.push_back(std::move(task));
+    }
+    m_TaskCV.notify_one();
+}
+
+void FileDrainerMultiThread::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_TaskMutex);
+    m_IdleCV.wait(lock, [this]() { return m_Tasks.empty() && m_Running == 0; });
+    lock.unlock();
+    for (auto &f : m_Outputs)
+    {
+        f.second.busyBegin = f.second.busyEnd = 0;
+    }
+}
+
+void FileDrainerMultiThread::WorkerThread()
+{
+    std::vector<char> buffer; // for pread/pwrite, allocated on first use
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_TaskMutex);
+            m_TaskCV.wait(lock, [this]() { return m_StopWorkers || !m_Tasks.empty(); });
+            if (m_Tasks.empty())
+            {
+                break;
+            }
+            task = std::move(m_Tasks.front());
+            m_Tasks.pop_front();
+            ++m_Running;
+        }
+
+        const double paced = Pace(task.count);
+        m_PacedFor += static_cast<size_t>(paced * 1.0e6);
+        try
+        {
+            if (task.data)
+            {
+                Write(task);
+            }
+            else
+            {
+                Copy(task, buffer);
+            }
+        }
+        catch (std::ios_base::failure &e)
+        {
+            helper::Log("BurstBuffer", "FileDrainerMultiThread", "WorkerThread",
+                        std::string(e.what()), helper::FATALERROR);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_TaskMutex);
+            --m_Running;
+        }
+        m_IdleCV.notify_all();
+    }
+}
+
+void FileDrainerMultiThread::Copy(const Task &task, std::vector<char> &buffer)
+{
+    size_t fromOffset = task.fromOffset;
+    size_t toOffset = task.toOffset;
+    size_t count = task.count;
+
+    auto lf_Wait = [&]() {
+        // the writer has not put the data on the burst buffer yet
+        std::this_thread::sleep_for(readRetrySleep);
+        m_SleptForWaitingOnRead +=
+            std::chrono::duration_cast<std::chrono::microseconds>(readRetrySleep).count();
+    };
+
+#if defined(__linux__) && defined(SYS_copy_file_range)
+    while (count > 0 && m_UseCopyFileRange)
+    {
+        loff_t in = static_cast<loff_t>(fromOffset);
+        loff_t out = static_cast<loff_t>(toOffset);
+        const long n =
+            syscall(SYS_copy_file_range, task.fromFD, &in, task.toFD, &out, count, 0u);
+        if (n > 0)
+        {
+            m_ReadBytesSucc += n;
+            m_WriteBytesSucc += n;
+            fromOffset += n;
+            toOffset += n;
+            count -= n;
+        }
+        else if (n == 0)
+        {
+            lf_Wait();
+        }
+        else if (errno != EINTR)
+        {
+            // across file systems on older kernels, or not supported at all
+            m_UseCopyFileRange = false;
+        }
+    }
+#endif
+
+    if (count > 0 && buffer.empty())
+    {
+        buffer.resize(m_BufferSize + ioAlignment);
+    }
+    // aligned within the buffer, the chunks themselves start at aligned file offsets
+    char *data = buffer.data();
+    data += (ioAlignment - reinterpret_cast<uintptr_t>(data) % ioAlignment) % ioAlignment;
+    while (count > 0)
+    {
+        const size_t chunk = std::min(count, m_BufferSize);
+        size_t have = 0;
+        while (have < chunk)
+        {
+            const ssize_t n = pread(task.fromFD, data + have, chunk - have,
+                                    static_cast<off_t>(fromOffset + have));
+            if (n > 0)
+            {
+                have += n;
+            }
+            else if (n == 0)
+            {
+                lf_Wait();
+            }
+            else if (errno != EINTR)
+            {
+                helper::Throw<std::ios_base::failure>(
+                    "Toolkit", "BurstBuffer::FileDrainerMultiThread", "Copy",
+                    "FileDrainer couldn't read from file " + *task.fromName +
+                        " offset = " + std::to_string(fromOffset + have) + ErrnoMessage(errno));
+            }
+        }
+        m_ReadBytesSucc += have;
+
+        size_t done = 0;
+        while (done < chunk)
+        {
+            const ssize_t n = pwrite(task.toFD, data + done, chunk - done,
+                                     static_cast<off_t>(toOffset + done));
+            if (n >= 0)
+            {
+                done += n;
+            }
+            else if (errno != EINTR)
+            {
+                helper::Throw<std::ios_base::failure>(
+                    "Toolkit", "BurstBuffer::FileDrainerMultiThread", "Copy",
+                    "FileDrainer couldn't write to file " + *task.toName +
+                        " offset = " + std::to_string(toOffset + done) + ErrnoMessage(errno));
+            }
+        }
+        m_WriteBytesSucc += done;
+
+        fromOffset += chunk;
+        toOffset += chunk;
+        count -= chunk;
+    }
+}
+
+void FileDrainerMultiThread::Write(const Task &task)
+{
+    const char *data = task.data->data() + task.fromOffset;
+    size_t done = 0;
+    while (done < task.count)
+    {
+        const ssize_t n = pwrite(task.toFD, data + done, task.count - done,
+                                 static_cast<off_t>(task.toOffset + done));
+        if (n >= 0)
+        {
+            done += n;
+        }
+        else if (errno != EINTR)
+        {
+            helper::Throw<std::ios_base::failure>(
+                "Toolkit", "BurstBuffer::FileDrainerMultiThread", "Write",
+                "FileDrainer couldn't write to file " + *task.toName +
+                    " count = " + std::to_string(task.count) + " bytes" + ErrnoMessage(errno));
+        }
+    }
+    m_WriteBytesSucc += done;
+}
+
+/*
+ * This function is running in a separate thread from all other member function
+ * calls.
+ */
+void FileDrainerMultiThread::DrainThread()
+{
+    const auto tTotalStart = core::Now();
+    core::Seconds timeTotal(0.0);
+    core::Seconds timeSleep(0.0);
+    core::Seconds timeWait(0.0);
+    core::Seconds timeClose(0.0);
+    core::TimePoint ts, te;
+    size_t maxQueueSize = 0;
+
+    // overwriting a range that may still be in flight must wait for it
+    auto lf_Reserve = [&](OutputState &out, const size_t offset, const size_t count) {
+        if (count == 0)
+        {
+            return;
+        }
+        if (offset < out.busyEnd && out.busyBegin < offset + count)
+        {
+            ts = core::Now();
+            WaitIdle();
+            te = core::Now();
+            timeWait += te - ts;
+        }
+        if (out.busyBegin == out.busyEnd)
+        {
+            out.busyBegin = offset;
+            out.busyEnd = offset + count;
+        }
+        else
+        {
+            out.busyBegin = std::min(out.busyBegin, offset);
+            out.busyEnd = std::max(out.busyEnd, offset + count);
+        }
+        out.size = std::max(out.size, offset + count);
+    };
+
+    auto lf_Copy = [&](const std::string &fromName, InputState &in, size_t fromOffset,
+                       const std::string &toName, OutputState &out, size_t toOffset,
+                       size_t count) {
+        m_ReadBytesTasked += count;
+        m_WriteBytesTasked += count;
+        lf_Reserve(out, toOffset, count);
+        // cut at aligned target offsets so every chunk but the first is aligned
+        while (count > 0)
+        {
+            const size_t toBoundary = m_BufferSize - toOffset % m_BufferSize;
+            const size_t chunk = std::min(count, toBoundary);
+            Dispatch({in.fd, out.fd, fromOffset, toOffset, chunk, nullptr, &fromName, &toName});
+            fromOffset += chunk;
+            toOffset += chunk;
+            count -= chunk;
+        }
+    };
+
+    auto lf_Write = [&](FileDrainOperation &fdo, OutputState &out, size_t toOffset,
+                        const std::string &toName) {
+        m_WriteBytesTasked += fdo.countBytes;
+        if (out.fd < 0 || fdo.countBytes == 0 || !fdo.dataToWrite)
+        {
+            return;
+        }
+        lf_Reserve(out, toOffset, fdo.countBytes);
+        Dispatch({-1, out.fd, 0, toOffset, fdo.countBytes, fdo.dataToWrite, nullptr, &toName});
+    };
+
+    std::chrono::duration<double> d(0.100);
+
+    while (true)
+    {
+        operationsMutex.lock();
+        if (operations.empty())
+        {
+            operationsMutex.unlock();
+            finishMutex.lock();
+            bool done = finish;
+            finishMutex.unlock();
+            if (done)
+            {
+                break;
+            }
+            ts = core::Now();
+            std::this_thread::sleep_for(d);
+            te = core::Now();
+            timeSleep += te - ts;
+            continue;
+        }
+
+        FileDrainOperation fdo = std::move(operations.front());
+        operations.pop();
+        maxQueueSize = std::max(maxQueueSize, operations.size() + 1);
+        operationsMutex.unlock();
+
+        if (m_Verbose >= 2)
+        {
+#ifndef NO_SANITIZE_THREAD
+            std::cout << "Drain " << m_Rank << ": operation " << static_cast<int>(fdo.op)
+                      << " from " << fdo.fromFileName << " -> " << fdo.toFileName << " "
+                      << fdo.countBytes << " bytes, offsets: from " << fdo.fromOffset << " to "
+                      << fdo.toOffset << std::endl;
+#endif
+        }
+
+        switch (fdo.op)
+        {
+
+        case DrainOperation::CopyAt:
+        case DrainOperation::Copy: {
+            InputState &in = Input(fdo.fromFileName);
+            const bool append = (fdo.op == DrainOperation::Copy);
+            OutputState &out = Output(fdo.toFileName, append);
+            const std::string &fromName = m_Inputs.find(fdo.fromFileName)->first;
+            const std::string &toName = m_Outputs.find(fdo.toFileName)->first;
+            if (in.fd < 0 || out.fd < 0)
+            {
+                // skip because of previous error
+                m_ReadBytesTasked += fdo.countBytes;
+                m_WriteBytesTasked += fdo.countBytes;
+                break;
+            }
+            if (fdo.op == DrainOperation::CopyAt)
+            {
+                in.pos = fdo.fromOffset;
+                out.pos = fdo.toOffset;
+            }
+            lf_Copy(fromName, in, in.pos, toName, out, out.pos, fdo.countBytes);
+            in.pos += fdo.countBytes;
+            out.pos += fdo.countBytes;
+            break;
+        }
+        case DrainOperation::SeekEnd: {
+            OutputState &out = Output(fdo.toFileName, false);
+            out.pos = out.size;
+            break;
+        }
+        case DrainOperation::WriteAt:
+        case DrainOperation::Write: {
+            OutputState &out = Output(fdo.toFileName, false);
+            const std::string &toName = m_Outputs.find(fdo.toFileName)->first;
+            if (fdo.op == DrainOperation::WriteAt)
+            {
+                out.pos = fdo.toOffset;
+            }
+            lf_Write(fdo, out, out.pos, toName);
+            out.pos += fdo.countBytes;
+            break;
+        }
+        case DrainOperation::Create:
+        case DrainOperation::Open:
+        case DrainOperation::Delete: {
+            // the file must not change under tasks still running on it
+            ts = core::Now();
+            WaitIdle();
+            te = core::Now();
+            timeWait += te - ts;
+            auto outIt = m_Outputs.find(fdo.toFileName);
+            if (outIt != m_Outputs.end() && fdo.op != DrainOperation::Open)
+            {
+                if (outIt->second.fd >= 0)
+                {
+                    close(outIt->second.fd);
+                }
+                m_Outputs.erase(outIt);
+            }
+            if (fdo.op == DrainOperation::Delete)
+            {
+                auto inIt = m_Inputs.find(fdo.toFileName);
+                if (inIt != m_Inputs.end())
+                {
+                    if (inIt->second.fd >= 0)
+                    {
+                        close(inIt->second.fd);
+                    }
+                    m_Inputs.erase(inIt);
+                }
+                std::remove(fdo.toFileName.c_str());
+            }
+            else
+            {
+                Output(fdo.toFileName, fdo.op == DrainOperation::Open);
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    if (m_Verbose > 1)
+    {
+#ifndef NO_SANITIZE_THREAD
+        std::cout << "Drain " << m_Rank << " finished operations. Closing all files" << std::endl;
+#endif
+    }
+
+    ts = core::Now();
+    WaitIdle();
+    {
+        std::lock_guard<std::mutex> lock(m_TaskMutex);
+        m_StopWorkers = true;
+    }
+    m_TaskCV.notify_all();
+    for (auto &w : m_Workers)
+    {
+        w.join();
+    }
+    m_Workers.clear();
+    te = core::Now();
+    timeWait += te - ts;
+
+    ts = core::Now();
+    CloseFiles();
+    te = core::Now();
+    timeClose += te - ts;
+
+    const auto tTotalEnd = core::Now();
+    timeTotal = tTotalEnd - tTotalStart;
+    const size_t nReadBytesTasked = m_ReadBytesTasked;
+    const size_t nReadBytesSucc = m_ReadBytesSucc;
+    const size_t nWriteBytesTasked = m_WriteBytesTasked;
+    const size_t nWriteBytesSucc = m_WriteBytesSucc;
+    const double sleptForWaitingOnRead = m_SleptForWaitingOnRead / 1.0e6;
+    const bool shouldReport =
+        (m_Verbose || (nReadBytesTasked != nReadBytesSucc) ||
+         (nWriteBytesTasked != nWriteBytesSucc) || (sleptForWaitingOnRead > 0.0));
+    if (shouldReport)
+    {
+#ifndef NO_SANITIZE_THREAD
+        std::cout << "Drain " << m_Rank << ": Runtime  total = " << timeTotal.count()
+                  << " wait = " << timeWait.count() << " close = " << timeClose.count()
+                  << " sleep = " << timeSleep.count() << " pace = " << m_PacedFor / 1.0e6
+                  << " seconds"
+                  << ", " << m_NThreads << " copy threads"
+                  << (m_UseCopyFileRange ? "" : " (pread/pwrite)")
+                  << ". Max queue size = " << maxQueueSize << ".";
+        if (nReadBytesTasked == nReadBytesSucc)
+        {
+            std::cout << " Read " << nReadBytesSucc << " bytes";
+        }
+        else
+        {
+            std::cout << " WARNING Read wanted = " << nReadBytesTasked
+                      << " but successfully read = " << nReadBytesSucc << " bytes.";
+        }
+        if (nWriteBytesTasked == nWriteBytesSucc)
+        {
+            std::cout << " Wrote " << nWriteBytesSucc << " bytes";
+        }
+        else
+        {
+            std::cout << " WARNING Write wanted = " << nWriteBytesTasked
+                      << " but successfully wrote = " << nWriteBytesSucc << " bytes.";
+        }
+        if (sleptForWaitingOnRead > 0.0)
+        {
+            std::cout << " WARNING Read had to wait " << sleptForWaitingOnRead
+                      << " seconds for the data to arrive on disk.";
+        }
+        std::cout << std::endl;
+#endif
+    }
+}
+
+} // end namespace burstbuffer
+} // end namespace adios2
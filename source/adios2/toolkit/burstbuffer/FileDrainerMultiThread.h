@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ADIOS2_TOOLKIT_BURSTBUFFER_FILEDRAINERMULTITHREAD_H_
+#define ADIOS2_TOOLKIT_BURSTBUFFER_FILEDRAINERMULTITHREAD_H_
+
+#include "adios2/toolkit/burstbuffer/FileDrainer.h"
+#include "adios2/toolkit/burstbuffer/FileDrainerSingleThread.h"
+
+#ifndef _WIN32
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+#endif
+
+namespace adios2
+{
+namespace burstbuffer
+{
+
+#ifndef _WIN32
+
+/**
+ * Drains with several copy streams at once. One thread takes the operations
+ * in order and resolves them to absolute file offsets, then splits copies
+ * into chunks that the worker threads move with copy_file_range, or pread
+ * and pwrite where the kernel can't copy between the two files. Writes from
+ * memory share the operation's buffer instead of copying it again.
+ */
+class FileDrainerMultiThread : public FileDrainer
+{
+
+public:
+    static const size_t defaultBufferSize = 16777216; // 16MB per chunk
+
+    /** @param nThreads number of concurrent copy streams, at least one */
+    explicit FileDrainerMultiThread(const size_t nThreads = 1);
+
+    ~FileDrainerMultiThread();
+
+    /** Size of the chunks copies are split into, call before Start */
+    void SetBufferSize(size_t bufferSizeBytes);
+
+    /** Number of copy streams, call before Start */
+    void SetThreads(size_t nThreads);
+
+    /** Create the ordering thread and the copy threads, which idle until
+     *  operations are given. Finish() will complete all work then join them
+     */
+    void Start();
+
+    /** Tell threads to terminate when all draining has finished. */
+    void Finish();
+
+    /** Join the threads. Main thread will block until they terminate */
+    void Join();
+
+private:
+    /** A copy or a write at absolute offsets, independent of all other tasks */
+    struct Task
+    {
+        int fromFD;
+        int toFD;
+        size_t fromOffset;
+        size_t toOffset;
+        size_t count;
+        std::shared_ptr<const std::vector<char>> data; // Write tasks only
+        const std::string *fromName;
+        const std::string *toName;
+    };
+
+    struct OutputState
+    {
+        int fd = -1;
+        size_t pos = 0;  // where the next Write/Copy goes
+        size_t size = 0; // end of everything dispatched so far
+        // range of the tasks dispatched since the drainer was last idle
+        size_t busyBegin = 0;
+        size_t busyEnd = 0;
+    };
+
+    struct InputState
+    {
+        int fd = -1;
+        size_t pos = 0; // where the next Copy reads from
+    };
+
+    size_t m_BufferSize = defaultBufferSize;
+    size_t m_NThreads = 1;
+    std::thread m_Dispatcher;
+    std::vector<std::thread> m_Workers;
+    bool finish = false;
+    std::mutex finishMutex;
+
+    /** Files are only touched by the dispatcher, the workers get descriptors */
+    std::map<std::string, InputState> m_Inputs;
+    std::map<std::string, OutputState> m_Outputs;
+
+    std::mutex m_TaskMutex;
+    std::condition_variable m_TaskCV; // a task was queued or m_StopWorkers
+    std::condition_variable m_IdleCV; // a task completed
+    std::deque<Task> m_Tasks;
+    size_t m_Running = 0;
+    bool m_StopWorkers = false;
+
+    /** false after copy_file_range failed for a reason other than EOF */
+    std::atomic<bool> m_UseCopyFileRange{true};
+
+    std::atomic<size_t> m_ReadBytesTasked{0};
+    std::atomic<size_t> m_ReadBytesSucc{0};
+    std::atomic<size_t> m_WriteBytesTasked{0};
+    std::atomic<size_t> m_WriteBytesSucc{0};
+    /** microseconds the workers waited for data to reach the burst buffer */
+    std::atomic<size_t> m_SleptForWaitingOnRead{0};
+    /** microseconds the workers waited in Pace() */
+    std::atomic<size_t> m_PacedFor{0};
+
+    void DrainThread();  // takes the operations in order
+    void WorkerThread(); // runs tasks
+    void Dispatch(Task &&task);
+    /** Blocks until all dispatched tasks have completed */
+    void WaitIdle();
+
+    /** Returns the output state, opening the file if needed; fd < 0 on error */
+    OutputState &Output(const std::string &path, const bool append);
+    InputState &Input(const std::string &path);
+    void CloseFiles();
+
+    /** Copy count bytes, waiting for data still on its way to the burst buffer */
+    void Copy(const Task &task, std::vector<char> &buffer);
+    void Write(const Task &task);
+};
+
+#else
+
+/** No positional I/O here, drain on a single thread */
+class FileDrainerMultiThread : public FileDrainerSingleThread
+{
+public:
+    explicit FileDrainerMultiThread(const size_t /*nThreads*/ = 1) {}
+
+    void SetThreads(size_t /*nThreads*/) {}
+};
+
+#endif
+
+} // end namespace burstbuffer
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_BURSTBUFFER_FILEDRAINERMULTITHREAD_H_ */
@@ -50,6 +50,7 @@ void FileDrainerSingleThread::Finish()
     finishMutex.lock();
     finish = true;
     finishMutex.unlock();
+    StopYielding();
 }
 
 void FileDrainerSingleThread::Join()
@@ -86,6 +87,7 @@ void FileDrainerSingleThread::DrainThread()
     core::Seconds timeRead(0.0);
     core::Seconds timeWrite(0.0);
     core::Seconds timeClose(0.0);
+    double timePace = 0.0;
     core::TimePoint ts, te;
     size_t maxQueueSize = 0;
     std::vector<char> buffer; // fixed, preallocated buffer to read/write data
@@ -99,6 +101,7 @@ void FileDrainerSingleThread::DrainThread()
 
     /* Copy a block of data from one file to another at the same offset */
     auto lf_Copy = [&](FileDrainOperation &fdo, InputFile fdr, OutputFile fdw, size_t count) {
+        timePace += Pace(count);
         nReadBytesTasked += count;
         ts = core::Now();
         std::pair<size_t, double> ret = Read(fdr, count, buffer.data(), fdo.fromFileName);
@@ -238,10 +241,11 @@ void FileDrainerSingleThread::DrainThread()
 #endif
             }
             nWriteBytesTasked += fdo.countBytes;
+            timePace += Pace(fdo.countBytes);
             ts = core::Now();
             auto fdw = GetFileForWrite(fdo.toFileName);
             Seek(fdw, fdo.toOffset, fdo.toFileName);
-            size_t n = Write(fdw, fdo.countBytes, fdo.dataToWrite.data(), fdo.toFileName);
+            size_t n = Write(fdw, fdo.countBytes, fdo.dataToWrite->data(), fdo.toFileName);
             te = core::Now();
             timeWrite += te - ts;
             nWriteBytesSucc += n;
@@ -256,9 +260,10 @@ void FileDrainerSingleThread::DrainThread()
 #endif
             }
             nWriteBytesTasked += fdo.countBytes;
+            timePace += Pace(fdo.countBytes);
             ts = core::Now();
             auto fdw = GetFileForWrite(fdo.toFileName);
-            size_t n = Write(fdw, fdo.countBytes, fdo.dataToWrite.data(), fdo.toFileName);
+            size_t n = Write(fdw, fdo.countBytes, fdo.dataToWrite->data(), fdo.toFileName);
             te = core::Now();
             timeWrite += te - ts;
             nWriteBytesSucc += n;
@@ -338,7 +343,7 @@ void FileDrainerSingleThread::DrainThread()
         std::cout << "Drain " << m_Rank << ": Runtime  total = " << timeTotal.count()
                   << " read = " << timeRead.count() << " write = " << timeWrite.count()
                   << " close = " << timeClose.count() << " sleep = " << timeSleep.count()
-                  << " seconds"
+                  << " pace = " << timePace << " seconds"
                   << ". Max queue size = " << maxQueueSize << ".";
         if (nReadBytesTasked == nReadBytesSucc)
         {
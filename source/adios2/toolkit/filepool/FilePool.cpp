@@ -22,6 +22,31 @@ void PoolableFile::Read(char *buffer, size_t size, size_t start)
     m_Entry->m_File->Read(buffer, size, start + m_BaseOffset);
 }
 
+void PoolableFile::ReadV(const adios2::Transport::ReadOp *ops, const size_t nOps)
+{
+    if (m_BaseOffset == 0)
+    {
+        m_Entry->m_File->ReadV(ops, nOps);
+        return;
+    }
+    std::vector<adios2::Transport::ReadOp> shifted(ops, ops + nOps);
+    for (auto &op : shifted)
+    {
+        op.Start += m_BaseOffset;
+    }
+    m_Entry->m_File->ReadV(shifted.data(), nOps);
+}
+
+const char *PoolableFile::DataPointer(size_t start, size_t size)
+{
+    return m_Entry->m_File->DataPointer(start + m_BaseOffset, size);
+}
+
+void PoolableFile::ReleaseDataPointer(const char *pointer)
+{
+    m_Entry->m_File->ReleaseDataPointer(pointer);
+}
+
 size_t PoolableFile::GetSize()
 {
     if (m_BaseSize != (size_t)-1)
@@ -94,6 +94,10 @@ public:
     ~PoolableFile();
     std::shared_ptr<adios2::Transport> file;
     void Read(char *buffer, size_t size, size_t start = 0);
+    void ReadV(const adios2::Transport::ReadOp *ops, const size_t nOps);
+    /** Data in place if the transport has it mapped, nullptr otherwise */
+    const char *DataPointer(size_t start, size_t size);
+    void ReleaseDataPointer(const char *pointer);
     size_t GetSize();
     void Close();
     void SetParameters(const adios2::Params &p);
@@ -196,6 +196,22 @@ void BPBase::Init(const Params &parameters, const std::string hint, const std::s
             parsedParameters.BurstBufferVerbose = static_cast<int>(
                 helper::StringTo<int32_t>(value, " in Parameter key=BurstBufferVerbose " + hint));
         }
+        else if (key == "burstbufferdrainthreads")
+        {
+            parsedParameters.BurstBufferDrainThreads =
+                static_cast<size_t>(helper::StringTo<uint32_t>(
+                    value, " in Parameter key=BurstBufferDrainThreads " + hint));
+        }
+        else if (key == "burstbuffermaxbandwidth")
+        {
+            parsedParameters.BurstBufferMaxBandwidth = helper::StringToByteUnits(
+                value, "for Parameter key=BurstBufferMaxBandwidth, in call to Open");
+        }
+        else if (key == "burstbufferlowpriority")
+        {
+            parsedParameters.BurstBufferLowPriority =
+                helper::StringTo<bool>(value, " in Parameter key=BurstBufferLowPriority " + hint);
+        }
         else if (key == "streamreader")
         {
             parsedParameters.StreamReader =
@@ -212,6 +212,12 @@ public:
         bool BurstBufferDrain = true;
         /** Verbose level for burst buffer draining thread */
         int BurstBufferVerbose = 0;
+        /** Number of concurrent copy streams of the draining */
+        size_t BurstBufferDrainThreads = 4;
+        /** Bytes per second the draining may use, 0 for no limit */
+        size_t BurstBufferMaxBandwidth = 0;
+        /** Drain only inside the application's computation blocks */
+        bool BurstBufferLowPriority = false;
 
         /** Stream reader flag: process metadata step-by-step
          * instead of parsing everything available
@@ -117,6 +117,153 @@ static FMField MetaArrayRecOperatorMM16List[] = {
                        FMOffset(BP5Base::MetaArrayRecOperator *, DataBlockSize)},
     {"MinMax", "char[32][BlockCount]", 1, FMOffset(BP5Base::MetaArrayRecOperatorMM *, MinMax)},
     {NULL, NULL, 0, 0}};
+
+#define SUBBLOCK_FIELD_ENTRIES(Type, PairType)                                                     \
+    {"SubBlockDiv", "integer[DBCount]", sizeof(uint64_t), FMOffset(Type *, SubBlockDiv)},          \
+        {"SubMinMaxCount", "integer", sizeof(uint64_t), FMOffset(Type *, SubMinMaxCount)},         \
+        {"SubMinMax", PairType, 1, FMOffset(Type *, SubMinMax)},
+
+static FMField MetaArrayRecMMSub1List[] = {
+    BASE_FIELD_ENTRIES{"MinMax", "char[2][BlockCount]", 1,
+                       FMOffset(BP5Base::MetaArrayRecMMSub *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecMMSub,
+                           "char[2][SubMinMaxCount]"){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecOperatorMMSub1List[] = {
+    BASE_FIELD_ENTRIES{"DataBlockSize", "integer[BlockCount]", sizeof(uint64_t),
+                       FMOffset(BP5Base::MetaArrayRecOperatorMMSub *, DataBlockSize)},
+    {"MinMax", "char[2][BlockCount]", 1, FMOffset(BP5Base::MetaArrayRecOperatorMMSub *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMSub,
+                           "char[2][SubMinMaxCount]"){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecMMSub2List[] = {
+    BASE_FIELD_ENTRIES{"MinMax", "char[4][BlockCount]", 1,
+                       FMOffset(BP5Base::MetaArrayRecMMSub *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecMMSub,
+                           "char[4][SubMinMaxCount]"){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecOperatorMMSub2List[] = {
+    BASE_FIELD_ENTRIES{"DataBlockSize", "integer[BlockCount]", sizeof(uint64_t),
+                       FMOffset(BP5Base::MetaArrayRecOperatorMMSub *, DataBlockSize)},
+    {"MinMax", "char[4][BlockCount]", 1, FMOffset(BP5Base::MetaArrayRecOperatorMMSub *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMSub,
+                           "char[4][SubMinMaxCount]"){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecMMSub4List[] = {
+    BASE_FIELD_ENTRIES{"MinMax", "char[8][BlockCount]", 1,
+                       FMOffset(BP5Base::MetaArrayRecMMSub *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecMMSub,
+                           "char[8][SubMinMaxCount]"){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecOperatorMMSub4List[] = {
+    BASE_FIELD_ENTRIES{"DataBlockSize", "integer[BlockCount]", sizeof(uint64_t),
+                       FMOffset(BP5Base::MetaArrayRecOperatorMMSub *, DataBlockSize)},
+    {"MinMax", "char[8][BlockCount]", 1, FMOffset(BP5Base::MetaArrayRecOperatorMMSub *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMSub,
+                           "char[8][SubMinMaxCount]"){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecMMSub8List[] = {
+    BASE_FIELD_ENTRIES{"MinMax", "char[16][BlockCount]", 1,
+                       FMOffset(BP5Base::MetaArrayRecMMSub *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecMMSub,
+                           "char[16][SubMinMaxCount]"){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecOperatorMMSub8List[] = {
+    BASE_FIELD_ENTRIES{"DataBlockSize", "integer[BlockCount]", sizeof(uint64_t),
+                       FMOffset(BP5Base::MetaArrayRecOperatorMMSub *, DataBlockSize)},
+    {"MinMax", "char[16][BlockCount]", 1, FMOffset(BP5Base::MetaArrayRecOperatorMMSub *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMSub,
+                           "char[16][SubMinMaxCount]"){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecMMSub16List[] = {
+    BASE_FIELD_ENTRIES{"MinMax", "char[32][BlockCount]", 1,
+                       FMOffset(BP5Base::MetaArrayRecMMSub *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecMMSub,
+                           "char[32][SubMinMaxCount]"){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecOperatorMMSub16List[] = {
+    BASE_FIELD_ENTRIES{"DataBlockSize", "integer[BlockCount]", sizeof(uint64_t),
+                       FMOffset(BP5Base::MetaArrayRecOperatorMMSub *, DataBlockSize)},
+    {"MinMax", "char[32][BlockCount]", 1, FMOffset(BP5Base::MetaArrayRecOperatorMMSub *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMSub,
+                           "char[32][SubMinMaxCount]"){NULL, NULL, 0, 0}};
+
+#define HISTOGRAM_FIELD_ENTRIES(Type)                                                              \
+    {"HistogramBins", "integer", sizeof(uint64_t), FMOffset(Type *, HistogramBins)},               \
+        {"HistogramCount", "integer", sizeof(uint64_t), FMOffset(Type *, HistogramCount)},         \
+        {"Histogram", "integer[HistogramCount]", sizeof(uint64_t), FMOffset(Type *, Histogram)},
+
+static FMField MetaArrayRecMMHist1List[] = {
+    BASE_FIELD_ENTRIES{"MinMax", "char[2][BlockCount]", 1,
+                       FMOffset(BP5Base::MetaArrayRecMMHist *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecMMHist, "char[2][SubMinMaxCount]")
+        HISTOGRAM_FIELD_ENTRIES(BP5Base::MetaArrayRecMMHist){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecOperatorMMHist1List[] = {
+    BASE_FIELD_ENTRIES{"DataBlockSize", "integer[BlockCount]", sizeof(uint64_t),
+                       FMOffset(BP5Base::MetaArrayRecOperatorMMHist *, DataBlockSize)},
+    {"MinMax", "char[2][BlockCount]", 1,
+     FMOffset(BP5Base::MetaArrayRecOperatorMMHist *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMHist, "char[2][SubMinMaxCount]")
+        HISTOGRAM_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMHist){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecMMHist2List[] = {
+    BASE_FIELD_ENTRIES{"MinMax", "char[4][BlockCount]", 1,
+                       FMOffset(BP5Base::MetaArrayRecMMHist *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecMMHist, "char[4][SubMinMaxCount]")
+        HISTOGRAM_FIELD_ENTRIES(BP5Base::MetaArrayRecMMHist){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecOperatorMMHist2List[] = {
+    BASE_FIELD_ENTRIES{"DataBlockSize", "integer[BlockCount]", sizeof(uint64_t),
+                       FMOffset(BP5Base::MetaArrayRecOperatorMMHist *, DataBlockSize)},
+    {"MinMax", "char[4][BlockCount]", 1,
+     FMOffset(BP5Base::MetaArrayRecOperatorMMHist *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMHist, "char[4][SubMinMaxCount]")
+        HISTOGRAM_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMHist){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecMMHist4List[] = {
+    BASE_FIELD_ENTRIES{"MinMax", "char[8][BlockCount]", 1,
+                       FMOffset(BP5Base::MetaArrayRecMMHist *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecMMHist, "char[8][SubMinMaxCount]")
+        HISTOGRAM_FIELD_ENTRIES(BP5Base::MetaArrayRecMMHist){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecOperatorMMHist4List[] = {
+    BASE_FIELD_ENTRIES{"DataBlockSize", "integer[BlockCount]", sizeof(uint64_t),
+                       FMOffset(BP5Base::MetaArrayRecOperatorMMHist *, DataBlockSize)},
+    {"MinMax", "char[8][BlockCount]", 1,
+     FMOffset(BP5Base::MetaArrayRecOperatorMMHist *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMHist, "char[8][SubMinMaxCount]")
+        HISTOGRAM_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMHist){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecMMHist8List[] = {
+    BASE_FIELD_ENTRIES{"MinMax", "char[16][BlockCount]", 1,
+                       FMOffset(BP5Base::MetaArrayRecMMHist *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecMMHist, "char[16][SubMinMaxCount]")
+        HISTOGRAM_FIELD_ENTRIES(BP5Base::MetaArrayRecMMHist){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecOperatorMMHist8List[] = {
+    BASE_FIELD_ENTRIES{"DataBlockSize", "integer[BlockCount]", sizeof(uint64_t),
+                       FMOffset(BP5Base::MetaArrayRecOperatorMMHist *, DataBlockSize)},
+    {"MinMax", "char[16][BlockCount]", 1,
+     FMOffset(BP5Base::MetaArrayRecOperatorMMHist *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMHist, "char[16][SubMinMaxCount]")
+        HISTOGRAM_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMHist){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecMMHist16List[] = {
+    BASE_FIELD_ENTRIES{"MinMax", "char[32][BlockCount]", 1,
+                       FMOffset(BP5Base::MetaArrayRecMMHist *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecMMHist, "char[32][SubMinMaxCount]")
+        HISTOGRAM_FIELD_ENTRIES(BP5Base::MetaArrayRecMMHist){NULL, NULL, 0, 0}};
+
+static FMField MetaArrayRecOperatorMMHist16List[] = {
+    BASE_FIELD_ENTRIES{"DataBlockSize", "integer[BlockCount]", sizeof(uint64_t),
+                       FMOffset(BP5Base::MetaArrayRecOperatorMMHist *, DataBlockSize)},
+    {"MinMax", "char[32][BlockCount]", 1,
+     FMOffset(BP5Base::MetaArrayRecOperatorMMHist *, MinMax)},
+    SUBBLOCK_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMHist, "char[32][SubMinMaxCount]")
+        HISTOGRAM_FIELD_ENTRIES(BP5Base::MetaArrayRecOperatorMMHist){NULL, NULL, 0, 0}};
+#undef HISTOGRAM_FIELD_ENTRIES
+#undef SUBBLOCK_FIELD_ENTRIES
 #undef BASE_FIELD_ENTRIES
 
 BP5Base::BP5Base()
@@ -133,6 +280,26 @@ BP5Base::BP5Base()
     MetaArrayRecOperatorMM8ListPtr = &MetaArrayRecOperatorMM8List[0];
     MetaArrayRecMM16ListPtr = &MetaArrayRecMM16List[0];
     MetaArrayRecOperatorMM16ListPtr = &MetaArrayRecOperatorMM16List[0];
+    MetaArrayRecMMSub1ListPtr = &MetaArrayRecMMSub1List[0];
+    MetaArrayRecOperatorMMSub1ListPtr = &MetaArrayRecOperatorMMSub1List[0];
+    MetaArrayRecMMSub2ListPtr = &MetaArrayRecMMSub2List[0];
+    MetaArrayRecOperatorMMSub2ListPtr = &MetaArrayRecOperatorMMSub2List[0];
+    MetaArrayRecMMSub4ListPtr = &MetaArrayRecMMSub4List[0];
+    MetaArrayRecOperatorMMSub4ListPtr = &MetaArrayRecOperatorMMSub4List[0];
+    MetaArrayRecMMSub8ListPtr = &MetaArrayRecMMSub8List[0];
+    MetaArrayRecOperatorMMSub8ListPtr = &MetaArrayRecOperatorMMSub8List[0];
+    MetaArrayRecMMSub16ListPtr = &MetaArrayRecMMSub16List[0];
+    MetaArrayRecOperatorMMSub16ListPtr = &MetaArrayRecOperatorMMSub16List[0];
+    MetaArrayRecMMHist1ListPtr = &MetaArrayRecMMHist1List[0];
+    MetaArrayRecOperatorMMHist1ListPtr = &MetaArrayRecOperatorMMHist1List[0];
+    MetaArrayRecMMHist2ListPtr = &MetaArrayRecMMHist2List[0];
+    MetaArrayRecOperatorMMHist2ListPtr = &MetaArrayRecOperatorMMHist2List[0];
+    MetaArrayRecMMHist4ListPtr = &MetaArrayRecMMHist4List[0];
+    MetaArrayRecOperatorMMHist4ListPtr = &MetaArrayRecOperatorMMHist4List[0];
+    MetaArrayRecMMHist8ListPtr = &MetaArrayRecMMHist8List[0];
+    MetaArrayRecOperatorMMHist8ListPtr = &MetaArrayRecOperatorMMHist8List[0];
+    MetaArrayRecMMHist16ListPtr = &MetaArrayRecMMHist16List[0];
+    MetaArrayRecOperatorMMHist16ListPtr = &MetaArrayRecOperatorMMHist16List[0];
 }
 }
 }
@@ -103,6 +103,56 @@ public:
         char *MinMax;            // char[TYPESIZE][BlockCount]  varies by type
     } MetaArrayRecOperatorMM;
 
+    /* MM records with per-subblock min/max (StatsBlockSize), the leading fields
+     * are those of the MM records so that MinMax stays where readers expect it */
+#define SUBBLOCK_FIELDS                                                                            \
+    uint64_t *SubBlockDiv;   /* Per-block divisions of Count [DBCount], all 1 if not divided */    \
+    uint64_t SubMinMaxCount; /* Total sub-blocks of the divided blocks */                         \
+    char *SubMinMax;         /* char[TYPESIZE][SubMinMaxCount]  varies by type */
+
+    typedef struct _MetaArrayRecMMSub
+    {
+        BASE_FIELDS
+        char *MinMax; // char[TYPESIZE][BlockCount]  varies by type
+        SUBBLOCK_FIELDS
+    } MetaArrayRecMMSub;
+
+    typedef struct _MetaArrayRecOperatorMMSub
+    {
+        BASE_FIELDS
+        uint64_t *DataBlockSize; // Per-block Lengths [BlockCount]
+        char *MinMax;            // char[TYPESIZE][BlockCount]  varies by type
+        SUBBLOCK_FIELDS
+    } MetaArrayRecOperatorMMSub;
+
+    /* records with per-block histograms (StatsLevel 2), which also carry the
+     * sub-block fields, left empty without StatsBlockSize; a block without a
+     * histogram (device memory) has HistogramMissing as its first count */
+#define HISTOGRAM_FIELDS                                                                           \
+    uint64_t HistogramBins;  /* Bins per block, equal-width over the block's [min, max] */        \
+    uint64_t HistogramCount; /* HistogramBins * BlockCount */                                     \
+    uint64_t *Histogram;     /* Per-block value counts [HistogramCount] */
+
+    typedef struct _MetaArrayRecMMHist
+    {
+        BASE_FIELDS
+        char *MinMax; // char[TYPESIZE][BlockCount]  varies by type
+        SUBBLOCK_FIELDS
+        HISTOGRAM_FIELDS
+    } MetaArrayRecMMHist;
+
+    typedef struct _MetaArrayRecOperatorMMHist
+    {
+        BASE_FIELDS
+        uint64_t *DataBlockSize; // Per-block Lengths [BlockCount]
+        char *MinMax;            // char[TYPESIZE][BlockCount]  varies by type
+        SUBBLOCK_FIELDS
+        HISTOGRAM_FIELDS
+    } MetaArrayRecOperatorMMHist;
+
+#undef HISTOGRAM_FIELDS
+#undef SUBBLOCK_FIELDS
+
 #undef BASE_FIELDS
 
     struct BP5MetadataInfoStruct
@@ -196,6 +246,86 @@ public:
     FMField *MetaArrayRecOperatorMM8ListPtr;
     FMField *MetaArrayRecMM16ListPtr;
     FMField *MetaArrayRecOperatorMM16ListPtr;
+    FMField *MetaArrayRecMMSub1ListPtr;
+    FMField *MetaArrayRecOperatorMMSub1ListPtr;
+    FMField *MetaArrayRecMMSub2ListPtr;
+    FMField *MetaArrayRecOperatorMMSub2ListPtr;
+    FMField *MetaArrayRecMMSub4ListPtr;
+    FMField *MetaArrayRecOperatorMMSub4ListPtr;
+    FMField *MetaArrayRecMMSub8ListPtr;
+    FMField *MetaArrayRecOperatorMMSub8ListPtr;
+    FMField *MetaArrayRecMMSub16ListPtr;
+    FMField *MetaArrayRecOperatorMMSub16ListPtr;
+    FMField *MetaArrayRecMMHist1ListPtr;
+    FMField *MetaArrayRecOperatorMMHist1ListPtr;
+    FMField *MetaArrayRecMMHist2ListPtr;
+    FMField *MetaArrayRecOperatorMMHist2ListPtr;
+    FMField *MetaArrayRecMMHist4ListPtr;
+    FMField *MetaArrayRecOperatorMMHist4ListPtr;
+    FMField *MetaArrayRecMMHist8ListPtr;
+    FMField *MetaArrayRecOperatorMMHist8ListPtr;
+    FMField *MetaArrayRecMMHist16ListPtr;
+    FMField *MetaArrayRecOperatorMMHist16ListPtr;
+
+    /* first count of a block histogram that could not be computed */
+    static constexpr uint64_t HistogramMissing = ~0ULL;
+
+    /*
+     * A DataBlockLocation with the top bit set is not an offset in the data
+     * of its own step. With DeduplicateBlocks, it refers to the data of the
+     * same writer in an earlier step: the next bits hold that absolute step
+     * and the low bits the offset within its data. With DirectWriteMinSize,
+     * the second bit is set as well, the step bits hold the step that wrote
+     * the block and the low bits its offset in the writer's subfile of that
+     * step, which a later step may refer to with DeduplicateBlocks.
+     */
+    static constexpr uint64_t DedupLocationFlag = 1ULL << 63;
+    static constexpr uint64_t FileLocationFlag = 1ULL << 62;
+    static constexpr int DedupStepShift = 40;
+    static constexpr uint64_t DedupOffsetMask = (1ULL << DedupStepShift) - 1;
+    static constexpr uint64_t DedupMaxStep = (1ULL << (62 - DedupStepShift)) - 1;
+
+    static bool IsDedupLocation(const uint64_t Location)
+    {
+        return (Location != static_cast<uint64_t>(-1)) && (Location & DedupLocationFlag);
+    }
+    static bool IsFileLocation(const uint64_t Location)
+    {
+        return IsDedupLocation(Location) && (Location & FileLocationFlag);
+    }
+    /* false if Step or Offset do not fit */
+    static bool EncodeDedupLocation(const size_t Step, const uint64_t Offset, uint64_t &Location)
+    {
+        if ((Step > DedupMaxStep) || (Offset >= DedupOffsetMask))
+            return false;
+        Location = DedupLocationFlag | (static_cast<uint64_t>(Step) << DedupStepShift) | Offset;
+        return true;
+    }
+    /* false if Step or Offset do not fit */
+    static bool EncodeFileLocation(const size_t Step, const uint64_t Offset, uint64_t &Location)
+    {
+        if ((Step > DedupMaxStep) || (Offset >= DedupOffsetMask))
+            return false;
+        Location = DedupLocationFlag | FileLocationFlag |
+                   (static_cast<uint64_t>(Step) << DedupStepShift) | Offset;
+        return true;
+    }
+    /* Location becomes the offset in the subfile of the step that wrote it */
+    static void ResolveFileLocation(uint64_t &Location, size_t &Step)
+    {
+        Step = static_cast<size_t>((Location & ~(DedupLocationFlag | FileLocationFlag)) >>
+                                   DedupStepShift);
+        Location &= DedupOffsetMask;
+    }
+    /* Step and Location are updated if Location refers to an earlier step */
+    static void ResolveDataBlockLocation(uint64_t &Location, size_t &Step)
+    {
+        if (IsDedupLocation(Location) && !IsFileLocation(Location))
+        {
+            Step = static_cast<size_t>((Location & ~DedupLocationFlag) >> DedupStepShift);
+            Location &= DedupOffsetMask;
+        }
+    }
 };
 } // end namespace format
 } // end namespace adios2
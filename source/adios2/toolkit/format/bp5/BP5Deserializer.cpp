@@ -34,6 +34,7 @@
 #include "adios2/operator/plugin/PluginOperator.h"
 
 #include <array>
+#include <cmath>
 #include <float.h>
 #include <limits.h>
 #include <math.h>
@@ -181,7 +182,8 @@ const char *BP5Deserializer::BreakdownVarName(const char *Name, DataType *type_p
     return p;
 }
 
-void BP5Deserializer::BreakdownFieldType(const char *FieldType, bool &Operator, bool &MinMax)
+void BP5Deserializer::BreakdownFieldType(const char *FieldType, bool &Operator, bool &MinMax,
+                                         bool &SubBlockStats, bool &Histogram)
 {
     if (FieldType[0] != 'M')
     {
@@ -200,6 +202,10 @@ void BP5Deserializer::BreakdownFieldType(const char *FieldType, bool &Operator,
     if (FieldType[0] == 'M')
     {
         MinMax = true;
+        FieldType += strlen("MM");
+        SubBlockStats = (strncmp(FieldType, "SB", 2) == 0);
+        // histogram records carry the sub-block fields as well
+        Histogram = (FieldType[0] == 'H');
     }
 }
 
@@ -448,6 +454,8 @@ BP5Deserializer::ControlInfo *BP5Deserializer::BuildControl(FMFormat Format)
             int ElementSize;
             bool Operator = false;
             bool MinMax = false;
+            bool SubBlockStats = false;
+            bool Histogram = false;
             bool V1_fields = true;
             FMFormat StructFormat = NULL;
             if (FieldList[i].field_type[0] == 'M')
@@ -459,7 +467,8 @@ BP5Deserializer::ControlInfo *BP5Deserializer::BuildControl(FMFormat Format)
             }
             else
             {
-                BreakdownFieldType(FieldList[i].field_type, Operator, MinMax);
+                BreakdownFieldType(FieldList[i].field_type, Operator, MinMax, SubBlockStats,
+                                   Histogram);
                 BreakdownArrayName(FieldList[i].field_name + HeaderSkip, &ArrayName, &Type,
                                    &ElementSize, &StructFormat);
             }
@@ -521,6 +530,29 @@ BP5Deserializer::ControlInfo *BP5Deserializer::BuildControl(FMFormat Format)
                                                 : offsetof(MetaArrayRecMM, MinMax);
                 MetaRecFields++;
             }
+            if (Histogram)
+            {
+                VarRec->SubBlockDivOffset =
+                    Operator ? offsetof(MetaArrayRecOperatorMMHist, SubBlockDiv)
+                             : offsetof(MetaArrayRecMMHist, SubBlockDiv);
+                VarRec->SubMinMaxOffset = Operator
+                                              ? offsetof(MetaArrayRecOperatorMMHist, SubMinMax)
+                                              : offsetof(MetaArrayRecMMHist, SubMinMax);
+                VarRec->HistogramBinsOffset =
+                    Operator ? offsetof(MetaArrayRecOperatorMMHist, HistogramBins)
+                             : offsetof(MetaArrayRecMMHist, HistogramBins);
+                VarRec->HistogramOffset = Operator
+                                              ? offsetof(MetaArrayRecOperatorMMHist, Histogram)
+                                              : offsetof(MetaArrayRecMMHist, Histogram);
+            }
+            else if (SubBlockStats)
+            {
+                VarRec->SubBlockDivOffset = Operator
+                                                ? offsetof(MetaArrayRecOperatorMMSub, SubBlockDiv)
+                                                : offsetof(MetaArrayRecMMSub, SubBlockDiv);
+                VarRec->SubMinMaxOffset = Operator ? offsetof(MetaArrayRecOperatorMMSub, SubMinMax)
+                                                   : offsetof(MetaArrayRecMMSub, SubMinMax);
+            }
             if (V1_fields)
             {
                 i += (int)MetaRecFields;
@@ -761,6 +793,8 @@ void BP5Deserializer::SetupForStep(size_t Step, size_t WriterCount)
     else
     {
         m_DefaultGetContext.Clear();
+        // earlier steps are gone for good in streaming mode
+        DropDecompressedBlocksBefore(Step);
 
         for (auto RecPair : VarByKey)
         {
@@ -811,6 +845,167 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen, size
     InstallMetadataBuffer(BaseData, WriterRank, Step, FFSformat);
 }
 
+void BP5Deserializer::IndexSteps(const size_t StepCount)
+{
+    m_StepsIndexed = true;
+    // steps are installed in any order later, while reads of other steps may
+    // be in flight, so the per step arrays must not move any more
+    m_ControlArray.resize(StepCount);
+    MetadataBaseArray.resize(StepCount, nullptr);
+    JoinedDimArray.resize(StepCount);
+}
+
+const BP5Deserializer::PresenceLayout &
+BP5Deserializer::GetPresenceLayout(const char *MetadataBlock, size_t BlockLen,
+                                   FFSTypeHandle FFSformat)
+{
+    auto it = m_PresenceLayouts.find(FFSformat);
+    if (it != m_PresenceLayouts.end())
+    {
+        return it->second;
+    }
+    static const PresenceLayout Decode;
+    if (m_SourceIsLittleEndian != m_ReaderIsLittleEndian)
+    {
+        return m_PresenceLayouts.emplace(FFSformat, Decode).first->second;
+    }
+    // Decode the first block of the format and look for its bitfield in the
+    // encoded block.  The base record follows the 8 aligned FFS header, and
+    // the encoded BitField is the offset of the words from the base record.
+    std::unique_ptr<void, void (*)(void *)> DecodedBuffer(
+        malloc(FFS_est_decode_length(ReaderFFSContext, (char *)MetadataBlock, BlockLen)), free);
+    FFSdecode_to_buffer(ReaderFFSContext, (char *)MetadataBlock, DecodedBuffer.get());
+    const auto *MBase = (const BP5MetadataInfoStruct *)DecodedBuffer.get();
+    if (MBase->BitFieldCount == 0)
+    {
+        // nothing to look for, try again with the next block
+        return Decode;
+    }
+    const size_t MaxHeader = 256;
+    const size_t Words = MBase->BitFieldCount * sizeof(uint64_t);
+    PresenceLayout Layout;
+    for (size_t Header = sizeof(uint64_t);
+         (Header <= MaxHeader) && (Header + sizeof(BP5MetadataInfoStruct) <= BlockLen);
+         Header += sizeof(uint64_t))
+    {
+        uint64_t Count, Offset;
+        memcpy(&Count, MetadataBlock + Header, sizeof(Count));
+        memcpy(&Offset, MetadataBlock + Header + offsetof(BP5MetadataInfoStruct, BitField),
+               sizeof(Offset));
+        if ((Count == MBase->BitFieldCount) && (Offset <= BlockLen - Header) &&
+            (Words <= BlockLen - Header - Offset) &&
+            (memcmp(MetadataBlock + Header + Offset, MBase->BitField, Words) == 0))
+        {
+            Layout.Direct = true;
+            Layout.Header = Header;
+            break;
+        }
+    }
+    return m_PresenceLayouts.emplace(FFSformat, Layout).first->second;
+}
+
+std::vector<uint64_t> BP5Deserializer::PresenceBits(void *MetadataBlock, size_t BlockLen,
+                                                    FFSTypeHandle FFSformat)
+{
+    const char *Block = (const char *)MetadataBlock;
+    const PresenceLayout &Layout = GetPresenceLayout(Block, BlockLen, FFSformat);
+    if (!Layout.Direct)
+    {
+        // the block stays encoded for its install, decode a throwaway copy
+        std::unique_ptr<void, void (*)(void *)> DecodedBuffer(
+            malloc(FFS_est_decode_length(ReaderFFSContext, (char *)MetadataBlock, BlockLen)),
+            free);
+        FFSdecode_to_buffer(ReaderFFSContext, (char *)MetadataBlock, DecodedBuffer.get());
+        const auto *MBase = (const BP5MetadataInfoStruct *)DecodedBuffer.get();
+        return std::vector<uint64_t>(MBase->BitField, MBase->BitField + MBase->BitFieldCount);
+    }
+    uint64_t Count = 0, Offset = 0;
+    const bool HeaderFits = (Layout.Header + sizeof(BP5MetadataInfoStruct) <= BlockLen);
+    if (HeaderFits)
+    {
+        memcpy(&Count, Block + Layout.Header, sizeof(Count));
+        memcpy(&Offset, Block + Layout.Header + offsetof(BP5MetadataInfoStruct, BitField),
+               sizeof(Offset));
+    }
+    const size_t Room = BlockLen - Layout.Header;
+    if (!HeaderFits ||
+        (Count && ((Offset > Room) || (Count > (Room - Offset) / sizeof(uint64_t)))))
+    {
+        helper::Throw<std::logic_error>("Toolkit", "format::BP5Deserializer", "IndexMetaData",
+                                        "Internal error or file corruption, metadata "
+                                        "block bitfield outside the block");
+    }
+    std::vector<uint64_t> Bits(Count);
+    if (Count)
+    {
+        memcpy(Bits.data(), Block + Layout.Header + Offset, Count * sizeof(uint64_t));
+    }
+    return Bits;
+}
+
+bool BP5Deserializer::IndexMetaData(void *MetadataBlock, size_t BlockLen, size_t WriterRank,
+                                    size_t Step)
+{
+    FFSTypeHandle FFSformat = BufferMetaMetaPrep(MetadataBlock);
+    std::vector<uint64_t> Bits = PresenceBits(MetadataBlock, BlockLen, FFSformat);
+    BP5MetadataInfoStruct Presence = {Bits.size(), Bits.data(), 0};
+    struct ControlInfo *Control = GetPriorControl(FMFormat_of_original(FFSformat));
+    if (!Control)
+    {
+        Control = BuildControl(FMFormat_of_original(FFSformat));
+    }
+
+    bool InstallNow = false;
+    for (int i = 0; i < Control->ControlCount; i++)
+    {
+        if (!BP5BitfieldTest(&Presence, i))
+        {
+            continue;
+        }
+        const struct ControlStruct &ControlField = Control->Controls[i];
+        BP5VarRec *VarRec = ControlField.VarRec;
+        if ((VarRec->AbsStepFromRel.size() == 0) || (VarRec->AbsStepFromRel.back() != Step))
+        {
+            VarRec->AbsStepFromRel.push_back(Step);
+        }
+        if (VarRec->FirstTSSeen == SIZE_MAX)
+        {
+            VarRec->FirstTSSeen = Step;
+        }
+        if (VarRec->Variable)
+        {
+            static_cast<VariableBase *>(VarRec->Variable)->m_AvailableStepsCount =
+                VarRec->AbsStepFromRel.size();
+        }
+        if (!VarRec->Variable || (ControlField.OrigShapeID == ShapeID::JoinedArray))
+        {
+            InstallNow = true;
+        }
+    }
+#ifdef ADIOS2_HAVE_DERIVED_VARIABLE
+    InstallReaderDerivedVariables();
+#endif
+    return InstallNow;
+}
+
+void BP5Deserializer::InstallIndexedMetaData(const void *MetadataBlock, size_t BlockLen,
+                                             size_t WriterRank, size_t Step)
+{
+    FFSTypeHandle FFSformat = BufferMetaMetaPrep((void *)MetadataBlock);
+    void *BaseData = MetadataBufferPrep((void *)MetadataBlock, BlockLen, WriterRank, FFSformat);
+    InstallMetadataBuffer(BaseData, WriterRank, Step, FFSformat);
+}
+
+size_t BP5Deserializer::AbsoluteStep(const VariableBase &Var, const size_t RelStep) const
+{
+    const BP5VarRec *VarRec = LookupVarByKey((void *)&Var);
+    if (RelStep >= VarRec->AbsStepFromRel.size())
+    {
+        return MaxSizeT;
+    }
+    return VarRec->AbsStepFromRel[RelStep];
+}
+
 FFSTypeHandle BP5Deserializer::BufferMetaMetaPrep(void *MetadataBlock)
 {
     FFSTypeHandle FFSformat = FFSTypeHandle_from_encode(ReaderFFSContext, (char *)MetadataBlock);
@@ -838,7 +1033,8 @@ void *BP5Deserializer::MetadataBufferPrep(void *MetadataBlock, const size_t Bloc
     void *BaseData;
     static std::once_flag once;
     static bool DumpMetadata = false;
-    if (FFSdecode_in_place_possible(FFSformat))
+    // shared metadata is decoded straight out of the shared block
+    if (!m_MetadataIsShared && FFSdecode_in_place_possible(FFSformat))
     {
         FFSdecode_in_place(ReaderFFSContext, (char *)MetadataBlock, &BaseData);
     }
@@ -890,7 +1086,10 @@ void BP5Deserializer::InstallMetadataBuffer(void *BaseData, size_t WriterRank, s
         }
         m_ControlArray[Step][WriterRank] = Control;
 
-        MetadataBaseArray.resize(Step + 1);
+        if (MetadataBaseArray.size() < Step + 1)
+        {
+            MetadataBaseArray.resize(Step + 1);
+        }
         if (MetadataBaseArray[Step] == nullptr)
         {
             m_MetadataBaseAddrs = new std::vector<void *>();
@@ -915,7 +1114,10 @@ void BP5Deserializer::InstallMetadataBuffer(void *BaseData, size_t WriterRank, s
 
         JDAIdx = 0;
     }
-    JoinedDimArray.resize(JDAIdx + 1);
+    if (JoinedDimArray.size() < JDAIdx + 1)
+    {
+        JoinedDimArray.resize(JDAIdx + 1);
+    }
     JoinedDimArray[JDAIdx].resize(writerCohortSize);
 
     (*m_MetadataBaseAddrs)[WriterRank] = BaseData;
@@ -958,6 +1160,7 @@ void BP5Deserializer::InstallMetadataBuffer(void *BaseData, size_t WriterRank, s
 
     // shortcut name. should be const
     uint64_t *JoinedDimenOffsetArray = JoinedDimArray[JDAIdx][WriterRank];
+    bool DefinedVariable = false;
 
     for (int i = 0; i < Control->ControlCount; i++)
     {
@@ -978,7 +1181,7 @@ void BP5Deserializer::InstallMetadataBuffer(void *BaseData, size_t WriterRank, s
                 }
                 VarRec->PerWriterMetaFieldOffset[WriterRank] = FieldOffset;
             }
-            else
+            else if (!m_StepsIndexed)
             {
                 if ((VarRec->AbsStepFromRel.size() == 0) || (VarRec->AbsStepFromRel.back() != Step))
                 {
@@ -1006,9 +1209,12 @@ void BP5Deserializer::InstallMetadataBuffer(void *BaseData, size_t WriterRank, s
                         }
                     }
                 }
-                if ((WriterRank == 0) || (VarRec->GlobalDims == NULL))
+                if (((WriterRank == 0) &&
+                     (!m_StepsIndexed || (ControlFields[i].OrigShapeID == ShapeID::JoinedArray))) ||
+                    (VarRec->GlobalDims == NULL))
                 {
-                    // use the shape from rank 0 (or first non-NULL)
+                    // use the shape from rank 0 (or first non-NULL), indexed
+                    // steps are installed out of order and keep the first one
                     VarRec->GlobalDims = meta_base->Shape;
                 }
                 if (ControlFields[i].OrigShapeID == ShapeID::JoinedArray)
@@ -1072,6 +1278,7 @@ void BP5Deserializer::InstallMetadataBuffer(void *BaseData, size_t WriterRank, s
                                       VarRec->Def, VarRec->ReaderDef);
                     static_cast<VariableBase *>(VarRec->Variable)->m_Engine = m_Engine;
                     VarByKey[VarRec->Variable] = VarRec;
+                    DefinedVariable = true;
                     VarRec->LastTSAdded = Step; // starts at 1
                     if (VarRec->Operator)
                     {
@@ -1086,7 +1293,11 @@ void BP5Deserializer::InstallMetadataBuffer(void *BaseData, size_t WriterRank, s
                     }
                 }
 
-                VarRec->DimCount = meta_base->Dims;
+                if (!m_StepsIndexed || (VarRec->DimCount == 0))
+                {
+                    // indexed steps keep the dims of the step that defined it
+                    VarRec->DimCount = meta_base->Dims;
+                }
             }
             else
             {
@@ -1113,6 +1324,7 @@ void BP5Deserializer::InstallMetadataBuffer(void *BaseData, size_t WriterRank, s
                         static_cast<VariableBase *>(VarRec->Variable)->m_Engine = m_Engine;
                     }
                     VarByKey[VarRec->Variable] = VarRec;
+                    DefinedVariable = true;
                     VarRec->LastTSAdded = Step;
                 }
             }
@@ -1126,7 +1338,7 @@ void BP5Deserializer::InstallMetadataBuffer(void *BaseData, size_t WriterRank, s
                 VarRec->LastTSAdded = 0;
                 VarRec->FirstTSSeen = 0;
             }
-            else if (m_RandomAccessMode && (VarRec->LastTSAdded != Step))
+            else if (m_RandomAccessMode && !m_StepsIndexed && (VarRec->LastTSAdded != Step))
             {
                 static_cast<VariableBase *>(VarRec->Variable)->m_AvailableStepsCount++;
                 VarRec->LastTSAdded = Step;
@@ -1168,7 +1380,11 @@ void BP5Deserializer::InstallMetadataBuffer(void *BaseData, size_t WriterRank, s
     // The file's variables for this rank are now installed; try to resolve any
     // reader-side derived variables whose inputs have become available. Cheap and
     // idempotent: the unresolved set is empty once none remain (the common case).
-    InstallReaderDerivedVariables();
+    // Indexed steps that define nothing are installed while other threads read.
+    if (!m_StepsIndexed || DefinedVariable)
+    {
+        InstallReaderDerivedVariables();
+    }
 #endif
 }
 
@@ -1216,7 +1432,7 @@ void BP5Deserializer::InstallAttributeData(void *AttributeBlock, size_t BlockLen
     // decoded buffer.  InstallAttributes{V1,V2} copy every value into the IO's
     // attributes, so the buffer can be released as soon as they return.
     std::unique_ptr<void, void (*)(void *)> DecodedBuffer(nullptr, free);
-    if (FFSdecode_in_place_possible(FFSformat))
+    if (!m_MetadataIsShared && FFSdecode_in_place_possible(FFSformat))
     {
         FFSdecode_in_place(ReaderFFSContext, (char *)AttributeBlock, &BaseData);
     }
@@ -2049,6 +2265,13 @@ BP5Deserializer::GenerateReadRequests(BP5GetContext &ctx, const bool doAllocTemp
                                                                 &writer_meta_base->Count[StartDim]);
                             }
                             RR.OffsetInBlock = 0;
+                            RR.ReqIndex = ReqIndex;
+                            RR.BlockID = NeededBlock;
+                            RR.DestinationAddr = nullptr;
+                            if (VarRec->Operator && ServeFromDecompressedBlockCache(ctx, RR))
+                            {
+                                break;
+                            }
                             if (RR.DirectToAppMemory)
                             {
                                 RR.DestinationAddr = (char *)Req->Data;
@@ -2073,8 +2296,6 @@ BP5Deserializer::GenerateReadRequests(BP5GetContext &ctx, const bool doAllocTemp
                                 *maxReadSize =
                                     (*maxReadSize < RR.ReadLength ? RR.ReadLength : *maxReadSize);
                             }
-                            RR.ReqIndex = ReqIndex;
-                            RR.BlockID = NeededBlock;
                             Ret.push_back(RR);
                             break;
                         }
@@ -2370,16 +2591,20 @@ BP5Deserializer::GenerateReadRequests(BP5GetContext &ctx, const bool doAllocTemp
                                     if (RR.StartOffset == static_cast<uint64_t>(-1))
                                         throw std::runtime_error(
                                             "No data exists for this variable");
+                                    RR.DirectToAppMemory = false;
+                                    RR.ReqIndex = ReqIndex;
+                                    RR.BlockID = Block;
+                                    RR.OffsetInBlock = 0;
+                                    if (ServeFromDecompressedBlockCache(ctx, RR))
+                                    {
+                                        continue;
+                                    }
                                     if (doAllocTempBuffers)
                                     {
                                         RR.DestinationAddr = (char *)malloc(RR.ReadLength);
                                     }
                                     *maxReadSize = (*maxReadSize < RR.ReadLength ? RR.ReadLength
                                                                                  : *maxReadSize);
-                                    RR.DirectToAppMemory = false;
-                                    RR.ReqIndex = ReqIndex;
-                                    RR.BlockID = Block;
-                                    RR.OffsetInBlock = 0;
                                     Ret.push_back(RR);
                                 }
                                 else
@@ -2489,7 +2714,183 @@ BP5Deserializer::GenerateReadRequests(BP5GetContext &ctx, const bool doAllocTemp
     return Ret;
 }
 
+std::shared_ptr<Operator> BP5Deserializer::AcquireOperator(BP5VarRec *VarRec,
+                                                           const std::shared_ptr<Operator> &primary)
+{
+    // caller holds mutexDecompress
+    if (!VarRec->IdleOperators.empty())
+    {
+        std::shared_ptr<Operator> op = VarRec->IdleOperators.back();
+        VarRec->IdleOperators.pop_back();
+        return op;
+    }
+    if (!VarRec->OperatorPoolSeeded)
+    {
+        // the variable's own operator is the first pool member
+        VarRec->OperatorPoolSeeded = true;
+        return primary;
+    }
+    // another thread holds every existing instance, clone one for this thread
+    std::shared_ptr<Operator> op = MakeOperator(primary->m_TypeString, primary->GetParameters());
+    if (primary->m_TypeEnum == Operator::PLUGIN_INTERFACE)
+    {
+        auto pop = dynamic_cast<plugin::PluginOperator *>(op.get());
+        pop->m_OperatorNameQuery =
+            dynamic_cast<plugin::PluginOperator *>(primary.get())->m_OperatorNameQuery;
+    }
+    return op;
+}
+
+void BP5Deserializer::ReleaseOperator(BP5VarRec *VarRec, std::shared_ptr<Operator> op)
+{
+    std::lock_guard<std::mutex> lockGuard(mutexDecompress);
+    VarRec->IdleOperators.push_back(std::move(op));
+}
+
+void BP5Deserializer::SetDecompressedBlockCacheSize(const size_t bytes)
+{
+    std::lock_guard<std::mutex> lockGuard(mutexDecompressedBlocks);
+    m_DecompressedBlockCacheSize = bytes;
+    EvictDecompressedBlocks(bytes);
+}
+
+std::map<std::string, size_t> BP5Deserializer::ProfileCounts()
+{
+    std::lock_guard<std::mutex> lockGuard(mutexDecompressedBlocks);
+    return {{"blockcachehits", m_DecompressedBlockCacheHits},
+            {"blockcacheevictions", m_DecompressedBlockCacheEvictions},
+            {"subsetdecompressions", m_SubsetDecompressions.load()},
+            {"blockdecompressions", m_BlockDecompressions.load()}};
+}
+
+BP5Deserializer::DecompressedBlockKey
+BP5Deserializer::MakeDecompressedBlockKey(const BP5VarRec *VarRec, const size_t Step,
+                                          const size_t WriterRank, const size_t BlockID,
+                                          const Accuracy &accuracy) const
+{
+    return DecompressedBlockKey(VarRec->VarNum, Step, WriterRank, BlockID, accuracy.error,
+                                accuracy.norm, accuracy.relative);
+}
+
+std::shared_ptr<const BP5Deserializer::DecompressedBlock>
+BP5Deserializer::LookupDecompressedBlock(const DecompressedBlockKey &key)
+{
+    std::lock_guard<std::mutex> lockGuard(mutexDecompressedBlocks);
+    auto it = m_DecompressedBlocks.find(key);
+    if (it == m_DecompressedBlocks.end())
+    {
+        return nullptr;
+    }
+    m_DecompressedBlockLRU.splice(m_DecompressedBlockLRU.begin(), m_DecompressedBlockLRU,
+                                  it->second.LRUPos);
+    ++m_DecompressedBlockCacheHits;
+    return it->second.Block;
+}
+
+void BP5Deserializer::InsertDecompressedBlock(const DecompressedBlockKey &key,
+                                              std::shared_ptr<const DecompressedBlock> block)
+{
+    std::lock_guard<std::mutex> lockGuard(mutexDecompressedBlocks);
+    const size_t size = block->Data.size();
+    if (size > m_DecompressedBlockCacheSize ||
+        m_DecompressedBlocks.find(key) != m_DecompressedBlocks.end())
+    {
+        return;
+    }
+    EvictDecompressedBlocks(m_DecompressedBlockCacheSize - size);
+    m_DecompressedBlockLRU.push_front(key);
+    m_DecompressedBlocks[key] = {std::move(block), m_DecompressedBlockLRU.begin()};
+    m_DecompressedBlockCacheBytes += size;
+}
+
+// caller holds mutexDecompressedBlocks
+void BP5Deserializer::EvictDecompressedBlocks(const size_t limit)
+{
+    while (m_DecompressedBlockCacheBytes > limit && !m_DecompressedBlockLRU.empty())
+    {
+        auto it = m_DecompressedBlocks.find(m_DecompressedBlockLRU.back());
+        m_DecompressedBlockCacheBytes -= it->second.Block->Data.size();
+        m_DecompressedBlocks.erase(it);
+        m_DecompressedBlockLRU.pop_back();
+        ++m_DecompressedBlockCacheEvictions;
+    }
+}
+
+void BP5Deserializer::DropDecompressedBlocksBefore(const size_t Step)
+{
+    std::lock_guard<std::mutex> lockGuard(mutexDecompressedBlocks);
+    for (auto it = m_DecompressedBlocks.begin(); it != m_DecompressedBlocks.end();)
+    {
+        if (std::get<1>(it->first) < Step)
+        {
+            m_DecompressedBlockCacheBytes -= it->second.Block->Data.size();
+            m_DecompressedBlockLRU.erase(it->second.LRUPos);
+            it = m_DecompressedBlocks.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+bool BP5Deserializer::ServeFromDecompressedBlockCache(BP5GetContext &ctx, const ReadRequest &RR)
+{
+    if (!m_DecompressedBlockCacheSize)
+    {
+        return false;
+    }
+    const auto &Req = ctx.PendingGetRequests[RR.ReqIndex];
+    auto cached = LookupDecompressedBlock(MakeDecompressedBlockKey(
+        (BP5VarRec *)Req.VarRec, RR.Timestep, RR.WriterRank, RR.BlockID, Req.AccuracyRequested));
+    if (!cached)
+    {
+        return false;
+    }
+    FinalizeGet(ctx, RR, false, std::move(cached));
+    return true;
+}
+
+bool BP5Deserializer::OperatorSubsetBox(const BP5ArrayRequest &Req, const size_t DimCount,
+                                        const size_t *RankOffset, const size_t *RankSize,
+                                        Dims &Start, Dims &Count) const
+{
+    // operators see the block in the writer's row-major order
+    if (!m_ReaderIsRowMajor || (DimCount == 0) || (Req.Count.size() != DimCount) ||
+        (Req.Start.size() != DimCount))
+    {
+        return false;
+    }
+    if ((Req.RequestType == Global) && (RankOffset == NULL))
+    {
+        return false;
+    }
+    Start.resize(DimCount);
+    Count.resize(DimCount);
+    bool whole = true;
+    for (size_t d = 0; d < DimCount; d++)
+    {
+        const size_t blockStart = (Req.RequestType == Global) ? RankOffset[d] : 0;
+        const size_t begin = std::max(Req.Start[d], blockStart);
+        const size_t end = std::min(Req.Start[d] + Req.Count[d], blockStart + RankSize[d]);
+        if (end <= begin)
+        {
+            return false;
+        }
+        Start[d] = begin - blockStart;
+        Count[d] = end - begin;
+        whole = whole && (Count[d] == RankSize[d]);
+    }
+    return !whole;
+}
+
 void BP5Deserializer::FinalizeGet(BP5GetContext &ctx, const ReadRequest &Read, const bool freeAddr)
+{
+    FinalizeGet(ctx, Read, freeAddr, nullptr);
+}
+
+void BP5Deserializer::FinalizeGet(BP5GetContext &ctx, const ReadRequest &Read, const bool freeAddr,
+                                  std::shared_ptr<const DecompressedBlock> cached)
 {
     auto &Req = ctx.PendingGetRequests[Read.ReqIndex];
     auto VarRec = (struct BP5VarRec *)Req.VarRec;
@@ -2527,7 +2928,30 @@ void BP5Deserializer::FinalizeGet(BP5GetContext &ctx, const ReadRequest &Read, c
     char *IncomingData = Read.DestinationAddr;
     char *VirtualIncomingData = Read.DestinationAddr - Read.OffsetInBlock;
     std::vector<char> decompressBuffer;
-    if (((struct BP5VarRec *)Req.VarRec)->Operator != NULL)
+    // set if only the part of an operated block the request needs was decompressed
+    bool useSubset = false;
+    Dims SubsetStart, SubsetCount;
+    if ((((struct BP5VarRec *)Req.VarRec)->Operator != NULL) && m_DecompressedBlockCacheSize)
+    {
+        const auto key = MakeDecompressedBlockKey(VarRec, Read.Timestep, Read.WriterRank,
+                                                  Read.BlockID, Req.AccuracyRequested);
+        if (!cached)
+        {
+            // another thread may have decompressed this block meanwhile
+            cached = LookupDecompressedBlock(key);
+        }
+        if (cached)
+        {
+            VariableBase *VB = static_cast<VariableBase *>(VarRec->Variable);
+            {
+                std::lock_guard<std::mutex> lockGuard(mutexDecompress);
+                VB->m_AccuracyProvided = cached->AccuracyProvided;
+            }
+            IncomingData = const_cast<char *>(cached->Data.data());
+            VirtualIncomingData = IncomingData;
+        }
+    }
+    if ((((struct BP5VarRec *)Req.VarRec)->Operator != NULL) && !cached)
     {
         try
         {
@@ -2536,7 +2960,11 @@ void BP5Deserializer::FinalizeGet(BP5GetContext &ctx, const ReadRequest &Read, c
             {
                 DestSize *= writer_meta_base->Count[dim + Read.BlockID * writer_meta_base->Dims];
             }
-            decompressBuffer.resize(DestSize);
+            // a whole block that goes into the cache is worth more than a piece
+            useSubset = (!m_DecompressedBlockCacheSize ||
+                         (DestSize > m_DecompressedBlockCacheSize)) &&
+                        OperatorSubsetBox(Req, DimCount, RankOffset, RankSize, SubsetStart,
+                                          SubsetCount);
 
             // Get the operator of the variable if exists or create one
             std::shared_ptr<Operator> op = nullptr;
@@ -2544,23 +2972,26 @@ void BP5Deserializer::FinalizeGet(BP5GetContext &ctx, const ReadRequest &Read, c
                 static_cast<VariableBase *>(((struct BP5VarRec *)Req.VarRec)->Variable);
             {
                 std::lock_guard<std::mutex> lockGuard(mutexDecompress);
-                // lock_guard protects mods to VB->m_Operations as well as the decompress operator
+                // lock_guard protects mods to VB->m_Operations and the operator pool
+                std::shared_ptr<Operator> primary = nullptr;
                 if (!VB->m_Operations.empty() && (VB->m_Operations[0]->m_TypeString != "null"))
                 {
-                    op = VB->m_Operations[0];
+                    primary = VB->m_Operations[0];
                 }
                 else
                 {
                     Operator::OperatorType compressorType =
                         static_cast<Operator::OperatorType>(IncomingData[0]);
-                    op = MakeOperator(OperatorTypeToString(compressorType), {});
+                    primary = MakeOperator(OperatorTypeToString(compressorType), {});
                     VB->m_Operations.clear();
-                    VB->m_Operations.push_back(op);
+                    VB->m_Operations.push_back(primary);
+                    VarRec->IdleOperators.clear();
+                    VarRec->OperatorPoolSeeded = false;
                     if (m_Engine->m_OperatorNameQuery)
                     {
                         if (compressorType == Operator::PLUGIN_INTERFACE)
                         {
-                            auto pop = dynamic_cast<plugin::PluginOperator *>(op.get());
+                            auto pop = dynamic_cast<plugin::PluginOperator *>(primary.get());
                             pop->m_OperatorNameQuery = true;
                         }
                         else
@@ -2574,14 +3005,65 @@ void BP5Deserializer::FinalizeGet(BP5GetContext &ctx, const ReadRequest &Read, c
                         }
                     }
                 }
+                op = AcquireOperator(VarRec, primary);
+            }
+            try
+            {
                 op->SetAccuracy(Req.AccuracyRequested);
-                core::Decompress(
-                    IncomingData,
-                    ((MetaArrayRecOperator *)writer_meta_base)->DataBlockSize[Read.BlockID],
-                    decompressBuffer.data(), Req.MemSpace, op, m_Engine, VB);
-                VB->m_AccuracyProvided = op->GetAccuracy();
+                const size_t compressedSize =
+                    ((MetaArrayRecOperator *)writer_meta_base)->DataBlockSize[Read.BlockID];
+                std::unique_lock<std::mutex> serialLock(mutexSerialDecompress, std::defer_lock);
+                if (!op->IsThreadSafe())
+                {
+                    serialLock.lock();
+                }
+                if (useSubset)
+                {
+                    decompressBuffer.resize(helper::GetTotalSize(SubsetCount, ElementSize));
+                    useSubset = core::DecompressSubset(IncomingData, compressedSize,
+                                                       Dims(RankSize, RankSize + DimCount),
+                                                       SubsetStart, SubsetCount,
+                                                       decompressBuffer.data(), op, m_Engine,
+                                                       VB) != 0;
+                    if (useSubset)
+                    {
+                        ++m_SubsetDecompressions;
+                    }
+                }
+                if (!useSubset)
+                {
+                    decompressBuffer.resize(DestSize);
+                    core::Decompress(IncomingData, compressedSize, decompressBuffer.data(),
+                                     Req.MemSpace, op, m_Engine, VB);
+                    ++m_BlockDecompressions;
+                }
+            }
+            catch (...)
+            {
+                ReleaseOperator(VarRec, op);
+                throw;
             }
+            Accuracy provided;
+            {
+                std::lock_guard<std::mutex> lockGuard(mutexDecompress);
+                provided = op->GetAccuracy();
+                VB->m_AccuracyProvided = provided;
+            }
+            ReleaseOperator(VarRec, op);
             IncomingData = decompressBuffer.data();
+            if (m_DecompressedBlockCacheSize && !useSubset &&
+                (decompressBuffer.size() <= m_DecompressedBlockCacheSize))
+            {
+                auto block = std::make_shared<DecompressedBlock>();
+                block->Data = std::move(decompressBuffer);
+                block->AccuracyProvided = provided;
+                IncomingData = block->Data.data();
+                cached = block;
+                InsertDecompressedBlock(MakeDecompressedBlockKey(VarRec, Read.Timestep,
+                                                                 Read.WriterRank, Read.BlockID,
+                                                                 Req.AccuracyRequested),
+                                        std::move(block));
+            }
             VirtualIncomingData = IncomingData;
         }
         catch (...)
@@ -2623,6 +3105,18 @@ void BP5Deserializer::FinalizeGet(BP5GetContext &ctx, const ReadRequest &Read, c
             GlobalDimensions[i] = RankSize[i];
         }
     }
+    std::vector<size_t> SubsetOffset;
+    if (useSubset)
+    {
+        // the incoming data now holds just the subset box of the block
+        SubsetOffset.resize(DimCount);
+        for (size_t d = 0; d < DimCount; d++)
+        {
+            SubsetOffset[d] = RankOffset[d] + SubsetStart[d];
+        }
+        RankOffset = SubsetOffset.data();
+        RankSize = SubsetCount.data();
+    }
 
     DimsArray inStart(DimCount, RankOffset);
     DimsArray inCount(DimCount, RankSize);
@@ -3157,6 +3651,7 @@ MinVarInfo *BP5Deserializer::MinBlocksInfo(const VariableBase &Var, size_t RelSt
             {
                 MMs = *(MinMaxStruct **)(((char *)writer_meta_base) + VarRec->MinMaxOffset);
             }
+            size_t SubPairOffset = 0;
             for (size_t i = 0; i < WriterBlockCount; i++)
             {
                 const size_t *Offsets = BP5MVIOwnDims(
@@ -3182,6 +3677,8 @@ MinVarInfo *BP5Deserializer::MinBlocksInfo(const VariableBase &Var, size_t RelSt
                     ApplyElementMinMax(Blk.MinMax, VarRec->Type, (void *)BlockMinAddr);
                     ApplyElementMinMax(Blk.MinMax, VarRec->Type, (void *)BlockMaxAddr);
                 }
+                ApplySubBlockStats(MV, VarRec, writer_meta_base, i, SubPairOffset, Blk);
+                ApplyHistogram(VarRec, writer_meta_base, i, Blk);
                 // Blk.BufferP
                 MV->BlocksInfo.push_back(Blk);
             }
@@ -3279,12 +3776,57 @@ MinVarInfo *BP5Deserializer::MinBlocksInfo(const VariableBase &Var, size_t RelSt
             ApplyElementMinMax(Blk.MinMax, VarRec->Type, (void *)BlockMinAddr);
             ApplyElementMinMax(Blk.MinMax, VarRec->Type, (void *)BlockMaxAddr);
         }
+        size_t SubPairOffset = 0;
+        for (size_t i = 0; i < BlockID; i++)
+        {
+            MinBlockInfo Earlier;
+            ApplySubBlockStats(MV, VarRec, writer_meta_base, i, SubPairOffset, Earlier);
+        }
+        ApplySubBlockStats(MV, VarRec, writer_meta_base, BlockID, SubPairOffset, Blk);
+        ApplyHistogram(VarRec, writer_meta_base, BlockID, Blk);
         // Blk.BufferP
         MV->BlocksInfo.push_back(Blk);
     }
     return MV;
 }
 
+void BP5Deserializer::ApplySubBlockStats(MinVarInfo *MV, const BP5VarRec *VarRec, void *MetaBase,
+                                         size_t Block, size_t &PairOffset, MinBlockInfo &Blk)
+{
+    // sub-blocks are numbered in the writer's dimension order
+    if ((VarRec->SubBlockDivOffset == SIZE_MAX) || MV->IsReverseDims)
+        return;
+    uint64_t *Divs = *(uint64_t **)((char *)MetaBase + VarRec->SubBlockDivOffset);
+    const char *Pairs = *(char **)((char *)MetaBase + VarRec->SubMinMaxOffset);
+    if (!Divs)
+        return;
+    const size_t NDims = static_cast<size_t>(MV->Dims);
+    size_t NSubBlocks = 1;
+    for (size_t d = 0; d < NDims; d++)
+    {
+        NSubBlocks *= static_cast<size_t>(Divs[Block * NDims + d]);
+    }
+    if (NSubBlocks <= 1)
+        return;
+    Blk.SubBlockDiv = BP5MVIOwnDims(MV, Divs + Block * NDims, NDims);
+    Blk.SubBlockCount = NSubBlocks;
+    Blk.SubMinMax = Pairs + 2 * PairOffset * VarRec->ElementSize;
+    PairOffset += NSubBlocks;
+}
+
+void BP5Deserializer::ApplyHistogram(const BP5VarRec *VarRec, void *MetaBase, size_t Block,
+                                     MinBlockInfo &Blk)
+{
+    if (VarRec->HistogramOffset == SIZE_MAX)
+        return;
+    const uint64_t Bins = *(uint64_t *)((char *)MetaBase + VarRec->HistogramBinsOffset);
+    const uint64_t *Counts = *(uint64_t **)((char *)MetaBase + VarRec->HistogramOffset);
+    if (!Counts || !Bins || (Counts[Block * Bins] == HistogramMissing))
+        return;
+    Blk.Histogram = Counts + Block * Bins;
+    Blk.HistogramBins = static_cast<size_t>(Bins);
+}
+
 static void ApplyElementMinMax(MinMaxStruct &MinMax, DataType Type, void *Element)
 {
     switch (Type)
@@ -3405,19 +3947,7 @@ void BP5Deserializer::GetAbsoluteSteps(const VariableBase &Var, std::vector<size
     if (!m_RandomAccessMode)
         return;
 
-    for (size_t Step = 0; Step < m_ControlArray.size(); Step++)
-    {
-        for (size_t WriterRank = 0; WriterRank < WriterCohortSize(Step); WriterRank++)
-        {
-            MetaArrayRec *writer_meta_base =
-                (MetaArrayRec *)GetMetadataBase(VarRec, Step, WriterRank);
-            if (writer_meta_base)
-            {
-                keys.push_back(Step);
-                break;
-            }
-        }
-    }
+    keys.insert(keys.end(), VarRec->AbsStepFromRel.begin(), VarRec->AbsStepFromRel.end());
 }
 
 bool BP5Deserializer::VarShape(const VariableBase &Var, const size_t RelStep, Dims &Shape) const
@@ -3583,6 +4113,123 @@ bool BP5Deserializer::VariableMinMax(const VariableBase &Var, const size_t Step,
     return true;
 }
 
+// add the counts of a block histogram over [BlockMin, BlockMax] to the
+// histogram Counts over [Min, Max]. This is approximate: the values in a
+// block bin are taken to be spread evenly over it, so its count is split
+// between the bins it overlaps in proportion to the overlap, rounded so that
+// the total is kept. Without a usable width a block bin goes by its center.
+template <class T>
+static void RebinHistogram(const T BlockMin, const T BlockMax, const uint64_t *BlockCounts,
+                           const size_t BlockBins, const T Min, const T Max,
+                           std::vector<uint64_t> &Counts)
+{
+    const size_t Bins = Counts.size();
+    const double Lo = static_cast<double>(BlockMin);
+    const double Width = (static_cast<double>(BlockMax) - Lo) / static_cast<double>(BlockBins);
+    const double GlobalLo = static_cast<double>(Min);
+    const double GlobalWidth =
+        (static_cast<double>(Max) - GlobalLo) / static_cast<double>(Bins);
+    const bool Split =
+        (Width > 0) && std::isfinite(Width) && (GlobalWidth > 0) && std::isfinite(GlobalWidth);
+    for (size_t b = 0; b < BlockBins; ++b)
+    {
+        const uint64_t Count = BlockCounts[b];
+        if (!Count)
+            continue;
+        const double Left = Lo + static_cast<double>(b) * Width;
+        if (!Split)
+        {
+            Counts[helper::HistogramBin(Left + 0.5 * Width, GlobalLo, static_cast<double>(Max),
+                                        Bins)] += Count;
+            continue;
+        }
+        const size_t First = helper::HistogramBin(Left, GlobalLo, static_cast<double>(Max), Bins);
+        const size_t Last =
+            helper::HistogramBin(Left + Width, GlobalLo, static_cast<double>(Max), Bins);
+        uint64_t Given = 0;
+        for (size_t j = First; j <= Last; ++j)
+        {
+            // the share of the block bin below the upper edge of bin j
+            const double Edge = GlobalLo + static_cast<double>(j + 1) * GlobalWidth;
+            const double Covered = (std::max)(0.0, (std::min)(1.0, (Edge - Left) / Width));
+            const uint64_t Upto =
+                (j == Last) ? Count
+                            : (std::min)(Count, static_cast<uint64_t>(std::llround(
+                                                    Covered * static_cast<double>(Count))));
+            if (Upto > Given)
+            {
+                Counts[j] += Upto - Given;
+                Given = Upto;
+            }
+        }
+    }
+}
+
+bool BP5Deserializer::VariableHistogram(const VariableBase &Var, const size_t Step,
+                                        MinMaxStruct &Range, std::vector<uint64_t> &Counts)
+{
+#ifdef ADIOS2_HAVE_DERIVED_VARIABLE
+    if (m_ReaderDerivedByVar.find(&Var) != m_ReaderDerivedByVar.end())
+        return false;
+#endif
+    BP5VarRec *VarRec = LookupVarByKey((void *)&Var);
+    if (!VarRec || (VarRec->HistogramOffset == SIZE_MAX))
+        return false;
+    if (!VariableMinMax(Var, Step, Range))
+        return false;
+
+    size_t StartStep = Step, StopStep = Step + 1;
+    if (Step == DefaultSizeT)
+    {
+        StartStep = 0;
+        StopStep = m_ControlArray.size();
+        if (!m_RandomAccessMode)
+            StopStep = 1;
+    }
+    Counts.clear();
+    for (size_t RelStep = StartStep; RelStep < StopStep; RelStep++)
+    {
+        const size_t writerCohortSize = WriterCohortSize(RelStep);
+        for (size_t WriterRank = 0; WriterRank < writerCohortSize; WriterRank++)
+        {
+            MetaArrayRec *writer_meta_base =
+                (MetaArrayRec *)GetMetadataBase(VarRec, RelStep, WriterRank);
+            if (!writer_meta_base)
+                continue;
+            const size_t WriterBlockCount =
+                VarRec->DimCount ? writer_meta_base->DBCount / VarRec->DimCount : 1;
+            const char *MMs = *(char **)(((char *)writer_meta_base) + VarRec->MinMaxOffset);
+            for (size_t B = 0; B < WriterBlockCount; B++)
+            {
+                MinBlockInfo Blk;
+                ApplyHistogram(VarRec, writer_meta_base, B, Blk);
+                if (!Blk.Histogram)
+                {
+                    // totals without this block would be wrong
+                    Counts.clear();
+                    return false;
+                }
+                if (Counts.empty())
+                    Counts.assign(Blk.HistogramBins, 0);
+                const char *BlockMM = MMs + 2 * B * VarRec->ElementSize;
+                if (VarRec->Type == DataType::None)
+                {
+                }
+#define declare_type(T, N)                                                                         \
+    else if (VarRec->Type == helper::GetDataType<T>())                                             \
+    {                                                                                              \
+        RebinHistogram(*(const T *)BlockMM, *(const T *)(BlockMM + VarRec->ElementSize),           \
+                       Blk.Histogram, Blk.HistogramBins, Range.MinUnion.field_##N,                 \
+                       Range.MaxUnion.field_##N, Counts);                                          \
+    }
+                ADIOS2_FOREACH_MINMAX_STDTYPE_2ARGS(declare_type)
+#undef declare_type
+            }
+        }
+    }
+    return !Counts.empty();
+}
+
 char *BP5Deserializer::VariableExprStr(const VariableBase &Var)
 {
 #ifdef ADIOS2_HAVE_DERIVED_VARIABLE
@@ -18,7 +18,12 @@
 #include "ffs.h"
 #include "fm.h"
 
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <tuple>
 
 #ifdef _WIN32
 #pragma warning(disable : 4250)
@@ -117,6 +122,37 @@ public:
     void FinalizeDerivedGets(BP5GetContext &ctx, std::vector<ReadRequest> &);
     void ClearGetState(BP5GetContext &ctx) { ctx.Clear(); }
 
+    /* Memory budget for keeping decompressed blocks of operated variables
+     * around between Gets, so that different selections of the same block
+     * decompress it only once. 0 disables the cache. */
+    void SetDecompressedBlockCacheSize(const size_t bytes);
+
+    /* Counts of events for the profile of the engine, by name */
+    std::map<std::string, size_t> ProfileCounts();
+
+    /* Metadata blocks handed to InstallMetaData/InstallAttributeData live in
+     * memory shared with other processes and must not be modified. They are
+     * decoded from there into a buffer of this process rather than in place,
+     * as the decoded pointers only hold in this address space. */
+    void SetMetadataIsShared(const bool shared) { m_MetadataIsShared = shared; }
+
+    /* Random access with steps installed on first use: after IndexSteps,
+     * IndexMetaData only reads which variables the block of a writer holds,
+     * from the encoded block without decoding it, so that the variables and
+     * their relative steps are complete before any step is installed.  The
+     * blocks are decoded and installed on first use with
+     * InstallIndexedMetaData, one step at a time in any order.
+     * IndexMetaData returns whether the step must be installed right away,
+     * because it defines a variable or adds to the offsets of a joined
+     * array, which depend on the steps before it. */
+    void IndexSteps(const size_t StepCount);
+    bool IndexMetaData(void *MetadataBlock, size_t BlockLen, size_t WriterRank, size_t Step);
+    void InstallIndexedMetaData(const void *MetadataBlock, size_t BlockLen, size_t WriterRank,
+                                size_t Step);
+    /** Absolute step of relative step RelStep of the variable, MaxSizeT if
+     * the variable has fewer steps */
+    size_t AbsoluteStep(const VariableBase &Var, const size_t RelStep) const;
+
     // Legacy non-context overloads forward via DefaultGetContext.
     bool QueueGet(core::VariableBase &variable, void *DestData, const core::Selection &selection,
                   bool dataIsRemote = false)
@@ -146,6 +182,9 @@ public:
                               const size_t BlockID);
     bool VarShape(const VariableBase &, const size_t Step, Dims &Shape) const;
     bool VariableMinMax(const VariableBase &var, const size_t Step, MinMaxStruct &MinMax);
+    /* histogram of all blocks of Step, rebinned over the global Range */
+    bool VariableHistogram(const VariableBase &var, const size_t Step, MinMaxStruct &Range,
+                           std::vector<uint64_t> &Counts);
     char *VariableExprStr(const VariableBase &var);
     void GetAbsoluteSteps(const VariableBase &variable, std::vector<size_t> &keys) const;
 
@@ -181,12 +220,20 @@ private:
         DataType Type;
         int ElementSize = 0;
         size_t MinMaxOffset = SIZE_MAX;
+        size_t SubBlockDivOffset = SIZE_MAX; // per-subblock min/max, see MetaArrayRecMMSub
+        size_t SubMinMaxOffset = SIZE_MAX;
+        size_t HistogramBinsOffset = SIZE_MAX; // per-block histograms, see MetaArrayRecMMHist
+        size_t HistogramOffset = SIZE_MAX;
         uint64_t *GlobalDims = NULL;
         size_t LastTSAdded = SIZE_MAX;
         size_t FirstTSSeen = SIZE_MAX;
         size_t LastStepAdded = SIZE_MAX;
         std::vector<size_t> AbsStepFromRel; // per relative step vector
         std::vector<size_t> PerWriterMetaFieldOffset;
+        // Decompression operator instances not currently lent to a reader
+        // thread, guarded by mutexDecompress
+        std::vector<std::shared_ptr<core::Operator>> IdleOperators;
+        bool OperatorPoolSeeded = false;
     };
 
     struct ControlStruct
@@ -227,6 +274,22 @@ private:
     const bool m_FlattenSteps;
     const bool m_SourceIsLittleEndian;
     const bool m_ReaderIsLittleEndian;
+    bool m_MetadataIsShared = false;
+    bool m_StepsIndexed = false;
+
+    // Where the presence bitfield of the encoded metadata blocks of one
+    // format sits, so that IndexMetaData can read it without decoding.
+    // Found once per format by decoding its first block.
+    struct PresenceLayout
+    {
+        bool Direct = false; // false: blocks of this format are decoded
+        size_t Header = 0;   // bytes of FFS header before the base record
+    };
+    std::unordered_map<FFSTypeHandle, PresenceLayout> m_PresenceLayouts;
+    const PresenceLayout &GetPresenceLayout(const char *MetadataBlock, size_t BlockLen,
+                                            FFSTypeHandle FFSformat);
+    std::vector<uint64_t> PresenceBits(void *MetadataBlock, size_t BlockLen,
+                                       FFSTypeHandle FFSformat);
 
     std::vector<size_t> m_WriterCohortSize; // per step, in random mode
     size_t m_CurrentWriterCohortSize;       // valid in streaming mode
@@ -285,12 +348,19 @@ private:
     BP5VarRec *CreateVarRec(const char *ArrayName);
     void ReverseDimensions(uint64_t *Dimensions, size_t count, size_t times);
     const char *BreakdownVarName(const char *Name, DataType *type_p, int *element_size_p);
-    void BreakdownFieldType(const char *FieldType, bool &Operator, bool &MinMax);
+    void BreakdownFieldType(const char *FieldType, bool &Operator, bool &MinMax,
+                            bool &SubBlockStats, bool &Histogram);
     void BreakdownArrayName(const char *Name, char **base_name_p, DataType *type_p,
                             int *element_size_p, FMFormat *Format);
     void BreakdownV1ArrayName(const char *Name, char **base_name_p, DataType *type_p,
                               int *element_size_p, bool &Operator, bool &MinMax);
     void *VarSetup(core::Engine *engine, const char *variableName, const DataType type, void *data);
+    /* point Blk at the sub-block statistics of block Block of a writer,
+     * PairOffset counts the pairs of the writer's earlier blocks */
+    void ApplySubBlockStats(MinVarInfo *MV, const BP5VarRec *VarRec, void *MetaBase, size_t Block,
+                            size_t &PairOffset, MinBlockInfo &Blk);
+    /* point Blk at the histogram of block Block of a writer, if any */
+    void ApplyHistogram(const BP5VarRec *VarRec, void *MetaBase, size_t Block, MinBlockInfo &Blk);
     void *ArrayVarSetup(core::Engine *engine, const char *variableName, const DataType type,
                         int DimCount, uint64_t *Shape, uint64_t *Start, uint64_t *Count,
                         core::StructDefinition *Def, core::StructDefinition *ReaderDef,
@@ -313,9 +383,60 @@ private:
 
     size_t CurTimestep = 0;
 
-    /* We assume operators are not thread-safe, call Decompress() one at a time
+    /* Guards first-time operator creation (VB->m_Operations) and the per-variable
+     * operator pools. Operators reporting IsThreadSafe() decompress outside of
+     * any lock on an instance of their own; the rest are still serialized on
+     * mutexSerialDecompress.
      */
     std::mutex mutexDecompress;
+    std::mutex mutexSerialDecompress;
+    std::shared_ptr<Operator> AcquireOperator(BP5VarRec *VarRec,
+                                              const std::shared_ptr<Operator> &primary);
+    void ReleaseOperator(BP5VarRec *VarRec, std::shared_ptr<Operator> op);
+
+    /* LRU cache of decompressed blocks, keyed by variable, step, writer rank,
+     * block and requested accuracy. Entries are handed out as shared_ptr so an
+     * eviction never pulls a block out from under a reader thread.
+     */
+    struct DecompressedBlock
+    {
+        std::vector<char> Data;
+        Accuracy AccuracyProvided;
+    };
+    using DecompressedBlockKey = std::tuple<size_t, size_t, size_t, size_t, double, double, bool>;
+    struct DecompressedBlockEntry
+    {
+        std::shared_ptr<const DecompressedBlock> Block;
+        std::list<DecompressedBlockKey>::iterator LRUPos;
+    };
+    size_t m_DecompressedBlockCacheSize = 0;
+    size_t m_DecompressedBlockCacheBytes = 0;
+    size_t m_DecompressedBlockCacheHits = 0;
+    size_t m_DecompressedBlockCacheEvictions = 0;
+    // operated blocks decoded in part (InverseOperateSubset) or in whole
+    std::atomic<size_t> m_SubsetDecompressions{0};
+    std::atomic<size_t> m_BlockDecompressions{0};
+    std::map<DecompressedBlockKey, DecompressedBlockEntry> m_DecompressedBlocks;
+    std::list<DecompressedBlockKey> m_DecompressedBlockLRU; // most recently used first
+    std::mutex mutexDecompressedBlocks;
+    DecompressedBlockKey MakeDecompressedBlockKey(const BP5VarRec *VarRec, const size_t Step,
+                                                  const size_t WriterRank, const size_t BlockID,
+                                                  const Accuracy &accuracy) const;
+    std::shared_ptr<const DecompressedBlock> LookupDecompressedBlock(const DecompressedBlockKey &key);
+    void InsertDecompressedBlock(const DecompressedBlockKey &key,
+                                 std::shared_ptr<const DecompressedBlock> block);
+    void EvictDecompressedBlocks(const size_t limit);
+    void DropDecompressedBlocksBefore(const size_t Step);
+    /* Completes a read request for an operated block from the cache instead of
+     * issuing it; returns false on a miss */
+    bool ServeFromDecompressedBlockCache(BP5GetContext &ctx, const ReadRequest &RR);
+    void FinalizeGet(BP5GetContext &ctx, const ReadRequest &Read, const bool freeAddr,
+                     std::shared_ptr<const DecompressedBlock> cached);
+    /* The part of an operated block a request needs, relative to the block,
+     * if that is worth decompressing on its own; false for the whole block */
+    bool OperatorSubsetBox(const BP5ArrayRequest &Req, const size_t DimCount,
+                           const size_t *RankOffset, const size_t *RankSize, Dims &Start,
+                           Dims &Count) const;
 
     // Backs the legacy non-context Get/Perform API.
     BP5GetContext m_DefaultGetContext;
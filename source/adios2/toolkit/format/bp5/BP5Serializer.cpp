@@ -38,6 +38,12 @@ namespace format
 BP5Serializer::BP5Serializer() { Init(); }
 BP5Serializer::~BP5Serializer()
 {
+    // queued compressions still point at their staging buffers
+    for (auto &job : PendingCompressions)
+    {
+        job->Done.wait();
+    }
+    PendingCompressions.clear();
     if (CurDataBuffer)
         delete CurDataBuffer;
     if (!Info.RecNameMap.empty())
@@ -613,26 +619,34 @@ BP5Serializer::BP5WriterRec BP5Serializer::CreateWriterRec(void *Variable, const
         {
             char MMArrayName[40] = {0};
             strcat(MMArrayName, ArrayTypeName);
+            // per-subblock min/max only where queries can use the regions
+            Rec->SubBlockStats = (m_StatsBlockSize > 0) &&
+                                 (VB->m_ShapeID == ShapeID::GlobalArray) && TypeHasMinMax(Type);
+            Rec->Histogram = (m_StatsLevel >= 2) && (m_HistogramBins > 0) && TypeHasMinMax(Type);
+            const char *MMSuffix = Rec->Histogram ? "MMH" : (Rec->SubBlockStats ? "MMSB" : "MM");
             switch (ElemSize)
             {
             case 1:
-                strcat(MMArrayName, "MM1");
-                break;
             case 2:
-                strcat(MMArrayName, "MM2");
-                break;
             case 4:
-                strcat(MMArrayName, "MM4");
-                break;
             case 8:
-                strcat(MMArrayName, "MM8");
-                break;
             case 16:
-                strcat(MMArrayName, "MM16");
+                strcat(MMArrayName, MMSuffix);
+                strcat(MMArrayName, std::to_string(ElemSize).c_str());
                 break;
             }
             Rec->MinMaxOffset = FieldSize;
             FieldSize += sizeof(char *);
+            if (Rec->Histogram)
+            {
+                FieldSize = VB->m_Operations.size() ? sizeof(MetaArrayRecOperatorMMHist)
+                                                    : sizeof(MetaArrayRecMMHist);
+            }
+            else if (Rec->SubBlockStats)
+            {
+                FieldSize = VB->m_Operations.size() ? sizeof(MetaArrayRecOperatorMMSub)
+                                                    : sizeof(MetaArrayRecMMSub);
+            }
             AddSimpleField(&Info.MetaFields, &Info.MetaFieldCount, LongName, MMArrayName,
                            FieldSize);
         }
@@ -690,8 +704,105 @@ void BP5Serializer::PerformPuts(bool forceCopyDeferred)
     DumpDeferredBlocks(true);
 }
 
+void BP5Serializer::SetCompressionThreads(size_t nThreads)
+{
+    CollectCompressedBlocks();
+    m_CompressionPool.reset(nThreads ? new helper::ThreadPool(nThreads) : nullptr);
+}
+
+std::map<std::string, size_t> BP5Serializer::ProfileCounts() const
+{
+    return {{"asynccompressions", m_AsyncCompressions},
+            {"splitstatsblocks", m_SplitStatsBlocks},
+            {"queuedstatsblocks", m_QueuedStatsBlocks}};
+}
+
+BP5Serializer::PendingCompression *
+BP5Serializer::QueueCompression(core::VariableBase *VB, const Params &operatorParams,
+                                const void *Data, bool Sync, DataType Type, size_t ElemSize,
+                                size_t ElemCount, const Dims &Count, const Dims &Offsets,
+                                size_t MetaOffset)
+{
+    // every job gets its own operator, so that blocks of one variable can be
+    // compressed at the same time
+    const auto &userOp = VB->m_Operations[0];
+    std::shared_ptr<core::Operator> op =
+        core::MakeOperator(userOp->m_TypeString, userOp->GetParameters());
+    op->AddExtraParameters(operatorParams);
+
+    std::unique_ptr<PendingCompression> job(new PendingCompression);
+    job->MetaOffset = MetaOffset;
+    job->BlockID = 0;
+    job->AlignReq = ElemSize;
+    const char *input = static_cast<const char *>(Data);
+    if (Sync)
+    {
+        // the application may reuse its buffer as soon as Put returns
+        job->Staged.reset(new char[ElemCount * ElemSize]);
+        std::memcpy(job->Staged.get(), Data, ElemCount * ElemSize);
+        input = job->Staged.get();
+    }
+
+    PendingCompression *p = job.get();
+    auto lf_Compress = [p, op, input, Type, ElemSize, ElemCount, Count, Offsets]() {
+        const size_t allocSize =
+            op->GetEstimatedSize(ElemCount, ElemSize, Count.size(), Count.data());
+        p->Output.reset(new char[allocSize]);
+        p->OutputSize = op->Operate(input, Offsets, Count, Type, p->Output.get());
+        // if the operator was not applied
+        if (p->OutputSize == 0)
+            p->OutputSize = helper::CopyMemoryWithOpHeader(input, Count, Type, p->Output.get(),
+                                                           op->GetHeaderSize(), MemorySpace::Host);
+        p->Staged.reset();
+    };
+    p->Done = m_CompressionPool->Submit(lf_Compress);
+    ++m_AsyncCompressions;
+    PendingCompressions.push_back(std::move(job));
+    return p;
+}
+
+void BP5Serializer::CollectCompressedBlocks()
+{
+    // all of them must be done before any is released, a failed one rethrows
+    for (auto &job : PendingCompressions)
+    {
+        job->Done.wait();
+    }
+    std::vector<std::unique_ptr<PendingCompression>> jobs;
+    jobs.swap(PendingCompressions);
+    for (auto &job : jobs)
+    {
+        job->Done.get();
+        MetaArrayRecOperator *OpEntry =
+            (MetaArrayRecOperator *)((char *)(MetadataBuf) + job->MetaOffset);
+        OpEntry->DataBlockLocation[job->BlockID] =
+            m_PriorDataBufferSizeTotal +
+            CurDataBuffer->AddToVec(job->OutputSize, job->Output.get(), job->AlignReq, true);
+        OpEntry->DataBlockSize[job->BlockID] = job->OutputSize;
+        NoteDedupLocation(job->MetaOffset, job->BlockID, OpEntry->DataBlockLocation[job->BlockID],
+                          job->OutputSize);
+    }
+}
+
+void BP5Serializer::NoteDedupLocation(size_t MetaOffset, size_t BlockID, uint64_t DataOffset,
+                                      uint64_t Size)
+{
+    if (!m_DeduplicateBlocks)
+        return;
+    auto it = m_DedupBlocks.find(std::make_pair(MetaOffset, BlockID));
+    if ((it == m_DedupBlocks.end()) || (it->second.Location != static_cast<uint64_t>(-1)))
+        return;
+    // offsets within the block are added to the location on read, so the
+    // whole block must fit in the offset bits
+    if (DataOffset + it->second.Length + Size >= DedupOffsetMask)
+        return;
+    EncodeDedupLocation(m_WriterStep, DataOffset, it->second.Location);
+    it->second.Size = Size;
+}
+
 void BP5Serializer::DumpDeferredBlocks(bool forceCopyDeferred)
 {
+    CollectCompressedBlocks();
     for (auto &Def : DeferredExterns)
     {
         MetaArrayRec *MetaEntry = (MetaArrayRec *)((char *)(MetadataBuf) + Def.MetaOffset);
@@ -699,6 +810,7 @@ void BP5Serializer::DumpDeferredBlocks(bool forceCopyDeferred)
             m_PriorDataBufferSizeTotal +
             CurDataBuffer->AddToVec(Def.DataSize, Def.Data, Def.AlignReq, forceCopyDeferred);
         MetaEntry->DataBlockLocation[Def.BlockID] = DataOffset;
+        NoteDedupLocation(Def.MetaOffset, Def.BlockID, DataOffset, 0);
     }
     DeferredExterns.clear();
 }
@@ -727,12 +839,275 @@ static void GetMinMax(const void *Data, size_t ElemCount, const DataType Type, M
 #define pertype(T, N)                                                                              \
     else if (Type == helper::GetDataType<T>())                                                     \
     {                                                                                              \
-        const T *values = (const T *)Data;                                                         \
-        auto res = std::minmax_element(values, values + ElemCount);                                \
-        MinMax.MinUnion.field_##N = *res.first;                                                    \
-        MinMax.MaxUnion.field_##N = *res.second;                                                   \
+        helper::GetMinMax((const T *)Data, ElemCount, MinMax.MinUnion.field_##N,                   \
+                          MinMax.MaxUnion.field_##N, MemorySpace::Host);                           \
+    }
+    ADIOS2_FOREACH_MINMAX_STDTYPE_2ARGS(pertype)
+#undef pertype
+}
+
+/*
+ * Copy a host block into Dest and compute its min/max in one pass over Data
+ */
+static void CopyAndGetMinMax(void *Dest, const void *Data, size_t ElemCount, const DataType Type,
+                             MinMaxStruct &MinMax)
+{
+    MinMax.Init(Type);
+    if (Type == DataType::Struct)
+    {
+    }
+#define pertype(T, N)                                                                              \
+    else if (Type == helper::GetDataType<T>())                                                     \
+    {                                                                                              \
+        helper::CopyAndGetMinMax((const T *)Data, ElemCount, (T *)Dest,                            \
+                                 MinMax.MinUnion.field_##N, MinMax.MaxUnion.field_##N);            \
+    }
+    ADIOS2_FOREACH_MINMAX_STDTYPE_2ARGS(pertype)
+#undef pertype
+}
+
+// blocks of at least this size have their stats computed by all StatsThreads
+static constexpr size_t ParallelStatsMinBytes = 2 * 1024 * 1024;
+
+template <class T>
+static void ParallelMinMax(helper::ThreadPool &Pool, size_t NPieces, const T *Data, T *Dest,
+                           size_t ElemCount, T &Min, T &Max)
+{
+    std::vector<T> Mins(NPieces), Maxs(NPieces);
+    const size_t PerPiece = ElemCount / NPieces;
+    const size_t Rem = ElemCount % NPieces;
+    Pool.Run(NPieces, [&](size_t p) {
+        const size_t Start = p * PerPiece + (std::min)(p, Rem);
+        const size_t N = PerPiece + (p < Rem ? 1 : 0);
+        if (Dest)
+            helper::CopyAndGetMinMax(Data + Start, N, Dest + Start, Mins[p], Maxs[p]);
+        else
+            helper::GetMinMax(Data + Start, N, Mins[p], Maxs[p], MemorySpace::Host);
+    });
+    Min = Mins[0];
+    Max = Maxs[0];
+    for (size_t p = 1; p < NPieces; ++p)
+    {
+        if (Mins[p] < Min)
+            Min = Mins[p];
+        if (Maxs[p] > Max)
+            Max = Maxs[p];
+    }
+}
+
+// append the sub-block divisions and min/max pairs of a block, whose dims
+// start at DBOffset, to an MMSB metadata record
+static void AppendSubBlockStats(void *MetaEntry, const bool Operator, const size_t ElemSize,
+                                const size_t DBOffset, const size_t DimCount, const uint64_t *Div,
+                                const std::vector<char> &MinMaxs)
+{
+    uint64_t **DivLoc;
+    uint64_t *CountLoc;
+    char **MinMaxLoc;
+    if (Operator)
+    {
+        auto *Entry = (BP5Base::MetaArrayRecOperatorMMSub *)MetaEntry;
+        DivLoc = &Entry->SubBlockDiv;
+        CountLoc = &Entry->SubMinMaxCount;
+        MinMaxLoc = &Entry->SubMinMax;
+    }
+    else
+    {
+        auto *Entry = (BP5Base::MetaArrayRecMMSub *)MetaEntry;
+        DivLoc = &Entry->SubBlockDiv;
+        CountLoc = &Entry->SubMinMaxCount;
+        MinMaxLoc = &Entry->SubMinMax;
+    }
+    if (DBOffset == 0)
+    {
+        // first block of the step
+        *DivLoc = NULL;
+        *CountLoc = 0;
+        *MinMaxLoc = NULL;
+    }
+    *DivLoc = (uint64_t *)realloc(*DivLoc, (DBOffset + DimCount) * sizeof(uint64_t));
+    memcpy(*DivLoc + DBOffset, Div, DimCount * sizeof(uint64_t));
+    if (!MinMaxs.empty())
+    {
+        const size_t PrevBytes = *CountLoc * 2 * ElemSize;
+        *MinMaxLoc = (char *)realloc(*MinMaxLoc, PrevBytes + MinMaxs.size());
+        memcpy(*MinMaxLoc + PrevBytes, MinMaxs.data(), MinMaxs.size());
+        *CountLoc += MinMaxs.size() / (2 * ElemSize);
+    }
+}
+
+// append the histogram of block BlockID to an MMH metadata record
+static void AppendHistogram(void *MetaEntry, const bool Operator, const size_t BlockID,
+                            const std::vector<uint64_t> &Counts)
+{
+    uint64_t *BinsLoc;
+    uint64_t *CountLoc;
+    uint64_t **HistogramLoc;
+    if (Operator)
+    {
+        auto *Entry = (BP5Base::MetaArrayRecOperatorMMHist *)MetaEntry;
+        BinsLoc = &Entry->HistogramBins;
+        CountLoc = &Entry->HistogramCount;
+        HistogramLoc = &Entry->Histogram;
+    }
+    else
+    {
+        auto *Entry = (BP5Base::MetaArrayRecMMHist *)MetaEntry;
+        BinsLoc = &Entry->HistogramBins;
+        CountLoc = &Entry->HistogramCount;
+        HistogramLoc = &Entry->Histogram;
+    }
+    if (BlockID == 0)
+    {
+        // first block of the step
+        *BinsLoc = Counts.size();
+        *CountLoc = 0;
+        *HistogramLoc = NULL;
+    }
+    *HistogramLoc =
+        (uint64_t *)realloc(*HistogramLoc, (*CountLoc + Counts.size()) * sizeof(uint64_t));
+    memcpy(*HistogramLoc + *CountLoc, Counts.data(), Counts.size() * sizeof(uint64_t));
+    *CountLoc += Counts.size();
+}
+
+// the histogram of block BlockID in an MMH metadata record
+static uint64_t *BlockHistogramLoc(void *MetaEntry, const bool Operator, const size_t BlockID)
+{
+    if (Operator)
+    {
+        auto *Entry = (BP5Base::MetaArrayRecOperatorMMHist *)MetaEntry;
+        return Entry->Histogram + BlockID * Entry->HistogramBins;
+    }
+    auto *Entry = (BP5Base::MetaArrayRecMMHist *)MetaEntry;
+    return Entry->Histogram + BlockID * Entry->HistogramBins;
+}
+
+void BP5Serializer::SetStatsThreads(size_t nThreads)
+{
+    m_StatsThreads = nThreads ? nThreads : 1;
+    // the calling thread takes a share of the work, too
+    m_StatsPool.reset(m_StatsThreads > 1 ? new helper::ThreadPool(m_StatsThreads - 1) : nullptr);
+}
+
+void BP5Serializer::BlockMinMax(const void *Data, void *Dest, size_t ElemCount,
+                                const DataType Type, const MemorySpace MemSpace,
+                                MinMaxStruct &MinMax)
+{
+    const bool Parallel = m_StatsPool && (MemSpace == MemorySpace::Host) &&
+                          (ElemCount * helper::GetDataTypeSize(Type) >= ParallelStatsMinBytes);
+    if (!Parallel)
+    {
+        if (Dest)
+            CopyAndGetMinMax(Dest, Data, ElemCount, Type, MinMax);
+        else
+            GetMinMax(Data, ElemCount, Type, MinMax, MemSpace);
+        return;
+    }
+    ++m_SplitStatsBlocks;
+    MinMax.Init(Type);
+    if (Type == DataType::Struct)
+    {
+    }
+#define pertype(T, N)                                                                              \
+    else if (Type == helper::GetDataType<T>())                                                     \
+    {                                                                                              \
+        ParallelMinMax(*m_StatsPool, m_StatsThreads, (const T *)Data, (T *)Dest, ElemCount,        \
+                       MinMax.MinUnion.field_##N, MinMax.MaxUnion.field_##N);                      \
+    }
+    ADIOS2_FOREACH_MINMAX_STDTYPE_2ARGS(pertype)
+#undef pertype
+}
+
+void BP5Serializer::BlockHistogram(const void *Data, size_t ElemCount, const DataType Type,
+                                   const MinMaxStruct &MinMax, uint64_t *Counts)
+{
+    const size_t Bins = m_HistogramBins;
+    const size_t NPieces =
+        (m_StatsPool && (ElemCount * helper::GetDataTypeSize(Type) >= ParallelStatsMinBytes))
+            ? m_StatsThreads
+            : 1;
+    if (Type == DataType::Struct)
+    {
+    }
+#define pertype(T, N)                                                                              \
+    else if (Type == helper::GetDataType<T>())                                                     \
+    {                                                                                              \
+        const T *Values = (const T *)Data;                                                         \
+        const T Min = MinMax.MinUnion.field_##N;                                                   \
+        const T Max = MinMax.MaxUnion.field_##N;                                                   \
+        if (NPieces == 1)                                                                          \
+        {                                                                                          \
+            helper::GetHistogram(Values, ElemCount, Min, Max, Bins, Counts);                       \
+            return;                                                                                \
+        }                                                                                          \
+        std::vector<uint64_t> PieceCounts(NPieces * Bins, 0);                                      \
+        const size_t PerPiece = ElemCount / NPieces;                                               \
+        const size_t Rem = ElemCount % NPieces;                                                    \
+        m_StatsPool->Run(NPieces, [&](size_t p) {                                                  \
+            const size_t Start = p * PerPiece + (std::min)(p, Rem);                                \
+            const size_t Len = PerPiece + (p < Rem ? 1 : 0);                                       \
+            helper::GetHistogram(Values + Start, Len, Min, Max, Bins,                              \
+                                 PieceCounts.data() + p * Bins);                                   \
+        });                                                                                        \
+        for (size_t p = 0; p < NPieces; ++p)                                                       \
+        {                                                                                          \
+            for (size_t b = 0; b < Bins; ++b)                                                      \
+            {                                                                                      \
+                Counts[b] += PieceCounts[p * Bins + b];                                            \
+            }                                                                                      \
+        }                                                                                          \
+    }
+    ADIOS2_FOREACH_MINMAX_STDTYPE_2ARGS(pertype)
+#undef pertype
+}
+
+void BP5Serializer::SubBlockMinMax(const void *Data, const DataType Type, const size_t DimCount,
+                                   const size_t *Count, std::vector<uint64_t> &Div,
+                                   std::vector<char> &MinMaxs)
+{
+    Div.assign(DimCount, 1);
+    MinMaxs.clear();
+    const Dims count(Count, Count + DimCount);
+    if (helper::GetTotalSize(count) <= m_StatsBlockSize)
+    {
+        return;
+    }
+    const helper::BlockDivisionInfo info =
+        helper::DivideBlock(count, m_StatsBlockSize, helper::BlockDivisionMethod::Contiguous);
+    if (info.NBlocks <= 1)
+    {
+        return;
+    }
+    const size_t NBlocks = info.NBlocks;
+    const size_t NThreads = m_StatsPool ? (std::min)(m_StatsThreads, NBlocks) : 1;
+    MinMaxs.resize(2 * NBlocks * helper::GetDataTypeSize(Type));
+    if (Type == DataType::Struct)
+    {
+    }
+#define pertype(T, N)                                                                              \
+    else if (Type == helper::GetDataType<T>())                                                     \
+    {                                                                                              \
+        T *MM = reinterpret_cast<T *>(MinMaxs.data());                                             \
+        auto lf_SubBlocks = [&](const size_t t) {                                                  \
+            for (size_t b = t; b < NBlocks; b += NThreads)                                         \
+            {                                                                                      \
+                const Box<Dims> sb =                                                               \
+                    helper::GetSubBlock(count, info, static_cast<unsigned int>(b));                \
+                helper::GetMinMaxSelection((const T *)Data, count, sb.first, sb.second,            \
+                                           m_RowMajor, MM[2 * b], MM[2 * b + 1]);                  \
+            }                                                                                      \
+        };                                                                                         \
+        if (NThreads > 1)                                                                          \
+            m_StatsPool->Run(NThreads, lf_SubBlocks);                                              \
+        else                                                                                       \
+            lf_SubBlocks(0);                                                                       \
     }
     ADIOS2_FOREACH_MINMAX_STDTYPE_2ARGS(pertype)
+#undef pertype
+    for (size_t d = 0; d < DimCount; ++d)
+    {
+        Div[d] = info.Div[d];
+    }
 }
 
 void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Type, size_t ElemSize,
@@ -744,9 +1119,10 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
     auto lf_QueueSpanMinMax = [&](const format::BufferV::BufferPos Data, const size_t ElemCount,
                                   const DataType Type, const MemorySpace MemSpace,
                                   const size_t MetaOffset, const size_t MinMaxOffset,
-                                  const size_t BlockNum) {
-        DeferredSpanMinMax entry = {Data,       ElemCount,    Type,    MemSpace,
-                                    MetaOffset, MinMaxOffset, BlockNum};
+                                  const size_t BlockNum, const bool Histogram,
+                                  const bool Operator) {
+        DeferredSpanMinMax entry = {Data,         ElemCount, Type,      MemSpace, MetaOffset,
+                                    MinMaxOffset, BlockNum,  Histogram, Operator};
         DefSpanMinMax.push_back(entry);
     };
 
@@ -761,6 +1137,7 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
     BP5WriterRec Rec = LookupWriterRec(Variable);
 
     bool DeferAddToVec;
+    PendingCompression *Pending = nullptr;
 
     if (VB->m_SingleValue)
     {
@@ -825,6 +1202,41 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
                                             "without prior Init");
         }
 
+        // a block with the same bytes as its last written copy refers to it
+        const std::pair<size_t, size_t> DedupKey(
+            Rec->MetaOffset, AlreadyWritten ? static_cast<size_t>(MetaEntry->BlockCount) : 0);
+        const bool DoDedup = m_DeduplicateBlocks && WriteData && !Span &&
+                             (MemSpace == MemorySpace::Host) && (ElemCount > 0);
+        uint64_t DedupHash = 0;
+        bool Deduped = false;
+        if (DoDedup)
+        {
+            DedupHash = helper::HashBytes(Data, ElemCount * ElemSize);
+            auto it = m_DedupBlocks.find(DedupKey);
+            if ((it != m_DedupBlocks.end()) && (it->second.Hash == DedupHash) &&
+                (it->second.Length == ElemCount * ElemSize) &&
+                (it->second.Location != static_cast<uint64_t>(-1)) &&
+                (!m_DedupMaxAge || (m_WriterStep - it->second.Step <= m_DedupMaxAge)) &&
+                std::equal(Count, Count + DimCount, it->second.Count.begin(),
+                           it->second.Count.end()) &&
+                (!m_DedupVerify || !std::memcmp(it->second.Bytes.data(), Data, it->second.Length)))
+            {
+                Deduped = true;
+                DataOffset = it->second.Location;
+                CompressedSize = static_cast<size_t>(it->second.Size);
+                DeferAddToVec = false;
+            }
+        }
+
+        // a large sync block may go straight from the application to the file
+        bool DirectWritten = false;
+        if (m_DirectWrite && Sync && !Deduped && WriteData && !Span && !Rec->OperatorType &&
+            (MemSpace == MemorySpace::Host) && (ElemCount > 0) &&
+            (ElemCount * ElemSize >= m_DirectWriteMinSize))
+        {
+            DirectWritten = m_DirectWrite(Data, ElemCount * ElemSize, DataOffset);
+        }
+
         MinMaxStruct MinMax;
         MinMax.Init(Type);
         bool DerivedWithoutStats = false;
@@ -833,15 +1245,38 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
 #endif
         bool DoMinMax =
             ((m_StatsLevel > 0) && !DerivedWithoutStats && TypeHasMinMax((DataType)Rec->Type));
-        if (DoMinMax && !Span)
+        // a block copied into the buffer now gets its stats from the copy loop
+        const bool FusedMinMax = DoMinMax && !Span && !Rec->OperatorType && WriteData &&
+                                 !DeferAddToVec && !Deduped && !DirectWritten &&
+                                 (MemSpace == MemorySpace::Host) && (ElemCount > 0);
+        // with StatsThreads, small copied blocks get their stats from the
+        // buffer at the end of the step, spread over the threads
+        const bool QueueMinMax = FusedMinMax && m_StatsPool && !Rec->Histogram &&
+                                 (ElemCount * ElemSize < ParallelStatsMinBytes);
+        BufferV::BufferPos MinMaxPos(-1, 0, 0);
+        // span and device data get no sub-block statistics, Div stays all 1
+        std::vector<uint64_t> SubDiv(DimCount, 1);
+        std::vector<char> SubMinMaxs;
+        if (DoMinMax && Rec->SubBlockStats && !Span && (MemSpace == MemorySpace::Host))
         {
             auto _gmm_t0 = std::chrono::steady_clock::now();
-            GetMinMax(Data, ElemCount, (DataType)Rec->Type, MinMax, MemSpace);
+            SubBlockMinMax(Data, (DataType)Rec->Type, DimCount, Count, SubDiv, SubMinMaxs);
+            m_GetMinMaxSecs +=
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - _gmm_t0).count();
+        }
+        if (DoMinMax && !Span && !FusedMinMax)
+        {
+            auto _gmm_t0 = std::chrono::steady_clock::now();
+            BlockMinMax(Data, nullptr, ElemCount, (DataType)Rec->Type, MemSpace, MinMax);
             m_GetMinMaxSecs +=
                 std::chrono::duration<double>(std::chrono::steady_clock::now() - _gmm_t0).count();
         }
 
-        if (Rec->OperatorType)
+        if (Deduped || DirectWritten)
+        {
+            // DataOffset (and CompressedSize) refer to data already in the file
+        }
+        else if (Rec->OperatorType)
         {
             std::string compressionMethod = Rec->OperatorType;
             std::transform(compressionMethod.begin(), compressionMethod.end(),
@@ -853,21 +1288,33 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
                 if (Offsets)
                     tmpOffsets.push_back(Offsets[i]);
             }
-            size_t AllocSize =
-                VB->m_Operations[0]->GetEstimatedSize(ElemCount, ElemSize, DimCount, Count);
-            BufferV::BufferPos pos = CurDataBuffer->Allocate(AllocSize, ElemSize);
-            char *CompressedData = (char *)GetPtr(pos.bufferIdx, pos.posInBuffer);
-            DataOffset = m_PriorDataBufferSizeTotal + pos.globalPos;
             Params operatorParams = core::CreateOperatorParams(m_Engine, VB);
-            VB->m_Operations[0]->AddExtraParameters(operatorParams);
-            CompressedSize = VB->m_Operations[0]->Operate((const char *)Data, tmpOffsets, tmpCount,
-                                                          (DataType)Rec->Type, CompressedData);
-            // if the operator was not applied
-            if (CompressedSize == 0)
-                CompressedSize = helper::CopyMemoryWithOpHeader(
-                    (const char *)Data, tmpCount, (DataType)Rec->Type, CompressedData,
-                    VB->m_Operations[0]->GetHeaderSize(), MemSpace);
-            CurDataBuffer->DownsizeLastAlloc(AllocSize, CompressedSize);
+            if (m_CompressionPool && WriteData && !Span && (MemSpace == MemorySpace::Host) &&
+                VB->m_Operations[0]->IsThreadSafe())
+            {
+                // location and size are patched in CollectCompressedBlocks()
+                Pending = QueueCompression(VB, operatorParams, Data, Sync, (DataType)Rec->Type,
+                                           ElemSize, ElemCount, tmpCount, tmpOffsets,
+                                           Rec->MetaOffset);
+            }
+            else
+            {
+                size_t AllocSize =
+                    VB->m_Operations[0]->GetEstimatedSize(ElemCount, ElemSize, DimCount, Count);
+                BufferV::BufferPos pos = CurDataBuffer->Allocate(AllocSize, ElemSize);
+                char *CompressedData = (char *)GetPtr(pos.bufferIdx, pos.posInBuffer);
+                DataOffset = m_PriorDataBufferSizeTotal + pos.globalPos;
+                VB->m_Operations[0]->AddExtraParameters(operatorParams);
+                CompressedSize =
+                    VB->m_Operations[0]->Operate((const char *)Data, tmpOffsets, tmpCount,
+                                                 (DataType)Rec->Type, CompressedData);
+                // if the operator was not applied
+                if (CompressedSize == 0)
+                    CompressedSize = helper::CopyMemoryWithOpHeader(
+                        (const char *)Data, tmpCount, (DataType)Rec->Type, CompressedData,
+                        VB->m_Operations[0]->GetHeaderSize(), MemSpace);
+                CurDataBuffer->DownsizeLastAlloc(AllocSize, CompressedSize);
+            }
         }
         else if (!WriteData)
         {
@@ -876,7 +1323,28 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
         }
         else if (Span == nullptr)
         {
-            if (!DeferAddToVec)
+            if (FusedMinMax)
+            {
+                m_BufferAppendCalls++;
+                auto _ba_t0 = std::chrono::steady_clock::now();
+                BufferV::BufferPos pos = CurDataBuffer->Allocate(ElemCount * ElemSize, ElemSize);
+                void *Dest = GetPtr(pos.bufferIdx, pos.posInBuffer);
+                if (QueueMinMax)
+                {
+                    memcpy(Dest, Data, ElemCount * ElemSize);
+                    MinMaxPos = pos;
+                }
+                else
+                {
+                    BlockMinMax(Data, Dest, ElemCount, (DataType)Rec->Type, MemorySpace::Host,
+                                MinMax);
+                }
+                DataOffset = m_PriorDataBufferSizeTotal + pos.globalPos;
+                m_BufferAppendSecs +=
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - _ba_t0)
+                        .count();
+            }
+            else if (!DeferAddToVec)
             {
                 m_BufferAppendCalls++;
                 auto _ba_t0 = std::chrono::steady_clock::now();
@@ -895,6 +1363,53 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
             spanMemSpace = MemorySpace::Host;
         }
 
+        // the histogram bins span the block's min/max, known by now except
+        // for a span, which gets its histogram with its min/max at EndStep
+        std::vector<uint64_t> HistCounts;
+        if (DoMinMax && Rec->Histogram)
+        {
+            HistCounts.assign(m_HistogramBins, 0);
+            if (!Span && (MemSpace != MemorySpace::Host))
+            {
+                // no histograms of device memory; marked, so that readers do
+                // not take the block for one without values
+                HistCounts[0] = HistogramMissing;
+            }
+            else if (!Span && (ElemCount > 0))
+            {
+                auto _gmm_t0 = std::chrono::steady_clock::now();
+                BlockHistogram(Data, ElemCount, (DataType)Rec->Type, MinMax, HistCounts.data());
+                m_GetMinMaxSecs +=
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - _gmm_t0)
+                        .count();
+            }
+        }
+
+        if (DoDedup && !Deduped)
+        {
+            DedupBlock &Entry = m_DedupBlocks[DedupKey];
+            Entry.Hash = DedupHash;
+            Entry.Length = ElemCount * ElemSize;
+            Entry.Count.assign(Count, Count + DimCount);
+            Entry.Location = static_cast<uint64_t>(-1);
+            Entry.Size = 0;
+            Entry.Step = m_WriterStep;
+            if (m_DedupVerify)
+            {
+                const char *Bytes = static_cast<const char *>(Data);
+                Entry.Bytes.assign(Bytes, Bytes + Entry.Length);
+            }
+            // deferred and compressed blocks are noted once they are placed
+            if (DirectWritten)
+            {
+                Entry.Location = DataOffset;
+            }
+            else if (!Pending && !DeferAddToVec)
+            {
+                NoteDedupLocation(Rec->MetaOffset, DedupKey.second, DataOffset, CompressedSize);
+            }
+        }
+
         if (!AlreadyWritten)
         {
             if (Shape)
@@ -921,17 +1436,30 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
             {
                 void **MMPtrLoc = (void **)(((char *)MetaEntry) + Rec->MinMaxOffset);
                 *MMPtrLoc = (void *)malloc(ElemSize * 2);
-                if (!Span)
+                if (!Span && !QueueMinMax)
                 {
                     memcpy(*MMPtrLoc, &MinMax.MinUnion, ElemSize);
                     memcpy(((char *)*MMPtrLoc) + ElemSize, &MinMax.MaxUnion, ElemSize);
                 }
                 else
                 {
-                    lf_QueueSpanMinMax(*Span, ElemCount, (DataType)Rec->Type, spanMemSpace,
-                                       Rec->MetaOffset, Rec->MinMaxOffset, 0 /*BlockNum*/);
+                    lf_QueueSpanMinMax(Span ? *Span : MinMaxPos, ElemCount, (DataType)Rec->Type,
+                                       spanMemSpace, Rec->MetaOffset, Rec->MinMaxOffset,
+                                       0 /*BlockNum*/, Span && Rec->Histogram,
+                                       Rec->OperatorType != NULL);
                 }
             }
+            if (DoMinMax && Rec->SubBlockStats)
+            {
+                AppendSubBlockStats(MetaEntry, Rec->OperatorType != NULL, ElemSize, 0, DimCount,
+                                    SubDiv.data(), SubMinMaxs);
+            }
+            if (DoMinMax && Rec->Histogram)
+            {
+                AppendHistogram(MetaEntry, Rec->OperatorType != NULL, 0, HistCounts);
+            }
+            if (Pending)
+                Pending->BlockID = 0;
             if (DeferAddToVec)
             {
                 DeferredExtern rec = {Rec->MetaOffset, 0, Data, ElemCount * ElemSize, ElemSize};
@@ -963,7 +1491,7 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
             {
                 void **MMPtrLoc = (void **)(((char *)MetaEntry) + Rec->MinMaxOffset);
                 *MMPtrLoc = (void *)realloc(*MMPtrLoc, MetaEntry->BlockCount * ElemSize * 2);
-                if (!Span)
+                if (!Span && !QueueMinMax)
                 {
                     memcpy(((char *)*MMPtrLoc) + ElemSize * (2 * (MetaEntry->BlockCount - 1)),
                            &MinMax.MinUnion, ElemSize);
@@ -972,12 +1500,25 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
                 }
                 else
                 {
-                    lf_QueueSpanMinMax(*Span, ElemCount, (DataType)Rec->Type, spanMemSpace,
-                                       Rec->MetaOffset, Rec->MinMaxOffset,
-                                       MetaEntry->BlockCount - 1 /*BlockNum*/);
+                    lf_QueueSpanMinMax(Span ? *Span : MinMaxPos, ElemCount, (DataType)Rec->Type,
+                                       spanMemSpace, Rec->MetaOffset, Rec->MinMaxOffset,
+                                       MetaEntry->BlockCount - 1 /*BlockNum*/,
+                                       Span && Rec->Histogram, Rec->OperatorType != NULL);
                 }
             }
 
+            if (DoMinMax && Rec->SubBlockStats)
+            {
+                AppendSubBlockStats(MetaEntry, Rec->OperatorType != NULL, ElemSize,
+                                    PreviousDBCount, DimCount, SubDiv.data(), SubMinMaxs);
+            }
+            if (DoMinMax && Rec->Histogram)
+            {
+                AppendHistogram(MetaEntry, Rec->OperatorType != NULL,
+                                static_cast<size_t>(MetaEntry->BlockCount - 1), HistCounts);
+            }
+            if (Pending)
+                Pending->BlockID = static_cast<size_t>(MetaEntry->BlockCount - 1);
             if (DeferAddToVec)
             {
                 DeferredExterns.push_back({Rec->MetaOffset,
@@ -1040,6 +1581,9 @@ MinVarInfo *BP5Serializer::MinBlocksInfo(const core::VariableBase &Var)
     if (!VarRec)
         return NULL;
 
+    // block locations of operated blocks are known once they are compressed
+    CollectCompressedBlocks();
+
     MinVarInfo *MV = new MinVarInfo((int)VarRec->DimCount, (size_t *)Var.m_Shape.data());
 
     BP5MetadataInfoStruct *MBase = (struct BP5MetadataInfoStruct *)MetadataBuf;
@@ -1087,7 +1631,8 @@ MinVarInfo *BP5Serializer::MinBlocksInfo(const core::VariableBase &Var)
             }
             Blk.Count = BP5MVIOwnDims(MV, &(MetaEntry->Count[b * MetaEntry->Dims]),
                                       (size_t)MetaEntry->Dims);
-            if (MetaEntry->DataBlockLocation[b] < m_PriorDataBufferSizeTotal)
+            if ((MetaEntry->DataBlockLocation[b] < m_PriorDataBufferSizeTotal) ||
+                IsDedupLocation(MetaEntry->DataBlockLocation[b]))
             {
                 Blk.BufferP = (void *)(intptr_t)(-1); // data is out of memory
             }
@@ -1272,13 +1817,45 @@ void BP5Serializer::InitStep(BufferV *DataBuffer)
 
 void BP5Serializer::ProcessDeferredMinMax()
 {
-    for (auto &Def : DefSpanMinMax)
+    std::vector<MinMaxStruct> MinMaxs(DefSpanMinMax.size());
+    std::vector<size_t> Small;
+    for (size_t i = 0; i < DefSpanMinMax.size(); ++i)
     {
-        MinMaxStruct MinMax;
-        MinMax.Init(Def.Type);
+        const auto &Def = DefSpanMinMax[i];
+        if (m_StatsPool && (Def.MemSpace == MemorySpace::Host) &&
+            (Def.ElemCount * helper::GetDataTypeSize(Def.Type) < ParallelStatsMinBytes))
+        {
+            Small.push_back(i);
+            continue;
+        }
         void *Ptr = reinterpret_cast<void *>(GetPtr(Def.Data.bufferIdx, Def.Data.posInBuffer));
-        GetMinMax(Ptr, Def.ElemCount, Def.Type, MinMax, Def.MemSpace);
+        BlockMinMax(Ptr, nullptr, Def.ElemCount, Def.Type, Def.MemSpace, MinMaxs[i]);
+    }
+    if (!Small.empty())
+    {
+        // GetPtr is not thread safe, resolve the pointers first
+        std::vector<void *> Ptrs(Small.size());
+        for (size_t k = 0; k < Small.size(); ++k)
+        {
+            const auto &Def = DefSpanMinMax[Small[k]];
+            Ptrs[k] = GetPtr(Def.Data.bufferIdx, Def.Data.posInBuffer);
+        }
+        const size_t NThreads = (std::min)(m_StatsThreads, Small.size());
+        m_QueuedStatsBlocks += Small.size();
+        m_StatsPool->Run(NThreads, [&](size_t t) {
+            for (size_t k = t; k < Small.size(); k += NThreads)
+            {
+                const auto &Def = DefSpanMinMax[Small[k]];
+                GetMinMax(Ptrs[k], Def.ElemCount, Def.Type, MinMaxs[Small[k]],
+                          MemorySpace::Host);
+            }
+        });
+    }
 
+    for (size_t i = 0; i < DefSpanMinMax.size(); ++i)
+    {
+        const auto &Def = DefSpanMinMax[i];
+        const MinMaxStruct &MinMax = MinMaxs[i];
         MetaArrayRecMM *MetaEntry = (MetaArrayRecMM *)((char *)(MetadataBuf) + Def.MetaOffset);
         void **MMPtrLoc = (void **)(((char *)MetaEntry) + Def.MinMaxOffset);
         auto ElemSize = helper::GetDataTypeSize(Def.Type);
@@ -1286,6 +1863,20 @@ void BP5Serializer::ProcessDeferredMinMax()
         memcpy(((char *)*MMPtrLoc) + ElemSize * (2 * (Def.BlockNum)), &MinMax.MinUnion, ElemSize);
         memcpy(((char *)*MMPtrLoc) + ElemSize * (2 * (Def.BlockNum) + 1), &MinMax.MaxUnion,
                ElemSize);
+        if (Def.Histogram)
+        {
+            // its slot was filled with zeros in Marshal
+            uint64_t *Counts = BlockHistogramLoc(MetaEntry, Def.Operator, Def.BlockNum);
+            if (Def.MemSpace != MemorySpace::Host)
+            {
+                Counts[0] = HistogramMissing;
+            }
+            else if (Def.ElemCount > 0)
+            {
+                BlockHistogram(GetPtr(Def.Data.bufferIdx, Def.Data.posInBuffer), Def.ElemCount,
+                               Def.Type, MinMax, Counts);
+            }
+        }
     }
     DefSpanMinMax.clear();
 }
@@ -1339,7 +1930,7 @@ BP5Serializer::TimestepInfo BP5Serializer::CloseTimestep(int timestep, bool forc
     if (!Info.MetaFormat && Info.MetaFieldCount)
     {
         MetaMetaInfoBlock Block;
-        FMStructDescRec struct_list[20] = {
+        FMStructDescRec struct_list[40] = {
             {NULL, NULL, 0, NULL},
             {"complex4", fcomplex_field_list, sizeof(fcomplex_struct), NULL},
             {"complex8", dcomplex_field_list, sizeof(dcomplex_struct), NULL},
@@ -1360,6 +1951,36 @@ BP5Serializer::TimestepInfo BP5Serializer::CloseTimestep(int timestep, bool forc
             {"MetaArrayMM16", MetaArrayRecMM16ListPtr, sizeof(MetaArrayRecMM), NULL},
             {"MetaArrayOpMM16", MetaArrayRecOperatorMM16ListPtr, sizeof(MetaArrayRecOperatorMM),
              NULL},
+            {"MetaArrayMMSB1", MetaArrayRecMMSub1ListPtr, sizeof(MetaArrayRecMMSub), NULL},
+            {"MetaArrayOpMMSB1", MetaArrayRecOperatorMMSub1ListPtr,
+             sizeof(MetaArrayRecOperatorMMSub), NULL},
+            {"MetaArrayMMSB2", MetaArrayRecMMSub2ListPtr, sizeof(MetaArrayRecMMSub), NULL},
+            {"MetaArrayOpMMSB2", MetaArrayRecOperatorMMSub2ListPtr,
+             sizeof(MetaArrayRecOperatorMMSub), NULL},
+            {"MetaArrayMMSB4", MetaArrayRecMMSub4ListPtr, sizeof(MetaArrayRecMMSub), NULL},
+            {"MetaArrayOpMMSB4", MetaArrayRecOperatorMMSub4ListPtr,
+             sizeof(MetaArrayRecOperatorMMSub), NULL},
+            {"MetaArrayMMSB8", MetaArrayRecMMSub8ListPtr, sizeof(MetaArrayRecMMSub), NULL},
+            {"MetaArrayOpMMSB8", MetaArrayRecOperatorMMSub8ListPtr,
+             sizeof(MetaArrayRecOperatorMMSub), NULL},
+            {"MetaArrayMMSB16", MetaArrayRecMMSub16ListPtr, sizeof(MetaArrayRecMMSub), NULL},
+            {"MetaArrayOpMMSB16", MetaArrayRecOperatorMMSub16ListPtr,
+             sizeof(MetaArrayRecOperatorMMSub), NULL},
+            {"MetaArrayMMH1", MetaArrayRecMMHist1ListPtr, sizeof(MetaArrayRecMMHist), NULL},
+            {"MetaArrayOpMMH1", MetaArrayRecOperatorMMHist1ListPtr,
+             sizeof(MetaArrayRecOperatorMMHist), NULL},
+            {"MetaArrayMMH2", MetaArrayRecMMHist2ListPtr, sizeof(MetaArrayRecMMHist), NULL},
+            {"MetaArrayOpMMH2", MetaArrayRecOperatorMMHist2ListPtr,
+             sizeof(MetaArrayRecOperatorMMHist), NULL},
+            {"MetaArrayMMH4", MetaArrayRecMMHist4ListPtr, sizeof(MetaArrayRecMMHist), NULL},
+            {"MetaArrayOpMMH4", MetaArrayRecOperatorMMHist4ListPtr,
+             sizeof(MetaArrayRecOperatorMMHist), NULL},
+            {"MetaArrayMMH8", MetaArrayRecMMHist8ListPtr, sizeof(MetaArrayRecMMHist), NULL},
+            {"MetaArrayOpMMH8", MetaArrayRecOperatorMMHist8ListPtr,
+             sizeof(MetaArrayRecOperatorMMHist), NULL},
+            {"MetaArrayMMH16", MetaArrayRecMMHist16ListPtr, sizeof(MetaArrayRecMMHist), NULL},
+            {"MetaArrayOpMMH16", MetaArrayRecOperatorMMHist16ListPtr,
+             sizeof(MetaArrayRecOperatorMMHist), NULL},
             {NULL, NULL, 0, NULL}};
         struct_list[0].format_name = "MetaData";
         struct_list[0].field_list = Info.MetaFields;
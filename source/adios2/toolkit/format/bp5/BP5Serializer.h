@@ -11,6 +11,7 @@
 #include "adios2/core/Attribute.h"
 #include "adios2/core/CoreTypes.h"
 #include "adios2/core/IO.h"
+#include "adios2/helper/adiosThreadPool.h"
 #include "adios2/toolkit/format/buffer/BufferV.h"
 #include "adios2/toolkit/format/buffer/heap/BufferSTL.h"
 #include "atl.h"
@@ -20,6 +21,9 @@
 #pragma warning(disable : 4250)
 #endif
 
+#include <functional>
+#include <map>
+#include <memory>
 #include <unordered_map>
 
 namespace adios2
@@ -133,6 +137,63 @@ public:
 
     int m_StatsLevel = 1;
 
+    /*
+     * With StatsLevel > 0, blocks of global arrays larger than this many
+     * elements are divided into sub-blocks (helper::DivideBlock) and the
+     * min/max of every sub-block is added to the metadata.  0 turns this off.
+     */
+    size_t m_StatsBlockSize = 0;
+
+    /*
+     * With StatsLevel 2, every block of an array also gets a histogram of its
+     * values in this many equal-width bins between its min and max.
+     */
+    size_t m_HistogramBins = 32;
+    bool m_RowMajor = true; // layout of the application's arrays
+
+    /*
+     * Hash every array block written from host memory and, if it has the
+     * same bytes as the same block of the variable in an earlier step, point
+     * its metadata at that data (BP5Base::EncodeDedupLocation) instead of
+     * writing it again.  m_WriterStep is the absolute step being marshaled.
+     * A copy older than m_DedupMaxAge steps (0 = no limit) is not referred
+     * to, the block is written again.  With m_DedupVerify the last copy of
+     * every block is also kept in memory and compared byte for byte, so
+     * that a hash collision cannot make a block refer to other data.
+     * Without it a hash match alone is trusted.
+     */
+    bool m_DeduplicateBlocks = false;
+    size_t m_DedupMaxAge = 0;
+    bool m_DedupVerify = true;
+    size_t m_WriterStep = 0;
+
+    /*
+     * If set, Marshal offers every Sync put of a host array without operator
+     * of at least m_DirectWriteMinSize bytes to this function.  If it has
+     * written the block to the file it returns true and sets Location
+     * (BP5Base::EncodeFileLocation), and the block is not copied.
+     */
+    std::function<bool(const void *Data, size_t Length, uint64_t &Location)> m_DirectWrite;
+    size_t m_DirectWriteMinSize = 0;
+
+    /*
+     * Run operators on up to nThreads background threads.  Blocks are then
+     * compressed while the application goes on with its next Put and are
+     * added to the data buffer, in Put order, when deferred blocks are dumped.
+     * 0 compresses inside Marshal.
+     */
+    void SetCompressionThreads(size_t nThreads);
+
+    /* Counts of the work done off the Put path, for the writer's profile */
+    std::map<std::string, size_t> ProfileCounts() const;
+
+    /*
+     * Compute min/max with up to nThreads threads: large blocks are split
+     * among them and small blocks copied into the buffer are distributed
+     * over them at the end of the step.  1 computes everything in Marshal.
+     */
+    void SetStatsThreads(size_t nThreads);
+
     // Per-call accumulators for sub-Marshal profiling.  Engines may read
     // these to attribute time inside Marshal between GetMinMax, the buffer's
     // data-append path, and the rest.  Accumulate over the lifetime of the
@@ -142,7 +203,9 @@ public:
     //
     // m_BufferAppendSecs is wall time inside CurDataBuffer->AddToVec — the
     // cost is dominated by memcpy in MallocV/ChunkV and by async submit
-    // (plus memcpy) in DaosChunkV.
+    // (plus memcpy) in DaosChunkV.  Blocks copied with their min/max in one
+    // pass (host data, stats on) count that whole pass here and nothing in
+    // m_GetMinMaxSecs.
     double m_GetMinMaxSecs = 0.0;
     double m_BufferAppendSecs = 0.0;
     size_t m_BufferAppendCalls = 0;
@@ -168,6 +231,8 @@ private:
         int DimCount;
         int Type;
         size_t MinMaxOffset;
+        bool SubBlockStats = false; // metadata has per-subblock min/max
+        bool Histogram = false;     // metadata has per-block histograms
     } *BP5WriterRec;
 
     struct FFSWriterMarshalBase
@@ -198,6 +263,25 @@ private:
     };
     std::vector<DeferredExtern> DeferredExterns;
 
+    // an operated block being compressed on m_CompressionPool
+    struct PendingCompression
+    {
+        size_t MetaOffset;
+        size_t BlockID;
+        size_t AlignReq;
+        std::unique_ptr<char[]> Staged; // copy of the data of a Sync put
+        std::unique_ptr<char[]> Output;
+        size_t OutputSize = 0;
+        std::shared_future<void> Done;
+    };
+    std::vector<std::unique_ptr<PendingCompression>> PendingCompressions;
+    std::unique_ptr<helper::ThreadPool> m_CompressionPool;
+    size_t m_AsyncCompressions = 0; // blocks submitted to m_CompressionPool
+    size_t m_StatsThreads = 1;
+    std::unique_ptr<helper::ThreadPool> m_StatsPool;
+    size_t m_SplitStatsBlocks = 0;  // blocks whose min/max was split over m_StatsPool
+    size_t m_QueuedStatsBlocks = 0; // small blocks spread over it at the end of a step
+
     struct DeferredSpanMinMax
     {
         const BufferV::BufferPos Data;
@@ -207,6 +291,8 @@ private:
         const size_t MetaOffset;
         const size_t MinMaxOffset;
         const size_t BlockNum;
+        const bool Histogram; // also fill in the block's histogram slot
+        const bool Operator;
     };
     std::vector<DeferredSpanMinMax> DefSpanMinMax;
 
@@ -252,6 +338,23 @@ private:
                          const size_t *Vals);
 
     void DumpDeferredBlocks(bool forceCopyDeferred = false);
+    /* min/max of a block, and a copy of it into Dest unless that is null */
+    void BlockMinMax(const void *Data, void *Dest, size_t ElemCount, const DataType Type,
+                     const MemorySpace MemSpace, MinMaxStruct &MinMax);
+    /* add the values of a block to Counts[m_HistogramBins], binned over MinMax */
+    void BlockHistogram(const void *Data, size_t ElemCount, const DataType Type,
+                        const MinMaxStruct &MinMax, uint64_t *Counts);
+    /* sub-block divisions of a block and the min/max pairs of its sub-blocks,
+     * Div is all 1 and MinMaxs empty if the block is not divided */
+    void SubBlockMinMax(const void *Data, const DataType Type, const size_t DimCount,
+                        const size_t *Count, std::vector<uint64_t> &Div,
+                        std::vector<char> &MinMaxs);
+    PendingCompression *QueueCompression(core::VariableBase *VB, const Params &operatorParams,
+                                         const void *Data, bool Sync, DataType Type,
+                                         size_t ElemSize, size_t ElemCount, const Dims &Count,
+                                         const Dims &Offsets, size_t MetaOffset);
+    /* wait for the queued compressions and add their output to the data buffer */
+    void CollectCompressedBlocks();
     void VariableStatsEnabled(void *Variable);
 
     typedef struct _ArrayRec
@@ -262,6 +365,21 @@ private:
 
 private:
     const void *SearchDeferredBlocks(size_t MetaOffset, size_t blocknum);
+
+    // the last written copy of a block, by variable MetaOffset and block number
+    struct DedupBlock
+    {
+        uint64_t Hash;
+        size_t Length;
+        std::vector<size_t> Count;
+        uint64_t Location;       // dedup location, -1 until the data is placed
+        uint64_t Size;           // operated size
+        size_t Step;             // step that wrote the copy
+        std::vector<char> Bytes; // the copy, with m_DedupVerify
+    };
+    std::map<std::pair<size_t, size_t>, DedupBlock> m_DedupBlocks;
+    /* note where a deferred or compressed block went, once it is placed */
+    void NoteDedupLocation(size_t MetaOffset, size_t BlockID, uint64_t DataOffset, uint64_t Size);
 };
 
 } // end namespace format
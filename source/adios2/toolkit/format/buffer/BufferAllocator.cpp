@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "BufferAllocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace adios2
+{
+namespace format
+{
+
+#ifdef __linux__
+namespace
+{
+constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+/* mappings are whole pages, huge ones for HugePage whether or not
+ * MAP_HUGETLB succeeded, so that the length to unmap follows from size */
+size_t MappedSize(const BufferAllocator allocator, const size_t size)
+{
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t unit = (allocator == BufferAllocator::HugePage) ? HugePageSize : pageSize;
+    return ((std::max<size_t>(size, 1) + unit - 1) / unit) * unit;
+}
+
+void *MapBuffer(const BufferAllocator allocator, const size_t size)
+{
+    const size_t length = MappedSize(allocator, size);
+    void *p = MAP_FAILED;
+    if (allocator == BufferAllocator::HugePage)
+    {
+        // fails unless huge pages are reserved on the node
+        p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                 -1, 0);
+    }
+    if (p == MAP_FAILED)
+    {
+        p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+        {
+            return nullptr;
+        }
+        if (allocator == BufferAllocator::HugePage)
+        {
+            madvise(p, length, MADV_HUGEPAGE);
+        }
+    }
+
+    // a failed mbind (no NUMA support, not allowed) leaves the default policy
+    if (allocator == BufferAllocator::NumaLocal)
+    {
+        syscall(SYS_mbind, p, length, MPOL_LOCAL, nullptr, 0UL, 0U);
+    }
+    else if (allocator == BufferAllocator::Interleave)
+    {
+        // the kernel keeps only the nodes that exist and are allowed
+        const unsigned long allNodes = ~0UL;
+        syscall(SYS_mbind, p, length, MPOL_INTERLEAVE, &allNodes, 8 * sizeof(allNodes), 0U);
+    }
+    return p;
+}
+}
+#endif
+
+void *BufferAlloc(const BufferAllocator allocator, const size_t size) noexcept
+{
+#ifdef __linux__
+    if (allocator != BufferAllocator::Malloc)
+    {
+        return MapBuffer(allocator, size);
+    }
+#endif
+    return malloc(size);
+}
+
+void *BufferRealloc(const BufferAllocator allocator, void *ptr, const size_t oldSize,
+                    const size_t newSize) noexcept
+{
+#ifdef __linux__
+    if (allocator != BufferAllocator::Malloc)
+    {
+        if (!ptr)
+        {
+            return MapBuffer(allocator, newSize);
+        }
+        const size_t oldLength = MappedSize(allocator, oldSize);
+        const size_t newLength = MappedSize(allocator, newSize);
+        if (newLength <= oldLength)
+        {
+            // shrink in place, whole (huge) pages are given back
+            if (newLength < oldLength)
+            {
+                munmap(static_cast<char *>(ptr) + newLength, oldLength - newLength);
+            }
+            return ptr;
+        }
+        void *p = MapBuffer(allocator, newSize);
+        if (p)
+        {
+            memcpy(p, ptr, oldSize);
+            munmap(ptr, oldLength);
+        }
+        return p;
+    }
+#endif
+    return realloc(ptr, newSize);
+}
+
+void BufferFree(const BufferAllocator allocator, void *ptr, const size_t size) noexcept
+{
+#ifdef __linux__
+    if (allocator != BufferAllocator::Malloc)
+    {
+        if (ptr)
+        {
+            munmap(ptr, MappedSize(allocator, size));
+        }
+        return;
+    }
+#endif
+    free(ptr);
+}
+
+} // end namespace format
+} // end namespace adios2
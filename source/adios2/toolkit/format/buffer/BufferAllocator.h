@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ADIOS2_TOOLKIT_FORMAT_BUFFER_BUFFERALLOCATOR_H_
+#define ADIOS2_TOOLKIT_FORMAT_BUFFER_BUFFERALLOCATOR_H_
+
+#include <cstddef>
+
+namespace adios2
+{
+namespace format
+{
+
+/**
+ * Where the memory of ChunkV and MallocV buffers comes from. Except for
+ * Malloc, buffers are mapped with mmap on Linux: HugePage asks for huge
+ * pages (MAP_HUGETLB, else transparent huge pages via madvise), NumaLocal
+ * places pages on the NUMA node of the thread that first touches them and
+ * Interleave spreads them over all nodes (mbind). Elsewhere all are malloc.
+ */
+enum class BufferAllocator
+{
+    Malloc,
+    HugePage,
+    NumaLocal,
+    Interleave
+};
+
+/** At least size bytes, nullptr on failure */
+void *BufferAlloc(const BufferAllocator allocator, const size_t size) noexcept;
+
+/** Like realloc(), oldSize is the size ptr was allocated with */
+void *BufferRealloc(const BufferAllocator allocator, void *ptr, const size_t oldSize,
+                    const size_t newSize) noexcept;
+
+/** size is the size ptr was allocated with */
+void BufferFree(const BufferAllocator allocator, void *ptr, const size_t size) noexcept;
+
+} // end namespace format
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_FORMAT_BUFFER_BUFFERALLOCATOR_H_ */
@@ -20,8 +20,9 @@ namespace format
 {
 
 ChunkV::ChunkV(const std::string type, const bool AlwaysCopy, const size_t MemAlign,
-               const size_t MemBlockSize, const size_t ChunkSize)
-: BufferV(type, AlwaysCopy, MemAlign, MemBlockSize), m_ChunkSize(ChunkSize)
+               const size_t MemBlockSize, const size_t ChunkSize,
+               const BufferAllocator Allocator)
+: BufferV(type, AlwaysCopy, MemAlign, MemBlockSize), m_ChunkSize(ChunkSize), m_Allocator(Allocator)
 {
 }
 
@@ -29,7 +30,7 @@ ChunkV::~ChunkV()
 {
     for (const auto &Chunk : m_Chunks)
     {
-        free(Chunk.AllocatedPtr);
+        BufferFree(m_Allocator, Chunk.AllocatedPtr, Chunk.Size + m_MemAlign - 1);
     }
 }
 
@@ -56,7 +57,9 @@ size_t ChunkV::ChunkAlloc(Chunk &v, const size_t size)
     }
 
     // align usable buffer to m_MemAlign bytes
-    void *b = realloc(v.AllocatedPtr, actualsize + m_MemAlign - 1);
+    void *b = BufferRealloc(m_Allocator, v.AllocatedPtr,
+                            v.AllocatedPtr ? v.Size + m_MemAlign - 1 : 0,
+                            actualsize + m_MemAlign - 1);
     if (b)
     {
         if (b != v.AllocatedPtr)
@@ -11,6 +11,7 @@
 #include "adios2/common/ADIOSTypes.h"
 #include "adios2/core/CoreTypes.h"
 
+#include "adios2/toolkit/format/buffer/BufferAllocator.h"
 #include "adios2/toolkit/format/buffer/BufferV.h"
 
 namespace adios2
@@ -26,7 +27,8 @@ public:
     const size_t m_ChunkSize;
 
     ChunkV(const std::string type, const bool AlwaysCopy = false, const size_t MemAlign = 1,
-           const size_t MemBlockSize = 1, const size_t ChunkSize = DefaultBufferChunkSize);
+           const size_t MemBlockSize = 1, const size_t ChunkSize = DefaultBufferChunkSize,
+           const BufferAllocator Allocator = BufferAllocator::Malloc);
     virtual ~ChunkV();
 
     std::vector<core::iovec> DataVec() noexcept override;
@@ -65,6 +67,8 @@ protected:
      *  bytes of trailing waste. */
     bool m_NoShrink = false;
 
+    const BufferAllocator m_Allocator;
+
     struct Chunk
     {
         char *Ptr;          // aligned, do not free
@@ -19,16 +19,17 @@ namespace format
 {
 
 MallocV::MallocV(const std::string type, const bool AlwaysCopy, const size_t MemAlign,
-                 const size_t MemBlockSize, size_t InitialBufferSize, double GrowthFactor)
+                 const size_t MemBlockSize, size_t InitialBufferSize, double GrowthFactor,
+                 const BufferAllocator Allocator)
 : BufferV(type, AlwaysCopy, MemAlign, MemBlockSize), m_InitialBufferSize(InitialBufferSize),
-  m_GrowthFactor(GrowthFactor)
+  m_GrowthFactor(GrowthFactor), m_Allocator(Allocator)
 {
 }
 
 MallocV::~MallocV()
 {
     if (m_InternalBlock)
-        free(m_InternalBlock);
+        BufferFree(m_Allocator, m_InternalBlock, m_AllocatedSize);
 }
 
 void MallocV::Reset()
@@ -70,7 +71,8 @@ size_t MallocV::AddToVec(const size_t size, const void *buf, size_t align, bool
             {
                 NewSize = (size_t)(m_AllocatedSize * m_GrowthFactor);
             }
-            m_InternalBlock = (char *)realloc(m_InternalBlock, NewSize);
+            m_InternalBlock =
+                (char *)BufferRealloc(m_Allocator, m_InternalBlock, m_AllocatedSize, NewSize);
             m_AllocatedSize = NewSize;
         }
 #ifdef ADIOS2_HAVE_GPU_SUPPORT
@@ -118,7 +120,8 @@ BufferV::BufferPos MallocV::Allocate(const size_t size, size_t align)
         {
             NewSize = (size_t)(m_AllocatedSize * m_GrowthFactor);
         }
-        m_InternalBlock = (char *)realloc(m_InternalBlock, NewSize);
+        m_InternalBlock =
+            (char *)BufferRealloc(m_Allocator, m_InternalBlock, m_AllocatedSize, NewSize);
         m_AllocatedSize = NewSize;
     }
 
@@ -11,6 +11,7 @@
 #include "adios2/common/ADIOSTypes.h"
 #include "adios2/core/CoreTypes.h"
 
+#include "adios2/toolkit/format/buffer/BufferAllocator.h"
 #include "adios2/toolkit/format/buffer/BufferV.h"
 
 namespace adios2
@@ -25,7 +26,8 @@ public:
 
     MallocV(const std::string type, const bool AlwaysCopy = false, const size_t MemAlign = 1,
             const size_t MemBlockSize = 1, size_t InitialBufferSize = DefaultInitialBufferSize,
-            double GrowthFactor = DefaultBufferGrowthFactor);
+            double GrowthFactor = DefaultBufferGrowthFactor,
+            const BufferAllocator Allocator = BufferAllocator::Malloc);
     virtual ~MallocV();
 
     virtual std::vector<core::iovec> DataVec() noexcept;
@@ -49,6 +51,7 @@ private:
     size_t m_AllocatedSize = 0;
     const size_t m_InitialBufferSize = 16 * 1024;
     const double m_GrowthFactor = 1.05;
+    const BufferAllocator m_Allocator = BufferAllocator::Malloc;
 };
 
 } // end namespace format
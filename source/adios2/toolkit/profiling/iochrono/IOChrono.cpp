@@ -67,6 +67,7 @@ JSONProfiler::JSONProfiler(helper::Comm const &comm) : m_Comm(comm)
     AddTimerWatch("BS_WaitOnAsync");
 
     AddTimerWatch("WriteData"); // called by Flush and EndStep
+    AddTimerWatch("DirectWrite"); // BP5 blocks written inside Put
 
     AddTimerWatch("WriteMD", false); // for BP5's two WriteMetadata()
     AddTimerWatch("WriteMmD", false);
@@ -136,6 +137,10 @@ std::string JSONProfiler::GetRankProfilingJSON(
     rankLog += ", \"databytes\":" + std::to_string(DataBytes);
     rankLog += ", \"metadatabytes\":" + std::to_string(MetaDataBytes);
     rankLog += ", \"metametadatabytes\":" + std::to_string(MetaMetaDataBytes);
+    for (const auto &count : m_Counts)
+    {
+        rankLog += ", \"" + count.first + "\":" + std::to_string(count.second);
+    }
 
     const size_t transportsSize = transportsTypes.size();
 
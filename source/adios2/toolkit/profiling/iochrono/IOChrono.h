@@ -8,6 +8,7 @@
 #define ADIOS2_TOOLKIT_PROFILING_IOCHRONO_IOCHRONO_H_
 
 /// \cond EXCLUDE_FROM_DOXYGEN
+#include <map>
 #include <unordered_map>
 #include <vector>
 /// \endcond
@@ -77,6 +78,8 @@ public:
     {
         m_Profiler.m_Bytes[process] += bytes;
     };
+    /** Count n events of a kind, reported as "name":count of the rank */
+    void AddCount(const std::string &name, size_t n = 1) { m_Counts[name] += n; };
 
     std::string GetRankProfilingJSON(
         const std::vector<std::string> &transportsTypes,
@@ -87,6 +90,7 @@ public:
 
 private:
     IOChrono m_Profiler;
+    std::map<std::string, size_t> m_Counts;
     int m_RankMPI = 0;
     helper::Comm const &m_Comm;
 };
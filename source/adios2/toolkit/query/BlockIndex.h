@@ -75,11 +75,42 @@ public:
                 if (!query.TouchSelection(ss, cc))
                     continue;
 
-                if (isHit)
+                if (blockInfo.SubBlockCount > 1)
                 {
-                    adios2::Box<adios2::Dims> box = {ss, cc};
-                    hitBlocks.push_back(BlockHit(blockInfo.BlockID, box));
+                    // return only the sub-blocks that hit, unless all of them do
+                    adios2::helper::BlockDivisionInfo subBlockInfo;
+                    subBlockInfo.Div.assign(blockInfo.SubBlockDiv,
+                                            blockInfo.SubBlockDiv + MinBlocksInfo->Dims);
+                    adios2::helper::CalculateSubblockInfo(cc, subBlockInfo);
+                    const T *subMinMax = static_cast<const T *>(blockInfo.SubMinMax);
+                    bool allCovered = true;
+                    BlockHit tmp(blockInfo.BlockID);
+                    for (unsigned int i = 0; i < subBlockInfo.NBlocks; i++)
+                    {
+                        T smin = subMinMax[2 * i];
+                        T smax = subMinMax[2 * i + 1];
+                        if (!query.m_RangeTree.CheckInterval(smin, smax))
+                        {
+                            allCovered = false;
+                            continue;
+                        }
+                        adios2::Box<adios2::Dims> currSubBlock =
+                            adios2::helper::GetSubBlock(cc, subBlockInfo, i);
+                        for (size_t d = 0; d < cc.size(); ++d)
+                            currSubBlock.first[d] += ss[d];
+                        if (query.TouchSelection(currSubBlock.first, currSubBlock.second))
+                            tmp.m_Regions.push_back(currSubBlock);
+                    }
+                    if (!allCovered)
+                    {
+                        if (!tmp.m_Regions.empty())
+                            hitBlocks.push_back(tmp);
+                        continue;
+                    }
                 }
+
+                adios2::Box<adios2::Dims> box = {ss, cc};
+                hitBlocks.push_back(BlockHit(blockInfo.BlockID, box));
             }
             else
             { // local array
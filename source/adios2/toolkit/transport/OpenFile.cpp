@@ -37,6 +37,7 @@
 #include "adios2/toolkit/transport/file/FileFStream.h"
 #ifndef _WIN32
 #include "adios2/toolkit/transport/file/FileHTTP.h"
+#include "adios2/toolkit/transport/file/FileMMAP.h"
 #endif
 #ifdef ADIOS2_HAVE_OPENSSL
 #include "adios2/toolkit/transport/file/FileHTTPS.h"
@@ -152,6 +153,16 @@ std::shared_ptr<Transport> OpenFileImpl(helper::Comm const &comm, const std::str
                     library + " transport does not support buffered I/O.");
             }
         }
+        else if (library == "mmap")
+        {
+            transport = std::make_shared<transport::FileMMAP>(comm);
+            if (lf_GetBuffered("false"))
+            {
+                helper::Throw<std::invalid_argument>(
+                    "Toolkit", "transport", "OpenFile",
+                    library + " transport does not support buffered I/O.");
+            }
+        }
 #endif
 #ifdef ADIOS2_HAVE_OPENSSL
         else if (library == "https")
@@ -77,6 +77,25 @@ void Transport::WriteV(const core::iovec *iov, const int iovcnt, size_t start)
     }
 }
 
+void Transport::ReadV(const ReadOp *ops, const size_t nOps)
+{
+    for (size_t i = 0; i < nOps; ++i)
+    {
+        Read(ops[i].Buffer, ops[i].Size, ops[i].Start);
+    }
+}
+
+void Transport::SubmitReads(const ReadOp *ops, const size_t nOps) { ReadV(ops, nOps); }
+
+void Transport::WaitReads() {}
+
+const char *Transport::DataPointer(const size_t /*start*/, const size_t /*size*/)
+{
+    return nullptr;
+}
+
+void Transport::ReleaseDataPointer(const char * /*pointer*/) {}
+
 void Transport::InitProfiler(const Mode openMode, const TimeUnit timeUnit)
 {
     m_Profiler.m_IsActive = true;
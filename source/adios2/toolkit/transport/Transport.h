@@ -44,6 +44,14 @@ public:
         // TODO add more thing...time?
     };
 
+    /** One read of a batch: Size bytes at position Start into Buffer */
+    struct ReadOp
+    {
+        char *Buffer;
+        size_t Size;
+        size_t Start;
+    };
+
     /**
      * Base constructor that all derived classes pass
      * @param type from derived class
@@ -122,6 +130,36 @@ public:
      */
     virtual void Read(char *buffer, size_t size, size_t start = 0) = 0;
 
+    /**
+     * Reads a batch of independent ranges, returns when all are complete.
+     * The default calls Read for each in order; transports that can keep
+     * several reads in flight override it.
+     * @param ops array of reads, buffers must be preallocated and disjoint
+     * @param nOps number of entries
+     */
+    virtual void ReadV(const ReadOp *ops, const size_t nOps);
+
+    /**
+     * Starts a batch of reads and may return before they are complete. The
+     * buffers must stay valid until WaitReads returns. The default is a
+     * blocking ReadV.
+     */
+    virtual void SubmitReads(const ReadOp *ops, const size_t nOps);
+
+    /** Waits for all reads started by SubmitReads, does nothing by default */
+    virtual void WaitReads();
+
+    /**
+     * Transports that hold the file contents in memory (e.g. mapped) return
+     * where "size" bytes from position "start" can be read in place, valid
+     * until it is given back with ReleaseDataPointer. Others, and ranges that
+     * are not available, give nullptr and must go through Read.
+     */
+    virtual const char *DataPointer(const size_t start, const size_t size);
+
+    /** Gives back a pointer returned by DataPointer, does nothing by default */
+    virtual void ReleaseDataPointer(const char *pointer);
+
     /**
      * Returns the size of current data in transport
      * @return size as size_t
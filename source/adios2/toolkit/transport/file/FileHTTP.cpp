@@ -5,38 +5,32 @@
  */
 
 #include "FileHTTP.h"
+#include "adios2/helper/adiosLog.h"
+#include "adios2/helper/adiosString.h"
+
 #include <cstring>
-#ifdef _MSC_VER
-#define FD_SETSIZE 1024
-#include <process.h>
-#include <time.h>
-#include <winsock2.h>
-
-#include <windows.h>
-#define getpid() _getpid()
-#define read(fd, buf, len) recv(fd, (buf), (len), 0)
-#define write(fd, buf, len) send(fd, buf, (len), 0)
-#define close(x) closesocket(x)
-#define INST_ADDRSTRLEN 50
-#else
-#include <cstring>
-#ifndef _WIN32
-#include <netdb.h>
-#endif
-#include <unistd.h>
-#endif
+#include <vector>
+
 namespace adios2
 {
 namespace transport
 {
 
-FileHTTP::FileHTTP(helper::Comm const &comm) : Transport("File", "HTTP", comm) {}
+FileHTTP::FileHTTP(helper::Comm const &comm)
+: Transport("File", "HTTP", comm),
+  m_Client([]() { return std::unique_ptr<HTTPConnection>(new HTTPTCPConnection()); })
+{
+    // the connection pool is shared by concurrent reads
+    m_ReentrantRead = true;
+}
 
-FileHTTP::~FileHTTP()
+FileHTTP::~FileHTTP() { m_Client.Close(); }
+
+void FileHTTP::SetParameters(const Params &params)
 {
-    if (m_IsOpen)
-    {
-    }
+    helper::SetParameterValue("hostname", params, m_hostname);
+    helper::SetParameterValueInt("port", params, m_server_port, "in call to FileHTTP");
+    m_Client.SetParameters(params);
 }
 
 void FileHTTP::WaitForOpen()
@@ -44,7 +38,7 @@ void FileHTTP::WaitForOpen()
     if (m_IsOpening)
     {
         m_IsOpening = false;
-        CheckFile("couldn't open file " + m_Name + ", in call to POSIX open");
+        CheckFile("couldn't open file " + m_Name + ", in call to HTTP open");
         m_IsOpen = true;
     }
 }
@@ -52,42 +46,19 @@ void FileHTTP::WaitForOpen()
 void FileHTTP::Open(const std::string &name, const Mode openMode, const bool async,
                     const bool directio)
 {
-    struct protoent *protoent;
-    struct hostent *hostent;
-    uint32_t addr_tmp;
-
     m_Name = name;
-    /* Build the socket. */
-    protoent = getprotobyname("tcp");
-    if (protoent == NULL)
-    {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Open",
-                                              "cannot make getprotobyname");
-    }
-    m_p_proto = protoent->p_proto;
-
-    /* get from parameters. Where the proxy should run*/
-
-    /* Build the address. */
-#define _WINSOCK_DEPRECATED_NO_WARNINGS 1
-    hostent = gethostbyname(m_hostname.c_str());
-    if (hostent == NULL)
-    {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Open",
-                                              "error: gethostbyname " + m_hostname);
-    }
-    addr_tmp = inet_addr(inet_ntoa(*(struct in_addr *)*(hostent->h_addr_list)));
-    if (addr_tmp == INADDR_NONE)
-    {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Open",
-                                              "error: inet_addr " +
-                                                  std::string(*(hostent->h_addr_list)));
-    }
-    sockaddr_in.sin_addr.s_addr = addr_tmp;
-    sockaddr_in.sin_family = AF_INET;
-    sockaddr_in.sin_port = htons(m_server_port);
-
-    return;
+    m_OpenMode = openMode;
+    std::string hostname = m_hostname;
+    uint16_t port = static_cast<uint16_t>(m_server_port);
+    std::string path = name;
+    if (name.find("://") != std::string::npos)
+    {
+        // http://host[:port]/path overrides the hostname and port parameters
+        path.clear();
+        HTTPClient::SplitURL(name, hostname, port, path);
+    }
+    m_Client.SetServer(hostname, port, path);
+    m_IsOpen = true;
 }
 
 void FileHTTP::OpenChain(const std::string &name, Mode openMode, const helper::Comm &chainComm,
@@ -194,122 +165,41 @@ void FilePOSIX::WriteV(const core::iovec *iov, const int iovcnt, size_t start)
 
 void FileHTTP::Read(char *buffer, size_t size, size_t start)
 {
-    /* not using BUFSIZ, the server might use another value for that */
-    const size_t BUF_SIZE = 8192;
-    enum CONSTEXPR
-    {
-        MAX_REQUEST_LEN = 1024
-    };
-    char request[MAX_REQUEST_LEN] = {'\0'};
-    int request_len = snprintf(request, MAX_REQUEST_LEN, request_template.c_str(), m_Name.c_str(),
-                               m_hostname.c_str(), start, start + size - 1);
-    if (request_len >= MAX_REQUEST_LEN)
+    if (size == 0)
     {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Read",
-                                              "request length too long:  " +
-                                                  std::to_string(request_len));
+        return;
     }
-    m_socketFileDescriptor = socket(AF_INET, SOCK_STREAM, m_p_proto);
-    if (m_socketFileDescriptor == -1)
-    {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Read",
-                                              "cannot open socket");
-    }
-    /* Actually connect. */
-    if (connect(m_socketFileDescriptor, (struct sockaddr *)&sockaddr_in, sizeof(sockaddr_in)) == -1)
-    {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Read",
-                                              "cannot connect");
-    }
-    /* Send HTTP request. */
-    int nbytes_total = 0;
-    while (nbytes_total < request_len)
+    ProfilerStart("read");
+    m_Client.Read(buffer, size, start + m_BaseOffset);
+    ProfilerStop("read");
+}
+
+void FileHTTP::ReadV(const ReadOp *ops, const size_t nOps)
+{
+    ProfilerStart("read");
+    if (m_BaseOffset)
     {
-        int nbytes_last =
-            write(m_socketFileDescriptor, request + nbytes_total, request_len - nbytes_total);
-        if (nbytes_last == -1)
+        std::vector<ReadOp> shifted(ops, ops + nOps);
+        for (auto &op : shifted)
         {
-            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Read",
-                                                  "cannot send request");
+            op.Start += m_BaseOffset;
         }
-        nbytes_total += nbytes_last;
+        m_Client.ReadV(shifted.data(), nOps);
     }
-
-    /* Read the response. */
-    size_t bytes_recd = 0;
-    while (bytes_recd < size)
+    else
     {
-        size_t remaining = size - bytes_recd;
-        int read_len = (int)(remaining < BUF_SIZE ? remaining : BUF_SIZE);
-        nbytes_total = read(m_socketFileDescriptor, buffer + bytes_recd, read_len);
-        if (nbytes_total == -1)
-        {
-            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Read",
-                                                  "cannot get response");
-        }
-        bytes_recd += nbytes_total;
+        m_Client.ReadV(ops, nOps);
     }
-
-    close(m_socketFileDescriptor);
-    return;
+    ProfilerStop("read");
 }
 
 size_t FileHTTP::GetSize()
 {
-    char request_template[] = "GET %s HTTP/1.1\r\nHost: %s\r\nContent-Length: bytes\r\n\r\n";
-    enum CONSTEXPR
-    {
-        MAX_REQUEST_LEN = 1024,
-        BUF_SIZE = 128
-    };
-    char request[MAX_REQUEST_LEN];
-    char buffer[BUF_SIZE] = {'\0'};
-    int request_len =
-        snprintf(request, MAX_REQUEST_LEN, request_template, m_Name.c_str(), m_hostname.c_str());
-    if (request_len >= MAX_REQUEST_LEN)
-    {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "GetSize",
-                                              "request length too long:  " +
-                                                  std::to_string(request_len));
-    }
-    m_socketFileDescriptor = socket(AF_INET, SOCK_STREAM, m_p_proto);
-    if (m_socketFileDescriptor == -1)
+    if (m_BaseSize > 0)
     {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "GetSize",
-                                              "cannot bind socket");
+        return m_BaseSize;
     }
-    /* Actually connect. */
-    if (connect(m_socketFileDescriptor, (struct sockaddr *)&sockaddr_in, sizeof(sockaddr_in)) == -1)
-    {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "GetSize",
-                                              "cannot connect");
-    }
-    /* Send HTTP request. */
-    int nbytes_total = 0;
-    while (nbytes_total < request_len)
-    {
-        int nbytes_last =
-            write(m_socketFileDescriptor, request + nbytes_total, request_len - nbytes_total);
-        if (nbytes_last == -1)
-        {
-            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "GetSize",
-                                                  "sending request failed");
-        }
-        nbytes_total += nbytes_last;
-    }
-
-    /* Read the response. */
-    while ((nbytes_total = read(m_socketFileDescriptor, buffer, BUF_SIZE)) > 0)
-        ;
-    if (nbytes_total == -1)
-    {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "GetSize",
-                                              "receiving response failed");
-    }
-    close(m_socketFileDescriptor);
-    size_t result = atoi(buffer);
-
-    return result;
+    return m_Client.GetSize();
 }
 
 void FileHTTP::Flush()
@@ -318,15 +208,19 @@ void FileHTTP::Flush()
      * slows down IO performance */
 }
 
-void FileHTTP::Close() { return; }
+void FileHTTP::Close()
+{
+    m_Client.Close();
+    m_IsOpen = false;
+}
 
 void FileHTTP::Delete() { return; }
 
 void FileHTTP::CheckFile(const std::string hint) const
 {
-    if (m_socketFileDescriptor == -1)
+    if (m_Errno)
     {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FilePOSIX", "CheckFile",
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "CheckFile",
                                               hint + SysErrMsg());
     }
 }
@@ -7,28 +7,9 @@
 #ifndef ADIOS2_FILEHTTP_H
 #define ADIOS2_FILEHTTP_H
 
-#ifdef _WIN32
-#ifndef FD_SET_SIZE
-#define FD_SETSIZE 1024
-#endif
-#include <winsock2.h>
-#endif
 #include "../Transport.h"
+#include "HTTPClient.h"
 #include "adios2/common/ADIOSConfig.h"
-#ifdef _MSC_VER
-#include <process.h>
-#include <time.h>
-#include <windows.h>
-#define getpid() _getpid()
-#else
-#ifndef _WIN32
-#include <arpa/inet.h>
-#include <netinet/in.h>
-#include <sys/socket.h>
-#endif
-
-#define SOCKET int
-#endif
 
 namespace adios2
 {
@@ -39,7 +20,10 @@ class Comm;
 namespace transport
 {
 
-/** File descriptor transport using the POSIX IO library */
+/**
+ * Read-only transport for files on an HTTP server, with range requests over
+ * a pool of keep-alive connections (see HTTPClient)
+ */
 class FileHTTP : public Transport
 {
 
@@ -48,6 +32,9 @@ public:
 
     ~FileHTTP();
 
+    /** hostname, port, and the HTTPClient parameters */
+    void SetParameters(const Params &parameters) final;
+
     void Open(const std::string &name, const Mode openMode, const bool async = false,
               const bool directio = false) final;
 
@@ -63,6 +50,9 @@ public:
 
     void Read(char *buffer, size_t size, size_t start = 0) final;
 
+    /** Multi-range requests, pipelined over several connections */
+    void ReadV(const ReadOp *ops, const size_t nOps) final;
+
     size_t GetSize() final;
 
     /** Does nothing, each write is supposed to flush */
@@ -85,17 +75,11 @@ public:
     void MkDir(const std::string &fileName) final;
 
 private:
-    /** POSIX file handle returned by Open */
-    SOCKET m_socketFileDescriptor = -1;
     int m_Errno = 0;
     bool m_IsOpening = false;
-    /* if filename is very lomg, we can get lout from array boundaries */
-    std::string request_template = "GET %s HTTP/1.1\r\nHost: %s\r\nRange: bytes=%d-%d\r\n\r\n";
     std::string m_hostname = "localhost";
     int m_server_port = 9999;
-    struct sockaddr_in sockaddr_in;
-    /* protocol number */
-    int m_p_proto;
+    HTTPClient m_Client;
 
     /**
      * Check if m_FileDescriptor is -1 after an operation
@@ -17,41 +17,30 @@ namespace adios2
 namespace transport
 {
 
-void ParseURL(const std::string &url, std::string &hostname, std::string &path)
+namespace
 {
-    const std::string httpsPrefix = "https://";
-    size_t pos = 0;
-
-    // Skip scheme if present
-    if (url.rfind(httpsPrefix, 0) == 0)
-        pos = httpsPrefix.size();
-
-    // Find first '/' after hostname
-    size_t slashPos = url.find('/', pos);
-    if (slashPos == std::string::npos)
-    {
-        hostname = url.substr(pos);
-        path = "";
-    }
-    else
+class HTTPSSLConnection : public HTTPConnection
+{
+public:
+    void Connect(const std::string &hostname, uint16_t port) final
     {
-        hostname = url.substr(pos, slashPos - pos);
-        path = url.substr(slashPos);
+        m_SSL.Connect(hostname, port);
     }
+    void Close() final { m_SSL.Close(); }
+    int Send(const char *buffer, int size) final { return m_SSL.Write(buffer, size); }
+    int Recv(char *buffer, int size) final { return m_SSL.Read(buffer, size); }
+
+private:
+    helper::SSLSocket m_SSL;
+};
 }
 
-std::string ExtractHeaderValue(const std::string &headers, const std::string &key)
+FileHTTPS::FileHTTPS(helper::Comm const &comm)
+: Transport("File", "HTTPS", comm),
+  m_Client([]() { return std::unique_ptr<HTTPConnection>(new HTTPSSLConnection()); })
 {
-    size_t pos = headers.find(key);
-    if (pos == std::string::npos)
-        return "";
-    pos += key.size();
-    size_t end = headers.find("\r\n", pos);
-    return headers.substr(pos, end - pos);
 }
 
-FileHTTPS::FileHTTPS(helper::Comm const &comm) : Transport("File", "HTTPS", comm) {}
-
 FileHTTPS::~FileHTTPS() { Close(); }
 
 void FileHTTPS::SetParameters(const Params &params)
@@ -64,6 +53,7 @@ void FileHTTPS::SetParameters(const Params &params)
     helper::SetParameterValue("path", params, m_path);
     helper::SetParameterValueInt("verbose", params, m_Verbose, "");
     helper::SetParameterValue("filenameintar", params, m_FileNameInTar);
+    m_Client.SetParameters(params);
 
     std::string recheckStr = "true";
     helper::SetParameterValue("recheck_metadata", params, recheckStr);
@@ -197,8 +187,9 @@ void FileHTTPS::Open(const std::string &name, const Mode openMode, const bool as
 {
     if (m_hostname.empty())
     {
-        ParseURL(name, m_hostname, m_path);
+        HTTPClient::SplitURL(name, m_hostname, m_server_port, m_path);
     }
+    m_Client.SetServer(m_hostname, m_server_port, m_path);
     if (m_Verbose)
     {
         std::cout << "FileHTTPS::Open( hostname = " << m_hostname << ", path = " << m_path << ")\n";
@@ -250,55 +241,10 @@ void FileHTTPS::Read(char *buffer, size_t size, size_t start)
         return;
     }
 
-    const size_t BUF_SIZE = 8192;
-    std::string request = "GET " + m_path + " HTTP/1.1\r\nHost: " + m_hostname +
-                          "\r\nRange: bytes=" + std::to_string(start + m_BaseOffset) + "-" +
-                          std::to_string(start + m_BaseOffset + size - 1) + "\r\n\r\n";
-
-    m_ssl.Connect(m_hostname, m_server_port);
-
-    if (m_Verbose > 1)
-    {
-        std::cout << "FileHTTPS::Read Request: [" << request << "]" << std::endl;
-    }
-
-    m_ssl.Write(request.c_str(), (int)request.size());
-
-    // first we have to read and parse the header to get to the actual data bytes
-    bool headerParsed = false;
-    std::string response;
-    int bytes;
-    char buf[BUF_SIZE];
-    size_t bytes_recd = 0;
-    while (!headerParsed)
-    {
-        bytes = m_ssl.Read(buf, sizeof(buf));
-        response.append(buf, bytes);
-        size_t headerEnd = response.find("\r\n\r\n");
-        if (headerEnd != std::string::npos)
-        {
-            headerParsed = true;
-            size_t bodyStart = headerEnd + 4;
-            size_t bodyLength = response.size() - bodyStart;
-            memcpy(buffer, response.data() + bodyStart, bodyLength);
-            bytes_recd = bodyLength;
-        }
-    }
-
-    while (bytes_recd < size)
-    {
-        int read_len = (int)((size - bytes_recd) < BUF_SIZE ? (size - bytes_recd) : BUF_SIZE);
-        int nbytes = m_ssl.Read(buffer + bytes_recd, read_len);
-        if (nbytes <= 0)
-        {
-            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTPS", "Read",
-                                                  "SSL_read failed");
-        }
-        bytes_recd += nbytes;
-    }
+    m_Client.Read(buffer, size, start + m_BaseOffset);
     if (m_Verbose > 0)
     {
-        std::cout << "FileHTTPS::Read Downloaded " << bytes_recd << " bytes.\n";
+        std::cout << "FileHTTPS::Read Downloaded " << size << " bytes.\n";
     }
     /* Save to cache */
     if (m_CachingThisFile)
@@ -311,55 +257,42 @@ void FileHTTPS::Read(char *buffer, size_t size, size_t start)
                       << " start = " << m_SeekPos << " size = " << size << std::endl;
         }
     }
-    m_ssl.Close();
 }
 
-size_t FileHTTPS::GetSize()
+void FileHTTPS::ReadV(const ReadOp *ops, const size_t nOps)
 {
-
-    if (m_IsCached && !m_RecheckMetadata)
+    if (m_IsCached || m_CachingThisFile)
     {
-        return m_Size;
+        // one by one through the cache
+        Transport::ReadV(ops, nOps);
+        return;
     }
-
-    if (m_BaseSize > 0)
+    std::vector<ReadOp> shifted(ops, ops + nOps);
+    for (auto &op : shifted)
     {
-        return m_BaseSize;
+        op.Start += m_BaseOffset;
     }
+    m_Client.ReadV(shifted.data(), nOps);
+}
 
-    m_ssl.Connect(m_hostname, m_server_port);
-
-    std::string request =
-        "HEAD " + m_path + " HTTP/1.1\r\nHost: " + m_hostname + "\r\nConnection: close\r\n\r\n";
+size_t FileHTTPS::GetSize()
+{
 
-    if (m_Verbose > 1)
+    if (m_IsCached && !m_RecheckMetadata)
     {
-        std::cout << "FileHTTPS::GetSize Request: [" << request << "]" << std::endl;
+        return m_Size;
     }
-    m_ssl.Write(request.c_str(), (int)request.size());
 
-    char buffer[4096] = {0};
-    int nbytes = m_ssl.Read(buffer, sizeof(buffer) - 1);
-    buffer[nbytes] = '\0';
-    if (nbytes <= 0)
+    if (m_BaseSize > 0)
     {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTPS", "GetSize",
-                                              "failed to read HEAD response");
+        return m_BaseSize;
     }
 
-    std::string headers(buffer);
-    if (m_Verbose > 1)
-    {
-        std::cout << "Headers: " << headers << "\n";
-    }
-    std::string cl = ExtractHeaderValue(headers, "Content-Length: ");
-    m_fileSize = cl.empty() ? 0 : std::stoul(cl);
+    m_fileSize = m_Client.GetSize();
     if (m_Verbose > 0)
     {
         std::cout << "File size: " << m_fileSize << " bytes\n";
     }
-
-    m_ssl.Close();
     return m_fileSize;
 }
 
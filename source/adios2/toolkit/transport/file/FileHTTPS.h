@@ -9,8 +9,8 @@
 
 #include "../Transport.h"
 #include "./FileFStream.h"
+#include "./HTTPClient.h"
 #include "adios2/common/ADIOSConfig.h"
-#include "adios2/helper/adiosNetwork.h" // NetworkSocket
 
 namespace adios2
 {
@@ -30,7 +30,7 @@ public:
 
     ~FileHTTPS();
 
-    void SetParameters(const Params &parameters);
+    void SetParameters(const Params &parameters) final;
 
     void Open(const std::string &name, const Mode openMode, const bool async = false,
               const bool directio = false) final;
@@ -42,6 +42,9 @@ public:
 
     void Read(char *buffer, size_t size, size_t start = 0) final;
 
+    /** Multi-range requests, pipelined over several connections */
+    void ReadV(const ReadOp *ops, const size_t nOps) final;
+
     size_t GetSize() final;
 
     void Flush() final{};
@@ -65,13 +68,11 @@ public:
 private:
     std::string m_hostname, m_path;
     uint16_t m_server_port = 443; // HTTPS default
-    helper::SSLSocket m_ssl;
+    HTTPClient m_Client;
 
     int m_Errno = 0;
     bool m_IsOpening = false;
 
-    std::string request_template = "GET %s HTTP/1.1\r\nHost: %s\r\nRange: bytes=%d-%d\r\n\r\n";
-
     size_t m_fileSize = 0;
 
     void CheckFile(const std::string hint) const;
@@ -0,0 +1,354 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ *
+ * FileMMAP.cpp read-only file access through mmap
+ *
+ */
+#include "FileMMAP.h"
+#include "adios2/helper/adiosLog.h"
+#include "adios2/helper/adiosString.h"
+
+#include <algorithm> // std::max
+#include <chrono>
+#include <cstdio>  // remove
+#include <cstring> // memcpy, strerror
+#include <thread>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace adios2
+{
+namespace transport
+{
+
+FileMMAP::FileMMAP(helper::Comm const &comm) : Transport("File", "mmap", comm)
+{
+    m_ReentrantRead = true;
+}
+
+FileMMAP::~FileMMAP()
+{
+    if (m_IsOpen)
+    {
+        Unmap();
+        close(m_FileDescriptor);
+    }
+}
+
+void FileMMAP::Open(const std::string &name, const Mode openMode, const bool /*async*/,
+                    const bool /*directio*/)
+{
+    m_Name = name;
+    CheckName();
+    m_OpenMode = openMode;
+    if (m_OpenMode != Mode::Read)
+    {
+        helper::Throw<std::invalid_argument>("Toolkit", "transport::file::FileMMAP", "Open",
+                                             "the mmap transport only supports Mode::Read, "
+                                             "can't open " +
+                                                 m_Name);
+    }
+
+    ProfilerStart("open");
+    errno = 0;
+    m_FileDescriptor = open(m_Name.c_str(), O_RDONLY);
+    const int localErrno = errno;
+    ProfilerStop("open");
+    CheckFile("couldn't open file " + m_Name + ", in call to mmap open", localErrno);
+    m_CurrentPos = 0;
+    m_IsOpen = true;
+}
+
+void FileMMAP::OpenChain(const std::string &name, Mode openMode, const helper::Comm &chainComm,
+                         const bool async, const bool directio)
+{
+    // reading needs no ordering among the processes
+    Open(name, openMode, async, directio);
+}
+
+void FileMMAP::Write(const char * /*buffer*/, size_t /*size*/, size_t /*start*/)
+{
+    helper::Throw<std::invalid_argument>("Toolkit", "transport::file::FileMMAP", "Write",
+                                         "the mmap transport is read-only, can't write to " +
+                                             m_Name);
+}
+
+const char *FileMMAP::Mapped(const size_t start, const size_t size)
+{
+    std::lock_guard<std::mutex> lock(m_MapMutex);
+    if (start + size <= m_MapSize)
+    {
+        ++m_Pinned;
+        return m_Map;
+    }
+
+    // the file may have grown since it was mapped (a reader following a writer)
+    struct stat fileStat;
+    if (fstat(m_FileDescriptor, &fileStat) == -1)
+    {
+        const int localErrno = errno;
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileMMAP", "Mapped",
+                                              "couldn't get size of file " + m_Name +
+                                                  ": errno = " + std::to_string(localErrno) +
+                                                  ": " + strerror(localErrno));
+    }
+    const size_t fileSize = static_cast<size_t>(fileStat.st_size);
+    if (start + size > fileSize)
+    {
+        return nullptr;
+    }
+    if (fileSize <= m_MapCapacity)
+    {
+        // a shared mapping sees the file grow into it, pointers stay valid
+        m_MapSize = fileSize;
+        ++m_Pinned;
+        return m_Map;
+    }
+
+    // doubled, so that a file read while it is written is not mapped again on
+    // every step and the mappings kept while pinned stay within twice its size
+    const size_t capacity = (std::max)(fileSize, 2 * m_MapCapacity);
+    errno = 0;
+    void *map = mmap(nullptr, capacity, PROT_READ, MAP_SHARED, m_FileDescriptor, 0);
+    if (map == MAP_FAILED)
+    {
+        const int localErrno = errno;
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileMMAP", "Mapped",
+                                              "couldn't map file " + m_Name + ": errno = " +
+                                                  std::to_string(localErrno) + ": " +
+                                                  strerror(localErrno));
+    }
+    int advice = MADV_NORMAL;
+    if (m_Advice == "sequential")
+    {
+        advice = MADV_SEQUENTIAL;
+    }
+    else if (m_Advice == "random")
+    {
+        advice = MADV_RANDOM;
+    }
+    else if (m_Advice == "willneed")
+    {
+        advice = MADV_WILLNEED;
+    }
+    // only a hint, failure changes nothing
+    madvise(map, fileSize, advice);
+
+    if (m_Map)
+    {
+        m_OldMaps.emplace_back(m_Map, m_MapCapacity);
+    }
+    m_Map = static_cast<const char *>(map);
+    m_MapSize = fileSize;
+    m_MapCapacity = capacity;
+    ++m_Pinned;
+    return m_Map;
+}
+
+void FileMMAP::Unpin()
+{
+    std::lock_guard<std::mutex> lock(m_MapMutex);
+    if (--m_Pinned == 0)
+    {
+        for (const auto &old : m_OldMaps)
+        {
+            munmap(const_cast<char *>(old.first), old.second);
+        }
+        m_OldMaps.clear();
+    }
+}
+
+void FileMMAP::Read(char *buffer, size_t size, size_t start)
+{
+    if (start == MaxSizeT)
+    {
+        start = m_CurrentPos;
+    }
+    if (size == 0)
+    {
+        return;
+    }
+
+    ProfilerStart("read");
+    const char *map = Mapped(m_BaseOffset + start, size);
+    // past the end of file, wait for the data as FilePOSIX does
+    size_t backoff_ns = 20;
+    while (!map)
+    {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(backoff_ns));
+        backoff_ns *= 2;
+        if (m_FailOnEOF)
+        {
+            if (std::chrono::nanoseconds(backoff_ns) > std::chrono::seconds(30))
+            {
+                ProfilerStop("read");
+                helper::Throw<std::ios_base::failure>(
+                    "Toolkit", "transport::file::FileMMAP", "Read",
+                    "Read past end of file on " + m_Name + " trying to read " +
+                        std::to_string(size) + " bytes at " + std::to_string(start));
+            }
+        }
+        else
+        {
+            constexpr size_t backoff_limit = 500 * 1000 * 1000;
+            if (backoff_ns > backoff_limit)
+                backoff_ns = backoff_limit;
+        }
+        map = Mapped(m_BaseOffset + start, size);
+    }
+    std::memcpy(buffer, map + m_BaseOffset + start, size);
+    Unpin();
+    ProfilerStop("read");
+}
+
+const char *FileMMAP::DataPointer(const size_t start, const size_t size)
+{
+    if (size == 0)
+    {
+        return nullptr;
+    }
+    const char *map = Mapped(m_BaseOffset + start, size);
+    return map ? map + m_BaseOffset + start : nullptr;
+}
+
+void FileMMAP::ReleaseDataPointer(const char *pointer)
+{
+    if (pointer)
+    {
+        Unpin();
+    }
+}
+
+size_t FileMMAP::GetSize()
+{
+    if (m_BaseSize > 0)
+    {
+        return m_BaseSize;
+    }
+    struct stat fileStat;
+    if (fstat(m_FileDescriptor, &fileStat) == -1)
+    {
+        const int localErrno = errno;
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileMMAP", "GetSize",
+                                              "couldn't get size of file " + m_Name +
+                                                  ": errno = " + std::to_string(localErrno) +
+                                                  ": " + strerror(localErrno));
+    }
+    return static_cast<size_t>(fileStat.st_size);
+}
+
+void FileMMAP::Flush() {}
+
+void FileMMAP::Unmap()
+{
+    std::lock_guard<std::mutex> lock(m_MapMutex);
+    for (const auto &old : m_OldMaps)
+    {
+        munmap(const_cast<char *>(old.first), old.second);
+    }
+    m_OldMaps.clear();
+    if (m_Map)
+    {
+        munmap(const_cast<char *>(m_Map), m_MapCapacity);
+    }
+    m_Map = nullptr;
+    m_MapSize = 0;
+    m_MapCapacity = 0;
+    m_Pinned = 0;
+}
+
+void FileMMAP::Close()
+{
+    Unmap();
+    ProfilerStart("close");
+    errno = 0;
+    const int status = close(m_FileDescriptor);
+    const int localErrno = errno;
+    ProfilerStop("close");
+    if (status == -1)
+    {
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileMMAP", "Close",
+                                              "couldn't close file " + m_Name + ": errno = " +
+                                                  std::to_string(localErrno) + ": " +
+                                                  strerror(localErrno));
+    }
+    m_FileDescriptor = -1;
+    m_IsOpen = false;
+}
+
+void FileMMAP::Delete()
+{
+    if (m_IsOpen)
+    {
+        Close();
+    }
+    std::remove(m_Name.c_str());
+}
+
+void FileMMAP::SeekToEnd() { m_CurrentPos = GetSize(); }
+
+void FileMMAP::SeekToBegin() { m_CurrentPos = 0; }
+
+void FileMMAP::Seek(const size_t start)
+{
+    if (start != MaxSizeT)
+    {
+        m_CurrentPos = start;
+    }
+    else
+    {
+        SeekToEnd();
+    }
+}
+
+void FileMMAP::Truncate(const size_t /*length*/)
+{
+    helper::Throw<std::invalid_argument>("Toolkit", "transport::file::FileMMAP", "Truncate",
+                                         "the mmap transport is read-only, can't truncate " +
+                                             m_Name);
+}
+
+void FileMMAP::MkDir(const std::string &fileName)
+{
+    helper::Throw<std::invalid_argument>("Toolkit", "transport::file::FileMMAP", "MkDir",
+                                         "the mmap transport is read-only, can't create " +
+                                             fileName);
+}
+
+void FileMMAP::SetParameters(const Params &params)
+{
+    // AddTransport parameters arrive lower-cased
+    const Params lowered = helper::LowerCaseParams(params);
+    helper::GetParameter(lowered, "advice", m_Advice);
+    helper::GetParameter(lowered, "failoneof", m_FailOnEOF);
+    if (m_Advice != "normal" && m_Advice != "sequential" && m_Advice != "random" &&
+        m_Advice != "willneed")
+    {
+        helper::Throw<std::invalid_argument>("Toolkit", "transport::file::FileMMAP",
+                                             "SetParameters",
+                                             "invalid Advice " + m_Advice +
+                                                 ", use normal, sequential, random or willneed");
+    }
+}
+
+void FileMMAP::CheckFile(const std::string &hint, const int localErrno) const
+{
+    if (m_FileDescriptor == -1)
+    {
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileMMAP", "CheckFile",
+                                              hint + ": errno = " + std::to_string(localErrno) +
+                                                  ": " + strerror(localErrno));
+    }
+}
+
+} // end namespace transport
+} // end namespace adios2
@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_
+#define ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_
+
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "adios2/common/ADIOSConfig.h"
+#include "adios2/toolkit/transport/Transport.h"
+
+namespace adios2
+{
+namespace helper
+{
+class Comm;
+}
+namespace transport
+{
+
+/**
+ * Read-only file transport that maps the whole file. Read copies out of the
+ * mapping, and DataPointer hands out the mapped bytes so callers can skip
+ * their own read buffer. Meant for node-local, burst-buffer or tmpfs files.
+ */
+class FileMMAP : public Transport
+{
+
+public:
+    FileMMAP(helper::Comm const &comm);
+
+    ~FileMMAP();
+
+    void Open(const std::string &name, const Mode openMode, const bool async = false,
+              const bool directio = false) final;
+
+    void OpenChain(const std::string &name, Mode openMode, const helper::Comm &chainComm,
+                   const bool async = false, const bool directio = false) final;
+
+    /** Throws, the transport is read-only */
+    void Write(const char *buffer, size_t size, size_t start = MaxSizeT) final;
+
+    void Read(char *buffer, size_t size, size_t start = 0) final;
+
+    const char *DataPointer(const size_t start, const size_t size) final;
+
+    void ReleaseDataPointer(const char *pointer) final;
+
+    size_t GetSize() final;
+
+    void Flush() final;
+
+    void Close() final;
+
+    void Delete() final;
+
+    void SeekToEnd() final;
+
+    void SeekToBegin() final;
+
+    void Seek(const size_t start = MaxSizeT) final;
+
+    size_t CurrentPos() final { return m_CurrentPos; }
+
+    void Truncate(const size_t length) final;
+
+    void MkDir(const std::string &fileName) final;
+
+    void SetParameters(const Params &params) final;
+
+private:
+    int m_FileDescriptor = -1;
+    /** madvise hint for new mappings: normal, sequential, random or willneed */
+    std::string m_Advice = "sequential";
+    size_t m_CurrentPos = 0;
+    /** Read past the end throws after a while instead of waiting for a writer */
+    bool m_FailOnEOF = false;
+
+    /** Guards the mappings, a mapping is only replaced when the file outgrew it */
+    std::mutex m_MapMutex;
+    const char *m_Map = nullptr;
+    /** Bytes of the file in the mapping */
+    size_t m_MapSize = 0;
+    /** Length of the mapping, past the end of the file when it grew into it */
+    size_t m_MapCapacity = 0;
+    /** Mappings replaced by a larger one, pointers into them may still be in
+     *  use, so they stay until nothing is pinned. Each is at most half the
+     *  next, so they add up to less than the current one. */
+    std::vector<std::pair<const char *, size_t>> m_OldMaps;
+    /** Pointers handed out by DataPointer, and Reads copying out of a
+     *  mapping, that are not done yet */
+    size_t m_Pinned = 0;
+
+    /**
+     * Returns the mapping if it covers [start, start + size) and pins it. If
+     * the file has grown since, takes in the new bytes, mapping the file again
+     * with twice the length when they go past the mapping. Returns nullptr,
+     * pinning nothing, if the range is past the end of the file.
+     */
+    const char *Mapped(const size_t start, const size_t size);
+    /** Ends a pin, the last one unmaps the replaced mappings */
+    void Unpin();
+    void Unmap();
+    void CheckFile(const std::string &hint, const int localErrno) const;
+};
+
+} // end namespace transport
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_ */
@@ -13,12 +13,17 @@
 #include "adios2/helper/adiosLog.h"
 #include "adios2/helper/adiosString.h"
 
+#ifdef ADIOS2_HAVE_IO_URING
+#include "IOUring.h"
+#endif
+
 #ifdef ADIOS2_HAVE_O_DIRECT
 #ifndef _GNU_SOURCE
 #define _GNU_SOURCE
 #endif
 #endif
 
+#include <algorithm>   // std::min
 #include <cstdio>      // remove
 #include <cstring>     // strerror
 #include <errno.h>     // errno
@@ -27,7 +32,8 @@
 #include <sys/types.h> // open
 #include <thread>
 #ifndef _MSC_VER
-#include <sys/uio.h> // writev
+#include <limits.h>  // IOV_MAX
+#include <sys/uio.h> // writev, preadv
 #include <unistd.h>  // write, close, ftruncate
 #ifndef O_BINARY
 #define O_BINARY 0
@@ -569,6 +575,282 @@ void FilePOSIX::Read(char *buffer, size_t size, size_t start)
     }
 }
 
+#ifndef _MSC_VER
+void FilePOSIX::ReadV(const ReadOp *ops, const size_t nOps)
+{
+#ifdef ADIOS2_HAVE_IO_URING
+    // another thread running a batch on the ring reads on its own
+    std::unique_lock<std::mutex> lock(m_RingMutex, std::try_to_lock);
+    if (lock.owns_lock() && m_RingReads.empty() && RingReady())
+    {
+        QueueRingReads(ops, nOps);
+        DrainRing();
+        return;
+    }
+#endif
+    ReadVSync(ops, nOps);
+}
+
+void FilePOSIX::ReadVSync(const ReadOp *ops, const size_t nOps)
+{
+#ifdef IOV_MAX
+    const size_t maxIOV = IOV_MAX;
+#else
+    const size_t maxIOV = 1024;
+#endif
+    std::vector<iovec> iov;
+    size_t i = 0;
+    while (i < nOps)
+    {
+        // adjacent ranges go out in one preadv
+        size_t j = i + 1;
+        size_t total = ops[i].Size;
+        while (j < nOps && j - i < maxIOV && ops[j].Start == ops[j - 1].Start + ops[j - 1].Size &&
+               total + ops[j].Size <= DefaultMaxFileBatchSize)
+        {
+            total += ops[j].Size;
+            ++j;
+        }
+        if (j - i == 1)
+        {
+            Read(ops[i].Buffer, ops[i].Size, ops[i].Start);
+            ++i;
+            continue;
+        }
+
+        iov.resize(j - i);
+        for (size_t k = i; k < j; ++k)
+        {
+            iov[k - i].iov_base = ops[k].Buffer;
+            iov[k - i].iov_len = ops[k].Size;
+        }
+        ProfilerStart("read");
+        ssize_t readSize;
+        do
+        {
+            errno = 0;
+            readSize = preadv(m_FileDescriptor, iov.data(), static_cast<int>(iov.size()),
+                              static_cast<off_t>(ops[i].Start + m_BaseOffset));
+        } while (readSize == -1 && errno == EINTR);
+        int localErrno = errno;
+        ProfilerStop("read");
+        if (readSize == -1)
+        {
+            helper::Throw<std::ios_base::failure>(
+                "Toolkit", "transport::file::FilePOSIX", "ReadV",
+                "couldn't read from file " + m_Name + " " + SysErrMsg(localErrno));
+        }
+
+        // a short read (EOF) finishes with the EOF handling of Read
+        size_t done = static_cast<size_t>(readSize);
+        for (size_t k = i; k < j; ++k)
+        {
+            if (done >= ops[k].Size)
+            {
+                done -= ops[k].Size;
+                continue;
+            }
+            Read(ops[k].Buffer + done, ops[k].Size - done, ops[k].Start + done);
+            done = 0;
+        }
+        i = j;
+    }
+}
+#endif
+
+#ifdef ADIOS2_HAVE_IO_URING
+void FilePOSIX::SubmitReads(const ReadOp *ops, const size_t nOps)
+{
+    std::lock_guard<std::mutex> lock(m_RingMutex);
+    if (!RingReady())
+    {
+        ReadVSync(ops, nOps);
+        return;
+    }
+    QueueRingReads(ops, nOps);
+}
+
+void FilePOSIX::WaitReads()
+{
+    std::lock_guard<std::mutex> lock(m_RingMutex);
+    if (m_Ring)
+    {
+        DrainRing();
+    }
+}
+
+bool FilePOSIX::RingReady()
+{
+    constexpr unsigned ringEntries = 64;
+    if (!m_Ring && m_UseIOUring && !m_RingFailed)
+    {
+        m_Ring.reset(new IOUring(ringEntries));
+        if (!m_Ring->Valid())
+        {
+            // io_uring not available here, stay with preadv for good
+            m_Ring.reset();
+            m_RingFailed = true;
+        }
+    }
+    return m_Ring != nullptr;
+}
+
+void FilePOSIX::QueueRingReads(const ReadOp *ops, const size_t nOps)
+{
+    for (size_t i = 0; i < nOps; ++i)
+    {
+        size_t position = 0;
+        while (position < ops[i].Size)
+        {
+            const size_t size = std::min(ops[i].Size - position, DefaultMaxFileBatchSize);
+            m_RingReads.push_back(
+                {ops[i].Buffer + position, size, ops[i].Start + m_BaseOffset + position});
+            position += size;
+        }
+    }
+    PushRingReads();
+}
+
+void FilePOSIX::PushRingReads()
+{
+    bool queued = false;
+    while (m_RingInFlight < m_Ring->Capacity())
+    {
+        const bool retry = !m_RingRetry.empty();
+        if (!retry && m_RingNext == m_RingReads.size())
+        {
+            break;
+        }
+        const size_t r = retry ? m_RingRetry.back() : m_RingNext;
+        const ReadOp &op = m_RingReads[r];
+        if (!m_Ring->PrepareRead(m_FileDescriptor, op.Buffer, op.Size, op.Start, r))
+        {
+            break;
+        }
+        if (retry)
+        {
+            m_RingRetry.pop_back();
+        }
+        else
+        {
+            ++m_RingNext;
+        }
+        ++m_RingInFlight;
+        queued = true;
+    }
+
+    const int err = queued ? m_Ring->Submit(0) : 0;
+    if (err < 0)
+    {
+        // the reads submitted before are collected first, the kernel must be
+        // done with their buffers before the caller unwinds them
+        size_t submitted = m_RingInFlight - m_Ring->Unsubmitted();
+        while (submitted > 0)
+        {
+            uint64_t r;
+            int result;
+            if (m_Ring->PopCompletion(r, result))
+            {
+                --submitted;
+                continue;
+            }
+            const int waitErr = m_Ring->Wait(1);
+            if (waitErr < 0 && waitErr != -EINTR)
+            {
+                break;
+            }
+        }
+        m_Ring.reset();
+        m_RingFailed = true;
+        m_RingReads.clear();
+        m_RingRetry.clear();
+        m_RingNext = m_RingInFlight = m_RingDone = 0;
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FilePOSIX",
+                                              "PushRingReads",
+                                              "couldn't submit reads of file " + m_Name + " " +
+                                                  SysErrMsg(-err));
+    }
+}
+
+void FilePOSIX::DrainRing()
+{
+    // after an error the reads in flight are still collected before throwing,
+    // the kernel must be done with the buffers
+    std::string error;
+    while (m_RingInFlight > 0 || (error.empty() && m_RingDone < m_RingReads.size()))
+    {
+        if (error.empty())
+        {
+            PushRingReads();
+        }
+        uint64_t r;
+        int result;
+        if (!m_Ring->PopCompletion(r, result))
+        {
+            ProfilerStart("read");
+            const int err = m_Ring->Submit(1);
+            ProfilerStop("read");
+            if (err < 0 && err != -EINTR)
+            {
+                error = "couldn't wait for reads of file " + m_Name + " " + SysErrMsg(-err);
+                m_Ring.reset();
+                m_RingFailed = true;
+                break;
+            }
+            continue;
+        }
+
+        --m_RingInFlight;
+        ReadOp &op = m_RingReads[r];
+        if (!error.empty())
+        {
+            continue;
+        }
+        if (result == -EINTR || result == -EAGAIN)
+        {
+            m_RingRetry.push_back(r);
+        }
+        else if (result == 0 || result == -EINVAL || result == -EOPNOTSUPP)
+        {
+            // EOF, or a kernel without IORING_OP_READ: pread with the EOF handling of Read
+            try
+            {
+                Read(op.Buffer, op.Size, op.Start - m_BaseOffset);
+                ++m_RingDone;
+            }
+            catch (std::exception &e)
+            {
+                error = e.what();
+            }
+        }
+        else if (result < 0)
+        {
+            error = "couldn't read from file " + m_Name + " " + SysErrMsg(-result);
+        }
+        else if (static_cast<size_t>(result) < op.Size)
+        {
+            op.Buffer += result;
+            op.Start += result;
+            op.Size -= result;
+            m_RingRetry.push_back(r);
+        }
+        else
+        {
+            ++m_RingDone;
+        }
+    }
+
+    m_RingReads.clear();
+    m_RingRetry.clear();
+    m_RingNext = m_RingInFlight = m_RingDone = 0;
+    if (!error.empty())
+    {
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FilePOSIX", "DrainRing",
+                                              error);
+    }
+}
+#endif
+
 size_t FilePOSIX::GetSize()
 {
     if (m_BaseSize > 0)
@@ -605,6 +887,9 @@ void FilePOSIX::Flush()
 void FilePOSIX::Close()
 {
     WaitForOpen();
+#ifdef ADIOS2_HAVE_IO_URING
+    WaitReads();
+#endif
     ProfilerStart("close");
     errno = 0;
     const int status = close(m_FileDescriptor);
@@ -736,6 +1021,10 @@ void FilePOSIX::SetParameters(const Params &params)
     // Otherwise, they remain at their default value
 
     helper::GetParameter(params, "FailOnEOF", m_FailOnEOF);
+#ifdef ADIOS2_HAVE_IO_URING
+    // AddTransport parameters arrive lower-cased
+    helper::GetParameter(helper::LowerCaseParams(params), "iouring", m_UseIOUring);
+#endif
 }
 
 } // end namespace transport
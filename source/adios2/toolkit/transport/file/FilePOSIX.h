@@ -8,6 +8,9 @@
 #define ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEDESCRIPTOR_H_
 
 #include <future> //std::async, std::future
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "adios2/common/ADIOSConfig.h"
 #include "adios2/toolkit/transport/Transport.h"
@@ -21,6 +24,8 @@ class Comm;
 namespace transport
 {
 
+class IOUring;
+
 /** File descriptor transport using the POSIX IO library */
 class FilePOSIX : public Transport
 {
@@ -44,6 +49,17 @@ public:
 
     void Read(char *buffer, size_t size, size_t start = 0) final;
 
+#ifndef _MSC_VER
+    /** Adjacent ranges are read with one preadv, or all go through io_uring */
+    void ReadV(const ReadOp *ops, const size_t nOps) final;
+#endif
+
+#ifdef ADIOS2_HAVE_IO_URING
+    void SubmitReads(const ReadOp *ops, const size_t nOps) final;
+
+    void WaitReads() final;
+#endif
+
     size_t GetSize() final;
 
     /** Does nothing, each write is supposed to flush */
@@ -75,6 +91,29 @@ private:
     std::future<std::pair<int, int>> m_OpenFuture;
     bool m_DirectIO = false;
 
+#ifdef ADIOS2_HAVE_IO_URING
+    /** IOUring parameter, false: batched reads use preadv/pread */
+    bool m_UseIOUring = true;
+    /** Guards the ring and the batch below, set up at the first batched read */
+    std::mutex m_RingMutex;
+    std::unique_ptr<IOUring> m_Ring;
+    bool m_RingFailed = false;
+    /** Reads of the current batch at file offsets, at most DefaultMaxFileBatchSize each */
+    std::vector<ReadOp> m_RingReads;
+    /** Short or interrupted reads to submit again, indices into m_RingReads */
+    std::vector<size_t> m_RingRetry;
+    size_t m_RingNext = 0;
+    size_t m_RingInFlight = 0;
+    size_t m_RingDone = 0;
+
+    bool RingReady();
+    void QueueRingReads(const ReadOp *ops, const size_t nOps);
+    /** Hands as many queued reads to the kernel as the ring holds */
+    void PushRingReads();
+    /** Completes every read of the current batch and clears it */
+    void DrainRing();
+#endif
+
     /**
      * Check if m_FileDescriptor is -1 after an operation
      * @param hint exception message
@@ -82,6 +121,9 @@ private:
     void CheckFile(const std::string hint, const int localErrno) const;
     void WaitForOpen();
     std::string SysErrMsg(const int localErrno) const;
+#ifndef _MSC_VER
+    void ReadVSync(const ReadOp *ops, const size_t nOps);
+#endif
 };
 
 } // end namespace transport
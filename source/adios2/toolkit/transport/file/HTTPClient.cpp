@@ -0,0 +1,774 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "HTTPClient.h"
+#include "adios2/helper/adiosLog.h"
+#include "adios2/helper/adiosString.h"
+
+#include <algorithm>
+#include <cstring> // memcpy
+#include <exception>
+#include <future>
+#include <iostream>
+
+namespace adios2
+{
+namespace transport
+{
+
+namespace
+{
+const size_t recvChunk = 65536;
+
+std::string Trim(const std::string &s)
+{
+    const size_t b = s.find_first_not_of(" \t");
+    const size_t e = s.find_last_not_of(" \t\r");
+    return (b == std::string::npos) ? std::string() : s.substr(b, e - b + 1);
+}
+
+/** "bytes a-b/total" -> [a, b + 1) */
+bool ParseContentRange(const std::string &value, size_t &begin, size_t &end)
+{
+    const std::string v = Trim(value);
+    if (v.compare(0, 6, "bytes ") != 0)
+    {
+        return false;
+    }
+    const size_t dash = v.find('-', 6);
+    const size_t slash = v.find('/', 6);
+    if (dash == std::string::npos || slash == std::string::npos || slash < dash)
+    {
+        return false;
+    }
+    try
+    {
+        begin = std::stoull(v.substr(6, dash - 6));
+        end = std::stoull(v.substr(dash + 1, slash - dash - 1)) + 1;
+    }
+    catch (...)
+    {
+        return false;
+    }
+    return end > begin;
+}
+
+size_t ContentLength(const std::map<std::string, std::string> &headers, bool &found)
+{
+    auto it = headers.find("content-length");
+    found = (it != headers.end());
+    return found ? std::stoull(it->second) : 0;
+}
+}
+
+void HTTPTCPConnection::Connect(const std::string &hostname, uint16_t port)
+{
+    m_Socket.Connect(hostname, port);
+    m_Socket.SetNoDelay();
+}
+
+void HTTPTCPConnection::Close() { m_Socket.Close(); }
+
+int HTTPTCPConnection::Send(const char *buffer, int size) { return m_Socket.Send(buffer, size); }
+
+int HTTPTCPConnection::Recv(char *buffer, int size) { return m_Socket.Recv(buffer, size); }
+
+HTTPClient::HTTPClient(ConnectionFactory factory) : m_Factory(std::move(factory)) {}
+
+HTTPClient::~HTTPClient() { Close(); }
+
+void HTTPClient::SetServer(const std::string &hostname, uint16_t port, const std::string &path)
+{
+    m_Hostname = hostname;
+    m_Port = port;
+    m_Path = path.empty() ? "/" : path;
+}
+
+void HTTPClient::SetParameters(const Params &params)
+{
+    uint64_t value;
+    if (helper::GetParameter(params, "connections", value))
+    {
+        m_Connections = std::max<size_t>(1, static_cast<size_t>(value));
+    }
+    if (helper::GetParameter(params, "pipelinedepth", value))
+    {
+        m_PipelineDepth = std::max<size_t>(1, static_cast<size_t>(value));
+    }
+    if (helper::GetParameter(params, "rangesperrequest", value))
+    {
+        m_RangesPerRequest = std::max<size_t>(1, static_cast<size_t>(value));
+    }
+    std::string size;
+    if (helper::GetParameter(params, "maxrequestsize", size))
+    {
+        m_MaxRequestSize = std::max<size_t>(
+            1, helper::StringToByteUnits(size, "for transport parameter MaxRequestSize"));
+    }
+    helper::GetParameter(params, "verbose", m_Verbose);
+}
+
+void HTTPClient::SplitURL(const std::string &url, std::string &hostname, uint16_t &port,
+                          std::string &path)
+{
+    size_t pos = url.find("://");
+    pos = (pos == std::string::npos) ? 0 : pos + 3;
+    const size_t slash = url.find('/', pos);
+    const std::string hostPort =
+        url.substr(pos, (slash == std::string::npos) ? std::string::npos : slash - pos);
+    const size_t colon = hostPort.rfind(':');
+    if (colon != std::string::npos && hostPort.find(']', colon) == std::string::npos)
+    {
+        hostname = hostPort.substr(0, colon);
+        port = static_cast<uint16_t>(std::stoi(hostPort.substr(colon + 1)));
+    }
+    else
+    {
+        hostname = hostPort;
+    }
+    if (slash != std::string::npos)
+    {
+        path = url.substr(slash);
+    }
+}
+
+std::unique_ptr<HTTPConnection> HTTPClient::Acquire(bool &reused)
+{
+    std::unique_lock<std::mutex> lock(m_PoolMutex);
+    m_PoolCV.wait(lock, [this]() { return !m_Idle.empty() || m_NOpen < m_Connections; });
+    if (!m_Idle.empty())
+    {
+        auto c = std::move(m_Idle.back());
+        m_Idle.pop_back();
+        reused = true;
+        return c;
+    }
+    ++m_NOpen;
+    lock.unlock();
+
+    reused = false;
+    try
+    {
+        auto c = m_Factory();
+        c->Connect(m_Hostname, m_Port);
+        return c;
+    }
+    catch (...)
+    {
+        Release(nullptr, false);
+        throw;
+    }
+}
+
+void HTTPClient::Release(std::unique_ptr<HTTPConnection> connection, const bool keepAlive)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_PoolMutex);
+        if (connection && keepAlive)
+        {
+            m_Idle.push_back(std::move(connection));
+        }
+        else
+        {
+            if (connection)
+            {
+                connection->Close();
+            }
+            --m_NOpen;
+        }
+    }
+    m_PoolCV.notify_one();
+}
+
+void HTTPClient::Close()
+{
+    std::lock_guard<std::mutex> lock(m_PoolMutex);
+    for (auto &c : m_Idle)
+    {
+        c->Close();
+    }
+    m_NOpen -= m_Idle.size();
+    m_Idle.clear();
+}
+
+void HTTPClient::Fill(HTTPConnection &c)
+{
+    char buf[recvChunk];
+    const int n = c.Recv(buf, static_cast<int>(sizeof(buf)));
+    if (n <= 0)
+    {
+        c.m_Lost = true;
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::HTTPClient", "Fill",
+                                              "connection to " + m_Hostname +
+                                                  " closed while reading " + m_Path);
+    }
+    c.m_Pending.append(buf, n);
+}
+
+std::string HTTPClient::ReadLine(HTTPConnection &c)
+{
+    size_t eol;
+    while ((eol = c.m_Pending.find("\r\n")) == std::string::npos)
+    {
+        Fill(c);
+    }
+    std::string line = c.m_Pending.substr(0, eol);
+    c.m_Pending.erase(0, eol + 2);
+    c.m_Consumed += eol + 2;
+    return line;
+}
+
+void HTTPClient::RecvExact(HTTPConnection &c, char *buffer, size_t size)
+{
+    const size_t fromPending = std::min(size, c.m_Pending.size());
+    std::memcpy(buffer, c.m_Pending.data(), fromPending);
+    c.m_Pending.erase(0, fromPending);
+    size_t have = fromPending;
+    // large bodies go straight to the destination, not through m_Pending
+    while (have < size)
+    {
+        const int n = c.Recv(buffer + have,
+                             static_cast<int>(std::min<size_t>(size - have, 1024 * 1024 * 1024)));
+        if (n <= 0)
+        {
+            c.m_Lost = true;
+            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::HTTPClient",
+                                                  "RecvExact",
+                                                  "connection to " + m_Hostname +
+                                                      " closed while reading " + m_Path);
+        }
+        have += n;
+    }
+    c.m_Consumed += size;
+}
+
+void HTTPClient::Skip(HTTPConnection &c, size_t size)
+{
+    std::vector<char> scratch(std::min(size, recvChunk));
+    while (size > 0)
+    {
+        const size_t n = std::min(size, scratch.size());
+        RecvExact(c, scratch.data(), n);
+        size -= n;
+    }
+}
+
+void HTTPClient::Send(HTTPConnection &c, const std::string &text)
+{
+    size_t sent = 0;
+    while (sent < text.size())
+    {
+        const int n = c.Send(text.data() + sent, static_cast<int>(text.size() - sent));
+        if (n <= 0)
+        {
+            c.m_Lost = true;
+            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::HTTPClient", "Send",
+                                                  "cannot send request to " + m_Hostname);
+        }
+        sent += n;
+    }
+}
+
+HTTPClient::Response HTTPClient::ReceiveHeader(HTTPConnection &c)
+{
+    Response r;
+    std::string line = ReadLine(c);
+    // "HTTP/1.1 206 Partial Content"
+    const size_t sp = line.find(' ');
+    if (line.compare(0, 5, "HTTP/") != 0 || sp == std::string::npos)
+    {
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::HTTPClient",
+                                              "ReceiveHeader",
+                                              "invalid response from " + m_Hostname + ": " + line);
+    }
+    r.Status = std::atoi(line.c_str() + sp + 1);
+    r.KeepAlive = (line.compare(0, 8, "HTTP/1.0") != 0);
+    while (!(line = ReadLine(c)).empty())
+    {
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos)
+        {
+            continue;
+        }
+        r.Headers[helper::LowerCase(line.substr(0, colon))] = Trim(line.substr(colon + 1));
+    }
+    auto it = r.Headers.find("connection");
+    if (it != r.Headers.end())
+    {
+        const std::string v = helper::LowerCase(it->second);
+        r.KeepAlive = (v.find("close") == std::string::npos) &&
+                      (r.KeepAlive || v.find("keep-alive") != std::string::npos);
+    }
+    return r;
+}
+
+void HTTPClient::Deliver(HTTPConnection &c, const Request &request, size_t offset, size_t size)
+{
+    const auto &ops = request.Ops;
+    const size_t end = offset + size;
+    while (offset < end)
+    {
+        // reads before lo are over, reads from hi on start after offset
+        const size_t lo =
+            std::upper_bound(request.MaxEnd.begin(), request.MaxEnd.end(), offset) -
+            request.MaxEnd.begin();
+        const size_t hi = std::upper_bound(ops.begin(), ops.end(), offset,
+                                           [](const size_t o, const Transport::ReadOp *op) {
+                                               return o < op->Start;
+                                           }) -
+                          ops.begin();
+        const Transport::ReadOp *dst = nullptr;
+        for (size_t i = lo; i < hi && !dst; ++i)
+        {
+            if (ops[i]->Start + ops[i]->Size > offset)
+            {
+                dst = ops[i];
+            }
+        }
+        if (!dst)
+        {
+            const size_t next = (hi < ops.size()) ? std::min(end, ops[hi]->Start) : end;
+            Skip(c, next - offset);
+            offset = next;
+            continue;
+        }
+
+        const size_t n = std::min(end, dst->Start + dst->Size) - offset;
+        char *data = dst->Buffer + (offset - dst->Start);
+        RecvExact(c, data, n);
+        // reads that overlap get their share from the first one
+        for (size_t i = lo; i < ops.size() && ops[i]->Start < offset + n; ++i)
+        {
+            const size_t b = std::max(offset, ops[i]->Start);
+            const size_t e = std::min(offset + n, ops[i]->Start + ops[i]->Size);
+            if (ops[i] != dst && b < e)
+            {
+                std::memcpy(ops[i]->Buffer + (b - ops[i]->Start), data + (b - offset), e - b);
+            }
+        }
+        offset += n;
+    }
+}
+
+size_t HTTPClient::ReceiveBody(HTTPConnection &c, const Response &response, const Request &request)
+{
+    bool hasLength;
+    const size_t length = ContentLength(response.Headers, hasLength);
+    if (!hasLength)
+    {
+        helper::Throw<std::ios_base::failure>(
+            "Toolkit", "transport::file::HTTPClient", "ReceiveBody",
+            "response from " + m_Hostname + " for " + m_Path +
+                " has no Content-Length, only plain range responses are supported");
+    }
+
+    size_t covered = 0;
+    auto lf_Covered = [&](const size_t begin, const size_t end) {
+        for (const auto &r : request.Ranges)
+        {
+            const size_t b = std::max(begin, r.Begin);
+            const size_t e = std::min(end, r.End);
+            covered += (b < e) ? e - b : 0;
+        }
+    };
+
+    if (response.Status == 200)
+    {
+        // the server ignored the ranges and sends the whole file
+        Deliver(c, request, 0, length);
+        lf_Covered(0, length);
+        return covered;
+    }
+
+    auto ct = response.Headers.find("content-type");
+    const std::string type = (ct != response.Headers.end()) ? ct->second : "";
+    const size_t b = type.find("boundary=");
+    if (helper::LowerCase(type).find("multipart/byteranges") == std::string::npos ||
+        b == std::string::npos)
+    {
+        size_t begin, end;
+        auto cr = response.Headers.find("content-range");
+        if (cr == response.Headers.end() || !ParseContentRange(cr->second, begin, end) ||
+            end - begin != length)
+        {
+            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::HTTPClient",
+                                                  "ReceiveBody",
+                                                  "invalid Content-Range in response from " +
+                                                      m_Hostname + " for " + m_Path);
+        }
+        Deliver(c, request, begin, length);
+        lf_Covered(begin, end);
+        return covered;
+    }
+
+    std::string boundary = Trim(type.substr(b + 9));
+    if (boundary.size() > 1 && boundary.front() == '"')
+    {
+        boundary = boundary.substr(1, boundary.find('"', 1) - 1);
+    }
+    const std::string delimiter = "--" + boundary;
+    const size_t bodyStart = c.m_Consumed;
+    while (true)
+    {
+        std::string line = ReadLine(c);
+        if (line == delimiter + "--")
+        {
+            break;
+        }
+        if (line != delimiter)
+        {
+            continue; // preamble or the CRLF after the previous part
+        }
+        size_t begin = 0, end = 0;
+        while (!(line = ReadLine(c)).empty())
+        {
+            const size_t colon = line.find(':');
+            if (colon != std::string::npos &&
+                helper::LowerCase(line.substr(0, colon)) == "content-range")
+            {
+                ParseContentRange(line.substr(colon + 1), begin, end);
+            }
+        }
+        if (end <= begin)
+        {
+            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::HTTPClient",
+                                                  "ReceiveBody",
+                                                  "multipart response from " + m_Hostname +
+                                                      " for " + m_Path +
+                                                      " has a part without Content-Range");
+        }
+        Deliver(c, request, begin, end - begin);
+        lf_Covered(begin, end);
+    }
+    // the epilogue, if any, is still part of this response
+    const size_t read = c.m_Consumed - bodyStart;
+    if (read < length)
+    {
+        Skip(c, length - read);
+    }
+    return covered;
+}
+
+std::vector<HTTPClient::Request>
+HTTPClient::MakeRequests(const std::vector<const Transport::ReadOp *> &ops) const
+{
+    // disjoint ranges over the sorted reads, with the reads each one covers
+    struct Merged
+    {
+        Range R;
+        size_t FirstOp;
+        size_t EndOp;
+    };
+    std::vector<Merged> merged;
+    for (size_t i = 0; i < ops.size(); ++i)
+    {
+        const size_t begin = ops[i]->Start;
+        const size_t end = begin + ops[i]->Size;
+        if (!merged.empty() && begin <= merged.back().R.End)
+        {
+            merged.back().R.End = std::max(merged.back().R.End, end);
+            merged.back().EndOp = i + 1;
+        }
+        else
+        {
+            merged.push_back({{begin, end}, i, i + 1});
+        }
+    }
+
+    std::vector<Request> requests;
+    Request current;
+    size_t currentBytes = 0;
+    auto lf_Flush = [&]() {
+        size_t maxEnd = 0;
+        for (const auto *op : current.Ops)
+        {
+            maxEnd = std::max(maxEnd, op->Start + op->Size);
+            current.MaxEnd.push_back(maxEnd);
+        }
+        requests.push_back(std::move(current));
+        current = Request();
+        currentBytes = 0;
+    };
+
+    for (const auto &m : merged)
+    {
+        // long ranges are cut so that several connections can share them; a
+        // full piece is a request of its own, so a read spanning a cut is in
+        // two different requests, never twice in one
+        for (size_t b = m.R.Begin; b < m.R.End; b += m_MaxRequestSize)
+        {
+            const Range piece = {b, std::min(m.R.End, b + m_MaxRequestSize)};
+            const size_t n = piece.End - piece.Begin;
+            const bool full = (current.Ranges.size() == m_RangesPerRequest) ||
+                              (currentBytes + n > m_MaxRequestSize);
+            if (!current.Ranges.empty() && full)
+            {
+                lf_Flush();
+            }
+            current.Ranges.push_back(piece);
+            currentBytes += n;
+            for (size_t i = m.FirstOp; i < m.EndOp; ++i)
+            {
+                if (ops[i]->Start < piece.End && ops[i]->Start + ops[i]->Size > piece.Begin)
+                {
+                    current.Ops.push_back(ops[i]);
+                }
+            }
+        }
+    }
+    lf_Flush();
+    return requests;
+}
+
+std::string HTTPClient::RequestText(const Request &request) const
+{
+    std::string text = "GET " + m_Path + " HTTP/1.1\r\nHost: " + m_Hostname + "\r\nRange: bytes=";
+    for (size_t i = 0; i < request.Ranges.size(); ++i)
+    {
+        text += (i ? "," : "") + std::to_string(request.Ranges[i].Begin) + "-" +
+                std::to_string(request.Ranges[i].End - 1);
+    }
+    text += "\r\n\r\n";
+    return text;
+}
+
+void HTTPClient::Run(Request *requests, const size_t nRequests)
+{
+    bool reused;
+    std::unique_ptr<HTTPConnection> c = Acquire(reused);
+    size_t sent = 0;
+    size_t done = 0;
+    size_t doneOnConnection = 0;
+    // new connections lost before any answer, so a dead server is not retried forever
+    size_t fruitless = 0;
+    bool canSend = true;
+    while (done < nRequests)
+    {
+        bool reconnect = false;
+        try
+        {
+            // keep up to PipelineDepth requests in flight; after a failed send
+            // only the answers to the requests already sent can still come
+            while (canSend && sent < nRequests && sent - done < m_PipelineDepth)
+            {
+                try
+                {
+                    Send(*c, RequestText(requests[sent]));
+                    ++sent;
+                }
+                catch (std::ios_base::failure &)
+                {
+                    canSend = false;
+                }
+            }
+            if (sent == done)
+            {
+                helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::HTTPClient",
+                                                      "Run",
+                                                      "cannot send request to " + m_Hostname);
+            }
+            const Response response = ReceiveHeader(*c);
+            if (response.Status != 200 && response.Status != 206)
+            {
+                bool hasLength;
+                const size_t length = ContentLength(response.Headers, hasLength);
+                Release(std::move(c), false);
+                helper::Throw<std::ios_base::failure>(
+                    "Toolkit", "transport::file::HTTPClient", "Run",
+                    "HTTP status " + std::to_string(response.Status) + " for " + m_Path +
+                        " on " + m_Hostname + " (" + std::to_string(length) + " bytes body)");
+            }
+            const size_t covered = ReceiveBody(*c, response, requests[done]);
+            size_t wanted = 0;
+            for (const auto &r : requests[done].Ranges)
+            {
+                wanted += r.End - r.Begin;
+            }
+            if (covered < wanted)
+            {
+                Release(std::move(c), false);
+                helper::Throw<std::ios_base::failure>(
+                    "Toolkit", "transport::file::HTTPClient", "Run",
+                    "response from " + m_Hostname + " for " + m_Path + " has " +
+                        std::to_string(covered) + " of the " + std::to_string(wanted) +
+                        " bytes requested");
+            }
+            ++done;
+            ++doneOnConnection;
+            fruitless = 0;
+            // the server answers nothing after Connection: close
+            if (!response.KeepAlive)
+            {
+                canSend = false;
+                sent = done;
+            }
+            reconnect = !canSend && sent == done;
+        }
+        catch (std::ios_base::failure &)
+        {
+            // the connection is gone (closed by the server, or a stale pooled
+            // one); a new connection that never answered gets one more try
+            const bool lost = c && c->m_Lost;
+            if (!lost || (!reused && doneOnConnection == 0 && ++fruitless > 1))
+            {
+                if (c)
+                {
+                    Release(std::move(c), false);
+                }
+                throw;
+            }
+            reconnect = true;
+        }
+        catch (...)
+        {
+            if (c)
+            {
+                Release(std::move(c), false);
+            }
+            throw;
+        }
+
+        if (reconnect)
+        {
+            Release(std::move(c), false);
+            if (done < nRequests)
+            {
+                // the requests without an answer are sent again
+                c = Acquire(reused);
+                sent = done;
+                doneOnConnection = 0;
+                canSend = true;
+            }
+        }
+    }
+    if (c)
+    {
+        Release(std::move(c), true);
+    }
+}
+
+void HTTPClient::ReadV(const Transport::ReadOp *ops, size_t nOps)
+{
+    std::vector<const Transport::ReadOp *> sorted;
+    sorted.reserve(nOps);
+    for (size_t i = 0; i < nOps; ++i)
+    {
+        if (ops[i].Size > 0)
+        {
+            sorted.push_back(&ops[i]);
+        }
+    }
+    if (sorted.empty())
+    {
+        return;
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Transport::ReadOp *a, const Transport::ReadOp *b) {
+                  return a->Start < b->Start;
+              });
+
+    std::vector<Request> requests = MakeRequests(sorted);
+    const size_t nWorkers = std::min(m_Connections, requests.size());
+    if (m_Verbose > 0)
+    {
+        std::cout << "HTTPClient::ReadV " << m_Path << ": " << nOps << " reads in "
+                  << requests.size() << " requests over " << nWorkers << " connections"
+                  << std::endl;
+    }
+
+    // contiguous shares keep neighboring ranges on one connection
+    std::vector<std::future<void>> futures;
+    for (size_t w = 1; w < nWorkers; ++w)
+    {
+        const size_t b = w * requests.size() / nWorkers;
+        const size_t e = (w + 1) * requests.size() / nWorkers;
+        futures.push_back(
+            std::async(std::launch::async, [this, &requests, b, e]() {
+                Run(requests.data() + b, e - b);
+            }));
+    }
+    std::exception_ptr error;
+    try
+    {
+        Run(requests.data(), requests.size() / nWorkers);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    for (auto &f : futures)
+    {
+        try
+        {
+            f.get();
+        }
+        catch (...)
+        {
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+void HTTPClient::Read(char *buffer, size_t size, size_t start)
+{
+    const Transport::ReadOp op = {buffer, size, start};
+    ReadV(&op, 1);
+}
+
+size_t HTTPClient::GetSize()
+{
+    bool reused;
+    std::unique_ptr<HTTPConnection> c = Acquire(reused);
+    const std::string request = "HEAD " + m_Path + " HTTP/1.1\r\nHost: " + m_Hostname + "\r\n\r\n";
+    Response response;
+    try
+    {
+        Send(*c, request);
+        response = ReceiveHeader(*c);
+    }
+    catch (std::ios_base::failure &)
+    {
+        Release(std::move(c), false);
+        if (!reused)
+        {
+            throw;
+        }
+        // stale pooled connection, once more on a new one
+        c = Acquire(reused);
+        try
+        {
+            Send(*c, request);
+            response = ReceiveHeader(*c);
+        }
+        catch (std::ios_base::failure &)
+        {
+            Release(std::move(c), false);
+            throw;
+        }
+    }
+    Release(std::move(c), response.KeepAlive);
+
+    bool hasLength;
+    const size_t size = ContentLength(response.Headers, hasLength);
+    if (response.Status != 200 || !hasLength)
+    {
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::HTTPClient", "GetSize",
+                                              "cannot get the size of " + m_Path + " on " +
+                                                  m_Hostname + ", HTTP status " +
+                                                  std::to_string(response.Status));
+    }
+    return size;
+}
+
+} // end namespace transport
+} // end namespace adios2
@@ -0,0 +1,161 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ADIOS2_TOOLKIT_TRANSPORT_FILE_HTTPCLIENT_H_
+#define ADIOS2_TOOLKIT_TRANSPORT_FILE_HTTPCLIENT_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "adios2/common/ADIOSTypes.h"
+#include "adios2/helper/adiosNetwork.h" // NetworkSocket
+#include "adios2/toolkit/transport/Transport.h"
+
+namespace adios2
+{
+namespace transport
+{
+
+/** One keep-alive connection to an HTTP server, plain or over TLS */
+class HTTPConnection
+{
+public:
+    virtual ~HTTPConnection() = default;
+
+    virtual void Connect(const std::string &hostname, uint16_t port) = 0;
+    virtual void Close() = 0;
+
+    /** Like send()/recv(): bytes moved, 0 at end of stream, < 0 on error */
+    virtual int Send(const char *buffer, int size) = 0;
+    virtual int Recv(char *buffer, int size) = 0;
+
+    /** Received bytes that belong to the next part of the response */
+    std::string m_Pending;
+    /** Bytes taken out of the stream so far */
+    size_t m_Consumed = 0;
+    /** Set when a send or receive failed, the connection cannot be used again */
+    bool m_Lost = false;
+};
+
+class HTTPTCPConnection : public HTTPConnection
+{
+public:
+    void Connect(const std::string &hostname, uint16_t port) final;
+    void Close() final;
+    int Send(const char *buffer, int size) final;
+    int Recv(char *buffer, int size) final;
+
+private:
+    helper::NetworkSocket m_Socket;
+};
+
+/**
+ * Range reads over HTTP/1.1 for the HTTP and HTTPS transports. Connections
+ * are kept alive in a pool and reused. A batch of reads is turned into
+ * multi-range GET requests, split among up to Connections connections, and
+ * each connection has up to PipelineDepth requests in flight.
+ */
+class HTTPClient
+{
+public:
+    using ConnectionFactory = std::function<std::unique_ptr<HTTPConnection>()>;
+
+    explicit HTTPClient(ConnectionFactory factory);
+
+    ~HTTPClient();
+
+    void SetServer(const std::string &hostname, uint16_t port, const std::string &path);
+
+    /** connections, pipelinedepth, rangesperrequest, maxrequestsize and
+     *  verbose, keys in lower case */
+    void SetParameters(const Params &params);
+
+    /** Content-Length from a HEAD request */
+    size_t GetSize();
+
+    void Read(char *buffer, size_t size, size_t start);
+
+    /** Ops may come in any order, Start is the offset in the remote file */
+    void ReadV(const Transport::ReadOp *ops, size_t nOps);
+
+    /** Closes the idle connections */
+    void Close();
+
+    /** Splits [scheme://]host[:port][/path], port and path are only set if present */
+    static void SplitURL(const std::string &url, std::string &hostname, uint16_t &port,
+                         std::string &path);
+
+private:
+    struct Range
+    {
+        size_t Begin;
+        size_t End; // exclusive
+    };
+
+    /** One GET, disjoint ranges in order, and the reads they serve */
+    struct Request
+    {
+        std::vector<Range> Ranges;
+        std::vector<const Transport::ReadOp *> Ops; // sorted by Start
+        std::vector<size_t> MaxEnd; // of Ops[0..i], to find the reads at an offset
+    };
+
+    struct Response
+    {
+        int Status = 0;
+        std::map<std::string, std::string> Headers; // keys in lower case
+        bool KeepAlive = true;
+    };
+
+    ConnectionFactory m_Factory;
+    std::string m_Hostname = "localhost";
+    uint16_t m_Port = 80;
+    std::string m_Path;
+
+    size_t m_Connections = 4;
+    size_t m_PipelineDepth = 4;
+    size_t m_RangesPerRequest = 16;
+    /** larger ranges are split so they can go over several connections */
+    size_t m_MaxRequestSize = 16 * 1024 * 1024;
+    int m_Verbose = 0;
+
+    std::mutex m_PoolMutex;
+    std::condition_variable m_PoolCV;
+    std::vector<std::unique_ptr<HTTPConnection>> m_Idle;
+    size_t m_NOpen = 0; // idle and in use
+
+    /** An idle connection, a new one, or waits for one to be released */
+    std::unique_ptr<HTTPConnection> Acquire(bool &reused);
+    void Release(std::unique_ptr<HTTPConnection> connection, const bool keepAlive);
+
+    std::vector<Request> MakeRequests(const std::vector<const Transport::ReadOp *> &ops) const;
+    std::string RequestText(const Request &request) const;
+
+    /** Sends the requests pipelined on one connection and reads the answers */
+    void Run(Request *requests, const size_t nRequests);
+
+    void Send(HTTPConnection &c, const std::string &text);
+    Response ReceiveHeader(HTTPConnection &c);
+    /** Returns the body bytes that were requested */
+    size_t ReceiveBody(HTTPConnection &c, const Response &response, const Request &request);
+    void Deliver(HTTPConnection &c, const Request &request, size_t offset, size_t size);
+
+    std::string ReadLine(HTTPConnection &c);
+    void RecvExact(HTTPConnection &c, char *buffer, size_t size);
+    void Skip(HTTPConnection &c, size_t size);
+    void Fill(HTTPConnection &c);
+};
+
+} // end namespace transport
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_TRANSPORT_FILE_HTTPCLIENT_H_ */
@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "IOUring.h"
+
+#include <algorithm> // std::max
+#include <cerrno>
+#include <cstring> // std::memset
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace adios2
+{
+namespace transport
+{
+
+namespace
+{
+unsigned LoadAcquire(const unsigned *p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+void StoreRelease(unsigned *p, const unsigned v) { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+
+void *MapRing(const int fd, const size_t size, const off_t offset)
+{
+    void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    return (p == MAP_FAILED) ? nullptr : p;
+}
+}
+
+IOUring::IOUring(const unsigned entries)
+{
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    const int fd = static_cast<int>(syscall(SYS_io_uring_setup, entries, &params));
+    if (fd < 0)
+    {
+        return;
+    }
+
+    m_SQRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_CQRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap)
+    {
+        m_SQRingSize = m_CQRingSize = std::max(m_SQRingSize, m_CQRingSize);
+    }
+    m_SQRing = MapRing(fd, m_SQRingSize, IORING_OFF_SQ_RING);
+    m_CQRing = singleMap ? m_SQRing : MapRing(fd, m_CQRingSize, IORING_OFF_CQ_RING);
+    m_SQEsSize = params.sq_entries * sizeof(io_uring_sqe);
+    m_SQEs = MapRing(fd, m_SQEsSize, IORING_OFF_SQES);
+    if (!m_SQRing || !m_CQRing || !m_SQEs)
+    {
+        Unmap();
+        close(fd);
+        return;
+    }
+
+    char *sq = static_cast<char *>(m_SQRing);
+    m_SQHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    m_SQTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    m_SQMask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    m_SQArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    char *cq = static_cast<char *>(m_CQRing);
+    m_CQHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    m_CQTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    m_CQMask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    m_CQEs = cq + params.cq_off.cqes;
+
+    m_SQEntries = params.sq_entries;
+    m_RingFD = fd;
+}
+
+IOUring::~IOUring()
+{
+    Unmap();
+    if (m_RingFD >= 0)
+    {
+        close(m_RingFD);
+    }
+}
+
+void IOUring::Unmap()
+{
+    if (m_SQEs)
+    {
+        munmap(m_SQEs, m_SQEsSize);
+    }
+    if (m_CQRing && m_CQRing != m_SQRing)
+    {
+        munmap(m_CQRing, m_CQRingSize);
+    }
+    if (m_SQRing)
+    {
+        munmap(m_SQRing, m_SQRingSize);
+    }
+    m_SQEs = m_CQRing = m_SQRing = nullptr;
+}
+
+bool IOUring::PrepareRead(const int fd, char *buffer, const size_t size, const uint64_t offset,
+                          const uint64_t userData)
+{
+    const unsigned tail = *m_SQTail;
+    if (tail - LoadAcquire(m_SQHead) >= m_SQEntries)
+    {
+        return false;
+    }
+    const unsigned index = tail & *m_SQMask;
+    io_uring_sqe *sqe = static_cast<io_uring_sqe *>(m_SQEs) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buffer);
+    sqe->len = static_cast<uint32_t>(size);
+    sqe->off = offset;
+    sqe->user_data = userData;
+    m_SQArray[index] = index;
+    StoreRelease(m_SQTail, tail + 1);
+    ++m_ToSubmit;
+    return true;
+}
+
+int IOUring::Submit(const unsigned minComplete)
+{
+    const unsigned flags = minComplete ? IORING_ENTER_GETEVENTS : 0;
+    while (true)
+    {
+        const long ret =
+            syscall(SYS_io_uring_enter, m_RingFD, m_ToSubmit, minComplete, flags, nullptr, 0);
+        if (ret >= 0)
+        {
+            m_ToSubmit -= static_cast<unsigned>(ret);
+            return 0;
+        }
+        if (errno != EINTR)
+        {
+            return -errno;
+        }
+    }
+}
+
+int IOUring::Wait(const unsigned minComplete)
+{
+    const long ret = syscall(SYS_io_uring_enter, m_RingFD, 0, minComplete, IORING_ENTER_GETEVENTS,
+                             nullptr, 0);
+    return (ret >= 0) ? 0 : -errno;
+}
+
+bool IOUring::PopCompletion(uint64_t &userData, int &result)
+{
+    const unsigned head = *m_CQHead;
+    if (head == LoadAcquire(m_CQTail))
+    {
+        return false;
+    }
+    const io_uring_cqe *cqe = static_cast<io_uring_cqe *>(m_CQEs) + (head & *m_CQMask);
+    userData = cqe->user_data;
+    result = cqe->res;
+    StoreRelease(m_CQHead, head + 1);
+    return true;
+}
+
+} // end namespace transport
+} // end namespace adios2
@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ADIOS2_TOOLKIT_TRANSPORT_FILE_IOURING_H_
+#define ADIOS2_TOOLKIT_TRANSPORT_FILE_IOURING_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace adios2
+{
+namespace transport
+{
+
+/**
+ * Minimal Linux io_uring submission/completion ring for file reads, driven
+ * through the raw system calls so no liburing is needed. Not thread-safe.
+ */
+class IOUring
+{
+public:
+    /**
+     * Sets up a ring for up to entries requests in flight. If the kernel
+     * refuses (too old, disabled, seccomp) the ring is left invalid.
+     */
+    explicit IOUring(const unsigned entries);
+
+    ~IOUring();
+
+    IOUring(const IOUring &) = delete;
+    IOUring &operator=(const IOUring &) = delete;
+
+    bool Valid() const noexcept { return m_RingFD >= 0; }
+
+    /** Maximum number of requests in flight */
+    unsigned Capacity() const noexcept { return m_SQEntries; }
+
+    /**
+     * Queues a read of size bytes (at most 2GB) at offset, without submitting
+     * @return false if the submission queue is full
+     */
+    bool PrepareRead(const int fd, char *buffer, const size_t size, const uint64_t offset,
+                     const uint64_t userData);
+
+    /**
+     * Submits the queued requests and waits for at least minComplete of the
+     * submitted ones to complete.
+     * @return 0 or -errno
+     */
+    int Submit(const unsigned minComplete);
+
+    /**
+     * Waits for at least minComplete of the submitted requests to complete,
+     * without submitting the queued ones.
+     * @return 0 or -errno
+     */
+    int Wait(const unsigned minComplete);
+
+    /** Requests queued by PrepareRead that the kernel has not taken yet */
+    unsigned Unsubmitted() const noexcept { return m_ToSubmit; }
+
+    /**
+     * Takes the next completion.
+     * @param result bytes read or -errno
+     * @return false if none is ready
+     */
+    bool PopCompletion(uint64_t &userData, int &result);
+
+private:
+    int m_RingFD = -1;
+    unsigned m_SQEntries = 0;
+    unsigned m_ToSubmit = 0;
+
+    void *m_SQRing = nullptr;
+    size_t m_SQRingSize = 0;
+    void *m_CQRing = nullptr;
+    size_t m_CQRingSize = 0;
+    void *m_SQEs = nullptr;
+    size_t m_SQEsSize = 0;
+
+    unsigned *m_SQHead = nullptr;
+    unsigned *m_SQTail = nullptr;
+    unsigned *m_SQMask = nullptr;
+    unsigned *m_SQArray = nullptr;
+    unsigned *m_CQHead = nullptr;
+    unsigned *m_CQTail = nullptr;
+    unsigned *m_CQMask = nullptr;
+    void *m_CQEs = nullptr;
+
+    void Unmap();
+};
+
+} // end namespace transport
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_TRANSPORT_FILE_IOURING_H_ */
@@ -12,8 +12,10 @@
 #include <complex>
 #include <cstdint>
 #include <cstdlib>
+#include <fstream>
 #include <limits>
 #include <regex>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -28,7 +30,9 @@
 // Include appropriate headers based on the operating system
 #ifdef _WIN32
 #include <direct.h>
+#include <process.h>
 #define GetCurrentDir _getcwd
+#define getpid _getpid
 #else
 #include <unistd.h>
 #define GetCurrentDir getcwd
@@ -96,6 +100,36 @@ inline void CleanupTestFilesMPI(const std::string &path, MPI_Comm comm)
 }
 #endif
 
+// The profiling.json a BP5 reader of file fname writes to /tmp at Close
+inline std::string ReaderProfileFile(const std::string &fname)
+{
+    std::stringstream pid;
+    pid << std::hex << getpid();
+    const std::string base = fname.substr(fname.find_last_of('/') + 1);
+    return "/tmp/" + base + "_" + pid.str() + "_profiling.json";
+}
+
+inline std::string ReadProfile(const std::string &profileFile)
+{
+    std::ifstream in(profileFile);
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+// Sum of "key":<number> over all ranks of a profiling.json text, 0 if absent
+inline size_t ProfileCount(const std::string &profile, const std::string &key)
+{
+    const std::regex entry("\"" + key + "\":\\s*([0-9]+)");
+    size_t sum = 0;
+    for (auto it = std::sregex_iterator(profile.begin(), profile.end(), entry);
+         it != std::sregex_iterator(); ++it)
+    {
+        sum += std::stoull((*it)[1].str());
+    }
+    return sum;
+}
+
 // Test data for each type.  Make sure our values exceed the range of the
 // previous size to make sure we all bytes for each element
 struct SmallTestData
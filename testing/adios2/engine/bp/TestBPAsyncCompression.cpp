@@ -0,0 +1,195 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 writes with AsyncCompressionThreads: blocks compressed in the background
+// must read back the same as blocks compressed inside Put, for sync and
+// deferred Puts, and with the application reusing its buffer right after a
+// sync Put.
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../TestHelpers.h"
+
+std::string engineName; // from command line
+
+namespace
+{
+constexpr size_t Nx = 1000;
+constexpr size_t NBlocks = 4;
+constexpr size_t NSteps = 3;
+
+double Value(size_t step, size_t i) { return static_cast<double>(step * 100000 + i); }
+
+std::vector<std::string> Operators()
+{
+    std::vector<std::string> ops = {"null"};
+#ifdef ADIOS2_HAVE_BZIP2
+    ops.push_back("bzip2");
+#endif
+    return ops;
+}
+
+void WriteFile(const std::string &fname, const std::string &params)
+{
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    io.SetParameters(params);
+
+    std::vector<adios2::Variable<double>> syncVars, deferredVars;
+    for (const auto &op : Operators())
+    {
+        syncVars.push_back(io.DefineVariable<double>("sync_" + op, {NBlocks * Nx}, {0}, {Nx}));
+        syncVars.back().AddOperation(op);
+        deferredVars.push_back(
+            io.DefineVariable<double>("deferred_" + op, {NBlocks * Nx}, {0}, {Nx}));
+        deferredVars.back().AddOperation(op);
+    }
+
+    adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        writer.BeginStep();
+        // deferred Puts of all variables stay pending until EndStep in odd steps
+        std::vector<std::vector<double>> deferredData(syncVars.size() * NBlocks,
+                                                      std::vector<double>(Nx));
+        for (size_t v = 0; v < syncVars.size(); ++v)
+        {
+            // one buffer for all blocks, overwritten right after every Put
+            std::vector<double> data(Nx);
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = Value(step, b * Nx + i);
+                }
+                syncVars[v].SetSelection({{b * Nx}, {Nx}});
+                writer.Put(syncVars[v], data.data(), adios2::Mode::Sync);
+                std::fill(data.begin(), data.end(), -1.0);
+            }
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    deferredData[v * NBlocks + b][i] = -Value(step, b * Nx + i);
+                }
+                deferredVars[v].SetSelection({{b * Nx}, {Nx}});
+                writer.Put(deferredVars[v], deferredData[v * NBlocks + b].data());
+            }
+            if (step % 2 == 0)
+            {
+                writer.PerformPuts();
+            }
+        }
+        writer.EndStep();
+    }
+    writer.Close();
+}
+}
+
+class BPAsyncCompression : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPAsyncCompression() = default;
+};
+
+TEST_P(BPAsyncCompression, ReadBack)
+{
+    const std::string fname("BPAsyncCompression.bp");
+    WriteFile(fname, GetParam());
+
+    // with threads, every block of every (thread-safe) operator goes to them
+    const size_t compressions =
+        ProfileCount(ReadProfile(fname + "/profiling.json"), "asynccompressions");
+    if (GetParam().find("AsyncCompressionThreads=0") != std::string::npos)
+    {
+        EXPECT_EQ(compressions, 0);
+    }
+    else
+    {
+        EXPECT_EQ(compressions, Operators().size() * 2 * NBlocks * NSteps);
+    }
+
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+
+    adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    EXPECT_EQ(reader.Steps(), NSteps);
+    for (const auto &op : Operators())
+    {
+        for (const std::string prefix : {"sync_", "deferred_"})
+        {
+            const double sign = (prefix == "sync_") ? 1.0 : -1.0;
+            auto var = io.InquireVariable<double>(prefix + op);
+            ASSERT_TRUE(var);
+            for (size_t step = 0; step < NSteps; ++step)
+            {
+                auto blocks = reader.BlocksInfo(var, step);
+                ASSERT_EQ(blocks.size(), NBlocks);
+                for (size_t b = 0; b < NBlocks; ++b)
+                {
+                    const double first = sign * Value(step, b * Nx);
+                    const double last = sign * Value(step, b * Nx + Nx - 1);
+                    EXPECT_EQ(blocks[b].Min, std::min(first, last));
+                    EXPECT_EQ(blocks[b].Max, std::max(first, last));
+                }
+
+                std::vector<double> data;
+                var.SetStepSelection({step, 1});
+                reader.Get(var, data, adios2::Mode::Sync);
+                ASSERT_EQ(data.size(), NBlocks * Nx);
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    EXPECT_EQ(data[i], sign * Value(step, i))
+                        << prefix << op << " step=" << step << " i=" << i;
+                }
+            }
+        }
+    }
+    reader.Close();
+    CleanupTestFiles(fname);
+}
+
+INSTANTIATE_TEST_SUITE_P(AsyncCompression, BPAsyncCompression,
+                         ::testing::Values("AsyncCompressionThreads=0",
+                                           "AsyncCompressionThreads=1",
+                                           "AsyncCompressionThreads=3",
+                                           "AsyncCompressionThreads=2,BufferVType=malloc"));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
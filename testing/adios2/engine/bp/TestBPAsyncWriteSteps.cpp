@@ -0,0 +1,225 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 async writes with AsyncWriteSteps > 1: steps marshaled while the data
+// of earlier steps is still being written, and mid-step data writes chained
+// behind them, must read back as if every step had been written in order.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../TestHelpers.h"
+
+std::string engineName; // from command line
+
+class BPAsyncWriteSteps : public ::testing::Test
+{
+public:
+    BPAsyncWriteSteps()
+    {
+#if ADIOS2_USE_MPI
+        MPI_Comm_rank(MPI_COMM_WORLD, &m_Rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &m_Size);
+#endif
+    }
+
+    int m_Rank = 0;
+    int m_Size = 1;
+    size_t m_NSteps = 6;
+
+    /** Elements a rank puts in each of its two blocks, the same on all by default */
+    size_t (*m_Count)(int rank) = [](int) -> size_t { return 10000; };
+
+    static double Value(size_t step, size_t i) { return static_cast<double>(step * 10000000 + i); }
+
+    size_t Offset(int rank) const
+    {
+        size_t offset = 0;
+        for (int r = 0; r < rank; ++r)
+        {
+            offset += 2 * m_Count(r);
+        }
+        return offset;
+    }
+
+    /** Every rank puts two blocks of a global array per step; with
+     *  midStepWrite every third step writes its first block before EndStep */
+    void Write(const std::string &fname, const std::string &params, bool midStepWrite = false)
+    {
+#if ADIOS2_USE_MPI
+        adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+        adios2::ADIOS adios;
+#endif
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameters(params);
+
+        const size_t nx = m_Count(m_Rank);
+        auto var = io.DefineVariable<double>("a", {Offset(m_Size)}, {0}, {nx});
+        auto stepVar = io.DefineVariable<uint64_t>("step");
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        std::vector<double> data(nx);
+        for (size_t step = 0; step < m_NSteps; ++step)
+        {
+            writer.BeginStep();
+            for (size_t b = 0; b < 2; ++b)
+            {
+                const size_t start = Offset(m_Rank) + b * nx;
+                for (size_t i = 0; i < nx; ++i)
+                {
+                    data[i] = Value(step, start + i);
+                }
+                var.SetSelection({{start}, {nx}});
+                writer.Put(var, data.data(), adios2::Mode::Sync);
+                if (midStepWrite && step % 3 == 1 && b == 0)
+                {
+                    writer.PerformDataWrite();
+                }
+            }
+            if (m_Rank == 0)
+            {
+                writer.Put(stepVar, static_cast<uint64_t>(step));
+            }
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    /** Reads all steps back as a stream, every rank the whole array */
+    void CheckRead(const std::string &fname)
+    {
+#if ADIOS2_USE_MPI
+        adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+        adios2::ADIOS adios;
+#endif
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        size_t step = 0;
+        while (reader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var = io.InquireVariable<double>("a");
+            auto stepVar = io.InquireVariable<uint64_t>("step");
+            ASSERT_TRUE(var);
+            ASSERT_TRUE(stepVar);
+            uint64_t writtenStep = 0;
+            std::vector<double> data;
+            reader.Get(stepVar, writtenStep);
+            reader.Get(var, data);
+            reader.EndStep();
+
+            EXPECT_EQ(writtenStep, step);
+            ASSERT_EQ(data.size(), Offset(m_Size));
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                ASSERT_EQ(data[i], Value(step, i)) << "step=" << step << " i=" << i;
+            }
+            ++step;
+        }
+        EXPECT_EQ(step, m_NSteps);
+        reader.Close();
+#if ADIOS2_USE_MPI
+        CleanupTestFilesMPI(fname, MPI_COMM_WORLD);
+#else
+        CleanupTestFiles(fname);
+#endif
+    }
+};
+
+TEST_F(BPAsyncWriteSteps, NaiveSeveralStepsInFlight)
+{
+    const std::string fname("BPAsyncWriteStepsNaive.bp");
+    Write(fname, "AsyncWrite=Naive,AggregationType=EveryoneWrites,AsyncWriteSteps=4");
+    CheckRead(fname);
+}
+
+TEST_F(BPAsyncWriteSteps, GuidedSeveralStepsInFlight)
+{
+    const std::string fname("BPAsyncWriteStepsGuided.bp");
+    Write(fname, "AsyncWrite=Guided,AggregationType=EveryoneWrites,AsyncWriteSteps=3");
+    CheckRead(fname);
+}
+
+TEST_F(BPAsyncWriteSteps, DataWriteWithinStep)
+{
+    // the mid-step write queues behind the steps still in flight
+    const std::string fname("BPAsyncWriteStepsWithinStep.bp");
+    Write(fname, "AsyncWrite=Naive,AggregationType=EveryoneWrites,AsyncWriteSteps=2", true);
+    CheckRead(fname);
+}
+
+TEST_F(BPAsyncWriteSteps, SerialWriters)
+{
+    const std::string fname("BPAsyncWriteStepsSerial.bp");
+    Write(fname, "AsyncWrite=Naive,AggregationType=EveryoneWritesSerial,AsyncWriteSteps=3", true);
+    CheckRead(fname);
+}
+
+TEST_F(BPAsyncWriteSteps, TwoLevelShm)
+{
+    // shared memory segments are rebuilt per write, so a mid-step write has
+    // to wait for the writes before it
+    const std::string fname("BPAsyncWriteStepsTLS.bp");
+    Write(fname, "AsyncWrite=Naive,AggregationType=TwoLevelShm,AsyncWriteSteps=3", true);
+    CheckRead(fname);
+}
+
+TEST_F(BPAsyncWriteSteps, MallocBuffer)
+{
+    const std::string fname("BPAsyncWriteStepsMalloc.bp");
+    Write(fname, "AsyncWrite=Naive,AggregationType=EveryoneWrites,AsyncWriteSteps=2,"
+                 "BufferVType=malloc");
+    CheckRead(fname);
+}
+
+TEST_F(BPAsyncWriteSteps, MaxMemoryUnevenRanks)
+{
+    // Each rank writes a different amount, so only some of them go over
+    // AsyncWriteMaxMemory and want to retire steps early. They must still
+    // agree on it, or the ranks end up in different collectives.
+    m_Count = [](int rank) -> size_t { return (rank % 2 == 0) ? 40000 + 20000 * rank : 100; };
+    m_NSteps = 8;
+    const std::string fname("BPAsyncWriteStepsMaxMemory.bp");
+    Write(fname, "AsyncWrite=Naive,AggregationType=EveryoneWrites,AsyncWriteSteps=4,"
+                 "AsyncWriteMaxMemory=600KB");
+    CheckRead(fname);
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
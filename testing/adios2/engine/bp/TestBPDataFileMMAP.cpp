@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 reads with DataFileTransport=mmap: blocks used in place from the mapped
+// subfiles, whole or as part of a coalesced read, must read back the same as
+// blocks read through the default transport.
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../TestHelpers.h"
+
+std::string engineName; // from command line
+
+namespace
+{
+constexpr size_t Nx = 1000;
+constexpr size_t NBlocks = 4;
+constexpr size_t NSteps = 3;
+
+double Value(size_t step, size_t i) { return static_cast<double>(step * 100000 + i); }
+
+void WriteFile(const std::string &fname)
+{
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+
+    auto var = io.DefineVariable<double>("a", {NBlocks * Nx}, {0}, {Nx});
+    auto varOp = io.DefineVariable<double>("op", {NBlocks * Nx}, {0}, {Nx});
+    varOp.AddOperation("null");
+
+    adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        writer.BeginStep();
+        for (size_t b = 0; b < NBlocks; ++b)
+        {
+            std::vector<double> data(Nx);
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                data[i] = Value(step, b * Nx + i);
+            }
+            var.SetSelection({{b * Nx}, {Nx}});
+            writer.Put(var, data.data(), adios2::Mode::Sync);
+            varOp.SetSelection({{b * Nx}, {Nx}});
+            writer.Put(varOp, data.data(), adios2::Mode::Sync);
+        }
+        writer.EndStep();
+    }
+    writer.Close();
+}
+}
+
+class BPDataFileMMAP : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPDataFileMMAP() = default;
+};
+
+TEST_P(BPDataFileMMAP, ReadBack)
+{
+    const std::string fname("BPDataFileMMAP.bp");
+    WriteFile(fname);
+
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    io.SetParameters(GetParam());
+
+    adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+    size_t step = 0;
+    while (reader.BeginStep() == adios2::StepStatus::OK)
+    {
+        auto var = io.InquireVariable<double>("a");
+        auto varOp = io.InquireVariable<double>("op");
+        ASSERT_TRUE(var);
+        ASSERT_TRUE(varOp);
+
+        // all of it, straight into application memory
+        std::vector<double> all;
+        reader.Get(var, all);
+        // a selection across blocks, copied out of the subfile
+        const size_t start = Nx / 2;
+        const size_t count = 2 * Nx;
+        std::vector<double> part;
+        var.SetSelection({{start}, {count}});
+        reader.Get(var, part);
+        // operated blocks are decoded from the subfile
+        std::vector<double> decoded;
+        reader.Get(varOp, decoded);
+        reader.EndStep();
+
+        ASSERT_EQ(all.size(), NBlocks * Nx);
+        ASSERT_EQ(decoded.size(), NBlocks * Nx);
+        for (size_t i = 0; i < all.size(); ++i)
+        {
+            EXPECT_EQ(all[i], Value(step, i)) << "step=" << step << " i=" << i;
+            EXPECT_EQ(decoded[i], Value(step, i)) << "step=" << step << " i=" << i;
+        }
+        ASSERT_EQ(part.size(), count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(part[i], Value(step, start + i)) << "step=" << step << " i=" << i;
+        }
+        ++step;
+    }
+    EXPECT_EQ(step, NSteps);
+    reader.Close();
+
+    const std::string profileFile = ReaderProfileFile(fname);
+    const std::string profile = ReadProfile(profileFile);
+    const size_t mapped = ProfileCount(profile, "mappedreads");
+    if (GetParam().find("mmap") == std::string::npos)
+    {
+        EXPECT_EQ(mapped, 0);
+    }
+    else
+    {
+        // every read of a data file is served from its mapping
+        EXPECT_GT(mapped, 0);
+        EXPECT_EQ(mapped, ProfileCount(profile, "datareads"));
+    }
+    std::remove(profileFile.c_str());
+    CleanupTestFiles(fname);
+}
+
+INSTANTIATE_TEST_SUITE_P(DataFileMMAP, BPDataFileMMAP,
+                         ::testing::Values("Threads=1", "DataFileTransport=mmap",
+                                           "DataFileTransport=mmap,ReadSieveGapBytes=1MB",
+                                           "DataFileTransport=mmap,Threads=3"));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,297 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 writes with DeduplicateBlocks: blocks Put unchanged in later steps are
+// stored once and must read back the same in every step, in random access and
+// in step mode, while changed blocks are written again.
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../TestHelpers.h"
+
+std::string engineName; // from command line
+
+class BPDeduplicate : public ::testing::Test
+{
+public:
+    static constexpr size_t Nx = 500;
+    static constexpr size_t NBlocks = 2;
+    static constexpr size_t NSteps = 4;
+    static constexpr size_t BlockBytes = NBlocks * Nx * sizeof(double);
+
+    static double Mesh(size_t i) { return static_cast<double>(i) * 0.5; }
+    static double Field(size_t step, size_t i) { return static_cast<double>(step * 10000 + i); }
+    // changes in step 2 only
+    static double Mask(size_t step, size_t i)
+    {
+        return static_cast<double>(i % 7 + (step >= 2 ? 100 : 0));
+    }
+
+    void Write(const std::string &fname, const std::string &params)
+    {
+        adios2::ADIOS adios;
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameters(params);
+
+        auto mesh = io.DefineVariable<double>("mesh", {NBlocks * Nx}, {0}, {Nx});
+        auto meshop = io.DefineVariable<double>("meshop", {NBlocks * Nx}, {0}, {Nx});
+        meshop.AddOperation("null");
+        auto deferred = io.DefineVariable<double>("deferred", {NBlocks * Nx}, {0}, {Nx});
+        auto field = io.DefineVariable<double>("field", {NBlocks * Nx}, {0}, {Nx});
+        auto mask = io.DefineVariable<double>("mask", {NBlocks * Nx}, {0}, {Nx});
+
+        std::vector<double> meshData(NBlocks * Nx);
+        for (size_t i = 0; i < meshData.size(); ++i)
+        {
+            meshData[i] = Mesh(i);
+        }
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            std::vector<double> data(Nx);
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                const adios2::Box<adios2::Dims> sel({b * Nx}, {Nx});
+                mesh.SetSelection(sel);
+                meshop.SetSelection(sel);
+                deferred.SetSelection(sel);
+                field.SetSelection(sel);
+                mask.SetSelection(sel);
+                writer.Put(mesh, meshData.data() + b * Nx, adios2::Mode::Sync);
+                writer.Put(meshop, meshData.data() + b * Nx, adios2::Mode::Sync);
+                writer.Put(deferred, meshData.data() + b * Nx);
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = Field(step, b * Nx + i);
+                }
+                writer.Put(field, data.data(), adios2::Mode::Sync);
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = Mask(step, b * Nx + i);
+                }
+                writer.Put(mask, data.data(), adios2::Mode::Sync);
+            }
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    static size_t DataSize(const std::string &fname)
+    {
+        std::ifstream f(fname + "/data.0", std::ios::binary | std::ios::ate);
+        return static_cast<size_t>(f.tellg());
+    }
+
+    /** Writes the file with and without DeduplicateBlocks and returns how
+     *  many bytes of data deduplication saved */
+    size_t WriteBoth(const std::string &fname, const std::string &params)
+    {
+        const std::string plainName = fname + ".plain";
+        const std::string more = params.empty() ? "" : "," + params;
+        Write(fname, "DeduplicateBlocks=true" + more);
+        Write(plainName, "DeduplicateBlocks=false" + more);
+        const size_t saved = DataSize(plainName) - DataSize(fname);
+        CleanupTestFiles(plainName);
+        return saved;
+    }
+
+    void CheckStep(adios2::IO &io, adios2::Engine &reader, const size_t step,
+                   const bool randomAccess)
+    {
+        const std::vector<std::pair<std::string, double (*)(size_t, size_t)>> vars = {
+            {"mesh", [](size_t, size_t i) { return Mesh(i); }},
+            {"meshop", [](size_t, size_t i) { return Mesh(i); }},
+            {"deferred", [](size_t, size_t i) { return Mesh(i); }},
+            {"field", Field},
+            {"mask", Mask},
+        };
+        for (const auto &v : vars)
+        {
+            auto var = io.InquireVariable<double>(v.first);
+            ASSERT_TRUE(var);
+            if (randomAccess)
+            {
+                var.SetStepSelection({step, 1});
+            }
+            std::vector<double> data;
+            var.SetSelection({{0}, {NBlocks * Nx}});
+            reader.Get(var, data, adios2::Mode::Sync);
+            ASSERT_EQ(data.size(), NBlocks * Nx);
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                ASSERT_EQ(data[i], v.second(step, i))
+                    << v.first << " step=" << step << " i=" << i;
+            }
+
+            // a piece inside the second block
+            var.SetSelection({{Nx + 17}, {40}});
+            reader.Get(var, data, adios2::Mode::Sync);
+            ASSERT_EQ(data.size(), 40);
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                EXPECT_EQ(data[i], v.second(step, Nx + 17 + i)) << v.first << " step=" << step;
+            }
+        }
+    }
+
+    /** Reads every step with random access, last step first, then as a
+     *  stream, and removes the file */
+    void CheckRead(const std::string &fname, const std::string &params)
+    {
+        adios2::ADIOS adios;
+        {
+            adios2::IO io = adios.DeclareIO("RandomAccessIO");
+            if (!engineName.empty())
+            {
+                io.SetEngine(engineName);
+            }
+            io.SetParameters(params);
+            adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+            EXPECT_EQ(reader.Steps(), NSteps);
+            // the references are followed before the data they refer to
+            // has been read
+            for (size_t s = NSteps; s-- > 0;)
+            {
+                CheckStep(io, reader, s, true);
+            }
+            reader.Close();
+        }
+        {
+            adios2::IO io = adios.DeclareIO("StepIO");
+            if (!engineName.empty())
+            {
+                io.SetEngine(engineName);
+            }
+            io.SetParameters(params);
+            adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+            size_t step = 0;
+            while (reader.BeginStep() == adios2::StepStatus::OK)
+            {
+                CheckStep(io, reader, step, false);
+                reader.EndStep();
+                ++step;
+            }
+            EXPECT_EQ(step, NSteps);
+            reader.Close();
+        }
+        CleanupTestFiles(fname);
+    }
+};
+
+// mesh, meshop and deferred are stored once, mask twice
+constexpr size_t AllSaved = (3 * (BPDeduplicate::NSteps - 1) + (BPDeduplicate::NSteps - 2)) *
+                            BPDeduplicate::BlockBytes;
+
+TEST_F(BPDeduplicate, ReadBack)
+{
+    const std::string fname("BPDeduplicate.bp");
+    EXPECT_GE(WriteBoth(fname, ""), AllSaved);
+    CheckRead(fname, "");
+}
+
+TEST_F(BPDeduplicate, ReaderThreads)
+{
+    const std::string fname("BPDeduplicateThreads.bp");
+    WriteBoth(fname, "");
+    CheckRead(fname, "Threads=2");
+}
+
+TEST_F(BPDeduplicate, ReadAheadIsOff)
+{
+    // the layout of one step does not predict the next, read ahead is ignored
+    const std::string fname("BPDeduplicateReadAhead.bp");
+    WriteBoth(fname, "");
+    CheckRead(fname, "ReadAheadSteps=2");
+}
+
+TEST_F(BPDeduplicate, UncoalescedReads)
+{
+    const std::string fname("BPDeduplicateUncoalesced.bp");
+    WriteBoth(fname, "");
+    CheckRead(fname, "MaxCoalescedReadSize=0");
+}
+
+TEST_F(BPDeduplicate, DecompressedBlockCache)
+{
+    const std::string fname("BPDeduplicateBlockCache.bp");
+    WriteBoth(fname, "");
+    CheckRead(fname, "DecompressedBlockCacheSize=1MB");
+}
+
+TEST_F(BPDeduplicate, AsyncCompression)
+{
+    // meshop is placed at EndStep, after its reference has been noted
+    const std::string fname("BPDeduplicateAsyncCompression.bp");
+    EXPECT_GE(WriteBoth(fname, "AsyncCompressionThreads=2"), AllSaved);
+    CheckRead(fname, "");
+}
+
+TEST_F(BPDeduplicate, MallocBuffer)
+{
+    const std::string fname("BPDeduplicateMalloc.bp");
+    EXPECT_GE(WriteBoth(fname, "BufferVType=malloc"), AllSaved);
+    CheckRead(fname, "");
+}
+
+TEST_F(BPDeduplicate, MaxAge)
+{
+    // a copy two steps old is not referred to, so the unchanged blocks are
+    // written in steps 0 and 2, and a streaming reader forgets step 0
+    const std::string fname("BPDeduplicateMaxAge.bp");
+    const size_t saved = WriteBoth(fname, "DeduplicateMaxAge=1");
+    EXPECT_GE(saved, (3 * 2 + 2) * BlockBytes);
+    EXPECT_LT(saved, AllSaved);
+    CheckRead(fname, "");
+}
+
+TEST_F(BPDeduplicate, NoMaxAge)
+{
+    const std::string fname("BPDeduplicateNoMaxAge.bp");
+    EXPECT_GE(WriteBoth(fname, "DeduplicateMaxAge=0"), AllSaved);
+    CheckRead(fname, "");
+}
+
+TEST_F(BPDeduplicate, HashOnly)
+{
+    // without the byte comparison the hash alone finds the unchanged blocks
+    const std::string fname("BPDeduplicateHashOnly.bp");
+    EXPECT_GE(WriteBoth(fname, "DeduplicateVerify=false"), AllSaved);
+    CheckRead(fname, "");
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
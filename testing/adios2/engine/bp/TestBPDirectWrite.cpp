@@ -0,0 +1,303 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 writes with DirectWriteMinSize: large Sync Puts written to the subfile
+// inside Put must read back the same as copied blocks, with the application
+// reusing its buffer right after the Put, next to small, deferred and
+// operated blocks of the same steps.
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../TestHelpers.h"
+
+std::string engineName; // from command line
+
+class BPDirectWrite : public ::testing::Test
+{
+public:
+    BPDirectWrite()
+    {
+#if ADIOS2_USE_MPI
+        MPI_Comm_rank(MPI_COMM_WORLD, &m_Rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &m_Size);
+#endif
+    }
+
+    static constexpr size_t NxBig = 64 * 1024; // 512KB of doubles
+    static constexpr size_t NxSmall = 100;
+    static constexpr size_t NBlocks = 2;
+    static constexpr size_t NSteps = 3;
+
+    int m_Rank = 0;
+    int m_Size = 1;
+    /** One rank per step puts an extra large local array, so that data size
+     *  based aggregation puts the ranks into different subfiles every step */
+    bool m_UnevenLoad = false;
+
+    static double Value(size_t step, size_t i) { return static_cast<double>(step * 1000000 + i); }
+
+    void Write(const std::string &fname, const std::string &params)
+    {
+#if ADIOS2_USE_MPI
+        adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+        adios2::ADIOS adios;
+#endif
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameters(params);
+
+        const size_t nBig = NBlocks * NxBig * m_Size;
+        const size_t nSmall = NBlocks * NxSmall * m_Size;
+        auto big = io.DefineVariable<double>("big", {nBig}, {0}, {NxBig});
+        auto mesh = io.DefineVariable<double>("mesh", {nBig}, {0}, {NxBig});
+        auto small = io.DefineVariable<double>("small", {nSmall}, {0}, {NxSmall});
+        auto deferred = io.DefineVariable<double>("deferred", {nBig}, {0}, {NxBig});
+        auto op = io.DefineVariable<double>("op", {nBig}, {0}, {NxBig});
+        auto load = io.DefineVariable<double>("load", {}, {}, {NxBig});
+        op.AddOperation("null");
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            std::vector<std::vector<double>> deferredData(NBlocks, std::vector<double>(NxBig));
+            // one buffer for all sync blocks, overwritten right after every Put
+            std::vector<double> data(NxBig);
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                const size_t g = m_Rank * NBlocks + b;
+                for (size_t i = 0; i < NxBig; ++i)
+                {
+                    data[i] = Value(step, g * NxBig + i);
+                }
+                big.SetSelection({{g * NxBig}, {NxBig}});
+                writer.Put(big, data.data(), adios2::Mode::Sync);
+                op.SetSelection({{g * NxBig}, {NxBig}});
+                writer.Put(op, data.data(), adios2::Mode::Sync);
+                std::fill(data.begin(), data.end(), -1.0);
+
+                // the same in every step
+                for (size_t i = 0; i < NxBig; ++i)
+                {
+                    data[i] = -Value(0, g * NxBig + i);
+                }
+                mesh.SetSelection({{g * NxBig}, {NxBig}});
+                writer.Put(mesh, data.data(), adios2::Mode::Sync);
+
+                small.SetSelection({{g * NxSmall}, {NxSmall}});
+                writer.Put(small, data.data(), adios2::Mode::Sync);
+
+                for (size_t i = 0; i < NxBig; ++i)
+                {
+                    deferredData[b][i] = Value(step + 1, g * NxBig + i);
+                }
+                deferred.SetSelection({{g * NxBig}, {NxBig}});
+                writer.Put(deferred, deferredData[b].data());
+            }
+            if (m_UnevenLoad && (step % m_Size == static_cast<size_t>(m_Rank)))
+            {
+                for (size_t k = 0; k < 4; ++k)
+                {
+                    writer.Put(load, data.data(), adios2::Mode::Sync);
+                }
+            }
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    void CheckStep(adios2::IO &io, adios2::Engine &reader, const size_t step,
+                   const bool randomAccess)
+    {
+        const std::vector<std::pair<std::string, double (*)(size_t, size_t)>> vars = {
+            {"big", Value},
+            {"op", Value},
+            {"mesh", [](size_t, size_t i) { return -Value(0, i); }},
+            {"small",
+             [](size_t, size_t i) { return -Value(0, (i / NxSmall) * NxBig + i % NxSmall); }},
+            {"deferred", [](size_t s, size_t i) { return Value(s + 1, i); }},
+        };
+        for (const auto &v : vars)
+        {
+            auto var = io.InquireVariable<double>(v.first);
+            ASSERT_TRUE(var);
+            if (randomAccess)
+            {
+                var.SetStepSelection({step, 1});
+            }
+            std::vector<double> data;
+            reader.Get(var, data, adios2::Mode::Sync);
+            const size_t nx = (v.first == "small") ? NxSmall : NxBig;
+            ASSERT_EQ(data.size(), NBlocks * nx * m_Size);
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                ASSERT_EQ(data[i], v.second(step, i))
+                    << v.first << " step=" << step << " i=" << i;
+            }
+        }
+
+        // a piece across two blocks
+        auto big = io.InquireVariable<double>("big");
+        std::vector<double> data;
+        big.SetSelection({{NxBig - 10}, {20}});
+        reader.Get(big, data, adios2::Mode::Sync);
+        ASSERT_EQ(data.size(), 20);
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            EXPECT_EQ(data[i], Value(step, NxBig - 10 + i)) << "step=" << step;
+        }
+        big.SetSelection({{0}, {NBlocks * NxBig * m_Size}});
+    }
+
+    /** Reads every step with random access, then as a stream with read-ahead */
+    void CheckRead(const std::string &fname)
+    {
+#if ADIOS2_USE_MPI
+        adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+        adios2::ADIOS adios;
+#endif
+        {
+            adios2::IO io = adios.DeclareIO("RandomAccessIO");
+            if (!engineName.empty())
+            {
+                io.SetEngine(engineName);
+            }
+            adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+            EXPECT_EQ(reader.Steps(), NSteps);
+            for (size_t s = 0; s < NSteps; ++s)
+            {
+                CheckStep(io, reader, s, true);
+            }
+            reader.Close();
+        }
+        {
+            adios2::IO io = adios.DeclareIO("StepIO");
+            if (!engineName.empty())
+            {
+                io.SetEngine(engineName);
+            }
+            io.SetParameters("ReadAheadSteps=1");
+            adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+            size_t step = 0;
+            while (reader.BeginStep() == adios2::StepStatus::OK)
+            {
+                CheckStep(io, reader, step, false);
+                reader.EndStep();
+                ++step;
+            }
+            EXPECT_EQ(step, NSteps);
+            reader.Close();
+        }
+#if ADIOS2_USE_MPI
+        CleanupTestFilesMPI(fname, MPI_COMM_WORLD);
+#else
+        CleanupTestFiles(fname);
+#endif
+    }
+};
+
+TEST_F(BPDirectWrite, Off)
+{
+    const std::string fname("BPDirectWriteOff.bp");
+    Write(fname, "DirectWriteMinSize=0");
+    CheckRead(fname);
+}
+
+TEST_F(BPDirectWrite, Default)
+{
+    const std::string fname("BPDirectWriteDefault.bp");
+    Write(fname, "DirectWriteMinSize=64KB");
+    CheckRead(fname);
+}
+
+TEST_F(BPDirectWrite, EveryoneWrites)
+{
+    const std::string fname("BPDirectWriteEW.bp");
+    Write(fname, "DirectWriteMinSize=64KB,AggregationType=EveryoneWrites");
+    CheckRead(fname);
+}
+
+TEST_F(BPDirectWrite, EveryoneWritesSerial)
+{
+    const std::string fname("BPDirectWriteEWS.bp");
+    Write(fname, "DirectWriteMinSize=64KB,AggregationType=EveryoneWritesSerial");
+    CheckRead(fname);
+}
+
+TEST_F(BPDirectWrite, MallocBuffer)
+{
+    const std::string fname("BPDirectWriteMalloc.bp");
+    Write(fname, "DirectWriteMinSize=64KB,BufferVType=malloc");
+    CheckRead(fname);
+}
+
+TEST_F(BPDirectWrite, AsyncWriteBuffers)
+{
+    // the file belongs to the async writes, blocks are buffered
+    const std::string fname("BPDirectWriteAsync.bp");
+    Write(fname, "DirectWriteMinSize=64KB,AsyncWrite=true");
+    CheckRead(fname);
+}
+
+TEST_F(BPDirectWrite, Deduplicate)
+{
+    // later steps refer to the mesh blocks written inside Put in step 0
+    const std::string fname("BPDirectWriteDedup.bp");
+    Write(fname, "DirectWriteMinSize=64KB,DeduplicateBlocks=true");
+    CheckRead(fname);
+}
+
+TEST_F(BPDirectWrite, Stats)
+{
+    const std::string fname("BPDirectWriteStats.bp");
+    Write(fname, "DirectWriteMinSize=64KB,StatsLevel=2,StatsThreads=2");
+    CheckRead(fname);
+}
+
+TEST_F(BPDirectWrite, AggregationChangesBetweenSteps)
+{
+    // The ranks land in other subfiles every step, so the unchanged mesh
+    // blocks refer to data of an earlier step in a subfile this writer does
+    // not write to any more.
+    m_UnevenLoad = true;
+    const std::string fname("BPDirectWriteChangingAggregation.bp");
+    Write(fname, "DirectWriteMinSize=64KB,DeduplicateBlocks=true,"
+                 "AggregationType=DataSizeBased,NumSubFiles=2");
+    CheckRead(fname);
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
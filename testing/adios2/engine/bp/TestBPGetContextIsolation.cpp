@@ -7,7 +7,9 @@
 // BP5 GetContext isolation and concurrent-use tests.  Local BP5 only.
 
 #include <array>
+#include <chrono>
 #include <cstdint>
+#include <future>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -256,6 +258,90 @@ TEST_F(BPGetContextIsolation, ConcurrentGetsOnSameEngine)
 #endif
 }
 
+// PerformGetsAsync: contexts for several steps in flight at once, each
+// completing into its own buffer, and Close with one still pending.
+TEST_F(BPGetContextIsolation, AsyncContextsInFlight)
+{
+    constexpr size_t Nx = 4096;
+    constexpr size_t NSteps = 4;
+    const std::string fname("BPGetContextAsync.bp");
+
+    adios2::ADIOS adios;
+    {
+        adios2::IO io = adios.DeclareIO("AsyncWriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        if (!engineParameters.empty())
+        {
+            io.SetParameters(engineParameters);
+        }
+        auto var = io.DefineVariable<double>("v", {Nx}, {0}, {Nx});
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        std::vector<double> data(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                data[i] = static_cast<double>(step * 10000 + i);
+            }
+            writer.BeginStep();
+            writer.Put(var, data.data(), adios2::Mode::Sync);
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("AsyncReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+        auto var = io.InquireVariable<double>("v");
+        ASSERT_TRUE(var);
+
+        std::vector<std::unique_ptr<adios2::core::GetContext>> ctxs;
+        std::vector<std::vector<double>> bufs(NSteps, std::vector<double>(Nx, -1.0));
+        std::vector<std::shared_future<void>> pending;
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            ctxs.push_back(reader.NewGetContext());
+            ASSERT_NE(ctxs.back(), nullptr);
+            reader.Get(*ctxs.back(), var, bufs[step].data(),
+                       adios2::Selection::All().WithSteps(step, 1));
+            pending.push_back(reader.PerformGetsAsync(*ctxs.back()));
+        }
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            ASSERT_TRUE(pending[step].valid());
+            EXPECT_NO_THROW(pending[step].get());
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                ASSERT_EQ(bufs[step][i], static_cast<double>(step * 10000 + i))
+                    << "step " << step << " i " << i;
+            }
+        }
+
+        // the context can be reused once its future is ready
+        std::vector<double> again(Nx, -1.0);
+        reader.Get(*ctxs[0], var, again.data(), adios2::Selection::All().WithSteps(1, 1));
+        auto last = reader.PerformGetsAsync(*ctxs[0]);
+        // Close waits for reads still in flight
+        reader.Close();
+        EXPECT_EQ(last.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        EXPECT_EQ(again[Nx - 1], static_cast<double>(10000 + Nx - 1));
+    }
+
+#if ADIOS2_USE_MPI
+    CleanupTestFilesMPI(fname, MPI_COMM_WORLD);
+#else
+    CleanupTestFiles(fname);
+#endif
+}
+
 // Non-reentrant transport (fstream) — NewGetContext must return null.
 TEST_F(BPGetContextIsolation, NonReentrantTransportRejected)
 {
@@ -0,0 +1,235 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 writes with StatsLevel=2: every array block carries a histogram of its
+// values, returned per block by BlocksInfo and combined over the step by
+// Variable::Histogram.
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../TestHelpers.h"
+
+std::string engineName; // from command line
+
+class BPHistogram : public ::testing::Test
+{
+public:
+    static constexpr size_t Nx = 1000;
+    static constexpr size_t NBlocks = 3;
+    static constexpr size_t NSteps = 2;
+    static constexpr size_t Bins = 10;
+
+    // block b of step s holds b*Nx + i, so the step spans 0 .. NBlocks*Nx-1
+    static double Value(size_t step, size_t i) { return static_cast<double>(step * 10 + i); }
+
+    /** Writes "d" and "i" with Put, "op" through a null operator and "s"
+     *  into spans, NBlocks blocks of each per step */
+    void Write(const std::string &fname, const std::string &params)
+    {
+        adios2::ADIOS adios;
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameters(params);
+
+        auto var = io.DefineVariable<double>("d", {NBlocks * Nx}, {0}, {Nx});
+        auto ivar = io.DefineVariable<int32_t>("i", {NBlocks * Nx}, {0}, {Nx});
+        auto opvar = io.DefineVariable<double>("op", {NBlocks * Nx}, {0}, {Nx});
+        auto svar = io.DefineVariable<double>("s", {NBlocks * Nx}, {0}, {Nx});
+        opvar.AddOperation("null");
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            std::vector<double> data(Nx);
+            std::vector<int32_t> idata(Nx);
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = Value(step, b * Nx + i);
+                    idata[i] = static_cast<int32_t>(b * Nx + i);
+                }
+                var.SetSelection({{b * Nx}, {Nx}});
+                ivar.SetSelection({{b * Nx}, {Nx}});
+                opvar.SetSelection({{b * Nx}, {Nx}});
+                svar.SetSelection({{b * Nx}, {Nx}});
+                writer.Put(var, data.data(), adios2::Mode::Sync);
+                writer.Put(ivar, idata.data(), adios2::Mode::Sync);
+                writer.Put(opvar, data.data(), adios2::Mode::Sync);
+                // filled after Put, its stats are only known at EndStep
+                auto span = writer.Put(svar);
+                std::copy(data.begin(), data.end(), span.data());
+            }
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    /** Uniform values: every block bin gets Nx / Bins, and so does every
+     *  bin of the step, up to the rounding of the rebinning */
+    void CheckUniform(const std::string &fname, const std::string &name)
+    {
+        adios2::ADIOS adios;
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+        auto var = io.InquireVariable<double>(name);
+        ASSERT_TRUE(var);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            auto blocks = reader.BlocksInfo(var, step);
+            ASSERT_EQ(blocks.size(), NBlocks);
+            for (const auto &block : blocks)
+            {
+                EXPECT_EQ(block.Histogram, std::vector<uint64_t>(Bins, Nx / Bins))
+                    << name << " step " << step;
+            }
+
+            // block bins straddling two step bins are split by rounding
+            const std::vector<uint64_t> hist = var.Histogram(step);
+            ASSERT_EQ(hist.size(), Bins);
+            EXPECT_EQ(std::accumulate(hist.begin(), hist.end(), uint64_t(0)), NBlocks * Nx);
+            for (size_t j = 0; j < Bins; ++j)
+            {
+                EXPECT_NEAR(static_cast<double>(hist[j]), NBlocks * Nx / Bins, 1.0)
+                    << name << " step " << step << " bin " << j;
+            }
+        }
+        reader.Close();
+    }
+};
+
+TEST_F(BPHistogram, BlockAndStepCounts)
+{
+    const std::string fname("BPHistogram.bp");
+    Write(fname, "StatsLevel=2,StatsHistogramBins=10");
+    CheckUniform(fname, "d");
+    CleanupTestFiles(fname);
+}
+
+TEST_F(BPHistogram, Operator)
+{
+    const std::string fname("BPHistogramOperator.bp");
+    Write(fname, "StatsLevel=2,StatsHistogramBins=10");
+    CheckUniform(fname, "op");
+    CleanupTestFiles(fname);
+}
+
+TEST_F(BPHistogram, Span)
+{
+    // computed at EndStep, once the span has been filled in
+    const std::string fname("BPHistogramSpan.bp");
+    Write(fname, "StatsLevel=2,StatsHistogramBins=10");
+    CheckUniform(fname, "s");
+    CleanupTestFiles(fname);
+}
+
+TEST_F(BPHistogram, StatsThreads)
+{
+    const std::string fname("BPHistogramThreads.bp");
+    Write(fname, "StatsLevel=2,StatsHistogramBins=10,StatsThreads=3");
+    CheckUniform(fname, "d");
+    CheckUniform(fname, "s");
+    CleanupTestFiles(fname);
+}
+
+TEST_F(BPHistogram, SubBlockStats)
+{
+    // the histogram is of the whole block, not of its sub-blocks
+    const std::string fname("BPHistogramSubBlocks.bp");
+    Write(fname, "StatsLevel=2,StatsHistogramBins=10,StatsBlockSize=100");
+    CheckUniform(fname, "d");
+    CleanupTestFiles(fname);
+}
+
+TEST_F(BPHistogram, AsyncCompression)
+{
+    const std::string fname("BPHistogramAsyncCompression.bp");
+    Write(fname, "StatsLevel=2,StatsHistogramBins=10,AsyncCompressionThreads=2");
+    CheckUniform(fname, "op");
+    CleanupTestFiles(fname);
+}
+
+TEST_F(BPHistogram, AllSteps)
+{
+    const std::string fname("BPHistogramAllSteps.bp");
+    Write(fname, "StatsLevel=2,StatsHistogramBins=10");
+
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    auto ivar = io.InquireVariable<int32_t>("i");
+    ASSERT_TRUE(ivar);
+    const std::vector<uint64_t> all = ivar.Histogram();
+    ASSERT_EQ(all.size(), Bins);
+    EXPECT_EQ(std::accumulate(all.begin(), all.end(), uint64_t(0)), NSteps * NBlocks * Nx);
+    reader.Close();
+    CleanupTestFiles(fname);
+}
+
+TEST_F(BPHistogram, Off)
+{
+    const std::string fname("BPHistogramOff.bp");
+    Write(fname, "StatsLevel=1");
+
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    auto var = io.InquireVariable<double>("d");
+    ASSERT_TRUE(var);
+    EXPECT_TRUE(var.Histogram(0).empty());
+    auto blocks = reader.BlocksInfo(var, 0);
+    ASSERT_EQ(blocks.size(), NBlocks);
+    EXPECT_TRUE(blocks[0].Histogram.empty());
+    EXPECT_EQ(blocks[0].Max, Value(0, Nx - 1));
+    reader.Close();
+    CleanupTestFiles(fname);
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,331 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 ReadRandomAccess with LazyMetadataInstall: steps whose blocks are
+// installed on first use, in any order, must read the same as with everything
+// installed at Open, and the variables, attributes and their steps must be
+// complete right after Open, including those that first appear in later
+// steps.
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <adios2.h>
+#include <adios2/core/GetContext.h>
+
+#include <gtest/gtest.h>
+
+#include "../TestHelpers.h"
+
+std::string engineName; // from command line
+
+class BPLazyMetadata : public ::testing::Test
+{
+public:
+    BPLazyMetadata() = default;
+
+    static constexpr size_t Nx = 10;
+    static constexpr size_t NBlocks = 2;
+    static constexpr size_t NSteps = 10;
+    /** "late" and the "late_attr" attribute first appear in this step */
+    static constexpr size_t LateStep = 6;
+
+    static double Value(size_t step, size_t i) { return static_cast<double>(step * 1000 + i); }
+
+    /** Rows of the joined array "rows" written in a step */
+    static size_t JoinedRows(size_t step) { return 1 + step % 3; }
+
+    void Write(const std::string &fname)
+    {
+        adios2::ADIOS adios;
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        auto var = io.DefineVariable<double>("f", {NBlocks * Nx}, {0}, {Nx});
+        auto odd = io.DefineVariable<double>("odd", {Nx}, {0}, {Nx});
+        auto late = io.DefineVariable<double>("late", {Nx}, {0}, {Nx});
+        auto scalar = io.DefineVariable<int32_t>("step");
+        adios2::Variable<double> rows;
+        if (m_Joined)
+        {
+            rows = io.DefineVariable<double>("rows", {adios2::JoinedDim, Nx}, {}, {1, Nx});
+        }
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            std::vector<double> data(Nx);
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = Value(step, b * Nx + i);
+                }
+                var.SetSelection({{b * Nx}, {Nx}});
+                writer.Put(var, data.data(), adios2::Mode::Sync);
+            }
+            if (step % 2)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = -Value(step, i);
+                }
+                writer.Put(odd, data.data(), adios2::Mode::Sync);
+            }
+            if (step >= LateStep)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = Value(step, 100 + i);
+                }
+                writer.Put(late, data.data(), adios2::Mode::Sync);
+            }
+            if (step == LateStep)
+            {
+                io.DefineAttribute<int32_t>("late_attr", static_cast<int32_t>(step));
+            }
+            if (m_Joined)
+            {
+                std::vector<double> block(JoinedRows(step) * Nx, static_cast<double>(step));
+                rows.SetSelection({{}, {JoinedRows(step), Nx}});
+                writer.Put(rows, block.data(), adios2::Mode::Sync);
+            }
+            writer.Put(scalar, static_cast<int32_t>(step));
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    /** Checks what Open reveals before any step is asked for */
+    void CheckVariables(adios2::IO &io, adios2::Engine &reader)
+    {
+        EXPECT_EQ(reader.Steps(), NSteps);
+        auto var = io.InquireVariable<double>("f");
+        ASSERT_TRUE(var);
+        EXPECT_EQ(var.Steps(), NSteps);
+        auto odd = io.InquireVariable<double>("odd");
+        ASSERT_TRUE(odd);
+        EXPECT_EQ(odd.Steps(), NSteps / 2);
+        auto late = io.InquireVariable<double>("late");
+        ASSERT_TRUE(late);
+        EXPECT_EQ(late.Steps(), NSteps - LateStep);
+        EXPECT_EQ(io.AvailableVariables().size(), m_Joined ? 5 : 4);
+        auto attr = io.InquireAttribute<int32_t>("late_attr");
+        ASSERT_TRUE(attr);
+        EXPECT_EQ(attr.Data().front(), static_cast<int32_t>(LateStep));
+        EXPECT_EQ(reader.GetAbsoluteSteps(odd), std::vector<size_t>({1, 3, 5, 7, 9}));
+    }
+
+    /** Reads single steps out of order, later ones first */
+    void CheckSteps(adios2::IO &io, adios2::Engine &reader)
+    {
+        auto var = io.InquireVariable<double>("f");
+        std::vector<double> data;
+        for (size_t step : {7, 2, 9})
+        {
+            var.SetStepSelection({step, 1});
+            reader.Get(var, data, adios2::Mode::Sync);
+            ASSERT_EQ(data.size(), NBlocks * Nx);
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                EXPECT_EQ(data[i], Value(step, i)) << "step=" << step << " i=" << i;
+            }
+        }
+
+        auto scalar = io.InquireVariable<int32_t>("step");
+        ASSERT_TRUE(scalar);
+        int32_t s = -1;
+        scalar.SetStepSelection({4, 1});
+        reader.Get(scalar, s, adios2::Mode::Sync);
+        EXPECT_EQ(s, 4);
+
+        // relative steps of "odd" are the odd absolute steps
+        auto odd = io.InquireVariable<double>("odd");
+        for (size_t relStep : {4, 0, 2})
+        {
+            odd.SetStepSelection({relStep, 1});
+            reader.Get(odd, data, adios2::Mode::Sync);
+            ASSERT_EQ(data.size(), Nx);
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                EXPECT_EQ(data[i], -Value(2 * relStep + 1, i)) << "relStep=" << relStep;
+            }
+        }
+
+        // two steps of "late" in one Get
+        auto late = io.InquireVariable<double>("late");
+        late.SetStepSelection({2, 2});
+        reader.Get(late, data, adios2::Mode::Sync);
+        ASSERT_EQ(data.size(), 2 * Nx);
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            EXPECT_EQ(data[i], Value(LateStep + 2 + i / Nx, 100 + i % Nx)) << "i=" << i;
+        }
+
+        auto blocks = reader.BlocksInfo(var, 5);
+        EXPECT_EQ(blocks.size(), NBlocks);
+        EXPECT_EQ(var.Steps(), NSteps);
+        EXPECT_EQ(odd.Steps(), NSteps / 2);
+
+        odd.SetStepSelection({3, 1});
+        EXPECT_EQ(odd.Shape(), adios2::Dims({Nx}));
+        const auto minMax = odd.MinMax();
+        EXPECT_EQ(minMax.first, -Value(NSteps - 1, Nx - 1));
+        EXPECT_EQ(minMax.second, -Value(1, 0));
+
+        if (m_Joined)
+        {
+            auto rows = io.InquireVariable<double>("rows");
+            ASSERT_TRUE(rows);
+            for (size_t step : {8, 4})
+            {
+                rows.SetStepSelection({step, 1});
+                rows.SetSelection({{0, 0}, {JoinedRows(step), Nx}});
+                reader.Get(rows, data, adios2::Mode::Sync);
+                ASSERT_EQ(data.size(), JoinedRows(step) * Nx);
+                EXPECT_EQ(data.front(), static_cast<double>(step));
+                EXPECT_EQ(data.back(), static_cast<double>(step));
+            }
+        }
+    }
+
+    void CheckRead(const std::string &fname, const std::string &params)
+    {
+        adios2::ADIOS adios;
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameters(params);
+
+        adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+        CheckVariables(io, reader);
+        CheckSteps(io, reader);
+        reader.Close();
+    }
+
+    void WriteAndCheck(const std::string &fname, const std::string &params)
+    {
+        Write(fname);
+        CheckRead(fname, params);
+        CleanupTestFiles(fname);
+    }
+
+    bool m_Joined = false;
+};
+
+TEST_F(BPLazyMetadata, Off) { WriteAndCheck("BPLazyMetadataOff.bp", "LazyMetadataInstall=false"); }
+
+TEST_F(BPLazyMetadata, Lazy) { WriteAndCheck("BPLazyMetadata.bp", "LazyMetadataInstall=true"); }
+
+TEST_F(BPLazyMetadata, MetadataThreads)
+{
+    WriteAndCheck("BPLazyMetadataThreads.bp", "LazyMetadataInstall=true,MetadataThreads=2");
+}
+
+TEST_F(BPLazyMetadata, SharedMetadata)
+{
+    // a single process has no one to share with, it keeps its own copy
+    WriteAndCheck("BPLazyMetadataShared.bp", "LazyMetadataInstall=true,ShareMetadataOnNode=true");
+}
+
+TEST_F(BPLazyMetadata, JoinedArray)
+{
+    m_Joined = true;
+    WriteAndCheck("BPLazyMetadataJoined.bp", "LazyMetadataInstall=true");
+}
+
+TEST_F(BPLazyMetadata, ConcurrentContexts)
+{
+    // every thread reads its own steps through its own context, so steps are
+    // installed while the reads of others are in flight
+    constexpr size_t NThreads = 4;
+    const std::string fname("BPLazyMetadataConcurrent.bp");
+    Write(fname);
+
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    io.SetParameters("LazyMetadataInstall=true");
+    adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    auto var = io.InquireVariable<double>("f");
+    ASSERT_TRUE(var);
+
+    std::vector<std::string> errors(NThreads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < NThreads; ++t)
+    {
+        threads.emplace_back(
+            [&](size_t tid) {
+                try
+                {
+                    auto ctx = reader.NewGetContext();
+                    std::vector<double> data(NBlocks * Nx);
+                    for (size_t step = NSteps - 1 - tid; step < NSteps; step -= NThreads)
+                    {
+                        const auto sel = adios2::Selection::All().WithSteps(step, 1);
+                        reader.Get(*ctx, var, data.data(), sel);
+                        reader.PerformGets(*ctx);
+                        for (size_t i = 0; i < data.size(); ++i)
+                        {
+                            if (data[i] != Value(step, i))
+                            {
+                                errors[tid] = "step " + std::to_string(step) + " [" +
+                                              std::to_string(i) + "] = " + std::to_string(data[i]);
+                                return;
+                            }
+                        }
+                    }
+                }
+                catch (const std::exception &e)
+                {
+                    errors[tid] = std::string("exception: ") + e.what();
+                }
+            },
+            t);
+    }
+    for (auto &th : threads)
+    {
+        th.join();
+    }
+    for (size_t t = 0; t < NThreads; ++t)
+    {
+        EXPECT_TRUE(errors[t].empty()) << "thread " << t << ": " << errors[t];
+    }
+    reader.Close();
+    CleanupTestFiles(fname);
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
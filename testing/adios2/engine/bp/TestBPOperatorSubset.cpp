@@ -0,0 +1,231 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 reads of a small box inside an operated block: operators that decode a
+// part of a block (Operator::InverseOperateSubset) must return the same data
+// as decompressing the whole block, and operators that cannot must fall back
+// to it.
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../TestHelpers.h"
+
+std::string engineName; // from command line
+
+namespace
+{
+constexpr size_t Nx = 20;
+constexpr size_t Ny = 30;
+constexpr size_t NBlocks = 2;
+
+// block pieces decoded by the reads below: one for each box inside a block
+// (two a2D boxes and the l2D box) and two for each a2D box spanning both
+constexpr size_t NSubsets = 7;
+
+// bzip2 has no InverseOperateSubset and decompresses whole blocks
+const std::vector<std::string> Operators = {"null",
+#ifdef ADIOS2_HAVE_BZIP2
+                                            "bzip2",
+#endif
+#ifdef ADIOS2_HAVE_BLOSC2
+                                            "blosc",
+#endif
+#ifdef ADIOS2_HAVE_ZFP
+                                            "zfp",
+#endif
+};
+
+double Value(size_t row, size_t col) { return static_cast<double>(row * 1000 + col); }
+
+// operators that implement InverseOperateSubset, zfp only in fixed-rate mode
+bool DecodesSubsets(const std::string &op) { return op == "null" || op == "blosc" || op == "zfp"; }
+
+bool Lossless(const std::string &op) { return op != "zfp"; }
+
+void WriteFile(const std::string &fname, const std::string &op)
+{
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+
+    // NBlocks row blocks of a (NBlocks*Nx) x Ny array, plus one local block
+    auto var = io.DefineVariable<double>("a2D", {NBlocks * Nx, Ny}, {0, 0}, {Nx, Ny});
+    auto local = io.DefineVariable<double>("l2D", {}, {}, {Nx, Ny});
+    // small blosc blocks so that a box needs only a few of them
+    adios2::Params opParams;
+    if (op == "zfp")
+    {
+        opParams = {{"rate", "16"}};
+    }
+    else if (op == "blosc")
+    {
+        opParams = {{"blocksize", "256"}};
+    }
+    var.AddOperation(op, opParams);
+    local.AddOperation(op, opParams);
+
+    adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+    writer.BeginStep();
+    std::vector<double> data(Nx * Ny);
+    for (size_t b = 0; b < NBlocks; ++b)
+    {
+        for (size_t r = 0; r < Nx; ++r)
+        {
+            for (size_t c = 0; c < Ny; ++c)
+            {
+                data[r * Ny + c] = Value(b * Nx + r, c);
+            }
+        }
+        var.SetSelection({{b * Nx, 0}, {Nx, Ny}});
+        writer.Put(var, data.data(), adios2::Mode::Sync);
+    }
+    writer.Put(local, data.data(), adios2::Mode::Sync);
+    writer.EndStep();
+    writer.Close();
+}
+}
+
+class BPOperatorSubset
+: public ::testing::TestWithParam<std::tuple<std::string, std::string>>
+{
+public:
+    BPOperatorSubset() = default;
+};
+
+TEST_P(BPOperatorSubset, ReadBoxes)
+{
+    const std::string op = std::get<0>(GetParam());
+    const std::string params = std::get<1>(GetParam());
+    const std::string fname("BPOperatorSubset.bp");
+    WriteFile(fname, op);
+
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    io.SetParameters(params);
+
+    adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    auto var = io.InquireVariable<double>("a2D");
+    ASSERT_TRUE(var);
+
+    // whole blocks are decompressed in whole; the boxes are checked against them
+    std::vector<double> all;
+    reader.Get(var, all, adios2::Mode::Sync);
+    ASSERT_EQ(all.size(), NBlocks * Nx * Ny);
+    if (Lossless(op))
+    {
+        for (size_t i = 0; i < all.size(); ++i)
+        {
+            ASSERT_EQ(all[i], Value(i / Ny, i % Ny)) << "i=" << i;
+        }
+    }
+
+    // a point, a row piece, a column piece and a box spanning both blocks
+    const std::vector<adios2::Box<adios2::Dims>> boxes = {
+        {{7, 11}, {1, 1}},
+        {{3, 0}, {2, Ny}},
+        {{0, 5}, {NBlocks * Nx, 2}},
+        {{Nx - 4, 9}, {8, 13}},
+    };
+    for (const auto &box : boxes)
+    {
+        var.SetSelection(box);
+        std::vector<double> data;
+        reader.Get(var, data, adios2::Mode::Sync);
+        ASSERT_EQ(data.size(), box.second[0] * box.second[1]);
+        for (size_t r = 0; r < box.second[0]; ++r)
+        {
+            for (size_t c = 0; c < box.second[1]; ++c)
+            {
+                EXPECT_EQ(data[r * box.second[1] + c],
+                          all[(box.first[0] + r) * Ny + box.first[1] + c])
+                    << "box at " << box.first[0] << "," << box.first[1] << " r=" << r
+                    << " c=" << c;
+            }
+        }
+    }
+
+    auto local = io.InquireVariable<double>("l2D");
+    ASSERT_TRUE(local);
+    local.SetBlockSelection(0);
+    local.SetSelection({{2, 3}, {4, 5}});
+    std::vector<double> data;
+    reader.Get(local, data, adios2::Mode::Sync);
+    ASSERT_EQ(data.size(), 4 * 5);
+    for (size_t r = 0; r < 4; ++r)
+    {
+        for (size_t c = 0; c < 5; ++c)
+        {
+            // the local block holds the last row block written
+            EXPECT_EQ(data[r * 5 + c], all[((NBlocks - 1) * Nx + 2 + r) * Ny + 3 + c]);
+        }
+    }
+
+    reader.Close();
+
+    // with room in the block cache, whole blocks are decompressed and kept
+    const std::string profileFile = ReaderProfileFile(fname);
+    const size_t subsets = ProfileCount(ReadProfile(profileFile), "subsetdecompressions");
+    if (DecodesSubsets(op) && params.find("DecompressedBlockCacheSize") == std::string::npos)
+    {
+        // blosc falls back to the whole block for boxes needing many blosc blocks
+        if (op == "blosc")
+        {
+            EXPECT_GT(subsets, 0);
+        }
+        else
+        {
+            EXPECT_EQ(subsets, NSubsets);
+        }
+    }
+    else
+    {
+        EXPECT_EQ(subsets, 0);
+    }
+    EXPECT_GT(ProfileCount(ReadProfile(profileFile), "blockdecompressions"), 0);
+    std::remove(profileFile.c_str());
+    CleanupTestFiles(fname);
+}
+
+INSTANTIATE_TEST_SUITE_P(OperatorSubset, BPOperatorSubset,
+                         ::testing::Combine(::testing::ValuesIn(Operators),
+                                            ::testing::Values("Threads=1", "Threads=2",
+                                                              "DecompressedBlockCacheSize=1MB")));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
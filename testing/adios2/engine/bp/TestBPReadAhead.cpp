@@ -0,0 +1,193 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 streaming read-ahead: data prefetched for later steps must match what a
+// plain read returns, also when the selection changes from step to step.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../TestHelpers.h"
+
+std::string engineName; // from command line
+
+class BPReadAhead : public ::testing::Test
+{
+public:
+    static constexpr size_t Nx = 100;
+    static constexpr size_t NBlocks = 3;
+    static constexpr size_t NSteps = 6;
+
+    static float Value(size_t step, size_t i) { return static_cast<float>(step * 1000 + i); }
+
+    void Write(const std::string &fname)
+    {
+        adios2::ADIOS adios;
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        auto var = io.DefineVariable<float>("f", {NBlocks * Nx}, {0}, {Nx});
+        auto scalar = io.DefineVariable<int32_t>("step");
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                std::vector<float> data(Nx);
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = Value(step, b * Nx + i);
+                }
+                var.SetSelection({{b * Nx}, {Nx}});
+                writer.Put(var, data.data(), adios2::Mode::Sync);
+            }
+            writer.Put(scalar, static_cast<int32_t>(step));
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    /** Streams through the file reading the middle of every step, or a
+     *  selection that moves and grows a little every step if changing.
+     *  Sets m_ReadAheadBytes to the bytes taken from read-ahead buffers. */
+    void ReadAndCheck(const std::string &fname, const std::string &params,
+                        const bool changing = false, const bool pause = false)
+    {
+        adios2::ADIOS adios;
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameters(params);
+
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        size_t step = 0;
+        while (reader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var = io.InquireVariable<float>("f");
+            ASSERT_TRUE(var);
+            const size_t start = changing ? step * 7 : Nx / 2;
+            const size_t count = changing ? Nx + step * 13 : NBlocks * Nx - Nx;
+            var.SetSelection({{start}, {count}});
+            std::vector<float> data;
+            reader.Get(var, data);
+            reader.EndStep();
+            if (pause)
+            {
+                // give the read-ahead of the next step time to finish
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            }
+
+            ASSERT_EQ(data.size(), count);
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                ASSERT_EQ(data[i], Value(step, start + i)) << "step=" << step << " i=" << i;
+            }
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+        reader.Close();
+        CleanupTestFiles(fname);
+
+        const std::string profileFile = ReaderProfileFile(fname);
+        m_ReadAheadBytes = ProfileCount(ReadProfile(profileFile), "readaheadbytes");
+        std::remove(profileFile.c_str());
+    }
+
+    size_t m_ReadAheadBytes = 0;
+};
+
+TEST_F(BPReadAhead, Off)
+{
+    const std::string fname("BPReadAheadOff.bp");
+    Write(fname);
+    ReadAndCheck(fname, "ReadAheadSteps=0");
+    EXPECT_EQ(m_ReadAheadBytes, 0);
+}
+
+TEST_F(BPReadAhead, OneStep)
+{
+    const std::string fname("BPReadAheadOneStep.bp");
+    Write(fname);
+    ReadAndCheck(fname, "ReadAheadSteps=1");
+}
+
+TEST_F(BPReadAhead, PrefetchedStepsAreUsed)
+{
+    // every step after the first is taken from the read-ahead buffers
+    const std::string fname("BPReadAheadUsed.bp");
+    Write(fname);
+    ReadAndCheck(fname, "ReadAheadSteps=2", false, true);
+    EXPECT_EQ(m_ReadAheadBytes, (NSteps - 1) * (NBlocks * Nx - Nx) * sizeof(float));
+}
+
+TEST_F(BPReadAhead, SeveralStepsOnePoolThread)
+{
+    // the prefetch tasks queue up on the single pool thread, and a step whose
+    // prefetch has not started is read without waiting for it
+    const std::string fname("BPReadAheadOnePoolThread.bp");
+    Write(fname);
+    ReadAndCheck(fname, "ReadAheadSteps=4,Threads=2");
+}
+
+TEST_F(BPReadAhead, SeveralStepsManyThreads)
+{
+    const std::string fname("BPReadAheadManyThreads.bp");
+    Write(fname);
+    ReadAndCheck(fname, "ReadAheadSteps=3,Threads=4");
+}
+
+TEST_F(BPReadAhead, BufferLimit)
+{
+    // room for less than one step, nothing is prefetched
+    const std::string fname("BPReadAheadBufferLimit.bp");
+    Write(fname);
+    ReadAndCheck(fname, "ReadAheadSteps=4,ReadAheadBufferSize=512");
+    EXPECT_EQ(m_ReadAheadBytes, 0);
+}
+
+TEST_F(BPReadAhead, ChangingSelection)
+{
+    // shifts by a few elements each step, so prefetched ranges rarely match
+    const std::string fname("BPReadAheadChanging.bp");
+    Write(fname);
+    ReadAndCheck(fname, "ReadAheadSteps=2,Threads=2", true);
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
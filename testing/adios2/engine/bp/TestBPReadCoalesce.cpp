@@ -0,0 +1,202 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 read coalescing: many small reads of one subfile must return the same
+// data whether they are merged (ReadSieveGapBytes/MaxCoalescedReadSize) or not.
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../TestHelpers.h"
+
+std::string engineName; // from command line
+
+namespace
+{
+constexpr size_t NVars = 16;
+constexpr size_t Nx = 10;
+constexpr size_t NBlocks = 4;
+constexpr size_t NSteps = 3;
+
+double Value1D(size_t step, size_t var, size_t i)
+{
+    return static_cast<double>(step * 10000 + var * 100 + i);
+}
+
+int32_t Value2D(size_t step, size_t row, size_t col)
+{
+    return static_cast<int32_t>(step * 10000 + row * 100 + col);
+}
+
+void WriteFile(const std::string &fname)
+{
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+
+    std::vector<adios2::Variable<double>> vars;
+    for (size_t v = 0; v < NVars; ++v)
+    {
+        vars.push_back(io.DefineVariable<double>("v" + std::to_string(v), {Nx}, {0}, {Nx}));
+    }
+    // NBlocks row blocks of a (NBlocks*Nx) x Nx array
+    auto var2D = io.DefineVariable<int32_t>("a2D", {NBlocks * Nx, Nx}, {0, 0}, {Nx, Nx});
+
+    adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        writer.BeginStep();
+        for (size_t v = 0; v < NVars; ++v)
+        {
+            std::vector<double> data(Nx);
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                data[i] = Value1D(step, v, i);
+            }
+            writer.Put(vars[v], data.data(), adios2::Mode::Sync);
+        }
+        for (size_t b = 0; b < NBlocks; ++b)
+        {
+            std::vector<int32_t> data(Nx * Nx);
+            for (size_t r = 0; r < Nx; ++r)
+            {
+                for (size_t c = 0; c < Nx; ++c)
+                {
+                    data[r * Nx + c] = Value2D(step, b * Nx + r, c);
+                }
+            }
+            var2D.SetSelection({{b * Nx, 0}, {Nx, Nx}});
+            writer.Put(var2D, data.data(), adios2::Mode::Sync);
+        }
+        writer.EndStep();
+    }
+    writer.Close();
+}
+}
+
+class BPReadCoalesce : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPReadCoalesce() = default;
+};
+
+TEST_P(BPReadCoalesce, ManySmallReads)
+{
+    const std::string fname("BPReadCoalesce.bp");
+    WriteFile(fname);
+
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    io.SetParameters(GetParam());
+
+    adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+    size_t step = 0;
+    while (reader.BeginStep() == adios2::StepStatus::OK)
+    {
+        std::vector<std::vector<double>> in1D(NVars);
+        for (size_t v = 0; v < NVars; ++v)
+        {
+            auto var = io.InquireVariable<double>("v" + std::to_string(v));
+            ASSERT_TRUE(var);
+            reader.Get(var, in1D[v]);
+        }
+
+        // a column slab across all row blocks: one non-contiguous read per block
+        auto var2D = io.InquireVariable<int32_t>("a2D");
+        ASSERT_TRUE(var2D);
+        const size_t col0 = 3, ncols = 4;
+        var2D.SetSelection({{0, col0}, {NBlocks * Nx, ncols}});
+        std::vector<int32_t> in2D;
+        reader.Get(var2D, in2D);
+        reader.EndStep();
+
+        for (size_t v = 0; v < NVars; ++v)
+        {
+            ASSERT_EQ(in1D[v].size(), Nx);
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                EXPECT_EQ(in1D[v][i], Value1D(step, v, i))
+                    << "step=" << step << " var=" << v << " i=" << i;
+            }
+        }
+        ASSERT_EQ(in2D.size(), NBlocks * Nx * ncols);
+        for (size_t r = 0; r < NBlocks * Nx; ++r)
+        {
+            for (size_t c = 0; c < ncols; ++c)
+            {
+                EXPECT_EQ(in2D[r * ncols + c], Value2D(step, r, col0 + c))
+                    << "step=" << step << " row=" << r << " col=" << col0 + c;
+            }
+        }
+        ++step;
+    }
+    EXPECT_EQ(step, NSteps);
+    reader.Close();
+
+    // every step asks for NVars + NBlocks byte ranges of the one subfile
+    const std::string profileFile = ReaderProfileFile(fname);
+    const size_t reads = ProfileCount(ReadProfile(profileFile), "datareads");
+    const std::string params = GetParam();
+    if (params.find("ReadSieveGapBytes") != std::string::npos)
+    {
+        // the gaps are read through, one read per step
+        EXPECT_EQ(reads, NSteps);
+    }
+    else if (params.find("MaxCoalescedReadSize") != std::string::npos)
+    {
+        // off, or too small to merge any two requests
+        EXPECT_EQ(reads, NSteps * (NVars + NBlocks));
+    }
+    else
+    {
+        EXPECT_LT(reads, NSteps * (NVars + NBlocks));
+    }
+    std::remove(profileFile.c_str());
+
+    CleanupTestFiles(fname);
+}
+
+INSTANTIATE_TEST_SUITE_P(Coalesce, BPReadCoalesce,
+                         ::testing::Values("Threads=1", "Threads=1,MaxCoalescedReadSize=0",
+                                           "Threads=1,ReadSieveGapBytes=1MB",
+                                           "Threads=1,MaxCoalescedReadSize=100",
+                                           "Threads=3,ReadSieveGapBytes=1MB",
+                                           "Threads=3,MaxCoalescedReadSize=0",
+                                           "Threads=8,MaxCoalescedReadSize=0"));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
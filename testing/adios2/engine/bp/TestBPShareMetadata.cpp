@@ -0,0 +1,175 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 ReadRandomAccess with ShareMetadataOnNode: the ranks of a node keep one
+// copy of the metadata in shared memory, so the private memory each rank
+// allocates at Open must not grow with the size of the metadata.
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+#if defined(__linux__)
+#include <malloc.h> // mallinfo2
+#endif
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../TestHelpers.h"
+
+std::string engineName; // from command line
+
+class BPShareMetadata : public ::testing::Test
+{
+public:
+    BPShareMetadata()
+    {
+        MPI_Comm_rank(MPI_COMM_WORLD, &m_Rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &m_Size);
+        MPI_Comm nodeComm;
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, m_Rank, MPI_INFO_NULL,
+                            &nodeComm);
+        MPI_Comm_size(nodeComm, &m_NodeSize);
+        MPI_Comm_free(&nodeComm);
+    }
+
+    // enough single element blocks for megabytes of metadata
+    static constexpr size_t NVars = 10;
+    static constexpr size_t NBlocks = 200;
+    static constexpr size_t NSteps = 20;
+
+    int m_Rank = 0;
+    int m_Size = 1;
+    int m_NodeSize = 1;
+
+    void Write(const std::string &fname)
+    {
+        adios2::ADIOS adios(MPI_COMM_WORLD);
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        const size_t nBlocks = NBlocks * static_cast<size_t>(m_Size);
+        std::vector<adios2::Variable<double>> vars;
+        for (size_t v = 0; v < NVars; ++v)
+        {
+            vars.push_back(io.DefineVariable<double>("v" + std::to_string(v), {nBlocks}, {0}, {1}));
+        }
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            for (auto &var : vars)
+            {
+                for (size_t b = 0; b < NBlocks; ++b)
+                {
+                    const size_t g = m_Rank * NBlocks + b;
+                    const double value = static_cast<double>(step * nBlocks + g);
+                    var.SetSelection({{g}, {1}});
+                    writer.Put(var, value, adios2::Mode::Sync);
+                }
+            }
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    /** Bytes this process has allocated with malloc, 0 if unknown. Shared
+     *  memory windows are not allocated with malloc. */
+    static size_t HeapInUse()
+    {
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+        const struct mallinfo2 mi = mallinfo2();
+        return mi.uordblks + mi.hblkhd;
+#else
+        return 0;
+#endif
+    }
+
+    /** Opens the file with params, checks a value of the last step and
+     *  returns how much private memory the Open took on this rank */
+    size_t OpenAndRead(const std::string &fname, const std::string &params)
+    {
+        adios2::ADIOS adios(MPI_COMM_WORLD);
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameters(params);
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        const size_t before = HeapInUse();
+        adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+        const size_t after = HeapInUse();
+
+        auto var = io.InquireVariable<double>("v3");
+        EXPECT_TRUE(var);
+        if (var)
+        {
+            const size_t g = m_Rank * NBlocks + 7;
+            var.SetStepSelection({NSteps - 1, 1});
+            var.SetSelection({{g}, {1}});
+            std::vector<double> data;
+            reader.Get(var, data, adios2::Mode::Sync);
+            EXPECT_EQ(data.size(), 1);
+            EXPECT_EQ(data.front(), static_cast<double>((NSteps - 1) * NBlocks * m_Size + g));
+        }
+        reader.Close();
+        return (after > before) ? after - before : 0;
+    }
+};
+
+TEST_F(BPShareMetadata, PrivateMemoryDoesNotGrowPerRank)
+{
+    const std::string fname("BPShareMetadata.bp");
+    Write(fname);
+
+    size_t metadataSize = 0;
+    if (m_Rank == 0)
+    {
+        std::ifstream md(fname + "/md.0", std::ios::binary | std::ios::ate);
+        metadataSize = static_cast<size_t>(md.tellg());
+    }
+    MPI_Bcast(&metadataSize, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+
+    const size_t plain = OpenAndRead(fname, "LazyMetadataInstall=true");
+    const size_t shared = OpenAndRead(fname, "LazyMetadataInstall=true,ShareMetadataOnNode=true");
+    CleanupTestFilesMPI(fname, MPI_COMM_WORLD);
+
+    if ((m_NodeSize < 2) || !HeapInUse())
+    {
+        GTEST_SKIP() << "needs several ranks per node and glibc's mallinfo2";
+    }
+    // every rank holds all of the metadata when it is not shared ...
+    EXPECT_GE(plain, metadataSize / 2) << "rank " << m_Rank;
+    // ... and only the index of the steps when it is
+    EXPECT_LT(shared, metadataSize / 4) << "rank " << m_Rank << " metadata " << metadataSize;
+}
+
+int main(int argc, char **argv)
+{
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+
+    return result;
+}
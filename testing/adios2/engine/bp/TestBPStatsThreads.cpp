@@ -0,0 +1,213 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 writes with StatsThreads: per-block min/max computed on several threads
+// (large blocks split, small blocks distributed at the end of the step) must
+// match the single-threaded statistics, for sync, deferred and span Puts.
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../TestHelpers.h"
+
+std::string engineName; // from command line
+
+namespace
+{
+constexpr size_t NLarge = 400000; // 3.2MB of doubles, above the split size
+constexpr size_t NSmall = 100;
+constexpr size_t NSmallBlocks = 20;
+constexpr size_t NSteps = 2;
+
+// the extremes sit somewhere inside the block, not at its ends
+double Value(size_t step, size_t block, size_t i, size_t n)
+{
+    if (i == (n * 2) / 3)
+        return -1.0 - static_cast<double>(step + block);
+    if (i == n / 5)
+        return 1e9 + static_cast<double>(step + block);
+    return static_cast<double>(i % 1000);
+}
+
+void WriteFile(const std::string &fname, const std::string &params)
+{
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    io.SetParameters(params);
+
+    auto large = io.DefineVariable<double>("large", {2 * NLarge}, {0}, {NLarge});
+    auto small = io.DefineVariable<double>("small", {NSmallBlocks * NSmall}, {0}, {NSmall});
+    auto ints = io.DefineVariable<int32_t>("ints", {NLarge}, {0}, {NLarge});
+    auto span = io.DefineVariable<double>("span", {NSmall}, {0}, {NSmall});
+
+    adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        writer.BeginStep();
+        std::vector<double> data(NLarge);
+        // block 0 sync (copied), block 1 deferred (zero copy)
+        std::vector<double> deferred(NLarge);
+        for (size_t b = 0; b < 2; ++b)
+        {
+            std::vector<double> &buf = b ? deferred : data;
+            for (size_t i = 0; i < NLarge; ++i)
+            {
+                buf[i] = Value(step, b, i, NLarge);
+            }
+            large.SetSelection({{b * NLarge}, {NLarge}});
+            writer.Put(large, buf.data(), b ? adios2::Mode::Deferred : adios2::Mode::Sync);
+        }
+        for (size_t b = 0; b < NSmallBlocks; ++b)
+        {
+            for (size_t i = 0; i < NSmall; ++i)
+            {
+                data[i] = Value(step, b, i, NSmall);
+            }
+            small.SetSelection({{b * NSmall}, {NSmall}});
+            writer.Put(small, data.data(), adios2::Mode::Sync);
+            // the buffer is reused right away
+            std::fill(data.begin(), data.begin() + NSmall, 5e9);
+        }
+        std::vector<int32_t> idata(NLarge);
+        for (size_t i = 0; i < NLarge; ++i)
+        {
+            idata[i] = static_cast<int32_t>(Value(step, 7, i, NLarge));
+        }
+        writer.Put(ints, idata.data(), adios2::Mode::Sync);
+        auto s = writer.Put(span);
+        for (size_t i = 0; i < NSmall; ++i)
+        {
+            s[i] = Value(step, 9, i, NSmall);
+        }
+        writer.EndStep();
+    }
+    writer.Close();
+}
+
+template <class T>
+void CheckBlocks(adios2::Engine &reader, adios2::Variable<T> var, size_t step,
+                 const std::vector<size_t> &blockIDs, size_t n)
+{
+    auto blocks = reader.BlocksInfo(var, step);
+    ASSERT_EQ(blocks.size(), blockIDs.size());
+    for (size_t k = 0; k < blocks.size(); ++k)
+    {
+        const size_t b = blockIDs[k];
+        EXPECT_EQ(blocks[k].Min, static_cast<T>(Value(step, b, (n * 2) / 3, n)))
+            << var.Name() << " step " << step << " block " << k;
+        EXPECT_EQ(blocks[k].Max, static_cast<T>(Value(step, b, n / 5, n)))
+            << var.Name() << " step " << step << " block " << k;
+    }
+}
+}
+
+class BPStatsThreads : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPStatsThreads() = default;
+};
+
+TEST_P(BPStatsThreads, BlockMinMax)
+{
+    const std::string fname("BPStatsThreads.bp");
+    WriteFile(fname, GetParam());
+
+    // with threads, the two large blocks are split; small, span and ints
+    // (1.6MB, under the split size) are queued
+    const std::string profile = ReadProfile(fname + "/profiling.json");
+    const size_t split = ProfileCount(profile, "splitstatsblocks");
+    const size_t queued = ProfileCount(profile, "queuedstatsblocks");
+    if (GetParam() == "StatsThreads=1")
+    {
+        EXPECT_EQ(split, 0);
+        EXPECT_EQ(queued, 0);
+    }
+    else
+    {
+        EXPECT_EQ(split, 2 * NSteps);
+        EXPECT_EQ(queued, (NSmallBlocks + 2) * NSteps);
+    }
+
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+
+    adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    auto large = io.InquireVariable<double>("large");
+    auto small = io.InquireVariable<double>("small");
+    auto ints = io.InquireVariable<int32_t>("ints");
+    auto span = io.InquireVariable<double>("span");
+    ASSERT_TRUE(large && small && ints && span);
+    std::vector<size_t> smallIDs(NSmallBlocks);
+    for (size_t b = 0; b < NSmallBlocks; ++b)
+    {
+        smallIDs[b] = b;
+    }
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        CheckBlocks(reader, large, step, {0, 1}, NLarge);
+        CheckBlocks(reader, small, step, smallIDs, NSmall);
+        CheckBlocks(reader, ints, step, {7}, NLarge);
+        CheckBlocks(reader, span, step, {9}, NSmall);
+    }
+
+    // the data itself is unchanged by the split copy
+    std::vector<double> data;
+    large.SetStepSelection({1, 1});
+    reader.Get(large, data, adios2::Mode::Sync);
+    ASSERT_EQ(data.size(), 2 * NLarge);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        ASSERT_EQ(data[i], Value(1, i / NLarge, i % NLarge, NLarge)) << "i=" << i;
+    }
+    small.SetStepSelection({0, 1});
+    reader.Get(small, data, adios2::Mode::Sync);
+    ASSERT_EQ(data.size(), NSmallBlocks * NSmall);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        ASSERT_EQ(data[i], Value(0, i / NSmall, i % NSmall, NSmall)) << "i=" << i;
+    }
+    reader.Close();
+    CleanupTestFiles(fname);
+}
+
+INSTANTIATE_TEST_SUITE_P(StatsThreads, BPStatsThreads,
+                         ::testing::Values("StatsThreads=1", "StatsThreads=4",
+                                           "StatsThreads=3,BufferVType=malloc"));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
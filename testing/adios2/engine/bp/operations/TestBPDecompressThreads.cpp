@@ -0,0 +1,198 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 reads with several reader threads decompress the blocks of an operated
+// variable concurrently, each thread with its own operator instance.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../../TestHelpers.h"
+
+std::string engineName; // comes from command line
+
+class BPDecompressThreads : public ::testing::Test
+{
+public:
+    BPDecompressThreads()
+    {
+#if ADIOS2_USE_MPI
+        MPI_Comm_rank(MPI_COMM_WORLD, &m_Rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &m_Size);
+#endif
+    }
+
+    static constexpr size_t Nx = 1000;
+    static constexpr size_t NBlocks = 8;
+    static constexpr size_t NSteps = 2;
+
+    int m_Rank = 0;
+    int m_Size = 1;
+
+    size_t RankOffset() const { return static_cast<size_t>(m_Rank) * Nx * NBlocks; }
+
+    static double Value(size_t step, size_t i) { return static_cast<double>(step * 100000 + i); }
+
+    /** Every rank writes NBlocks BZIP2 compressed blocks of Nx doubles per step */
+    void Write(const std::string &fname)
+    {
+#if ADIOS2_USE_MPI
+        adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+        adios2::ADIOS adios;
+#endif
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        const adios2::Dims shape{Nx * NBlocks * static_cast<size_t>(m_Size)};
+        auto var = io.DefineVariable<double>("r64", shape, {RankOffset()}, {Nx});
+        var.AddOperation(adios2::ops::LosslessBZIP2,
+                         {{adios2::ops::bzip2::key::blockSize100k,
+                           adios2::ops::bzip2::value::blockSize100k_1}});
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        std::vector<double> data(Nx * NBlocks);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                data[i] = Value(step, RankOffset() + i);
+            }
+            writer.BeginStep();
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                var.SetSelection({{RankOffset() + b * Nx}, {Nx}});
+                writer.Put(var, data.data() + b * Nx, adios2::Mode::Sync);
+            }
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    /** Reads this rank's blocks of every step in one Get */
+    void CheckRead(const std::string &fname, const std::string &threads, adios2::Mode mode)
+    {
+#if ADIOS2_USE_MPI
+        adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+        adios2::ADIOS adios;
+#endif
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameter("Threads", threads);
+
+        adios2::Engine reader = io.Open(fname, mode);
+        std::vector<double> data;
+        size_t step = 0;
+        auto lf_Check = [&](adios2::Variable<double> &var) {
+            var.SetSelection({{RankOffset()}, {Nx * NBlocks}});
+            reader.Get(var, data, adios2::Mode::Sync);
+            ASSERT_EQ(data.size(), Nx * NBlocks);
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                ASSERT_EQ(data[i], Value(step, RankOffset() + i))
+                    << "step=" << step << " i=" << i << " rank=" << m_Rank;
+            }
+        };
+        if (mode == adios2::Mode::ReadRandomAccess)
+        {
+            auto var = io.InquireVariable<double>("r64");
+            ASSERT_TRUE(var);
+            for (; step < NSteps; ++step)
+            {
+                var.SetStepSelection({step, 1});
+                lf_Check(var);
+            }
+        }
+        else
+        {
+            while (reader.BeginStep() == adios2::StepStatus::OK)
+            {
+                auto var = io.InquireVariable<double>("r64");
+                ASSERT_TRUE(var);
+                lf_Check(var);
+                reader.EndStep();
+                ++step;
+            }
+        }
+        EXPECT_EQ(step, NSteps);
+        reader.Close();
+    }
+
+    void Cleanup(const std::string &fname)
+    {
+#if ADIOS2_USE_MPI
+        CleanupTestFilesMPI(fname, MPI_COMM_WORLD);
+#else
+        CleanupTestFiles(fname);
+#endif
+    }
+};
+
+TEST_F(BPDecompressThreads, OneThread)
+{
+    const std::string fname("BPDecompressThreadsOne.bp");
+    Write(fname);
+    CheckRead(fname, "1", adios2::Mode::Read);
+    Cleanup(fname);
+}
+
+TEST_F(BPDecompressThreads, Streaming)
+{
+    const std::string fname("BPDecompressThreadsStreaming.bp");
+    Write(fname);
+    CheckRead(fname, "4", adios2::Mode::Read);
+    Cleanup(fname);
+}
+
+TEST_F(BPDecompressThreads, RandomAccess)
+{
+    const std::string fname("BPDecompressThreadsRandomAccess.bp");
+    Write(fname);
+    CheckRead(fname, "4", adios2::Mode::ReadRandomAccess);
+    Cleanup(fname);
+}
+
+TEST_F(BPDecompressThreads, MoreThreadsThanBlocks)
+{
+    // some reader threads get no block to decompress
+    const std::string fname("BPDecompressThreadsMore.bp");
+    Write(fname);
+    CheckRead(fname, "16", adios2::Mode::Read);
+    Cleanup(fname);
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
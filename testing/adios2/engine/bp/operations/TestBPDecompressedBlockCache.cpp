@@ -0,0 +1,234 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// BP5 readers with DecompressedBlockCacheSize keep decompressed blocks of
+// operated variables across Get calls. Slicing the same blocks along rows and
+// columns must give the same data with a cache that holds them all, one that
+// keeps evicting them and none.
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../../TestHelpers.h"
+
+std::string engineName; // comes from command line
+
+class BPDecompressedBlockCache : public ::testing::Test
+{
+public:
+    BPDecompressedBlockCache()
+    {
+#if ADIOS2_USE_MPI
+        MPI_Comm_rank(MPI_COMM_WORLD, &m_Rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &m_Size);
+#endif
+    }
+
+    static constexpr size_t Nx = 20;
+    static constexpr size_t Ny = 30;
+    static constexpr size_t NBlocks = 3;
+    static constexpr size_t NSteps = 2;
+
+    int m_Rank = 0;
+    int m_Size = 1;
+
+    size_t RankRow() const { return static_cast<size_t>(m_Rank) * Nx * NBlocks; }
+
+    static double Value(size_t step, size_t row, size_t col)
+    {
+        return static_cast<double>(step * 100000 + row * Ny + col);
+    }
+
+    /** Every rank writes NBlocks BZIP2 compressed Nx x Ny row blocks per step */
+    void Write(const std::string &fname)
+    {
+#if ADIOS2_USE_MPI
+        adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+        adios2::ADIOS adios;
+#endif
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        const size_t totalRows = Nx * NBlocks * static_cast<size_t>(m_Size);
+        auto var = io.DefineVariable<double>("r64", {totalRows, Ny}, {RankRow(), 0}, {Nx, Ny});
+        var.AddOperation(adios2::ops::LosslessBZIP2,
+                         {{adios2::ops::bzip2::key::blockSize100k,
+                           adios2::ops::bzip2::value::blockSize100k_1}});
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        std::vector<double> block(Nx * Ny);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    for (size_t j = 0; j < Ny; ++j)
+                    {
+                        block[i * Ny + j] = Value(step, RankRow() + b * Nx + i, j);
+                    }
+                }
+                var.SetSelection({{RankRow() + b * Nx, 0}, {Nx, Ny}});
+                writer.Put(var, block.data(), adios2::Mode::Sync);
+            }
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    /** Reads columns across all of this rank's blocks, then a row out of each
+     *  block, twice per step */
+    void CheckSlices(const std::string &fname, const std::string &cacheSize)
+    {
+#if ADIOS2_USE_MPI
+        adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+        adios2::ADIOS adios;
+#endif
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameter("DecompressedBlockCacheSize", cacheSize);
+
+        adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+        auto var = io.InquireVariable<double>("r64");
+        ASSERT_TRUE(var);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            var.SetStepSelection({step, 1});
+            for (size_t pass = 0; pass < 2; ++pass)
+            {
+                for (size_t col = 0; col < Ny; col += 7)
+                {
+                    std::vector<double> column;
+                    var.SetSelection({{RankRow(), col}, {Nx * NBlocks, 1}});
+                    reader.Get(var, column, adios2::Mode::Sync);
+                    ASSERT_EQ(column.size(), Nx * NBlocks);
+                    for (size_t i = 0; i < Nx * NBlocks; ++i)
+                    {
+                        ASSERT_EQ(column[i], Value(step, RankRow() + i, col))
+                            << "step=" << step << " col=" << col << " i=" << i;
+                    }
+                }
+                for (size_t row = 1; row < Nx * NBlocks; row += Nx)
+                {
+                    std::vector<double> line;
+                    var.SetSelection({{RankRow() + row, 0}, {1, Ny}});
+                    reader.Get(var, line, adios2::Mode::Sync);
+                    ASSERT_EQ(line.size(), Ny);
+                    for (size_t j = 0; j < Ny; ++j)
+                    {
+                        ASSERT_EQ(line[j], Value(step, RankRow() + row, j))
+                            << "step=" << step << " row=" << row << " j=" << j;
+                    }
+                }
+            }
+        }
+        reader.Close();
+
+        // rank 0 writes the profile with the counts of all ranks
+        const std::string profileFile = ReaderProfileFile(fname);
+        const std::string profile = ReadProfile(profileFile);
+        m_Hits = ProfileCount(profile, "blockcachehits");
+        m_Evictions = ProfileCount(profile, "blockcacheevictions");
+        if (m_Rank == 0)
+        {
+            std::remove(profileFile.c_str());
+        }
+    }
+
+    size_t m_Hits = 0;
+    size_t m_Evictions = 0;
+
+    /** Blocks CheckSlices uses: each column and one row use every block, in
+     *  both passes of every step and on every rank */
+    size_t BlockUses() const
+    {
+        const size_t columns = (Ny + 6) / 7;
+        return static_cast<size_t>(m_Size) * NSteps * 2 * NBlocks * (columns + 1);
+    }
+
+    void Cleanup(const std::string &fname)
+    {
+#if ADIOS2_USE_MPI
+        CleanupTestFilesMPI(fname, MPI_COMM_WORLD);
+#else
+        CleanupTestFiles(fname);
+#endif
+    }
+};
+
+TEST_F(BPDecompressedBlockCache, NoCache)
+{
+    const std::string fname("BPDecompressedBlockCacheOff.bp");
+    Write(fname);
+    CheckSlices(fname, "0");
+    EXPECT_EQ(m_Hits, 0);
+    Cleanup(fname);
+}
+
+TEST_F(BPDecompressedBlockCache, HoldsAllBlocks)
+{
+    const std::string fname("BPDecompressedBlockCacheAll.bp");
+    Write(fname);
+    CheckSlices(fname, "1MB");
+    if (m_Rank == 0)
+    {
+        // every block is decompressed once per step
+        EXPECT_EQ(m_Hits, BlockUses() - static_cast<size_t>(m_Size) * NSteps * NBlocks);
+        EXPECT_EQ(m_Evictions, 0);
+    }
+    Cleanup(fname);
+}
+
+TEST_F(BPDecompressedBlockCache, EvictsBlocks)
+{
+    // room for one decompressed block, so the others are evicted and
+    // decompressed again
+    const std::string fname("BPDecompressedBlockCacheEvict.bp");
+    Write(fname);
+    CheckSlices(fname, std::to_string(Nx * Ny * sizeof(double)));
+    if (m_Rank == 0)
+    {
+        EXPECT_GT(m_Evictions, 0);
+        EXPECT_LT(m_Hits, BlockUses() - static_cast<size_t>(m_Size) * NSteps * NBlocks);
+    }
+    Cleanup(fname);
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    int result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -11,6 +11,7 @@
 #include <iostream>
 #include <limits>
 #include <stdexcept>
+#include <vector>
 
 #include <adios2.h>
 #include <adios2/common/ADIOSTypes.h>
@@ -1098,6 +1099,96 @@ TEST(ADIOS2MinMaxs, ADIOS2MinMaxs_4D_3x2x5x4)
     }
 }
 
+namespace
+{
+template <class T>
+void CheckCopyAndGetMinMax(const size_t size)
+{
+    // values go up and down so min and max land in the middle and in the tail
+    std::vector<T> values(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        values[i] = static_cast<T>((i * 37) % 101);
+    }
+    values[size / 2] = static_cast<T>(-3);
+    values[size - 1] = static_cast<T>(120);
+
+    std::vector<T> dest(size, static_cast<T>(0));
+    T min, max;
+    adios2::helper::CopyAndGetMinMax(values.data(), size, dest.data(), min, max);
+    T emin, emax;
+    adios2::helper::GetMinMax(values.data(), size, emin, emax, adios2::MemorySpace::Host);
+    EXPECT_EQ(min, emin) << "size=" << size;
+    EXPECT_EQ(max, emax) << "size=" << size;
+    EXPECT_EQ(dest, values) << "size=" << size;
+}
+}
+
+TEST(ADIOS2MinMaxs, ADIOS2CopyAndGetMinMax)
+{
+    // sizes below, at and across the vector widths and the copy piece size
+    for (size_t size : {1, 3, 8, 9, 1000, 5000, 100003})
+    {
+        CheckCopyAndGetMinMax<double>(size);
+        CheckCopyAndGetMinMax<float>(size);
+        CheckCopyAndGetMinMax<int8_t>(size);
+        CheckCopyAndGetMinMax<uint16_t>(size);
+        CheckCopyAndGetMinMax<int32_t>(size);
+        CheckCopyAndGetMinMax<int64_t>(size);
+    }
+}
+
+TEST(ADIOS2MinMaxs, ADIOS2Histogram)
+{
+    // 0..99 in 10 bins: 10 each, the max lands in the last bin
+    std::vector<int32_t> values(100);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<int32_t>(i);
+    }
+    std::vector<uint64_t> counts(10, 0);
+    adios2::helper::GetHistogram(values.data(), values.size(), 0, 99, counts.size(),
+                                 counts.data());
+    EXPECT_EQ(counts, std::vector<uint64_t>(10, 10));
+    EXPECT_EQ(adios2::helper::HistogramBin(99, 0, 99, 10), 9u);
+    EXPECT_EQ(adios2::helper::HistogramBin(-5, 0, 99, 10), 0u);
+    EXPECT_EQ(adios2::helper::HistogramBin(500, 0, 99, 10), 9u);
+
+    // counts add up, and a constant block goes to the first bin
+    adios2::helper::GetHistogram(values.data(), values.size(), 0, 99, counts.size(),
+                                 counts.data());
+    EXPECT_EQ(counts[3], 20u);
+    const std::vector<double> same(7, 2.5);
+    std::vector<uint64_t> one(4, 0);
+    adios2::helper::GetHistogram(same.data(), same.size(), 2.5, 2.5, one.size(), one.data());
+    EXPECT_EQ(one, std::vector<uint64_t>({7, 0, 0, 0}));
+
+    // a full int8 range does not overflow the bin width
+    EXPECT_EQ(adios2::helper::HistogramBin<int8_t>(127, -128, 127, 4), 3u);
+    EXPECT_EQ(adios2::helper::HistogramBin<int8_t>(-1, -128, 127, 4), 1u);
+
+    // nor does the full double range
+    const double big = std::numeric_limits<double>::max();
+    EXPECT_EQ(adios2::helper::HistogramBin(big, -big, big, 4), 3u);
+    EXPECT_EQ(adios2::helper::HistogramBin(-big, -big, big, 4), 0u);
+    EXPECT_EQ(adios2::helper::HistogramBin(1.0, -big, big, 4), 2u);
+
+    // a denormal width and non-finite values land in the end bins
+    const double tiny = std::numeric_limits<double>::denorm_min();
+    EXPECT_EQ(adios2::helper::HistogramBin(tiny, 0.0, tiny, 4), 3u);
+    EXPECT_EQ(adios2::helper::HistogramBin(0.0, 0.0, tiny, 4), 0u);
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_EQ(adios2::helper::HistogramBin(inf, 0.0, 1.0, 4), 3u);
+    EXPECT_EQ(adios2::helper::HistogramBin(-inf, 0.0, 1.0, 4), 0u);
+    EXPECT_EQ(adios2::helper::HistogramBin(nan, 0.0, 1.0, 4), 0u);
+    const std::vector<double> odd = {nan, inf, -inf, tiny, 0.0};
+    std::vector<uint64_t> oddCounts(4, 0);
+    adios2::helper::GetHistogram(odd.data(), odd.size(), 0.0, tiny, oddCounts.size(),
+                                 oddCounts.data());
+    EXPECT_EQ(oddCounts, std::vector<uint64_t>({3, 0, 0, 2}));
+}
+
 int main(int argc, char **argv)
 {
 
@@ -67,6 +67,46 @@ TEST(ADIOS2Partitioner, ADIOS2PartitionerGreedy)
     }
 }
 
+TEST(ADIOS2Partitioner, ADIOS2PartitionCountTuner)
+{
+    // throughput grows with the count up to a peak, then drops
+    auto lf_Run = [](const size_t initial, const size_t maxCount, const size_t peak) {
+        adios2::helper::PartitionCountTuner tuner(initial, maxCount);
+        size_t steps = 0;
+        while (!tuner.Converged() && steps < 64)
+        {
+            const size_t n = tuner.Count();
+            const double throughput = (n <= peak) ? 100.0 * n : 100.0 * peak - 10.0 * (n - peak);
+            tuner.Update(throughput);
+            EXPECT_GE(tuner.Count(), 1);
+            EXPECT_LE(tuner.Count(), maxCount);
+            ++steps;
+        }
+        EXPECT_TRUE(tuner.Converged());
+        return tuner.Count();
+    };
+
+    // growing from below the peak
+    EXPECT_EQ(lf_Run(1, 64, 8), 8);
+    EXPECT_EQ(lf_Run(2, 64, 16), 16);
+    // stops at the largest count allowed
+    EXPECT_EQ(lf_Run(2, 12, 64), 8);
+    // shrinking from above the peak
+    EXPECT_EQ(lf_Run(32, 64, 4), 4);
+    // nothing to tune
+    EXPECT_EQ(lf_Run(1, 1, 8), 1);
+
+    // a flat curve keeps the initial count
+    adios2::helper::PartitionCountTuner flat(4, 16);
+    while (!flat.Converged())
+    {
+        flat.Update(1000.0);
+    }
+    EXPECT_EQ(flat.Count(), 4);
+    // the search is over, later measurements do not change the count
+    EXPECT_EQ(flat.Update(1.0), 4);
+}
+
 int main(int argc, char **argv)
 {
     int result;
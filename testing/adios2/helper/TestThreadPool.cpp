@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <adios2/helper/adiosThreadPool.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(ADIOS2ThreadPool, RunCallsEveryIndexOnce)
+{
+    adios2::helper::ThreadPool pool(3);
+    for (size_t n : {1, 2, 4, 17})
+    {
+        std::vector<std::atomic<int>> calls(n);
+        pool.Run(n, [&](size_t i) { ++calls[i]; });
+        for (size_t i = 0; i < n; ++i)
+        {
+            EXPECT_EQ(calls[i].load(), 1) << "n=" << n << " i=" << i;
+        }
+    }
+}
+
+TEST(ADIOS2ThreadPool, RunRethrows)
+{
+    adios2::helper::ThreadPool pool(2);
+    std::atomic<int> done(0);
+    EXPECT_THROW(pool.Run(4,
+                          [&](size_t i) {
+                              if (i == 2)
+                              {
+                                  throw std::runtime_error("task 2");
+                              }
+                              ++done;
+                          }),
+                 std::runtime_error);
+    EXPECT_EQ(done.load(), 3);
+}
+
+TEST(ADIOS2ThreadPool, NestedRunOnBusyPool)
+{
+    // every worker is inside Run waiting for more tasks than there are
+    // workers: only calling the untaken indices itself lets this finish
+    adios2::helper::ThreadPool pool(2);
+    std::atomic<int> inner(0);
+    std::vector<std::shared_future<void>> outer;
+    for (int t = 0; t < 4; ++t)
+    {
+        outer.push_back(pool.Submit([&]() { pool.Run(8, [&](size_t) { ++inner; }); }));
+    }
+    for (auto &f : outer)
+    {
+        f.get();
+    }
+    EXPECT_EQ(inner.load(), 4 * 8);
+}
+
+TEST(ADIOS2ThreadPool, RunLeavesOtherTasksQueued)
+{
+    // the only worker is busy, so Run calls all of its indices itself, and
+    // a task queued before it must not run on the calling thread
+    adios2::helper::ThreadPool pool(1);
+    std::promise<void> started, release;
+    std::shared_future<void> released = release.get_future().share();
+    auto blocker = pool.Submit([&started, released]() {
+        started.set_value();
+        released.wait();
+    });
+    started.get_future().wait();
+    std::atomic<bool> otherRan(false);
+    auto other = pool.Submit([&]() { otherRan = true; });
+
+    const auto caller = std::this_thread::get_id();
+    std::vector<std::thread::id> callers(4);
+    pool.Run(callers.size(), [&](size_t i) { callers[i] = std::this_thread::get_id(); });
+    for (const auto &id : callers)
+    {
+        EXPECT_EQ(id, caller);
+    }
+    EXPECT_FALSE(otherRan.load());
+
+    release.set_value();
+    blocker.get();
+    other.get();
+    EXPECT_TRUE(otherRan.load());
+}
+
+TEST(ADIOS2ThreadPool, SubmitFuture)
+{
+    adios2::helper::ThreadPool pool(1);
+    int value = 0;
+    auto ok = pool.Submit([&]() { value = 42; });
+    auto bad = pool.Submit([]() { throw std::logic_error("bad"); });
+    ok.get();
+    EXPECT_EQ(value, 42);
+    EXPECT_THROW(bad.get(), std::logic_error);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -78,6 +78,9 @@ public:
     const size_t NSteps = 3;
 
     int mpiRank = 0, mpiSize = 1;
+
+    // BP5 files written with sub-block statistics hit the same regions as BP4
+    bool m_SubBlockStats = false;
 };
 
 void BPQueryTest::QueryIntVar(const std::string &fname, adios2::ADIOS &adios,
@@ -104,7 +107,7 @@ void BPQueryTest::QueryIntVar(const std::string &fname, adios2::ADIOS &adios,
     WriteXmlQuery1D(queryFile, ioName, "intV");
 
     std::vector<size_t> rr;
-    if (engineName.compare("BP4") == 0)
+    if ((engineName.compare("BP4") == 0) || m_SubBlockStats)
         rr = {2, 1, 1};
     else
         rr = {1, 1, 1};
@@ -140,7 +143,7 @@ void BPQueryTest::QueryDoubleVar(const std::string &fname, adios2::ADIOS &adios,
     WriteXmlQuery1D(queryFile, ioName, "doubleV");
 
     std::vector<size_t> rr; //= {0,9,9};
-    if (engineName.compare("BP4") == 0)
+    if ((engineName.compare("BP4") == 0) || m_SubBlockStats)
         rr = {0, 3, 1};
     else
         rr = {0, 1, 1};
@@ -193,7 +196,7 @@ void BPQueryTest::WriteFile(const std::string &fname, adios2::ADIOS &adios,
             io.SetEngine("BPFile");
         }
 
-        if (engineName.compare("BP4") == 0)
+        if ((engineName.compare("BP4") == 0) || m_SubBlockStats)
         {
             io.SetParameters("statslevel=1");
             io.SetParameters("statsblocksize=10");
@@ -259,6 +262,28 @@ TEST_F(BPQueryTest, BP5)
     }
 }
 
+TEST_F(BPQueryTest, BP5StatsBlockSize)
+{
+    std::string engineName = "BP5";
+    m_SubBlockStats = true;
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+    const std::string fname(engineName + "QuerySubBlocks1D_MPI.bp");
+#else
+    adios2::ADIOS adios;
+    const std::string fname(engineName + "QuerySubBlocks1D.bp");
+#endif
+
+    WriteFile(fname, adios, engineName);
+
+    if (mpiSize == 1)
+    {
+        QueryDoubleVar(fname, adios, engineName);
+        QueryIntVar(fname, adios, engineName);
+    }
+}
+
 //******************************************************************************
 // 2D  test data
 //******************************************************************************
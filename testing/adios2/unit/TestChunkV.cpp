@@ -15,6 +15,7 @@
 #include <adios2.h>
 #include <adios2/common/ADIOSTypes.h>
 #include <adios2/toolkit/format/buffer/chunk/ChunkV.h>
+#include <adios2/toolkit/format/buffer/malloc/MallocV.h>
 
 #include <gtest/gtest.h>
 
@@ -138,6 +139,62 @@ TEST(ChunkV, AlignmentToMemBlockSize)
         ASSERT_EQ(chunk1[AllocSize - 1], AllocSize - 1);
     }
 }
+
+static const BufferAllocator Allocators[] = {BufferAllocator::Malloc, BufferAllocator::HugePage,
+                                             BufferAllocator::NumaLocal,
+                                             BufferAllocator::Interleave};
+
+/* copies blocks of growing size into b and checks that the buffer holds
+ * them back to back */
+static void FillAndCheck(BufferV &b)
+{
+    std::vector<uint8_t> expected;
+    std::vector<uint8_t> block;
+    for (size_t n = 0; n < 12; ++n)
+    {
+        block.resize((n + 1) * 512 * 1024 + 13);
+        for (size_t i = 0; i < block.size(); ++i)
+        {
+            block[i] = static_cast<uint8_t>(i * 7 + n);
+        }
+        b.AddToVec(block.size(), block.data(), 1, true);
+        expected.insert(expected.end(), block.begin(), block.end());
+    }
+
+    std::vector<uint8_t> actual;
+    for (const auto &v : b.DataVec())
+    {
+        const uint8_t *p = reinterpret_cast<const uint8_t *>(v.iov_base);
+        actual.insert(actual.end(), p, p + v.iov_len);
+    }
+    ASSERT_EQ(actual.size(), expected.size());
+    ASSERT_TRUE(actual == expected);
+}
+
+TEST(ChunkV, Allocators)
+{
+    for (const auto allocator : Allocators)
+    {
+        SCOPED_TRACE(static_cast<int>(allocator));
+        ChunkV b("test", false, 64, 1, 3 * 1024 * 1024, allocator);
+        FillAndCheck(b);
+        // again in the recycled chunks
+        b.Reset();
+        FillAndCheck(b);
+    }
+}
+
+TEST(MallocV, Allocators)
+{
+    for (const auto allocator : Allocators)
+    {
+        SCOPED_TRACE(static_cast<int>(allocator));
+        MallocV b("test", false, 1, 1, 16 * 1024, 1.5, allocator);
+        FillAndCheck(b);
+        b.Reset();
+        FillAndCheck(b);
+    }
+}
 }
 }
 
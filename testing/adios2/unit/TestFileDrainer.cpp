@@ -0,0 +1,222 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <adios2/toolkit/burstbuffer/FileDrainerMultiThread.h>
+#include <adios2/toolkit/burstbuffer/FileDrainerSingleThread.h>
+
+#include <gtest/gtest.h>
+
+namespace adios2
+{
+namespace burstbuffer
+{
+
+namespace
+{
+std::vector<char> Pattern(size_t n, size_t seed)
+{
+    std::vector<char> v(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        v[i] = static_cast<char>((i * 31 + seed * 7) % 251);
+    }
+    return v;
+}
+
+void WriteFile(const std::string &name, const std::vector<char> &data)
+{
+    std::ofstream f(name, std::ios::binary | std::ios::trunc);
+    f.write(data.data(), data.size());
+}
+
+std::vector<char> ReadFile(const std::string &name)
+{
+    std::ifstream f(name, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+/** The same operations as the BP writers give, in the same order */
+template <class Drainer>
+void Drain(Drainer &drainer, const std::string &prefix, const std::vector<char> &data,
+           const std::vector<char> &header)
+{
+    const std::string from = prefix + ".from";
+    const std::string toData = prefix + ".data";
+    const std::string toMeta = prefix + ".meta";
+    drainer.AddOperationOpen(toData, Mode::Write);
+    drainer.AddOperationOpen(toMeta, Mode::Write);
+    // data in pieces, appended one after the other
+    size_t pos = 0;
+    for (size_t piece : {size_t(1000), size_t(70000), size_t(5), data.size() - 70000 - 1005})
+    {
+        drainer.AddOperationCopy(from, toData, piece);
+        pos += piece;
+    }
+    // rewrite the start of the data, then copy part of it again at the end
+    drainer.AddOperationCopyAt(from, toData, 100, 0, 5000);
+    drainer.AddOperationCopyAt(from, toData, 0, pos, 3000);
+    // header rewritten in place, then more appended after it
+    drainer.AddOperationWriteAt(toMeta, 0, header.size(), header.data());
+    drainer.AddOperationWriteAt(toMeta, 0, 4, "ABCD");
+    drainer.AddOperationSeekEnd(toMeta);
+    drainer.AddOperationWrite(toMeta, header.size(), header.data());
+    // reopen for append
+    drainer.AddOperationOpen(toMeta, Mode::Append);
+    drainer.AddOperationWrite(toMeta, 3, "xyz");
+    drainer.AddOperationDelete(from);
+    drainer.Finish();
+    drainer.Join();
+}
+}
+
+TEST(FileDrainer, MultiThreadMatchesSingleThread)
+{
+    const std::vector<char> data = Pattern(200000, 1);
+    const std::vector<char> header = Pattern(300, 2);
+
+    WriteFile("FileDrainerSingle.from", data);
+    FileDrainerSingleThread single;
+    single.Start();
+    Drain(single, "FileDrainerSingle", data, header);
+
+    for (size_t nThreads : {1, 3})
+    {
+        WriteFile("FileDrainerMulti.from", data);
+        FileDrainerMultiThread multi(nThreads);
+        // small chunks so the copies are spread over the threads
+        multi.SetBufferSize(4096);
+        multi.Start();
+        Drain(multi, "FileDrainerMulti", data, header);
+
+        EXPECT_EQ(ReadFile("FileDrainerMulti.data"), ReadFile("FileDrainerSingle.data"))
+            << nThreads << " threads";
+        EXPECT_EQ(ReadFile("FileDrainerMulti.meta"), ReadFile("FileDrainerSingle.meta"))
+            << nThreads << " threads";
+        EXPECT_FALSE(std::ifstream("FileDrainerMulti.from").good());
+    }
+
+    std::vector<char> expected(data);
+    std::copy(data.begin() + 100, data.begin() + 5100, expected.begin());
+    expected.insert(expected.end(), data.begin(), data.begin() + 3000);
+    EXPECT_EQ(ReadFile("FileDrainerMulti.data"), expected);
+
+    for (const char *name : {"FileDrainerSingle.data", "FileDrainerSingle.meta",
+                             "FileDrainerMulti.data", "FileDrainerMulti.meta"})
+    {
+        std::remove(name);
+    }
+}
+
+TEST(FileDrainer, MultiThreadWaitsForData)
+{
+    // the copy is queued before the writer has put all of the data there
+    const std::vector<char> data = Pattern(50000, 3);
+    std::vector<char> first(data.begin(), data.begin() + 20000);
+    WriteFile("FileDrainerWait.from", first);
+
+    FileDrainerMultiThread drainer(2);
+    drainer.SetBufferSize(8192);
+    drainer.Start();
+    drainer.AddOperationOpen("FileDrainerWait.to", Mode::Write);
+    drainer.AddOperationCopy("FileDrainerWait.from", "FileDrainerWait.to", data.size());
+    {
+        std::ofstream f("FileDrainerWait.from", std::ios::binary | std::ios::app);
+        f.write(data.data() + first.size(), data.size() - first.size());
+    }
+    drainer.Finish();
+    drainer.Join();
+
+    EXPECT_EQ(ReadFile("FileDrainerWait.to"), data);
+    std::remove("FileDrainerWait.from");
+    std::remove("FileDrainerWait.to");
+}
+
+TEST(FileDrainer, MaxBandwidth)
+{
+    const std::vector<char> data = Pattern(400000, 4);
+    WriteFile("FileDrainerBandwidth.from", data);
+
+    FileDrainerMultiThread drainer(3);
+    drainer.SetBufferSize(4096);
+    drainer.SetMaxBandwidth(2000000);
+    drainer.Start();
+    const auto start = std::chrono::steady_clock::now();
+    drainer.AddOperationOpen("FileDrainerBandwidth.to", Mode::Write);
+    drainer.AddOperationCopy("FileDrainerBandwidth.from", "FileDrainerBandwidth.to", data.size());
+    drainer.Finish();
+    drainer.Join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    // 0.2 seconds at 2MB/s, less the first chunk that starts right away
+    EXPECT_GE(elapsed.count(), 0.19);
+    EXPECT_EQ(ReadFile("FileDrainerBandwidth.to"), data);
+    std::remove("FileDrainerBandwidth.from");
+    std::remove("FileDrainerBandwidth.to");
+}
+
+TEST(FileDrainer, LowPriority)
+{
+    const std::vector<char> data = Pattern(100000, 5);
+    WriteFile("FileDrainerLowPriority.from", data);
+
+    FileDrainerMultiThread drainer(2);
+    drainer.SetLowPriority(true);
+    drainer.Start();
+    // the application computed before, now it is communicating
+    drainer.EnterComputationBlock();
+    drainer.ExitComputationBlock();
+    drainer.AddOperationOpen("FileDrainerLowPriority.to", Mode::Write);
+    drainer.AddOperationCopy("FileDrainerLowPriority.from", "FileDrainerLowPriority.to",
+                             data.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    EXPECT_TRUE(ReadFile("FileDrainerLowPriority.to").empty());
+
+    // computing again, the drain continues without waiting for Finish
+    drainer.EnterComputationBlock();
+    for (int i = 0; i < 100 && ReadFile("FileDrainerLowPriority.to").size() < data.size(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    EXPECT_EQ(ReadFile("FileDrainerLowPriority.to"), data);
+    drainer.ExitComputationBlock();
+    drainer.Finish();
+    drainer.Join();
+
+    // yielding ends when the application waits for the drain
+    WriteFile("FileDrainerLowPriority.from", data);
+    FileDrainerSingleThread single;
+    single.SetLowPriority(true);
+    single.Start();
+    single.EnterComputationBlock();
+    single.ExitComputationBlock();
+    single.AddOperationOpen("FileDrainerLowPriority.to2", Mode::Write);
+    single.AddOperationCopy("FileDrainerLowPriority.from", "FileDrainerLowPriority.to2",
+                            data.size());
+    single.Finish();
+    single.Join();
+    EXPECT_EQ(ReadFile("FileDrainerLowPriority.to2"), data);
+
+    std::remove("FileDrainerLowPriority.from");
+    std::remove("FileDrainerLowPriority.to");
+    std::remove("FileDrainerLowPriority.to2");
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
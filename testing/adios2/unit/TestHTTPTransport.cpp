@@ -0,0 +1,389 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Oak Ridge National Laboratory and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <adios2/helper/adiosCommDummy.h>
+#include <adios2/toolkit/transport/file/FileHTTP.h>
+
+#include <gtest/gtest.h>
+
+namespace adios2
+{
+namespace transport
+{
+
+namespace
+{
+std::vector<char> Pattern(size_t n)
+{
+    std::vector<char> v(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        v[i] = static_cast<char>((i * 131 + i / 251) % 253);
+    }
+    return v;
+}
+
+/** HTTP/1.1 server on localhost with keep-alive, pipelining and range requests */
+class RangeServer
+{
+public:
+    /** answer every GET with the whole file, as servers without range support do */
+    bool IgnoreRanges = false;
+    /** close each connection after this many responses, 0 for never */
+    size_t CloseAfter = 0;
+    /** send Connection: close with the last response, or just drop the connection */
+    bool AnnounceClose = true;
+
+    std::atomic<int> Connections{0};
+    std::atomic<int> Requests{0};
+    std::atomic<size_t> MaxRanges{0};
+
+    explicit RangeServer(const std::vector<char> &data) : m_Data(data)
+    {
+        m_Listen = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(m_Listen, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+        listen(m_Listen, 16);
+        socklen_t len = sizeof(addr);
+        getsockname(m_Listen, reinterpret_cast<sockaddr *>(&addr), &len);
+        m_Port = ntohs(addr.sin_port);
+        m_Acceptor = std::thread(&RangeServer::Accept, this);
+    }
+
+    ~RangeServer()
+    {
+        shutdown(m_Listen, SHUT_RDWR);
+        m_Acceptor.join();
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            for (int fd : m_Clients)
+            {
+                shutdown(fd, SHUT_RDWR);
+            }
+        }
+        for (auto &t : m_Handlers)
+        {
+            t.join();
+        }
+        for (int fd : m_Clients)
+        {
+            close(fd);
+        }
+        close(m_Listen);
+    }
+
+    std::string URL() const
+    {
+        return "http://127.0.0.1:" + std::to_string(m_Port) + "/data/file.bp";
+    }
+
+private:
+    const std::vector<char> &m_Data;
+    int m_Listen;
+    uint16_t m_Port;
+    std::thread m_Acceptor;
+    std::vector<std::thread> m_Handlers;
+    std::mutex m_Mutex;
+    std::vector<int> m_Clients;
+
+    void Accept()
+    {
+        while (true)
+        {
+            const int fd = accept(m_Listen, nullptr, nullptr);
+            if (fd < 0)
+            {
+                return;
+            }
+            ++Connections;
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Clients.push_back(fd);
+            m_Handlers.emplace_back(&RangeServer::Serve, this, fd);
+        }
+    }
+
+    static void SendAll(int fd, const std::string &s)
+    {
+        size_t sent = 0;
+        while (sent < s.size())
+        {
+            const ssize_t n = send(fd, s.data() + sent, s.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0)
+            {
+                return;
+            }
+            sent += n;
+        }
+    }
+
+    std::string Response(const std::string &request, bool close)
+    {
+        const std::string total = std::to_string(m_Data.size());
+        const std::string connection = close ? "Connection: close\r\n" : "";
+        if (request.compare(0, 5, "HEAD ") == 0)
+        {
+            return "HTTP/1.1 200 OK\r\n" + connection + "Content-Length: " + total + "\r\n\r\n";
+        }
+
+        std::vector<std::pair<size_t, size_t>> ranges;
+        const size_t r = request.find("Range: bytes=");
+        if (r != std::string::npos)
+        {
+            const char *p = request.c_str() + r + 13;
+            while (*p != '\r')
+            {
+                char *dash, *next;
+                const size_t b = std::strtoull(p, &dash, 10);
+                const size_t e = std::strtoull(dash + 1, &next, 10);
+                ranges.emplace_back(b, e + 1);
+                p = (*next == ',') ? next + 1 : next;
+            }
+        }
+        MaxRanges = std::max(MaxRanges.load(), ranges.size());
+
+        if (ranges.empty() || IgnoreRanges)
+        {
+            return "HTTP/1.1 200 OK\r\n" + connection + "Content-Length: " + total + "\r\n\r\n" +
+                   std::string(m_Data.begin(), m_Data.end());
+        }
+        auto lf_Range = [&](const std::pair<size_t, size_t> &range) {
+            return "bytes " + std::to_string(range.first) + "-" +
+                   std::to_string(range.second - 1) + "/" + total;
+        };
+        auto lf_Data = [&](const std::pair<size_t, size_t> &range) {
+            return std::string(m_Data.begin() + range.first, m_Data.begin() + range.second);
+        };
+        if (ranges.size() == 1)
+        {
+            const size_t length = ranges[0].second - ranges[0].first;
+            return "HTTP/1.1 206 Partial Content\r\n" + connection + "Content-Range: " +
+                   lf_Range(ranges[0]) + "\r\nContent-Length: " + std::to_string(length) +
+                   "\r\n\r\n" + lf_Data(ranges[0]);
+        }
+        std::string body;
+        for (const auto &range : ranges)
+        {
+            body += (body.empty() ? "" : "\r\n") + std::string("--SEPARATOR\r\n") +
+                    "Content-Type: application/octet-stream\r\nContent-Range: " +
+                    lf_Range(range) + "\r\n\r\n" + lf_Data(range);
+        }
+        body += "\r\n--SEPARATOR--\r\n";
+        return "HTTP/1.1 206 Partial Content\r\n" + connection +
+               "Content-Type: multipart/byteranges; boundary=SEPARATOR\r\n"
+               "Content-Length: " +
+               std::to_string(body.size()) + "\r\n\r\n" + body;
+    }
+
+    void Serve(int fd)
+    {
+        std::string in;
+        size_t answered = 0;
+        char buf[4096];
+        while (true)
+        {
+            size_t end;
+            while ((end = in.find("\r\n\r\n")) == std::string::npos)
+            {
+                const ssize_t n = recv(fd, buf, sizeof(buf), 0);
+                if (n <= 0)
+                {
+                    return;
+                }
+                in.append(buf, n);
+            }
+            const std::string request = in.substr(0, end + 4);
+            in.erase(0, end + 4);
+            ++Requests;
+            ++answered;
+            const bool last = (CloseAfter > 0 && answered == CloseAfter);
+            SendAll(fd, Response(request, last && AnnounceClose));
+            if (last)
+            {
+                // requests already pipelined behind this one are dropped
+                shutdown(fd, SHUT_RDWR);
+                return;
+            }
+        }
+    }
+};
+
+/** Reads that overlap, touch, lie far apart and cross request size limits */
+std::vector<std::pair<size_t, size_t>> Pieces(size_t fileSize)
+{
+    std::vector<std::pair<size_t, size_t>> pieces = {
+        {500000, 100}, {0, 10},    {10, 20},      {25, 1},          {100, 5000},
+        {2000, 300},   {2100, 50}, {9000, 70000}, {fileSize - 7, 7}, {300000, 1}};
+    for (size_t i = 0; i < 40; ++i)
+    {
+        pieces.emplace_back(600000 + i * 9000, 1000 + i * 17);
+    }
+    return pieces;
+}
+
+void CheckReadV(FileHTTP &file, const std::vector<char> &data)
+{
+    const auto pieces = Pieces(data.size());
+    std::vector<std::vector<char>> buffers;
+    std::vector<Transport::ReadOp> ops;
+    for (const auto &p : pieces)
+    {
+        buffers.emplace_back(p.second);
+    }
+    for (size_t i = 0; i < pieces.size(); ++i)
+    {
+        ops.push_back({buffers[i].data(), pieces[i].second, pieces[i].first});
+    }
+    file.ReadV(ops.data(), ops.size());
+    for (size_t i = 0; i < pieces.size(); ++i)
+    {
+        const auto b = data.begin() + pieces[i].first;
+        EXPECT_TRUE(std::equal(b, b + pieces[i].second, buffers[i].begin()))
+            << "read " << i << " at " << pieces[i].first;
+    }
+}
+}
+
+TEST(HTTPTransport, ReadAndGetSize)
+{
+    const std::vector<char> data = Pattern(1000003);
+    RangeServer server(data);
+
+    FileHTTP file(helper::CommDummy());
+    file.Open(server.URL(), Mode::Read);
+    EXPECT_EQ(file.GetSize(), data.size());
+
+    std::vector<char> buffer(4321);
+    file.Read(buffer.data(), buffer.size(), 123456);
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), data.begin() + 123456));
+    file.Read(buffer.data(), 10, data.size() - 10);
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.begin() + 10, data.end() - 10));
+    file.Close();
+}
+
+TEST(HTTPTransport, ReadVParallelMultiRange)
+{
+    const std::vector<char> data = Pattern(1000003);
+    RangeServer server(data);
+
+    FileHTTP file(helper::CommDummy());
+    file.SetParameters({{"connections", "3"},
+                        {"pipelinedepth", "2"},
+                        {"rangesperrequest", "4"},
+                        {"maxrequestsize", "20000"}});
+    file.Open(server.URL(), Mode::Read);
+    CheckReadV(file, data);
+
+    EXPECT_LE(server.Connections, 3);
+    EXPECT_GT(server.Connections, 1);
+    EXPECT_EQ(server.MaxRanges, 4u);
+
+    // the second batch goes over the pooled connections
+    const int connections = server.Connections;
+    CheckReadV(file, data);
+    EXPECT_EQ(server.Connections, connections);
+    file.Close();
+}
+
+TEST(HTTPTransport, ReusesConnection)
+{
+    const std::vector<char> data = Pattern(100000);
+    RangeServer server(data);
+
+    FileHTTP file(helper::CommDummy());
+    file.SetParameters({{"connections", "1"}});
+    file.Open(server.URL(), Mode::Read);
+    EXPECT_EQ(file.GetSize(), data.size());
+    std::vector<char> buffer(1000);
+    for (size_t start = 0; start < 50000; start += 5000)
+    {
+        file.Read(buffer.data(), buffer.size(), start);
+        EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), data.begin() + start));
+    }
+    EXPECT_EQ(server.Connections, 1);
+    EXPECT_EQ(server.Requests, 11);
+    file.Close();
+}
+
+TEST(HTTPTransport, ServerClosesConnection)
+{
+    const std::vector<char> data = Pattern(1000003);
+    RangeServer server(data);
+    // pipelined requests are lost when the server closes and are sent again
+    server.CloseAfter = 2;
+
+    FileHTTP file(helper::CommDummy());
+    file.SetParameters({{"connections", "2"},
+                        {"pipelinedepth", "4"},
+                        {"rangesperrequest", "3"},
+                        {"maxrequestsize", "50000"}});
+    file.Open(server.URL(), Mode::Read);
+    for (int i = 0; i < 5; ++i)
+    {
+        CheckReadV(file, data);
+    }
+    EXPECT_GT(server.Connections, 2);
+    file.Close();
+}
+
+TEST(HTTPTransport, ServerDropsConnection)
+{
+    const std::vector<char> data = Pattern(1000003);
+    RangeServer server(data);
+    // closed without notice while requests are still being sent to it
+    server.CloseAfter = 1;
+    server.AnnounceClose = false;
+
+    FileHTTP file(helper::CommDummy());
+    file.SetParameters({{"connections", "2"},
+                        {"pipelinedepth", "8"},
+                        {"rangesperrequest", "2"},
+                        {"maxrequestsize", "10000"}});
+    file.Open(server.URL(), Mode::Read);
+    for (int i = 0; i < 3; ++i)
+    {
+        CheckReadV(file, data);
+    }
+    file.Close();
+}
+
+TEST(HTTPTransport, ServerIgnoresRanges)
+{
+    const std::vector<char> data = Pattern(1000003);
+    RangeServer server(data);
+    server.IgnoreRanges = true;
+
+    FileHTTP file(helper::CommDummy());
+    file.SetParameters({{"connections", "2"}, {"rangesperrequest", "8"}});
+    file.Open(server.URL(), Mode::Read);
+    CheckReadV(file, data);
+    file.Close();
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -8,18 +8,22 @@
 #include <cstdint>
 #include <cstring>
 
+#include <fstream>
 #include <future>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
+#include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "adios2/helper/adiosLog.h"
 #include "adios2/helper/adiosString.h"
 #include <adios2.h>
 #include <adios2/common/ADIOSTypes.h>
 #include <adios2/helper/adiosCommDummy.h>
+#include <adios2/toolkit/transport/file/FileMMAP.h>
 #include <adios2/toolkit/transport/file/FilePOSIX.h>
 
 #include <gtest/gtest.h>
@@ -86,6 +90,161 @@ TEST(FileTransport, WaitForData)
     }
     w->Close();
 }
+
+TEST(FileTransport, ReadV)
+{
+    constexpr size_t size = 1 << 20;
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 7 + i / 251);
+    }
+    {
+        helper::Comm comm = helper::CommDummy();
+        auto w = std::make_unique<transport::FilePOSIX>(comm);
+        w->Open("ReadV", Mode::Write);
+        w->Write((char *)data.data(), size);
+        w->Close();
+    }
+
+    // more reads than the ring holds, runs of adjacent ones and scattered ones
+    std::vector<Transport::ReadOp> ops;
+    std::vector<std::vector<uint8_t>> bufs;
+    size_t start = 0;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        const size_t len = 100 + (i * 37) % 4000;
+        bufs.emplace_back(len);
+        ops.push_back({(char *)bufs.back().data(), len, start});
+        start += (i % 3 == 0) ? len : len + 1000;
+    }
+    // zero length and a read up to the end of the file
+    bufs.emplace_back(1);
+    ops.push_back({(char *)bufs.back().data(), 0, 10});
+    bufs.emplace_back(5000);
+    ops.push_back({(char *)bufs.back().data(), 5000, size - 5000});
+
+    auto lf_Check = [&]() {
+        for (size_t i = 0; i < ops.size(); ++i)
+        {
+            ASSERT_EQ(std::memcmp(ops[i].Buffer, data.data() + ops[i].Start, ops[i].Size), 0)
+                << "read " << i;
+            std::memset(ops[i].Buffer, 0, ops[i].Size);
+        }
+    };
+
+    for (const std::string useRing : {"true", "false"})
+    {
+        helper::Comm comm = helper::CommDummy();
+        auto r = std::make_unique<transport::FilePOSIX>(comm);
+        r->Open("ReadV", Mode::Read);
+        r->SetParameters({{"IOUring", useRing}});
+
+        r->ReadV(ops.data(), ops.size());
+        lf_Check();
+
+        r->SubmitReads(ops.data(), ops.size() / 2);
+        r->SubmitReads(ops.data() + ops.size() / 2, ops.size() - ops.size() / 2);
+        r->WaitReads();
+        lf_Check();
+        r->Close();
+    }
+}
+
+/** Bytes of a file named name mapped in this process, -1 if unknown. A
+ *  mapping may be split in several entries by madvise. */
+static long MappedBytesOf(const std::string &name)
+{
+#if defined(__linux__)
+    std::ifstream maps("/proc/self/maps");
+    long bytes = 0;
+    const std::string suffix = "/" + name;
+    for (std::string line; std::getline(maps, line);)
+    {
+        if (line.size() >= suffix.size() &&
+            line.compare(line.size() - suffix.size(), suffix.size(), suffix) == 0)
+        {
+            const size_t dash = line.find('-');
+            bytes += std::stol(line.substr(dash + 1), nullptr, 16) -
+                     std::stol(line.substr(0, dash), nullptr, 16);
+        }
+    }
+    return bytes;
+#else
+    return -1;
+#endif
+}
+
+TEST(FileTransport, MMAP)
+{
+    constexpr size_t size = 4096;
+    std::vector<uint8_t> b(size, 0xef);
+    helper::Comm comm = helper::CommDummy();
+    auto w = std::make_unique<transport::FilePOSIX>(comm);
+    w->Open("MMAP", Mode::Write);
+    w->Write((char *)b.data(), size);
+
+    auto r = std::make_unique<transport::FileMMAP>(comm);
+    r->Open("MMAP", Mode::Read);
+    r->SetParameters({{"Advice", "random"}});
+    EXPECT_EQ(r->GetSize(), size);
+    const char *p = r->DataPointer(100, 200);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ((uint8_t)p[0], 0xef);
+    EXPECT_EQ(r->DataPointer(size - 10, 20), nullptr);
+
+    // a read past the end waits for the file to grow, the mapping follows and
+    // the old pointer stays valid
+    auto lf_WriteMore = [&](uint8_t value, size_t delay_ms) {
+        std::vector<uint8_t> more(size, value);
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        w->Write((char *)more.data(), size);
+    };
+    auto h = std::async(std::launch::async, lf_WriteMore, 0xfe, 500);
+    std::vector<uint8_t> in(2 * size);
+    r->Read((char *)in.data(), 2 * size, 0);
+    h.get();
+    EXPECT_EQ(in[size - 1], 0xef);
+    EXPECT_EQ(in[size], 0xfe);
+    EXPECT_EQ((uint8_t)p[199], 0xef);
+    const char *p2 = r->DataPointer(size - 10, 20);
+    ASSERT_NE(p2, nullptr);
+    EXPECT_EQ((uint8_t)p2[19], 0xfe);
+
+    // mapped again with twice the length, so the next growth fits in it
+    lf_WriteMore(0xfd, 0);
+    const char *p3 = r->DataPointer(0, 3 * size);
+    ASSERT_NE(p3, nullptr);
+    lf_WriteMore(0xfc, 0);
+    const char *p4 = r->DataPointer(0, 4 * size);
+    EXPECT_EQ(p4, p3);
+    EXPECT_EQ((uint8_t)p4[3 * size - 1], 0xfd);
+    EXPECT_EQ((uint8_t)p4[4 * size - 1], 0xfc);
+    w->Close();
+
+    // the replaced mappings stay while pointers into them are out, and go
+    // with the last one
+    if (MappedBytesOf("MMAP") >= 0)
+    {
+        // mapped with 1, 2 and 4 times size
+        EXPECT_EQ(MappedBytesOf("MMAP"), 7 * size);
+        for (const char *q : {p, p2, p3})
+        {
+            r->ReleaseDataPointer(q);
+        }
+        EXPECT_EQ(MappedBytesOf("MMAP"), 7 * size);
+        r->ReleaseDataPointer(p4);
+        EXPECT_EQ(MappedBytesOf("MMAP"), 4 * size);
+        std::vector<uint8_t> last(size);
+        r->Read((char *)last.data(), size, 3 * size);
+        EXPECT_EQ(last[0], 0xfc);
+        EXPECT_EQ(MappedBytesOf("MMAP"), 4 * size);
+    }
+
+    EXPECT_THROW(r->Write((char *)b.data(), size, 0), std::invalid_argument);
+    EXPECT_THROW(r->SetParameters({{"Advice", "soon"}}), std::invalid_argument);
+    r->Close();
+}
 }
 }
 